@@ -0,0 +1,285 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_AsyncOperationQueue_h
+#define Mezz_Filesystem_AsyncOperationQueue_h
+
+/// @file
+/// @brief A queue for running filesystem operations on dedicated threads.
+
+#ifndef SWIG
+    #include "DataTypes.h"
+    #include "FilesystemManagement.h"
+
+    #include <condition_variable>
+    #include <deque>
+    #include <functional>
+    #include <future>
+    #include <mutex>
+    #include <thread>
+    #include <vector>
+#endif
+
+namespace Mezzanine {
+namespace Filesystem {
+    /// @brief An enum for how urgently a queued operation should be run.
+    enum class OperationPriority
+    {
+        High,   ///< Run before anything else that is waiting.
+        Normal, ///< Run once no High priority operations are waiting.
+        Low     ///< Run only when nothing else is waiting.
+    };//OperationPriority
+
+    /// @brief A collection of options for controlling an AsyncOperationQueue.
+    struct MEZZ_LIB AsyncQueueOptions
+    {
+        /// @brief The number of threads dedicated to running operations.
+        /// @remarks Zero uses one thread per hardware thread.
+        size_t ThreadCount = 2;
+        /// @brief The most operations that can be waiting to run at once.
+        /// @remarks Operations that are running don't count towards this. Zero is treated as one.
+        size_t MaxQueueDepth = 1024;
+    };//AsyncQueueOptions
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// @brief A queue that runs filesystem operations on its own threads.
+    /// @details Operations are any callable returning a ModifyResult, which is usually a lambda calling one of the
+    /// functions in FilesystemManagement.h. The most common of those have convenience functions here as well.
+    /// The result is delivered either through a std::future, or by calling a completion callback. @n @n
+    /// Waiting operations are run strictly by priority, and in the order they were submitted within a priority.
+    /// A steady stream of higher priority operations will therefore starve lower priority ones. @n @n
+    /// The queue holds at most MaxQueueDepth waiting operations. Submit blocks until there is room, while
+    /// TrySubmit returns immediately without queueing anything if the queue is full, so it is safe to call from
+    /// threads that must never wait on the disk. @n @n
+    /// Completion callbacks are called on the thread that ran the operation, so they should be short, must not
+    /// throw, and must synchronize with anything they share. If an operation throws, futures rethrow the exception
+    /// from get() and completion callbacks are passed ModifyResult::Unknown.
+    ///////////////////////////////////////
+    class MEZZ_LIB AsyncOperationQueue
+    {
+    public:
+        /// @brief Convenience type for the operations that can be queued.
+        using Operation = std::function<ModifyResult()>;
+        /// @brief Convenience type for the callbacks that are called with the result of an operation.
+        using CompletionCallback = std::function<void(const ModifyResult)>;
+    protected:
+        /// @brief An operation waiting to be run.
+        struct QueuedOperation
+        {
+            /// @brief The operation to run.
+            Operation ToRun;
+            /// @brief Called with the result of the operation, or the exception it threw.
+            std::function<void(const ModifyResult, std::exception_ptr)> OnComplete;
+        };//QueuedOperation
+
+        /// @brief The waiting operations of each priority, highest priority first.
+        std::deque<QueuedOperation> Waiting[3];
+        /// @brief The threads running operations.
+        std::vector<std::thread> Workers;
+        /// @brief The lock guarding the waiting operations and the counters.
+        mutable std::mutex QueueLock;
+        /// @brief Signalled when an operation is queued, or the queue is shutting down.
+        std::condition_variable OperationQueued;
+        /// @brief Signalled when a waiting operation is taken to be run.
+        std::condition_variable SpaceAvailable;
+        /// @brief Signalled when an operation finishes running.
+        std::condition_variable OperationFinished;
+        /// @brief The most operations that can be waiting at once.
+        size_t MaxQueueDepth;
+        /// @brief The number of operations waiting to be run.
+        size_t WaitingCount = 0;
+        /// @brief The number of operations currently being run.
+        size_t RunningCount = 0;
+        /// @brief Set when the workers should exit once nothing is waiting.
+        Boole ShuttingDown = false;
+
+        /// @brief The loop run by each worker thread.
+        void RunWorker();
+        /// @brief Adds an operation to the queue.
+        /// @param ToQueue The operation to add.
+        /// @param Priority How urgently the operation should be run.
+        /// @param Block Whether to wait for room if the queue is full.
+        /// @return Returns true if the operation was queued, false if the queue was full or shutting down.
+        Boole Enqueue(QueuedOperation&& ToQueue, const OperationPriority Priority, const Boole Block);
+        /// @brief Adds an operation whose result will be delivered through a future.
+        /// @param ToRun The operation to add.
+        /// @param Priority How urgently the operation should be run.
+        /// @param Block Whether to wait for room if the queue is full.
+        /// @return Returns a future for the result, or an invalid future if the operation wasn't queued.
+        std::future<ModifyResult> EnqueueWithFuture(Operation ToRun, const OperationPriority Priority,
+                                                    const Boole Block);
+    public:
+        /// @brief Class constructor.
+        AsyncOperationQueue();
+        /// @brief Options constructor.
+        /// @param Options The number of threads and queue depth to use.
+        explicit AsyncOperationQueue(const AsyncQueueOptions& Options);
+        /// @brief Deleted copy constructor.
+        AsyncOperationQueue(const AsyncOperationQueue&) = delete;
+        /// @brief Class destructor.
+        /// @remarks Every operation that was queued is run before the destructor returns.
+        ~AsyncOperationQueue();
+
+        /// @brief Deleted copy assignment operator.
+        AsyncOperationQueue& operator=(const AsyncOperationQueue&) = delete;
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // Submission
+
+        /// @brief Queues an operation, waiting for room if the queue is full.
+        /// @param ToRun The operation to run.
+        /// @param Priority How urgently the operation should be run.
+        /// @return Returns a future for the result of the operation, or an invalid future if the queue is shutting
+        /// down.
+        [[nodiscard]]
+        std::future<ModifyResult> Submit(Operation ToRun, const OperationPriority Priority = OperationPriority::Normal);
+        /// @brief Queues an operation, waiting for room if the queue is full.
+        /// @param ToRun The operation to run.
+        /// @param OnComplete Called on a queue thread with the result of the operation. If the queue is shutting
+        /// down it is instead called on the submitting thread with OperationCanceled.
+        /// @param Priority How urgently the operation should be run.
+        void Submit(Operation ToRun, CompletionCallback OnComplete,
+                    const OperationPriority Priority = OperationPriority::Normal);
+        /// @brief Queues an operation if there is room, without waiting.
+        /// @param ToRun The operation to run.
+        /// @param Priority How urgently the operation should be run.
+        /// @return Returns a future for the result of the operation, or an invalid future if the queue was full or
+        /// shutting down.
+        [[nodiscard]]
+        std::future<ModifyResult> TrySubmit(Operation ToRun,
+                                            const OperationPriority Priority = OperationPriority::Normal);
+        /// @brief Queues an operation if there is room, without waiting.
+        /// @param ToRun The operation to run.
+        /// @param OnComplete Called on a queue thread with the result of the operation.
+        /// @param Priority How urgently the operation should be run.
+        /// @return Returns true if the operation was queued, false if the queue was full or shutting down.
+        [[nodiscard]]
+        Boole TrySubmit(Operation ToRun, CompletionCallback OnComplete,
+                        const OperationPriority Priority = OperationPriority::Normal);
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // Convenience Operations
+
+        /// @brief Queues copying a file, waiting for room if the queue is full.
+        /// @param OldFilePath The existing path to the file (including the filename) to be copied.
+        /// @param NewFilePath The path (including the filename) to where the file should be copied.
+        /// @param IfExists If true the operation will fail if a file with the target name already exists.
+        /// @param Priority How urgently the operation should be run.
+        /// @return Returns a future for the result of CopyFile.
+        [[nodiscard]]
+        std::future<ModifyResult> CopyFile(const StringView OldFilePath, const StringView NewFilePath,
+                                           const FileOverwrite IfExists,
+                                           const OperationPriority Priority = OperationPriority::Normal);
+        /// @brief Queues moving a file, waiting for room if the queue is full.
+        /// @param OldFilePath The existing path to the file (including the filename) to be moved.
+        /// @param NewFilePath The path (including the filename) to where the file should be moved.
+        /// @param IfExists If true the operation will fail if a file with the target name already exists.
+        /// @param Priority How urgently the operation should be run.
+        /// @return Returns a future for the result of MoveFile.
+        [[nodiscard]]
+        std::future<ModifyResult> MoveFile(const StringView OldFilePath, const StringView NewFilePath,
+                                           const FileOverwrite IfExists,
+                                           const OperationPriority Priority = OperationPriority::Normal);
+        /// @brief Queues removing a file, waiting for room if the queue is full.
+        /// @param FilePath The path to the file (including the filename) to be removed.
+        /// @param Priority How urgently the operation should be run.
+        /// @return Returns a future for the result of RemoveFile.
+        [[nodiscard]]
+        std::future<ModifyResult> RemoveFile(const StringView FilePath,
+                                             const OperationPriority Priority = OperationPriority::Normal);
+        /// @brief Queues creating every missing directory in a path, waiting for room if the queue is full.
+        /// @param DirectoryPath The path of directories to create.
+        /// @param Priority How urgently the operation should be run.
+        /// @return Returns a future for the result of CreateDirectoryPath.
+        [[nodiscard]]
+        std::future<ModifyResult> CreateDirectoryPath(const StringView DirectoryPath,
+                                                      const OperationPriority Priority = OperationPriority::Normal);
+        /// @brief Queues removing an empty directory, waiting for room if the queue is full.
+        /// @param DirectoryPath The directory to remove.
+        /// @param Priority How urgently the operation should be run.
+        /// @return Returns a future for the result of RemoveDirectory.
+        [[nodiscard]]
+        std::future<ModifyResult> RemoveDirectory(const StringView DirectoryPath,
+                                                  const OperationPriority Priority = OperationPriority::Normal);
+        /// @brief Queues removing a directory and everything in it, waiting for room if the queue is full.
+        /// @remarks The tree is removed by the single queue thread running the operation.
+        /// @param DirectoryPath The directory to remove.
+        /// @param Priority How urgently the operation should be run.
+        /// @return Returns a future for the result of RemoveDirectoryTree.
+        [[nodiscard]]
+        std::future<ModifyResult> RemoveDirectoryTree(const StringView DirectoryPath,
+                                                      const OperationPriority Priority = OperationPriority::Normal);
+        /// @brief Queues writing a file atomically, waiting for room if the queue is full.
+        /// @remarks The data is copied, so it doesn't need to outlive the call.
+        /// @param FilePath The path (including the filename) of the file to write.
+        /// @param Data The complete contents of the file.
+        /// @param Durability How far the data should be flushed before the file is made visible.
+        /// @param Priority How urgently the operation should be run.
+        /// @return Returns a future for the result of AtomicWriteFile.
+        [[nodiscard]]
+        std::future<ModifyResult> AtomicWriteFile(const StringView FilePath, const StringView Data,
+                                                  const DurabilityPolicy Durability,
+                                                  const OperationPriority Priority = OperationPriority::Normal);
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // Queue State
+
+        /// @brief Gets the number of threads running operations.
+        /// @return Returns the number of threads dedicated to this queue.
+        [[nodiscard]]
+        size_t GetThreadCount() const noexcept;
+        /// @brief Gets the most operations that can be waiting at once.
+        /// @return Returns the depth of the queue.
+        [[nodiscard]]
+        size_t GetMaxQueueDepth() const noexcept;
+        /// @brief Gets the number of operations waiting to be run.
+        /// @return Returns the number of queued operations that haven't started.
+        [[nodiscard]]
+        size_t GetWaitingCount() const;
+        /// @brief Gets the number of operations waiting or running.
+        /// @return Returns the number of operations that haven't completed.
+        [[nodiscard]]
+        size_t GetPendingCount() const;
+        /// @brief Blocks until every queued operation has completed.
+        void WaitForAll();
+    };//AsyncOperationQueue
+}//Filesystem
+}//Mezzanine
+
+#endif
@@ -43,10 +43,199 @@
 #ifndef SWIG
     #include "DataTypes.h"
     #include "ArchiveEntry.h"
+    #include "StringArena.h"
+
+    #include <iterator>
+    #include <memory>
 #endif
 
 namespace Mezzanine {
 namespace Filesystem {
+    /// @brief A container of views, usually of strings stored in a StringArena.
+    using StringViewVector = std::vector<StringView>;
+
+    /// @brief A bitmask of the metadata that should be retrieved for each entry in a directory listing.
+    enum class EntryMetadata : UInt32
+    {
+        None        = 0,  ///< Only the name of the entry.
+        Type        = 1,  ///< Whether the entry is a File, Directory or Symlink.
+        Size        = 2,  ///< The size of the entry in bytes.
+        Times       = 4,  ///< The creation, access and modification times of the entry.
+        Permissions = 8,  ///< The permissions of the entry.
+        All         = 15  ///< Every piece of metadata an ArchiveEntry can store.
+    };//EntryMetadata
+
+    /// @brief The size in bytes of the buffer used to read directory entries when no size is specified.
+    /// @remarks 64 KiB is enough for several hundred to a few thousand entries per system call, depending on the
+    /// length of the names in the directory.
+    constexpr size_t DefaultDirectoryBatchSize = 64 * 1024;
+
+    /// @brief A collection of options for controlling how the contents of a directory are retrieved.
+    struct MEZZ_LIB DirectoryContentsOptions
+    {
+        /// @brief The size in bytes of the buffer to read entries into.
+        /// @remarks Zero uses the portable one entry at a time readdir path. Only used on Linux.
+        size_t BatchSize = DefaultDirectoryBatchSize;
+        /// @brief The metadata that needs to be retrieved for each entry.
+        /// @remarks When only the Type is requested the entry type reported by the directory itself is used and
+        /// entries are only stat'd when the filesystem doesn't report a type, or when the entry is a Symlink that
+        /// needs to be followed. Fields that weren't requested may be left at their default values.
+        EntryMetadata Metadata = EntryMetadata::All;
+        /// @brief Whether Symlinks report the metadata of what they point to, or of the link itself.
+        /// @remarks When false, Symlinks are reported with an EntryType of Symlink. When true, broken Symlinks are
+        /// skipped. Only used on Posix systems.
+        Boole FollowSymlinks = true;
+    };//DirectoryContentsOptions
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // EntryMetadata Operators
+
+    /// @brief Bitwise OR operator for EntryMetadata.
+    /// @param Left The first set of flags to combine.
+    /// @param Right The second set of flags to combine.
+    /// @return Returns the union of both sets of flags.
+    [[nodiscard]]
+    constexpr EntryMetadata operator|(const EntryMetadata Left, const EntryMetadata Right) noexcept
+        { return static_cast<EntryMetadata>( static_cast<UInt32>(Left) | static_cast<UInt32>(Right) ); }
+    /// @brief Bitwise AND operator for EntryMetadata.
+    /// @param Left The first set of flags to intersect.
+    /// @param Right The second set of flags to intersect.
+    /// @return Returns the flags set in both Left and Right.
+    [[nodiscard]]
+    constexpr EntryMetadata operator&(const EntryMetadata Left, const EntryMetadata Right) noexcept
+        { return static_cast<EntryMetadata>( static_cast<UInt32>(Left) & static_cast<UInt32>(Right) ); }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Directory Iteration
+
+    /// @brief The platform specific handle to an open directory that entries are read from.
+    class DirectoryStream;
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// @brief An iterator that reads the entries of an open directory one at a time.
+    /// @details Only the entry currently being pointed to is stored, so iterating over a directory takes the same
+    /// amount of memory regardless of how many entries it has. Since entries are read from the directory as the
+    /// iterator is advanced this is a single pass iterator. Copies of an iterator share the same read position.
+    ///////////////////////////////////////
+    class MEZZ_LIB DirectoryIterator
+    {
+    public:
+        /// @brief The category of this iterator.
+        using iterator_category = std::input_iterator_tag;
+        /// @brief The type yielded by this iterator.
+        using value_type = ArchiveEntry;
+        /// @brief The type used to express the distance between two iterators.
+        using difference_type = std::ptrdiff_t;
+        /// @brief A pointer to the type yielded by this iterator.
+        using pointer = const ArchiveEntry*;
+        /// @brief A reference to the type yielded by this iterator.
+        using reference = const ArchiveEntry&;
+    protected:
+        /// @brief The entry the iterator is currently pointing to.
+        ArchiveEntry Current;
+        /// @brief The open directory being read from, or nullptr if this is an end iterator.
+        DirectoryStream* Stream = nullptr;
+
+        /// @brief Reads the next entry from the directory, becoming an end iterator if there are none left.
+        void Advance();
+    public:
+        /// @brief End iterator constructor.
+        DirectoryIterator() = default;
+        /// @brief Stream constructor.
+        /// @param ToRead The open directory to read entries from. The first entry is read immediately.
+        explicit DirectoryIterator(DirectoryStream* ToRead);
+
+        /// @brief Dereference operator.
+        /// @return Returns a reference to the current entry.
+        [[nodiscard]]
+        reference operator*() const noexcept
+            { return this->Current; }
+        /// @brief Member access operator.
+        /// @return Returns a pointer to the current entry.
+        [[nodiscard]]
+        pointer operator->() const noexcept
+            { return &(this->Current); }
+
+        /// @brief Pre-increment operator.
+        /// @return Returns a reference to this iterator after it has moved to the next entry.
+        DirectoryIterator& operator++()
+        {
+            this->Advance();
+            return *this;
+        }
+        /// @brief Post-increment operator.
+        /// @return Returns a copy of this iterator holding the entry it pointed to before being incremented.
+        DirectoryIterator operator++(int)
+        {
+            DirectoryIterator Ret(*this);
+            this->Advance();
+            return Ret;
+        }
+
+        /// @brief Equality comparison operator.
+        /// @param Other The other iterator to compare to.
+        /// @return Returns true if both iterators read from the same directory or both are end iterators.
+        [[nodiscard]]
+        Boole operator==(const DirectoryIterator& Other) const noexcept
+            { return ( this->Stream == Other.Stream ); }
+        /// @brief Inequality comparison operator.
+        /// @param Other The other iterator to compare to.
+        /// @return Returns true if the iterators read from different directories or only one is an end iterator.
+        [[nodiscard]]
+        Boole operator!=(const DirectoryIterator& Other) const noexcept
+            { return ( this->Stream != Other.Stream ); }
+    };//DirectoryIterator
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// @brief An open directory that can be iterated over with a range-based for loop.
+    /// @details The directory is opened on construction and closed when the range is destroyed. If the directory
+    /// couldn't be opened the range will be empty. Since a directory can only be read once per opening, only one
+    /// pass can be made over the range.
+    ///////////////////////////////////////
+    class MEZZ_LIB DirectoryRange
+    {
+    protected:
+        /// @brief The open directory entries are read from.
+        std::unique_ptr<DirectoryStream> Stream;
+    public:
+        /// @brief Opening constructor.
+        /// @param DirectoryPath The directory to read the entries of.
+        explicit DirectoryRange(const StringView DirectoryPath);
+        /// @brief Opening constructor.
+        /// @param DirectoryPath The directory to read the entries of.
+        /// @param Options The batch size and metadata to retrieve for each entry.
+        DirectoryRange(const StringView DirectoryPath, const DirectoryContentsOptions& Options);
+        /// @brief Deleted copy constructor.
+        DirectoryRange(const DirectoryRange&) = delete;
+        /// @brief Move constructor.
+        /// @param Other The range to take ownership of the open directory from.
+        DirectoryRange(DirectoryRange&& Other) noexcept;
+        /// @brief Class destructor.
+        ~DirectoryRange();
+
+        /// @brief Deleted copy assignment operator.
+        DirectoryRange& operator=(const DirectoryRange&) = delete;
+        /// @brief Move assignment operator.
+        /// @param Other The range to take ownership of the open directory from.
+        /// @return Returns a reference to this.
+        DirectoryRange& operator=(DirectoryRange&& Other) noexcept;
+
+        /// @brief Gets whether or not the directory was successfully opened.
+        /// @return Returns true if the directory is open and can be read from, false otherwise.
+        [[nodiscard]]
+        Boole IsOpen() const noexcept;
+
+        /// @brief Gets an iterator to the next unread entry in the directory.
+        /// @return Returns an iterator pointing at the next entry, or an end iterator if the directory is exhausted.
+        [[nodiscard]]
+        DirectoryIterator begin();
+        /// @brief Gets an iterator marking the end of the directory.
+        /// @return Returns an end iterator.
+        [[nodiscard]]
+        DirectoryIterator end() const noexcept
+            { return DirectoryIterator(); }
+    };//DirectoryRange
+
     ///////////////////////////////////////////////////////////////////////////////
     // Directory Contents
 
@@ -55,11 +244,74 @@ namespace Filesystem {
     /// @return Returns a vector of strings containing the names of every subdirectory and file in the directory.
     [[nodiscard]]
     StringVector MEZZ_LIB GetDirectoryContentNames(const StringView DirectoryPath);
+    /// @brief Gets a listing of file and subdirectory names in a directory.
+    /// @remarks On Linux entries are pulled from the kernel in batches that fill a buffer of BatchSize bytes. On
+    /// other platforms the batch size is ignored.
+    /// @param DirectoryPath The directory to look in.
+    /// @param BatchSize The size in bytes of the buffer to read entries into. Zero uses the portable one entry
+    /// at a time readdir path. Sizes too small to hold one entry of maximum length will be raised to that size.
+    /// @return Returns a vector of strings containing the names of every subdirectory and file in the directory.
+    [[nodiscard]]
+    StringVector MEZZ_LIB GetDirectoryContentNames(const StringView DirectoryPath, const size_t BatchSize);
+    /// @brief Gets a listing of file and subdirectory names in a directory, storing the names in an arena.
+    /// @details Listing a directory this way takes a fixed number of allocations regardless of how many entries
+    /// it has, and none at all for the names once the arena and vector are large enough. Directories that are
+    /// listed repeatedly can reuse the same arena and vector by clearing both between listings.
+    /// @param DirectoryPath The directory to look in.
+    /// @param Arena The arena to copy every name into.
+    /// @param Names The vector to append a view of every name to. Existing views in the vector are kept.
+    /// @return Returns the number of names appended to Names.
+    size_t MEZZ_LIB GetDirectoryContentNames(const StringView DirectoryPath, StringArena& Arena,
+                                             StringViewVector& Names);
     /// @brief Gets a listing of file and subdirectory metadata in a directory.
     /// @param DirectoryPath The directory to look in.
     /// @return Returns a vector of archive entries containing metadata on every file and subdirectory in directory specified.
     [[nodiscard]]
     ArchiveEntryVector MEZZ_LIB GetDirectoryContents(const StringView DirectoryPath);
+    /// @brief Gets a listing of file and subdirectory metadata in a directory.
+    /// @remarks On Linux entries are pulled from the kernel in batches that fill a buffer of BatchSize bytes. On
+    /// other platforms the batch size is ignored.
+    /// @param DirectoryPath The directory to look in.
+    /// @param BatchSize The size in bytes of the buffer to read entries into. Zero uses the portable one entry
+    /// at a time readdir path. Sizes too small to hold one entry of maximum length will be raised to that size.
+    /// @return Returns a vector of archive entries containing metadata on every file and subdirectory in the
+    /// directory specified.
+    [[nodiscard]]
+    ArchiveEntryVector MEZZ_LIB GetDirectoryContents(const StringView DirectoryPath, const size_t BatchSize);
+    /// @brief Gets a listing of file and subdirectory metadata in a directory.
+    /// @remarks Options can be used to skip retrieving metadata that isn't needed, which on Posix systems can
+    /// avoid a stat call for every entry.
+    /// @param DirectoryPath The directory to look in.
+    /// @param Options The batch size and metadata to retrieve for the listing.
+    /// @return Returns a vector of archive entries containing the requested metadata on every file and
+    /// subdirectory in the directory specified.
+    [[nodiscard]]
+    ArchiveEntryVector MEZZ_LIB GetDirectoryContents(const StringView DirectoryPath,
+                                                     const DirectoryContentsOptions& Options);
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Path Metadata
+
+    /// @brief Gets the metadata of a single file, directory or Symlink.
+    /// @remarks Symlinks are followed and all metadata is retrieved.
+    /// @param Path The path of the entry to get the metadata of.
+    /// @return Returns an entry populated with the metadata of the path, or an empty Optional if the path
+    /// doesn't exist or couldn't be accessed.
+    [[nodiscard]]
+    Optional<ArchiveEntry> MEZZ_LIB StatPath(const StringView Path);
+    /// @brief Gets the metadata of a single file, directory or Symlink.
+    /// @remarks On Linux this is a single statx call that only asks the filesystem for the requested fields, and
+    /// the CreateTime of the entry is its birth time when the filesystem records one. Otherwise CreateTime is the
+    /// last time the metadata of the entry changed, as it is in directory listings on other Posix systems.
+    /// @param Path The path of the entry to get the metadata of.
+    /// @param Metadata The metadata that needs to be retrieved. Fields that weren't requested may be left at their
+    /// default values.
+    /// @param FollowSymlinks Whether a Symlink reports the metadata of what it points to, or of the link itself.
+    /// @return Returns an entry populated with the requested metadata of the path, or an empty Optional if the
+    /// path doesn't exist or couldn't be accessed.
+    [[nodiscard]]
+    Optional<ArchiveEntry> MEZZ_LIB StatPath(const StringView Path, const EntryMetadata Metadata,
+                                             const Boole FollowSymlinks);
 }//Filesystem
 }//Mezzanine
 
@@ -0,0 +1,460 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_DirectorySnapshot_h
+#define Mezz_Filesystem_DirectorySnapshot_h
+
+#ifndef SWIG
+    #include "DataTypes.h"
+    #include "ArchiveEntry.h"
+    #include "DirectoryContents.h"
+
+    #include <iterator>
+    #include <vector>
+#endif
+
+namespace Mezzanine {
+namespace Filesystem {
+    ///////////////////////////////////////////////////////////////////////////////
+    /// @brief A compact listing of the entries in a directory, stored as a structure of arrays.
+    /// @details Every name is stored in a single buffer, and each piece of metadata is stored in its own array
+    /// with one element per entry. Scanning or filtering on one kind of metadata therefore walks contiguous memory
+    /// holding only that metadata, rather than skipping over the names and other fields of each ArchiveEntry and
+    /// chasing a pointer to each name that is looked at. @n @n
+    /// Only what a filesystem reports is stored. Descriptions aren't kept, and every entry converted back to an
+    /// ArchiveEntry has an ArchiveType of FileSystem.
+    ///////////////////////////////////////
+    class MEZZ_LIB DirectorySnapshot
+    {
+    public:
+        /// @brief The container storing the type of every entry.
+        using TypeContainer = std::vector<EntryType>;
+        /// @brief The container storing the sizes and times of every entry.
+        using UInt64Container = std::vector<UInt64>;
+        /// @brief The container storing the permissions of every entry.
+        using PermissionsContainer = std::vector<FilePermissions>;
+
+        ///////////////////////////////////////////////////////////////////////////////
+        /// @brief A lightweight view of a single entry in a snapshot.
+        /// @details A view stays valid until the snapshot it refers to is modified or destroyed.
+        ///////////////////////////////////////
+        class MEZZ_LIB EntryView
+        {
+        protected:
+            /// @brief The snapshot holding the entry.
+            const DirectorySnapshot* Snapshot;
+            /// @brief The index of the entry in the snapshot.
+            size_t Index;
+        public:
+            /// @brief Class constructor.
+            /// @param Owner The snapshot holding the entry.
+            /// @param EntryIndex The index of the entry in the snapshot.
+            EntryView(const DirectorySnapshot* Owner, const size_t EntryIndex) noexcept :
+                Snapshot(Owner),
+                Index(EntryIndex)
+                {  }
+
+            /// @brief Gets the index of the entry in its snapshot.
+            /// @return Returns the index of the entry being viewed.
+            [[nodiscard]]
+            size_t GetIndex() const noexcept
+                { return this->Index; }
+            /// @brief Gets the name of the entry.
+            /// @return Returns a null terminated view of the name of the entry.
+            [[nodiscard]]
+            StringView GetName() const noexcept
+                { return this->Snapshot->GetName(this->Index); }
+            /// @brief Gets the type of the entry.
+            /// @return Returns whether the entry is a File, Directory or Symlink.
+            [[nodiscard]]
+            EntryType GetType() const noexcept
+                { return this->Snapshot->GetType(this->Index); }
+            /// @brief Gets the size of the entry.
+            /// @return Returns the size of the entry in bytes.
+            [[nodiscard]]
+            UInt64 GetSize() const noexcept
+                { return this->Snapshot->GetSize(this->Index); }
+            /// @brief Gets the creation time of the entry.
+            /// @return Returns the time the entry was created.
+            [[nodiscard]]
+            UInt64 GetCreateTime() const noexcept
+                { return this->Snapshot->GetCreateTime(this->Index); }
+            /// @brief Gets the last access time of the entry.
+            /// @return Returns the last time the entry was read.
+            [[nodiscard]]
+            UInt64 GetAccessTime() const noexcept
+                { return this->Snapshot->GetAccessTime(this->Index); }
+            /// @brief Gets the last modification time of the entry.
+            /// @return Returns the last time the entry was written.
+            [[nodiscard]]
+            UInt64 GetModifyTime() const noexcept
+                { return this->Snapshot->GetModifyTime(this->Index); }
+            /// @brief Gets the permissions of the entry.
+            /// @return Returns the permissions of the entry.
+            [[nodiscard]]
+            FilePermissions GetPermissions() const noexcept
+                { return this->Snapshot->GetPermissions(this->Index); }
+            /// @brief Copies the entry to an ArchiveEntry.
+            /// @return Returns a new ArchiveEntry with the same name and metadata as the entry.
+            [[nodiscard]]
+            ArchiveEntry ToArchiveEntry() const
+                { return this->Snapshot->GetEntry(this->Index); }
+        };//EntryView
+
+        ///////////////////////////////////////////////////////////////////////////////
+        /// @brief An iterator over the entries of a snapshot.
+        /// @details Entries aren't stored as objects, so dereferencing yields an EntryView by value. That prevents
+        /// this from being a standard random access iterator, but it supports the same arithmetic.
+        ///////////////////////////////////////
+        class MEZZ_LIB const_iterator
+        {
+        public:
+            /// @brief The category of this iterator.
+            using iterator_category = std::input_iterator_tag;
+            /// @brief The type yielded by this iterator.
+            using value_type = EntryView;
+            /// @brief The type used to express the distance between two iterators.
+            using difference_type = std::ptrdiff_t;
+            /// @brief This iterator yields views, which can't be pointed to.
+            using pointer = void;
+            /// @brief The type returned when this iterator is dereferenced.
+            using reference = EntryView;
+        protected:
+            /// @brief The snapshot being iterated over.
+            const DirectorySnapshot* Snapshot = nullptr;
+            /// @brief The index of the entry being pointed to.
+            size_t Index = 0;
+        public:
+            /// @brief Blank constructor.
+            const_iterator() = default;
+            /// @brief Class constructor.
+            /// @param Owner The snapshot to iterate over.
+            /// @param EntryIndex The index of the entry to point to.
+            const_iterator(const DirectorySnapshot* Owner, const size_t EntryIndex) noexcept :
+                Snapshot(Owner),
+                Index(EntryIndex)
+                {  }
+
+            /// @brief Dereference operator.
+            /// @return Returns a view of the entry being pointed to.
+            [[nodiscard]]
+            reference operator*() const noexcept
+                { return EntryView(this->Snapshot,this->Index); }
+            /// @brief Subscript operator.
+            /// @param Offset The distance from this iterator to the entry to view.
+            /// @return Returns a view of the entry Offset entries away from this iterator.
+            [[nodiscard]]
+            reference operator[](const difference_type Offset) const noexcept
+                { return EntryView(this->Snapshot,this->Index + static_cast<size_t>(Offset)); }
+
+            /// @brief Pre-increment operator.
+            /// @return Returns a reference to this iterator after it has moved to the next entry.
+            const_iterator& operator++() noexcept
+            {
+                ++(this->Index);
+                return *this;
+            }
+            /// @brief Post-increment operator.
+            /// @return Returns a copy of this iterator from before it was incremented.
+            const_iterator operator++(int) noexcept
+            {
+                const_iterator Ret(*this);
+                ++(this->Index);
+                return Ret;
+            }
+            /// @brief Pre-decrement operator.
+            /// @return Returns a reference to this iterator after it has moved to the previous entry.
+            const_iterator& operator--() noexcept
+            {
+                --(this->Index);
+                return *this;
+            }
+            /// @brief Post-decrement operator.
+            /// @return Returns a copy of this iterator from before it was decremented.
+            const_iterator operator--(int) noexcept
+            {
+                const_iterator Ret(*this);
+                --(this->Index);
+                return Ret;
+            }
+            /// @brief Compound addition operator.
+            /// @param Offset The number of entries to move forward.
+            /// @return Returns a reference to this iterator.
+            const_iterator& operator+=(const difference_type Offset) noexcept
+            {
+                this->Index += static_cast<size_t>(Offset);
+                return *this;
+            }
+            /// @brief Compound subtraction operator.
+            /// @param Offset The number of entries to move back.
+            /// @return Returns a reference to this iterator.
+            const_iterator& operator-=(const difference_type Offset) noexcept
+            {
+                this->Index -= static_cast<size_t>(Offset);
+                return *this;
+            }
+            /// @brief Addition operator.
+            /// @param Offset The number of entries to move forward.
+            /// @return Returns a new iterator Offset entries after this one.
+            [[nodiscard]]
+            const_iterator operator+(const difference_type Offset) const noexcept
+                { return const_iterator(this->Snapshot,this->Index + static_cast<size_t>(Offset)); }
+            /// @brief Subtraction operator.
+            /// @param Offset The number of entries to move back.
+            /// @return Returns a new iterator Offset entries before this one.
+            [[nodiscard]]
+            const_iterator operator-(const difference_type Offset) const noexcept
+                { return const_iterator(this->Snapshot,this->Index - static_cast<size_t>(Offset)); }
+            /// @brief Difference operator.
+            /// @param Other The iterator to get the distance from.
+            /// @return Returns the number of entries between Other and this iterator.
+            [[nodiscard]]
+            difference_type operator-(const const_iterator& Other) const noexcept
+                { return static_cast<difference_type>(this->Index) - static_cast<difference_type>(Other.Index); }
+
+            /// @brief Equality comparison operator.
+            /// @param Other The other iterator to compare to.
+            /// @return Returns true if both iterators point to the same entry of the same snapshot.
+            [[nodiscard]]
+            Boole operator==(const const_iterator& Other) const noexcept
+                { return ( this->Snapshot == Other.Snapshot && this->Index == Other.Index ); }
+            /// @brief Inequality comparison operator.
+            /// @param Other The other iterator to compare to.
+            /// @return Returns true if the iterators point to different entries.
+            [[nodiscard]]
+            Boole operator!=(const const_iterator& Other) const noexcept
+                { return !( *this == Other ); }
+            /// @brief Less-than comparison operator.
+            /// @param Other The other iterator to compare to.
+            /// @return Returns true if this iterator points to an entry before the one Other points to.
+            [[nodiscard]]
+            Boole operator<(const const_iterator& Other) const noexcept
+                { return ( this->Index < Other.Index ); }
+        };//const_iterator
+    protected:
+        /// @brief Every name in the snapshot, each followed by a null terminator.
+        String Names;
+        /// @brief The offset of each name in the name buffer, with an extra offset marking the end of the buffer.
+        std::vector<size_t> NameOffsets = { 0 };
+        /// @brief The type of each entry.
+        TypeContainer Types;
+        /// @brief The size in bytes of each entry.
+        UInt64Container Sizes;
+        /// @brief The creation time of each entry.
+        UInt64Container CreateTimes;
+        /// @brief The last access time of each entry.
+        UInt64Container AccessTimes;
+        /// @brief The last modification time of each entry.
+        UInt64Container ModifyTimes;
+        /// @brief The permissions of each entry.
+        PermissionsContainer Permissions;
+    public:
+        /// @brief Blank constructor.
+        DirectorySnapshot() = default;
+        /// @brief Conversion constructor.
+        /// @param Entries The entries to copy into the snapshot.
+        explicit DirectorySnapshot(const ArchiveEntryVector& Entries);
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // Capacity
+
+        /// @brief Gets the number of entries in the snapshot.
+        /// @return Returns the number of entries stored.
+        [[nodiscard]]
+        size_t size() const noexcept
+            { return this->Types.size(); }
+        /// @brief Gets whether or not the snapshot has any entries.
+        /// @return Returns true if there are no entries stored, false otherwise.
+        [[nodiscard]]
+        Boole empty() const noexcept
+            { return this->Types.empty(); }
+        /// @brief Gets the number of bytes used to store every name.
+        /// @return Returns the size of the name buffer, including the null terminator after each name.
+        [[nodiscard]]
+        size_t GetNameBufferSize() const noexcept
+            { return this->Names.size(); }
+        /// @brief Allocates space for entries ahead of time.
+        /// @param EntryCount The number of entries to make room for.
+        /// @param NameBytes The total length of the names to make room for, excluding null terminators.
+        void Reserve(const size_t EntryCount, const size_t NameBytes);
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // Modifying
+
+        /// @brief Adds an entry to the end of the snapshot.
+        /// @param ToAdd The entry to copy the name and metadata of.
+        void Append(const ArchiveEntry& ToAdd);
+        /// @brief Removes every entry from the snapshot.
+        void Clear() noexcept;
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // Entry Access
+
+        /// @brief Subscript operator.
+        /// @param Index The index of the entry to view. Must be less than the size of the snapshot.
+        /// @return Returns a view of the entry at the specified index.
+        [[nodiscard]]
+        EntryView operator[](const size_t Index) const noexcept
+            { return EntryView(this,Index); }
+        /// @brief Gets the name of an entry.
+        /// @param Index The index of the entry. Must be less than the size of the snapshot.
+        /// @return Returns a null terminated view of the name of the entry.
+        [[nodiscard]]
+        StringView GetName(const size_t Index) const noexcept
+        {
+            return StringView(this->Names.data() + this->NameOffsets[Index],
+                              ( this->NameOffsets[Index + 1] - this->NameOffsets[Index] ) - 1);
+        }
+        /// @brief Gets the type of an entry.
+        /// @param Index The index of the entry. Must be less than the size of the snapshot.
+        /// @return Returns whether the entry is a File, Directory or Symlink.
+        [[nodiscard]]
+        EntryType GetType(const size_t Index) const noexcept
+            { return this->Types[Index]; }
+        /// @brief Gets the size of an entry.
+        /// @param Index The index of the entry. Must be less than the size of the snapshot.
+        /// @return Returns the size of the entry in bytes.
+        [[nodiscard]]
+        UInt64 GetSize(const size_t Index) const noexcept
+            { return this->Sizes[Index]; }
+        /// @brief Gets the creation time of an entry.
+        /// @param Index The index of the entry. Must be less than the size of the snapshot.
+        /// @return Returns the time the entry was created.
+        [[nodiscard]]
+        UInt64 GetCreateTime(const size_t Index) const noexcept
+            { return this->CreateTimes[Index]; }
+        /// @brief Gets the last access time of an entry.
+        /// @param Index The index of the entry. Must be less than the size of the snapshot.
+        /// @return Returns the last time the entry was read.
+        [[nodiscard]]
+        UInt64 GetAccessTime(const size_t Index) const noexcept
+            { return this->AccessTimes[Index]; }
+        /// @brief Gets the last modification time of an entry.
+        /// @param Index The index of the entry. Must be less than the size of the snapshot.
+        /// @return Returns the last time the entry was written.
+        [[nodiscard]]
+        UInt64 GetModifyTime(const size_t Index) const noexcept
+            { return this->ModifyTimes[Index]; }
+        /// @brief Gets the permissions of an entry.
+        /// @param Index The index of the entry. Must be less than the size of the snapshot.
+        /// @return Returns the permissions of the entry.
+        [[nodiscard]]
+        FilePermissions GetPermissions(const size_t Index) const noexcept
+            { return this->Permissions[Index]; }
+        /// @brief Copies an entry to an ArchiveEntry.
+        /// @param Index The index of the entry. Must be less than the size of the snapshot.
+        /// @return Returns a new ArchiveEntry with the same name and metadata as the entry.
+        [[nodiscard]]
+        ArchiveEntry GetEntry(const size_t Index) const;
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // Column Access
+
+        /// @brief Gets the type of every entry.
+        /// @return Returns a const reference to the array of types, in entry order.
+        [[nodiscard]]
+        const TypeContainer& GetTypes() const noexcept
+            { return this->Types; }
+        /// @brief Gets the size of every entry.
+        /// @return Returns a const reference to the array of sizes, in entry order.
+        [[nodiscard]]
+        const UInt64Container& GetSizes() const noexcept
+            { return this->Sizes; }
+        /// @brief Gets the creation time of every entry.
+        /// @return Returns a const reference to the array of creation times, in entry order.
+        [[nodiscard]]
+        const UInt64Container& GetCreateTimes() const noexcept
+            { return this->CreateTimes; }
+        /// @brief Gets the last access time of every entry.
+        /// @return Returns a const reference to the array of access times, in entry order.
+        [[nodiscard]]
+        const UInt64Container& GetAccessTimes() const noexcept
+            { return this->AccessTimes; }
+        /// @brief Gets the last modification time of every entry.
+        /// @return Returns a const reference to the array of modification times, in entry order.
+        [[nodiscard]]
+        const UInt64Container& GetModifyTimes() const noexcept
+            { return this->ModifyTimes; }
+        /// @brief Gets the permissions of every entry.
+        /// @return Returns a const reference to the array of permissions, in entry order.
+        [[nodiscard]]
+        const PermissionsContainer& GetPermissions() const noexcept
+            { return this->Permissions; }
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // Iteration
+
+        /// @brief Gets an iterator to the first entry.
+        /// @return Returns an iterator pointing at the first entry in the snapshot.
+        [[nodiscard]]
+        const_iterator begin() const noexcept
+            { return const_iterator(this,0); }
+        /// @brief Gets an iterator past the last entry.
+        /// @return Returns an iterator pointing one past the last entry in the snapshot.
+        [[nodiscard]]
+        const_iterator end() const noexcept
+            { return const_iterator(this,this->size()); }
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // Conversion
+
+        /// @brief Copies every entry to an ArchiveEntryVector.
+        /// @return Returns a vector holding an ArchiveEntry for every entry, in the same order.
+        [[nodiscard]]
+        ArchiveEntryVector ToArchiveEntries() const;
+    };//DirectorySnapshot
+
+    /// @brief Gets a snapshot of the file and subdirectory metadata in a directory.
+    /// @param DirectoryPath The directory to look in.
+    /// @return Returns a snapshot containing metadata on every file and subdirectory in the directory specified.
+    [[nodiscard]]
+    DirectorySnapshot MEZZ_LIB GetDirectorySnapshot(const StringView DirectoryPath);
+    /// @brief Gets a snapshot of the file and subdirectory metadata in a directory.
+    /// @remarks Entries are read straight into the snapshot, so no ArchiveEntryVector is built along the way.
+    /// @param DirectoryPath The directory to look in.
+    /// @param Options The batch size and metadata to retrieve for the listing.
+    /// @return Returns a snapshot containing the requested metadata on every file and subdirectory in the
+    /// directory specified.
+    [[nodiscard]]
+    DirectorySnapshot MEZZ_LIB GetDirectorySnapshot(const StringView DirectoryPath,
+                                                    const DirectoryContentsOptions& Options);
+}//Filesystem
+}//Mezzanine
+
+#endif
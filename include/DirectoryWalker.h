@@ -0,0 +1,139 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_DirectoryWalker_h
+#define Mezz_Filesystem_DirectoryWalker_h
+
+#ifndef SWIG
+    #include "DataTypes.h"
+    #include "ArchiveEntry.h"
+    #include "DirectoryContents.h"
+
+    #include <functional>
+    #include <limits>
+#endif
+
+namespace Mezzanine {
+namespace Filesystem {
+    /// @brief An enum for how Symlinks are treated while walking a directory tree.
+    enum class SymlinkPolicy
+    {
+        DontFollow, ///< Symlinks are reported as Symlinks and never descended into.
+        Follow      ///< Symlinks are reported as what they point to, and directories they point to are walked.
+    };//SymlinkPolicy
+
+    /// @brief An enum for what a directory walk should do after visiting an entry.
+    enum class WalkAction
+    {
+        Continue,    ///< Keep walking, descending into the entry if it is a directory.
+        SkipSubtree, ///< Keep walking, but don't descend into the entry if it is a directory.
+        Stop         ///< Stop the walk as soon as possible.
+    };//WalkAction
+
+    /// @brief The callback invoked for every entry found while walking a directory tree.
+    /// @details The first parameter is the path of the directory containing the entry, ending with a separator.
+    /// The second is the entry that was found. The third is the depth of the entry, where entries directly in the
+    /// root of the walk have a depth of 0. @n @n
+    /// When walking with more than one thread the visitor will be called concurrently from several threads, and
+    /// entries are visited in no particular order, other than a directory always being visited before its contents.
+    using DirectoryWalkVisitor = std::function<WalkAction(const StringView, const ArchiveEntry&, const Whole)>;
+
+    /// @brief A collection of options for controlling how a directory tree is walked.
+    struct MEZZ_LIB DirectoryWalkOptions
+    {
+        /// @brief The deepest level of the tree that will be visited.
+        /// @remarks Entries directly in the root of the walk are at a depth of 0, so a MaxDepth of 0 visits only
+        /// the contents of the root without descending into any subdirectories.
+        Whole MaxDepth = std::numeric_limits<Whole>::max();
+        /// @brief The number of threads to walk the tree with, including the calling thread.
+        /// @remarks Zero uses one thread per hardware thread.
+        size_t ThreadCount = 0;
+        /// @brief How Symlinks found while walking are to be treated.
+        /// @remarks When following Symlinks, every directory walked is identified by its device and inode (or
+        /// volume and file index on Windows) and directories that have already been walked are skipped, so
+        /// Symlinks that form loops won't cause the walk to run forever.
+        SymlinkPolicy Symlinks = SymlinkPolicy::DontFollow;
+        /// @brief The metadata that needs to be retrieved for each entry.
+        /// @remarks The type of each entry is always retrieved, since it is needed to find subdirectories.
+        EntryMetadata Metadata = EntryMetadata::All;
+        /// @brief The size in bytes of the buffer to read the entries of each directory into.
+        /// @remarks See DirectoryContentsOptions::BatchSize for details.
+        size_t BatchSize = DefaultDirectoryBatchSize;
+    };//DirectoryWalkOptions
+
+    /// @brief A summary of what was encountered during a directory walk.
+    struct MEZZ_LIB DirectoryWalkResult
+    {
+        /// @brief The number of entries that were passed to the visitor.
+        Whole EntriesVisited = 0;
+        /// @brief The number of directories whose contents were read, including the root.
+        Whole DirectoriesWalked = 0;
+        /// @brief The number of directories that couldn't be opened, including the root.
+        Whole DirectoriesFailed = 0;
+        /// @brief The number of directories skipped because they had already been walked.
+        Whole LoopsSkipped = 0;
+        /// @brief Whether or not the walk ended early because the visitor asked it to stop.
+        Boole Stopped = false;
+    };//DirectoryWalkResult
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Directory Walking
+
+    /// @brief Visits every entry in a directory and all of its subdirectories.
+    /// @param RootPath The directory to start walking from.
+    /// @param Visitor The callback to invoke for every entry found. See DirectoryWalkVisitor for details.
+    /// @return Returns a summary of the entries and directories encountered.
+    [[nodiscard]]
+    DirectoryWalkResult MEZZ_LIB WalkDirectoryTree(const StringView RootPath, const DirectoryWalkVisitor& Visitor);
+    /// @brief Visits every entry in a directory and all of its subdirectories.
+    /// @remarks Each directory is read by a single task. Tasks for subdirectories are queued on the thread that
+    /// found them and idle threads steal queued tasks from busy ones, so wide and deep trees both keep every
+    /// thread busy. The call doesn't return until every task has completed.
+    /// @exception If the visitor throws, the walk is stopped and the first exception thrown is rethrown.
+    /// @param RootPath The directory to start walking from.
+    /// @param Visitor The callback to invoke for every entry found. See DirectoryWalkVisitor for details.
+    /// @param Options The thread count, depth limit, Symlink policy and metadata to use for the walk.
+    /// @return Returns a summary of the entries and directories encountered.
+    [[nodiscard]]
+    DirectoryWalkResult MEZZ_LIB WalkDirectoryTree(const StringView RootPath, const DirectoryWalkVisitor& Visitor,
+                                                   const DirectoryWalkOptions& Options);
+}//Filesystem
+}//Mezzanine
+
+#endif
@@ -0,0 +1,223 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_DirectoryWatcher_h
+#define Mezz_Filesystem_DirectoryWatcher_h
+
+/// @file
+/// @brief Utilities for being notified when the contents of a directory change.
+
+#ifndef SWIG
+    #include "DataTypes.h"
+
+    #include <atomic>
+    #include <chrono>
+    #include <functional>
+    #include <thread>
+    #include <unordered_map>
+    #include <vector>
+#endif
+
+namespace Mezzanine {
+namespace Filesystem {
+    /// @brief An enum for the kinds of changes a DirectoryWatcher reports.
+    enum class WatchEventType
+    {
+        Created,  ///< An entry was created, or moved into a watched directory.
+        Removed,  ///< An entry was removed, or moved out of a watched directory.
+        Modified, ///< The contents or metadata of an entry changed, or it was replaced.
+        Overflow  ///< The system dropped changes. Creations and removals were recovered, but modifications may not be.
+    };//WatchEventType
+
+    /// @brief A single change to an entry in a watched directory.
+    struct MEZZ_LIB WatchEvent
+    {
+        /// @brief The path of the entry that changed, starting with the path of the watched directory.
+        String Path;
+        /// @brief The kind of change that happened.
+        WatchEventType Type;
+        /// @brief Whether or not the entry that changed is a directory.
+        Boole IsDirectory;
+    };//WatchEvent
+
+    /// @brief Convenience type for a group of changes delivered together.
+    using WatchEventBatch = std::vector<WatchEvent>;
+    /// @brief Convenience type for the callback that receives changes.
+    using WatchCallback = std::function<void(const WatchEventBatch&)>;
+
+    /// @brief A collection of options for controlling how a DirectoryWatcher reports changes.
+    struct MEZZ_LIB DirectoryWatcherOptions
+    {
+        /// @brief Whether or not changes in subdirectories, and their subdirectories, are reported as well.
+        /// @remarks Subdirectories created after the watcher starts are watched as they appear.
+        Boole Recursive = false;
+        /// @brief The number of milliseconds to collect changes for before delivering them as a batch.
+        /// @remarks Timed from the first change in the batch. Zero delivers changes as soon as they are read.
+        UInt32 CoalesceInterval = 100;
+    };//DirectoryWatcherOptions
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// @brief Reports changes to the contents of a directory as they happen.
+    /// @details Changes are read from the system on a dedicated thread, and bursts of them are coalesced into
+    /// batches. Within a batch each path appears at most once: an entry created and then written is only reported
+    /// as Created, an entry created and then removed isn't reported at all, and an entry removed and then created
+    /// again is reported as Modified. Moves are reported as a removal from the old path and a creation at the
+    /// new path. @n @n
+    /// If the system runs out of room for changes and drops some, a single Overflow event is added to the batch
+    /// and the watcher lists again only the directories that changed since they were last listed, reporting any
+    /// entries created or removed in the meantime. Modifications made while changes were being dropped can't be
+    /// recovered. @n @n
+    /// This is backed by inotify, and so is only active on Linux. The callback is called on the watcher thread,
+    /// must not throw, and must not destroy the watcher. Changes not yet delivered when the watcher is destroyed
+    /// are discarded.
+    ///////////////////////////////////////
+    class MEZZ_LIB DirectoryWatcher
+    {
+    public:
+        /// @brief The clock used to time batches.
+        using ClockType = std::chrono::steady_clock;
+    protected:
+        /// @brief What is known about a directory being watched.
+        struct WatchedDirectory
+        {
+            /// @brief The name of every entry in the directory, and whether or not each is a directory.
+            std::unordered_map<String,Boole> Entries;
+            /// @brief The path of the directory.
+            String Path;
+            /// @brief The modification time of the directory in nanoseconds when it was last listed.
+            UInt64 ListedTime = 0;
+            /// @brief Whether or not entries have been created or removed since the directory was last listed.
+            Boole Changed = false;
+        };//WatchedDirectory
+
+        /// @brief The directories being watched, by their watch descriptor.
+        std::unordered_map<int,WatchedDirectory> Watches;
+        /// @brief The changes waiting to be delivered.
+        WatchEventBatch Pending;
+        /// @brief The index of the pending change for each path.
+        std::unordered_map<String,size_t> PendingIndex;
+        /// @brief The path of the root directory being watched, without trailing separators.
+        String RootPath;
+        /// @brief The callback changes are delivered to.
+        WatchCallback Callback;
+        /// @brief The options the watcher was created with.
+        DirectoryWatcherOptions Options;
+        /// @brief The thread reading and delivering changes.
+        std::thread WatchThread;
+        /// @brief When the pending changes should be delivered.
+        ClockType::time_point BatchDeadline;
+        /// @brief The number of times the system has dropped changes.
+        std::atomic<UInt64> OverflowCount{0};
+        /// @brief The number of directories being watched.
+        std::atomic<size_t> WatchCount{0};
+        /// @brief The inotify instance changes are read from, or -1 if it couldn't be created.
+        int EventHandle = -1;
+        /// @brief The eventfd used to wake the watcher thread when it should stop, or -1 if it couldn't be created.
+        int WakeHandle = -1;
+        /// @brief Whether or not an Overflow event is in the pending changes.
+        Boole OverflowPending = false;
+
+        /// @brief The loop run by the watcher thread.
+        void RunWatcher();
+        /// @brief Starts watching a directory, and its subdirectories if the watcher is recursive.
+        /// @param DirectoryPath The path of the directory to watch.
+        /// @param ReportContents Whether to report every entry found in the directory as Created.
+        void AddWatch(const String& DirectoryPath, const Boole ReportContents);
+        /// @brief Stops watching a directory and every subdirectory in it.
+        /// @param DirectoryPath The path of the directory to stop watching.
+        void RemoveWatches(const String& DirectoryPath);
+        /// @brief Lists a directory again and reports the differences from what was known about it.
+        /// @param Watch The watch descriptor of the directory.
+        void Rescan(const int Watch);
+        /// @brief Lists again every watched directory that changed since it was last listed.
+        void RescanChanged();
+        /// @brief Reads every change available from the system.
+        void ReadEvents();
+        /// @brief Adds a change to the pending batch, coalescing it with any pending change to the same path.
+        /// @param Path The path of the entry that changed.
+        /// @param Type The kind of change that happened.
+        /// @param IsDirectory Whether or not the entry is a directory.
+        void QueueEvent(const String& Path, const WatchEventType Type, const Boole IsDirectory);
+        /// @brief Delivers the pending changes to the callback.
+        void DeliverBatch();
+    public:
+        /// @brief Class constructor.
+        /// @param DirectoryPath The directory to watch.
+        /// @param OnChange Called on the watcher thread with each batch of changes.
+        DirectoryWatcher(const StringView DirectoryPath, WatchCallback OnChange);
+        /// @brief Options constructor.
+        /// @param DirectoryPath The directory to watch.
+        /// @param OnChange Called on the watcher thread with each batch of changes.
+        /// @param ToUse Whether to watch subdirectories, and how long to coalesce changes for.
+        DirectoryWatcher(const StringView DirectoryPath, WatchCallback OnChange, const DirectoryWatcherOptions& ToUse);
+        /// @brief Deleted copy constructor.
+        DirectoryWatcher(const DirectoryWatcher&) = delete;
+        /// @brief Class destructor.
+        /// @remarks Waits for any callback in progress to return.
+        ~DirectoryWatcher();
+
+        /// @brief Deleted copy assignment operator.
+        DirectoryWatcher& operator=(const DirectoryWatcher&) = delete;
+
+        /// @brief Gets whether or not changes are being watched for.
+        /// @return Returns true if the directory is being watched, false if it couldn't be watched, the platform
+        /// doesn't support watching, or the directory has since been removed or moved.
+        [[nodiscard]]
+        Boole IsActive() const noexcept
+            { return ( this->WatchCount.load(std::memory_order_relaxed) > 0 ); }
+        /// @brief Gets the path of the directory being watched.
+        /// @return Returns the path the watcher was created with, without trailing separators.
+        [[nodiscard]]
+        const String& GetDirectoryPath() const noexcept
+            { return this->RootPath; }
+        /// @brief Gets the number of directories being watched.
+        /// @return Returns one for the watched directory, plus the number of subdirectories watched if recursive.
+        [[nodiscard]]
+        size_t GetWatchedDirectoryCount() const noexcept
+            { return this->WatchCount.load(std::memory_order_relaxed); }
+        /// @brief Gets the number of times the system has dropped changes.
+        /// @return Returns the number of Overflow events that have been reported.
+        [[nodiscard]]
+        UInt64 GetOverflowCount() const noexcept
+            { return this->OverflowCount.load(std::memory_order_relaxed); }
+    };//DirectoryWatcher
+}//Filesystem
+}//Mezzanine
+
+#endif
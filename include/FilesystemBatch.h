@@ -0,0 +1,196 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_FilesystemBatch_h
+#define Mezz_Filesystem_FilesystemBatch_h
+
+/// @file
+/// @brief Utilities for submitting many filesystem operations to the system at once.
+
+#ifndef SWIG
+    #include "DataTypes.h"
+    #include "ArchiveEntry.h"
+    #include "FilesystemManagement.h"
+
+    #include <vector>
+#endif
+
+namespace Mezzanine {
+namespace Filesystem {
+    /// @brief An enum for the kinds of operations that can be queued in a FilesystemBatch.
+    enum class BatchOperation
+    {
+        CreateDirectory, ///< Create a single new directory.
+        RemoveFile,      ///< Remove a file or Symlink.
+        RemoveDirectory, ///< Remove an empty directory.
+        Move,            ///< Move or rename a file or directory, replacing any file at the destination.
+        CreateSymlink,   ///< Create a Symlink.
+        Stat             ///< Get the metadata of a file or directory.
+    };//BatchOperation
+
+    /// @brief An enum for how a FilesystemBatch passes its operations to the system.
+    enum class BatchBackend
+    {
+        Auto,       ///< Use io_uring where the kernel supports it, and one system call per operation otherwise.
+        Synchronous ///< Always use one blocking system call per operation, in the order they were queued.
+    };//BatchBackend
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// @brief A queue of filesystem operations that are submitted to the system together.
+    /// @details Each of the functions in FilesystemManagement.h makes at least one blocking system call, which
+    /// adds up when creating or removing tens of thousands of entries. A batch collects operations and submits
+    /// them all at once, returning a ModifyResult for each in the order they were queued. @n @n
+    /// On Linux the operations are submitted through an io_uring, so the kernel receives them in large groups and
+    /// may run them concurrently. Operations within a batch can therefore complete in any order. If an operation
+    /// depends on an earlier one (such as creating a file in a directory created by the same batch), queue a
+    /// Barrier between them. Operations the running kernel can't perform through io_uring, and every operation
+    /// on other systems, are performed one at a time in the order they were queued. @n @n
+    /// The kernel performs most path operations on its own worker threads rather than inline, so the gain over
+    /// calling the functions in FilesystemManagement.h depends on how many operations the filesystem and the
+    /// hardware can run at once. Operations on entries in the same directory contend for the lock on that
+    /// directory. Benchmark on the intended system before assuming a batch is faster. @n @n
+    /// All paths are copied into the batch when queued, so the views passed in don't need to outlive the call.
+    ///////////////////////////////////////
+    class MEZZ_LIB FilesystemBatch
+    {
+    public:
+        /// @brief Convenience type for the results of each operation in a batch.
+        using ResultContainer = std::vector<ModifyResult>;
+    protected:
+        /// @brief A single operation waiting to be submitted.
+        struct QueuedOperation
+        {
+            /// @brief Where the metadata is written to for Stat operations.
+            ArchiveEntry* StatResult;
+            /// @brief The offset of the first path in the path buffer.
+            size_t FirstPath;
+            /// @brief The offset of the second path in the path buffer, if the operation has one.
+            size_t SecondPath;
+            /// @brief The kind of operation to perform.
+            BatchOperation Operation;
+            /// @brief Whether every earlier operation must complete before this one starts.
+            Boole AfterBarrier;
+        };//QueuedOperation
+
+        /// @brief Every path used by the queued operations, each followed by a null terminator.
+        String PathBuffer;
+        /// @brief The operations waiting to be submitted, in the order they were queued.
+        std::vector<QueuedOperation> Operations;
+        /// @brief How the operations are passed to the system.
+        BatchBackend Backend;
+        /// @brief Whether the next queued operation must wait for every earlier one to complete.
+        Boole BarrierPending = false;
+
+        /// @brief Copies a path into the path buffer.
+        /// @param ToStore The path to be copied.
+        /// @return Returns the offset of the stored path in the path buffer.
+        size_t StorePath(const StringView ToStore);
+        /// @brief Adds an operation to the queue.
+        /// @param Operation The kind of operation to queue.
+        /// @param FirstPath The path the operation acts on.
+        /// @param SecondPath The second path used by the operation, or an empty view.
+        /// @param StatResult Where to write metadata for Stat operations, or nullptr.
+        void QueueOperation(const BatchOperation Operation, const StringView FirstPath, const StringView SecondPath,
+                            ArchiveEntry* StatResult);
+    public:
+        /// @brief Class constructor.
+        FilesystemBatch();
+        /// @brief Backend constructor.
+        /// @param ToUse How the operations should be passed to the system.
+        explicit FilesystemBatch(const BatchBackend ToUse);
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // Queueing
+
+        /// @brief Queues the creation of a single new directory.
+        /// @param DirectoryPath The path of the directory to create.
+        void CreateDirectory(const StringView DirectoryPath);
+        /// @brief Queues the removal of a file or Symlink.
+        /// @param FilePath The path of the file to remove.
+        void RemoveFile(const StringView FilePath);
+        /// @brief Queues the removal of an empty directory.
+        /// @param DirectoryPath The path of the directory to remove.
+        void RemoveDirectory(const StringView DirectoryPath);
+        /// @brief Queues moving a file or directory.
+        /// @remarks This behaves like MoveFile with FileOverwrite::Allow, including moves across filesystems.
+        /// @param OldPath The existing path of the file or directory to move.
+        /// @param NewPath The path to move it to.
+        void MoveFile(const StringView OldPath, const StringView NewPath);
+        /// @brief Queues the creation of a Symlink.
+        /// @param SymPath The path of the Symlink to create.
+        /// @param TargetPath The path the Symlink should point to.
+        void CreateSymlink(const StringView SymPath, const StringView TargetPath);
+        /// @brief Queues getting the metadata of a file or directory.
+        /// @remarks Symlinks are followed. The type, size, times and permissions of the Result are written when the
+        /// batch is submitted, if the operation succeeds.
+        /// @param Path The path of the file or directory to get the metadata of.
+        /// @param Result The entry to write the metadata to. Must remain valid until the batch is submitted.
+        void Stat(const StringView Path, ArchiveEntry& Result);
+        /// @brief Makes every operation queued after this wait for every operation queued before it to complete.
+        void Barrier();
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // Submission
+
+        /// @brief Gets the number of operations waiting to be submitted.
+        /// @return Returns the number of queued operations.
+        [[nodiscard]]
+        size_t GetOperationCount() const noexcept;
+        /// @brief Gets how the operations are passed to the system.
+        /// @return Returns the backend this batch was constructed with.
+        [[nodiscard]]
+        BatchBackend GetBackend() const noexcept;
+        /// @brief Removes every queued operation without submitting them.
+        void Clear() noexcept;
+        /// @brief Performs every queued operation, and then clears the queue.
+        /// @return Returns the result of each operation, in the order they were queued.
+        [[nodiscard]]
+        ResultContainer Submit();
+
+        /// @brief Checks if operations can be submitted through io_uring on this system.
+        /// @remarks Even if io_uring is available, older kernels may not support every operation. Operations that
+        /// aren't supported are performed one at a time.
+        /// @return Returns true if batches using the Auto backend will use io_uring, false otherwise.
+        [[nodiscard]]
+        static Boole IsAsyncSupported();
+    };//FilesystemBatch
+}//Filesystem
+}//Mezzanine
+
+#endif
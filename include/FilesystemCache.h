@@ -0,0 +1,266 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_FilesystemCache_h
+#define Mezz_Filesystem_FilesystemCache_h
+
+/// @file
+/// @brief A cache of directory listings and path metadata that is kept up to date by the system.
+
+#ifndef SWIG
+    #include "DataTypes.h"
+    #include "ArchiveEntry.h"
+
+    #include <chrono>
+    #include <list>
+    #include <memory>
+    #include <unordered_map>
+#endif
+
+namespace Mezzanine {
+namespace Filesystem {
+    /// @brief A collection of options for controlling what a FilesystemCache holds on to.
+    struct MEZZ_LIB FilesystemCacheOptions
+    {
+        /// @brief The most directories that can have their listings or the metadata of their entries cached.
+        /// @remarks Each cached directory uses one watch, so this should stay well below the system limit on
+        /// watches, which is often 8192 per user on Linux. The least recently used directory is forgotten to make
+        /// room for a new one.
+        size_t MaxDirectories = 1024;
+        /// @brief The number of milliseconds between checks for changes reported by the system.
+        /// @remarks Queries made within this long of the last check are answered without any system calls, and
+        /// so may miss a change made in that window. Zero checks on every query.
+        UInt32 EventCheckInterval = 10;
+        /// @brief The number of milliseconds anything cached for a directory that can't be watched is trusted for.
+        UInt32 PollInterval = 1000;
+        /// @brief Whether or not to ask the system to report changes to cached directories.
+        /// @remarks When false, or on platforms without inotify, every directory falls back to polling.
+        Boole UseWatches = true;
+    };//FilesystemCacheOptions
+
+    /// @brief A collection of counters describing how well a FilesystemCache is working.
+    struct MEZZ_LIB FilesystemCacheStatistics
+    {
+        /// @brief The number of queries answered from the cache.
+        UInt64 Hits = 0;
+        /// @brief The number of queries that had to ask the filesystem.
+        UInt64 Misses = 0;
+        /// @brief The number of listings and path metadata forgotten because they changed or expired.
+        UInt64 Invalidations = 0;
+        /// @brief The number of directories forgotten to make room for others.
+        UInt64 Evictions = 0;
+    };//FilesystemCacheStatistics
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// @brief An in memory cache of directory listings and path metadata.
+    /// @details Anything looked up through the cache is remembered, so asking again costs a hash lookup rather
+    /// than system calls. Everything is remembered per directory: the listing of a directory, and the metadata of
+    /// paths within it, including paths that don't exist. @n @n
+    /// On Linux each directory remembered is watched with inotify, and anything in it that changes is forgotten
+    /// as soon as the change is noticed. Changes are checked for at most once per EventCheckInterval, or whenever
+    /// Refresh is called. Directories that can't be watched, such as ones that don't exist yet or any directory on
+    /// other platforms, are instead forgotten once they've been remembered for PollInterval. @n @n
+    /// Paths are remembered as they are written, apart from trailing separators, so "Assets/" and "./Assets" are
+    /// cached separately. @n @n
+    /// A cache must not be used by more than one thread at a time.
+    ///////////////////////////////////////
+    class MEZZ_LIB FilesystemCache
+    {
+    public:
+        /// @brief A shared, immutable listing of a directory.
+        using ListingPointer = std::shared_ptr<const ArchiveEntryVector>;
+        /// @brief The clock used to track when cached directories need to be checked again.
+        using ClockType = std::chrono::steady_clock;
+    protected:
+        /// @brief Everything remembered about a single directory.
+        struct DirectoryRecord
+        {
+            /// @brief The metadata of each path in the directory that has been looked up, by name.
+            std::unordered_map<String,Optional<ArchiveEntry>> Entries;
+            /// @brief The listing of the directory, or nullptr if it hasn't been retrieved.
+            ListingPointer Listing;
+            /// @brief The position of this directory in the usage order.
+            std::list<String>::iterator UsagePos;
+            /// @brief When anything cached for this directory needs to be retrieved again, if it isn't watched.
+            ClockType::time_point ExpireTime;
+            /// @brief The watch descriptor for this directory, or -1 if it isn't watched.
+            int Watch = -1;
+        };//DirectoryRecord
+        /// @brief The container mapping directory paths to what is remembered about them.
+        using RecordContainer = std::unordered_map<String,DirectoryRecord>;
+
+        /// @brief Everything remembered, by the path of the directory it was found in.
+        RecordContainer Records;
+        /// @brief The paths of the remembered directories each watch descriptor is watching.
+        /// @remarks The system gives out one watch descriptor per directory, so every spelling of a directory that
+        /// is remembered shares it.
+        std::unordered_map<int,StringVector> WatchedPaths;
+        /// @brief Every remembered directory path, from most to least recently used.
+        std::list<String> UsageOrder;
+        /// @brief The options the cache was created with.
+        FilesystemCacheOptions Options;
+        /// @brief The counters of what the cache has done.
+        FilesystemCacheStatistics Statistics;
+        /// @brief The next time changes reported by the system should be checked for.
+        ClockType::time_point NextEventCheck;
+        /// @brief A reusable buffer for the directory part of a path being looked up.
+        String DirectoryKey;
+        /// @brief A reusable buffer for the name part of a path being looked up.
+        String NameKey;
+        /// @brief The inotify instance changes are read from, or -1 if directories aren't being watched.
+        int EventHandle = -1;
+
+        /// @brief Splits a path into the reusable directory and name buffers.
+        /// @param Path The path to split.
+        /// @return Returns true if the path has a name that can be cached, false for roots and dot segments.
+        Boole SplitPath(const StringView Path);
+
+        /// @brief Gets the record for a directory, creating it and starting its watch if needed.
+        /// @param DirectoryPath The path of the directory, without any trailing separators.
+        /// @return Returns a reference to the record for the directory.
+        DirectoryRecord& AcquireRecord(const String& DirectoryPath);
+        /// @brief Forgets everything cached for a directory and stops watching it.
+        /// @param ToForget An iterator to the record of the directory to forget.
+        /// @return Returns the number of listings and path metadata that were forgotten.
+        size_t ForgetRecord(RecordContainer::iterator ToForget);
+        /// @brief Forgets the metadata of one path, and the listing of the directory containing it.
+        /// @param DirectoryPath The path of the directory the changed path is in, without trailing separators.
+        /// @param Name The name of the path within the directory.
+        void InvalidateEntry(const StringView DirectoryPath, const StringView Name);
+        /// @brief Forgets anything cached for a directory that can't be watched, once it has expired.
+        /// @param ToCheck The record of the directory to check.
+        void ExpireIfStale(DirectoryRecord& ToCheck);
+        /// @brief Reads every change reported by the system and forgets anything they affect.
+        void ProcessEvents();
+        /// @brief Checks for changes reported by the system, if enough time has passed since the last check.
+        void RefreshIfDue();
+        /// @brief Gets the cached metadata of a path, retrieving and remembering it on a miss.
+        /// @param Path The path to get the metadata of.
+        /// @return Returns a pointer to the cached metadata, which is empty if the path doesn't exist, or nullptr
+        /// if the path is one that can't be cached or has trailing separators but isn't a directory.
+        const Optional<ArchiveEntry>* LookupEntry(const StringView Path);
+    public:
+        /// @brief Class constructor.
+        /// @param ToUse The options for what the cache holds on to.
+        explicit FilesystemCache(const FilesystemCacheOptions& ToUse = FilesystemCacheOptions());
+        /// @brief Deleted copy constructor.
+        FilesystemCache(const FilesystemCache&) = delete;
+        /// @brief Class destructor.
+        ~FilesystemCache();
+
+        /// @brief Deleted copy assignment operator.
+        FilesystemCache& operator=(const FilesystemCache&) = delete;
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // Queries
+
+        /// @brief Gets a listing of file and subdirectory metadata in a directory.
+        /// @param DirectoryPath The directory to look in.
+        /// @return Returns a shared listing of every file and subdirectory in the directory, which is empty if the
+        /// directory couldn't be read. The listing isn't changed when the cache is updated.
+        [[nodiscard]]
+        ListingPointer GetDirectoryContents(const StringView DirectoryPath);
+        /// @brief Gets the metadata of a single file, directory or Symlink.
+        /// @remarks Symlinks are followed.
+        /// @param Path The path of the entry to get the metadata of.
+        /// @return Returns an entry populated with the metadata of the path, or an empty Optional if the path
+        /// doesn't exist or couldn't be accessed.
+        [[nodiscard]]
+        Optional<ArchiveEntry> StatPath(const StringView Path);
+        /// @brief Checks to see if the given path exists and is a file.
+        /// @param FilePath The path to check.
+        /// @return Returns true if a file at the specified path exists, false otherwise.
+        [[nodiscard]]
+        Boole FileExists(const StringView FilePath);
+        /// @brief Checks to see if the given path exists and is a directory.
+        /// @param DirectoryPath The path to check.
+        /// @return Returns true if a directory at the specified path exists, false otherwise.
+        [[nodiscard]]
+        Boole DirectoryExists(const StringView DirectoryPath);
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // Maintenance
+
+        /// @brief Immediately checks for changes reported by the system, and forgets anything that has expired.
+        void Refresh();
+        /// @brief Forgets the metadata of a path, along with the listing of it and of the directory containing it.
+        /// @remarks Useful after changing something through means the cache can't see, on a platform where
+        /// directories are polled.
+        /// @param Path The path to forget.
+        void Invalidate(const StringView Path);
+        /// @brief Forgets everything cached and stops watching every directory.
+        void Clear();
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // Status
+
+        /// @brief Gets whether or not the system is reporting changes to the cache.
+        /// @return Returns true if cached directories are watched, false if they are polled.
+        [[nodiscard]]
+        Boole IsWatching() const noexcept
+            { return ( this->EventHandle != -1 ); }
+        /// @brief Gets the number of directories with anything cached.
+        /// @return Returns the number of directories currently remembered.
+        [[nodiscard]]
+        size_t GetCachedDirectoryCount() const noexcept
+            { return this->Records.size(); }
+        /// @brief Gets the number of directories being watched.
+        /// @remarks Different spellings of the same directory share one watch, and are only counted once.
+        /// @return Returns the number of distinct directories the system is reporting changes to.
+        [[nodiscard]]
+        size_t GetWatchedDirectoryCount() const noexcept
+            { return this->WatchedPaths.size(); }
+        /// @brief Gets the options the cache was created with.
+        /// @return Returns a const reference to the options of the cache.
+        [[nodiscard]]
+        const FilesystemCacheOptions& GetOptions() const noexcept
+            { return this->Options; }
+        /// @brief Gets the counters of what the cache has done.
+        /// @return Returns a const reference to the hit, miss, invalidation and eviction counters.
+        [[nodiscard]]
+        const FilesystemCacheStatistics& GetStatistics() const noexcept
+            { return this->Statistics; }
+        /// @brief Sets every counter back to zero.
+        void ResetStatistics() noexcept
+            { this->Statistics = FilesystemCacheStatistics(); }
+    };//FilesystemCache
+}//Filesystem
+}//Mezzanine
+
+#endif
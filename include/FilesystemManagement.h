@@ -42,6 +42,8 @@
 
 #ifndef SWIG
     #include "DataTypes.h"
+
+    #include <functional>
 #endif
 
 namespace Mezzanine {
@@ -85,6 +87,58 @@ namespace Filesystem {
         Deny
     };//FileOverwrite
 
+    /// @brief An enum for how the data of a file should be duplicated when copying it.
+    enum class CopyStrategy
+    {
+        Auto,          ///< Use whatever is fastest, which may share data with the original if the filesystem allows.
+        ReflinkOnly,   ///< Only create a copy-on-write clone of the file, failing with NotSupported if it can't.
+        ReflinkOrCopy, ///< Attempt a copy-on-write clone of the file, copying the data if that can't be done.
+        FullCopy       ///< Always write a full copy of the data, never sharing any of it with the original.
+    };//CopyStrategy
+
+    /// @brief An enum for the method that was used to duplicate the data of a file when copying it.
+    enum class CopyMethod
+    {
+        None,         ///< No data was copied.
+        Reflink,      ///< A copy-on-write clone was made, sharing the data with the original until either changes.
+        SystemCopy,   ///< The operating system copied the data without it passing through this process.
+        BufferedCopy  ///< The data was read into a buffer and written out again.
+    };//CopyMethod
+
+    /// @brief A collection of options for controlling how a directory tree is copied.
+    struct MEZZ_LIB DirectoryCopyOptions
+    {
+        /// @brief The number of threads to copy with, including the calling thread.
+        /// @remarks Zero uses one thread per hardware thread.
+        size_t ThreadCount = 0;
+        /// @brief What to do when a file being copied already exists in the destination.
+        /// @remarks Directories that already exist in the destination are always merged into.
+        FileOverwrite IfExists = FileOverwrite::Deny;
+        /// @brief How the data of each file should be duplicated.
+        CopyStrategy Strategy = CopyStrategy::Auto;
+        /// @brief Whether Symlinks are recreated as Symlinks, or replaced by copies of what they point to.
+        Boole PreserveSymlinks = true;
+        /// @brief Whether the permissions of files and directories are copied.
+        /// @remarks Only used on Posix systems, on Windows the attributes of files are always copied.
+        Boole PreservePermissions = true;
+        /// @brief Whether the access and modification times of files and directories are copied.
+        /// @remarks Only used on Posix systems, on Windows the times of files are always copied.
+        Boole PreserveTimestamps = true;
+    };//DirectoryCopyOptions
+
+    /// @brief An enum for how far data should be pushed towards the disk before a write is considered complete.
+    enum class DurabilityPolicy
+    {
+        None,                 ///< Leave flushing to the operating system, the data may be lost if power is lost.
+        FlushFile,            ///< Flush the data of the file to the disk before it is made visible.
+        FlushFileAndDirectory ///< Also flush the directory containing the file, so the new name survives power loss.
+    };//DurabilityPolicy
+
+    /// @brief A callable that appends data to a file being written, returning false if the data couldn't be written.
+    using FileDataSink = std::function<Boole(const StringView)>;
+    /// @brief A callable that produces the contents of a file by passing it to a sink, returning false to cancel.
+    using FileDataWriter = std::function<Boole(const FileDataSink&)>;
+
     ///////////////////////////////////////////////////////////////////////////////
     // ModifyResult Operators
 
@@ -134,6 +188,9 @@ namespace Filesystem {
 
     /// @brief Copies a file on disk to a new location.
     /// @note This function makes no attempt to copy file permissions or attributes, only data.
+    /// @remarks On Linux the data is copied inside the kernel with copy_file_range or sendfile when possible,
+    /// falling back to copying through a large buffer. If the copy fails part way through, the partially written
+    /// destination file is removed.
     /// @param OldFilePath The existing path to the file (including the filename) to be copied.
     /// @param NewFilePath The path (including the filename) to where the file should be copied.
     /// @param IfExists If true the operation will fail if a file with the target name already exists.
@@ -141,8 +198,42 @@ namespace Filesystem {
     [[nodiscard]]
     ModifyResult MEZZ_LIB CopyFile(const StringView OldFilePath, const StringView NewFilePath,
                                    const FileOverwrite IfExists);
+    /// @brief Copies a file on disk to a new location.
+    /// @note This function makes no attempt to copy file permissions or attributes, only data.
+    /// @remarks On Linux clones are made with the FICLONE ioctl, which is supported by filesystems such as btrfs
+    /// and XFS and takes about the same time regardless of the size of the file. With the Auto strategy a clone
+    /// is only attempted when both files are on the same device, and copy_file_range (which may share data on
+    /// some filesystems) is used otherwise. The FullCopy strategy avoids copy_file_range for this reason. On other
+    /// systems clones aren't supported, so ReflinkOnly will always fail with NotSupported. @n @n
+    /// When ReflinkOnly fails, an existing file at NewFilePath is left untouched. If a copy fails part way, a file
+    /// created by the copy is removed, but an existing file that was being overwritten may be left truncated.
+    /// @param OldFilePath The existing path to the file (including the filename) to be copied.
+    /// @param NewFilePath The path (including the filename) to where the file should be copied.
+    /// @param IfExists If true the operation will fail if a file with the target name already exists.
+    /// @param Strategy How the data of the file should be duplicated.
+    /// @return Returns a ModifyResult value describing the result of the file copy.
+    [[nodiscard]]
+    ModifyResult MEZZ_LIB CopyFile(const StringView OldFilePath, const StringView NewFilePath,
+                                   const FileOverwrite IfExists, const CopyStrategy Strategy);
+    /// @brief Copies a file on disk to a new location.
+    /// @note This function makes no attempt to copy file permissions or attributes, only data.
+    /// @remarks See the other CopyFile overload taking a CopyStrategy for details on each strategy.
+    /// @param OldFilePath The existing path to the file (including the filename) to be copied.
+    /// @param NewFilePath The path (including the filename) to where the file should be copied.
+    /// @param IfExists If true the operation will fail if a file with the target name already exists.
+    /// @param Strategy How the data of the file should be duplicated.
+    /// @param MethodUsed Set to the method that copied the data, or the method that failed if the copy failed.
+    /// @return Returns a ModifyResult value describing the result of the file copy.
+    [[nodiscard]]
+    ModifyResult MEZZ_LIB CopyFile(const StringView OldFilePath, const StringView NewFilePath,
+                                   const FileOverwrite IfExists, const CopyStrategy Strategy,
+                                   CopyMethod& MethodUsed);
     /// @brief Moves a file on disk from one location to another.
-    /// @remarks This function can be used to rename files.
+    /// @remarks This function can be used to rename files, Symlinks and directories. When moving to another
+    /// filesystem, the original is copied to the new location along with its permissions and timestamps and then
+    /// removed. Directories are copied with CopyDirectoryTree and removed with RemoveDirectoryTree, and a
+    /// directory can only replace an empty directory. If the original can't be removed after being copied, the
+    /// error is returned and both copies are left in place.
     /// @param OldFilePath The existing path to the file (including the filename) to be moved.
     /// @param NewFilePath The path (including the filename) to where the file should be named.
     /// @param IfExists If true the operation will fail if a file with the target name already exists.
@@ -156,6 +247,38 @@ namespace Filesystem {
     [[nodiscard]]
     ModifyResult MEZZ_LIB RemoveFile(const StringView FilePath);
 
+    ///////////////////////////////////////////////////////////////////////////////
+    // Atomic File Writing
+
+    /// @brief Writes a file such that readers only ever see the old contents or all of the new contents.
+    /// @param FilePath The path (including the filename) of the file to write.
+    /// @param Data The complete contents of the file.
+    /// @param Durability How far the data should be flushed before the file is made visible.
+    /// @return Returns a ModifyResult value describing the result of the write.
+    [[nodiscard]]
+    ModifyResult MEZZ_LIB AtomicWriteFile(const StringView FilePath, const StringView Data,
+                                          const DurabilityPolicy Durability);
+    /// @brief Writes a file such that readers only ever see the old contents or all of the new contents.
+    /// @remarks The data is written to a file that can't be seen by anyone else, which then replaces any file
+    /// at FilePath in a single step. If the file already exists, its permissions are given to the new file. @n @n
+    /// On Linux the data is written to an unnamed O_TMPFILE in the destination directory, which is given its name
+    /// with linkat. Since linkat can't replace a file, an existing file is replaced by linking the data under a
+    /// temporary name and renaming it over the old file. Where O_TMPFILE isn't available, or the unnamed file
+    /// can't be linked (no CAP_DAC_READ_SEARCH and no /proc), the data is written to a temporary file in the
+    /// destination directory and renamed over the old file. On Windows the temporary file replaces the old file
+    /// with ReplaceFile, which keeps its security descriptor and attributes, or is moved into place with
+    /// MoveFileEx if there is no old file. Flushing the directory isn't supported there, so it only flushes the
+    /// file. @n @n
+    /// If the Writer returns false or the data can't be written, the file at FilePath is left untouched.
+    /// @param FilePath The path (including the filename) of the file to write.
+    /// @param Writer A callable that passes all of the contents of the file to the sink it is given.
+    /// @param Durability How far the data should be flushed before the file is made visible.
+    /// @return Returns a ModifyResult value describing the result of the write. OperationCanceled is returned if
+    /// the Writer returned false without the sink reporting an error.
+    [[nodiscard]]
+    ModifyResult MEZZ_LIB AtomicWriteFile(const StringView FilePath, const FileDataWriter& Writer,
+                                          const DurabilityPolicy Durability);
+
     ///////////////////////////////////////////////////////////////////////////////
     // Symlinks
 
@@ -226,6 +349,48 @@ namespace Filesystem {
     /// @return Returns a ModifyResult value describing the result of the directory removal(delete).
     [[nodiscard]]
     ModifyResult MEZZ_LIB RemoveDirectory(const StringView DirectoryPath);
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Directory Tree Management
+
+    /// @brief Copies a directory and everything in it to a new location.
+    /// @param SourcePath The directory to be copied.
+    /// @param DestPath The directory to copy to. It is created if it doesn't exist, and merged into if it does.
+    /// @return Returns a ModifyResult value describing the result of the copy.
+    [[nodiscard]]
+    ModifyResult MEZZ_LIB CopyDirectoryTree(const StringView SourcePath, const StringView DestPath);
+    /// @brief Copies a directory and everything in it to a new location.
+    /// @remarks Directories are read and files are copied as separate tasks spread over a pool of threads, so
+    /// many files are copied at once. Each file is copied with CopyFile, using the strategy in the options.
+    /// Directories are created as they are found, and have their permissions and times set once everything in
+    /// them has been copied. Directories that have already been copied (through Symlinks or because the
+    /// destination is inside the source) are skipped. @n @n
+    /// The copy stops at the first error, which may leave some of the tree copied.
+    /// @param SourcePath The directory to be copied.
+    /// @param DestPath The directory to copy to. It is created if it doesn't exist, and merged into if it does.
+    /// @param Options The thread count and what to preserve when copying.
+    /// @return Returns a ModifyResult value describing the result of the copy.
+    [[nodiscard]]
+    ModifyResult MEZZ_LIB CopyDirectoryTree(const StringView SourcePath, const StringView DestPath,
+                                            const DirectoryCopyOptions& Options);
+    /// @brief Removes a directory and everything in it.
+    /// @param DirectoryPath The directory to remove.
+    /// @return Returns a ModifyResult value describing the result of the removal.
+    [[nodiscard]]
+    ModifyResult MEZZ_LIB RemoveDirectoryTree(const StringView DirectoryPath);
+    /// @brief Removes a directory and everything in it.
+    /// @remarks Symlinks are never followed, they are removed rather than what they point to. If DirectoryPath
+    /// itself is a Symlink, NotADirectory is returned and nothing is removed. @n @n
+    /// On Posix systems everything is removed relative to open file descriptors of the directories containing
+    /// them, and separate subdirectories are removed in parallel. On Windows the tree is removed by path on the
+    /// calling thread, and read only files are removed as well. @n @n
+    /// The removal stops at the first error, which may leave some of the tree removed.
+    /// @param DirectoryPath The directory to remove.
+    /// @param ThreadCount The number of threads to remove with, including the calling thread. Zero uses one
+    /// thread per hardware thread.
+    /// @return Returns a ModifyResult value describing the result of the removal.
+    [[nodiscard]]
+    ModifyResult MEZZ_LIB RemoveDirectoryTree(const StringView DirectoryPath, const size_t ThreadCount);
 }//Filesystem
 }//Mezzanine
 
@@ -363,26 +363,70 @@ namespace Filesystem {
 
     /// @brief Removes all needless instances of "." or ".." and makes appropriate edits to the Host path.
     /// @details A dot segment is "." or "..". They often get in the way of path parsing and this method will
-    /// remove any extraneous dot segments that may exist in the provided String.
+    /// remove any extraneous dot segments that may exist in the provided String. Everything after the last
+    /// separator is treated as a file name and left as is.
     /// @param ToRemove The Host path to remove dot segments from.
     /// @return Returns a copy of the ToRemove parameter with all needless dot segments removed.
     [[nodiscard]]
     String MEZZ_LIB RemoveDotSegments_Host(const StringView ToRemove);
     /// @brief Removes all needless instances of "." or ".." and makes appropriate edits to the Posix path.
     /// @details A dot segment is "." or "..". They often get in the way of path parsing and this method will
-    /// remove any extraneous dot segments that may exist in the provided String.
+    /// remove any extraneous dot segments that may exist in the provided String. Everything after the last
+    /// separator is treated as a file name and left as is.
     /// @param ToRemove The Posix path to remove dot segments from.
     /// @return Returns a copy of the ToRemove parameter with all needless dot segments removed.
     [[nodiscard]]
     String MEZZ_LIB RemoveDotSegments_Posix(const StringView ToRemove);
     /// @brief Removes all needless instances of "." or ".." and makes appropriate edits to the Windows path.
     /// @details A dot segment is "." or "..". They often get in the way of path parsing and this method will
-    /// remove any extraneous dot segments that may exist in the provided String.
+    /// remove any extraneous dot segments that may exist in the provided String. Everything after the last
+    /// separator is treated as a file name and left as is.
     /// @param ToRemove The Windows path to remove dot segments from.
     /// @return Returns a copy of the ToRemove parameter with all needless dot segments removed.
     [[nodiscard]]
     String MEZZ_LIB RemoveDotSegments_Windows(const StringView ToRemove);
 
+    /// @brief Removes all needless instances of "." or ".." from a Host path, writing the result to a buffer.
+    /// @details This makes the same edits as the String returning version in a single pass, without allocating.
+    /// The result is never longer than the original path, and the buffer may be the memory ToRemove views.
+    /// @param ToRemove The Host path to remove dot segments from.
+    /// @param Buffer The buffer to write the path with dot segments removed to. It is not null terminated.
+    /// @param BufferSize The number of characters that can be written to Buffer.
+    /// @return Returns the number of characters written to Buffer, or StringView::npos if BufferSize is smaller
+    /// than the size of ToRemove, in which case nothing is written.
+    [[nodiscard]]
+    size_t MEZZ_LIB RemoveDotSegments_Host(const StringView ToRemove, Char8* Buffer, const size_t BufferSize) noexcept;
+    /// @brief Removes all needless instances of "." or ".." from a Posix path, writing the result to a buffer.
+    /// @details This makes the same edits as the String returning version in a single pass, without allocating.
+    /// The result is never longer than the original path, and the buffer may be the memory ToRemove views.
+    /// @param ToRemove The Posix path to remove dot segments from.
+    /// @param Buffer The buffer to write the path with dot segments removed to. It is not null terminated.
+    /// @param BufferSize The number of characters that can be written to Buffer.
+    /// @return Returns the number of characters written to Buffer, or StringView::npos if BufferSize is smaller
+    /// than the size of ToRemove, in which case nothing is written.
+    [[nodiscard]]
+    size_t MEZZ_LIB RemoveDotSegments_Posix(const StringView ToRemove, Char8* Buffer, const size_t BufferSize) noexcept;
+    /// @brief Removes all needless instances of "." or ".." from a Windows path, writing the result to a buffer.
+    /// @details This makes the same edits as the String returning version in a single pass, without allocating.
+    /// The result is never longer than the original path, and the buffer may be the memory ToRemove views.
+    /// @param ToRemove The Windows path to remove dot segments from.
+    /// @param Buffer The buffer to write the path with dot segments removed to. It is not null terminated.
+    /// @param BufferSize The number of characters that can be written to Buffer.
+    /// @return Returns the number of characters written to Buffer, or StringView::npos if BufferSize is smaller
+    /// than the size of ToRemove, in which case nothing is written.
+    [[nodiscard]]
+    size_t MEZZ_LIB RemoveDotSegments_Windows(const StringView ToRemove, Char8* Buffer,
+                                              const size_t BufferSize) noexcept;
+    /// @brief Removes all needless instances of "." or ".." from a Host path, editing it in place.
+    /// @param ToNormalize The Host path to remove dot segments from. It is only ever shrunk, so never reallocated.
+    void MEZZ_LIB RemoveDotSegmentsInPlace_Host(String& ToNormalize);
+    /// @brief Removes all needless instances of "." or ".." from a Posix path, editing it in place.
+    /// @param ToNormalize The Posix path to remove dot segments from. It is only ever shrunk, so never reallocated.
+    void MEZZ_LIB RemoveDotSegmentsInPlace_Posix(String& ToNormalize);
+    /// @brief Removes all needless instances of "." or ".." from a Windows path, editing it in place.
+    /// @param ToNormalize The Windows path to remove dot segments from. It is only ever shrunk, so never reallocated.
+    void MEZZ_LIB RemoveDotSegmentsInPlace_Windows(String& ToNormalize);
+
     /// @brief Convenience method to verify the necessary Host separator is present when concatenating.
     /// @param FilePath The Host directory path to the file.
     /// @param FileName The name of the file.
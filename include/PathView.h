@@ -0,0 +1,335 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_PathView_h
+#define Mezz_Filesystem_PathView_h
+
+/// @file
+/// @brief A non-owning view of a path that can be split into its parts without allocating.
+
+#ifndef SWIG
+    #include "PathUtilities.h"
+
+    #include <iterator>
+#endif
+
+namespace Mezzanine {
+namespace Filesystem {
+    /// @brief An enum for the rules used to interpret a path.
+    enum class PathFlavor
+    {
+        Posix,   ///< Only '/' separates directories, and only a leading '/' makes a path absolute.
+        Windows, ///< Both '/' and '\\' separate directories, and paths can start with a drive letter.
+    #ifdef MEZZ_Windows
+        Host = Windows ///< The rules of the platform being compiled for.
+    #else
+        Host = Posix   ///< The rules of the platform being compiled for.
+    #endif
+    };//PathFlavor
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// @brief A non-owning view of a path that can be split into its parts without allocating.
+    /// @details Every part of the path is returned as a view into the original characters, so the path being
+    /// viewed must outlive the PathView and anything retrieved from it. Nothing is normalized; dot segments and
+    /// repeated separators are left as they are. @n @n
+    /// DirName and BaseName split the path the same way as GetDirName and GetBaseName, but only on the
+    /// separators of the flavor. Segments are the names between separators, not including the root, and empty
+    /// names caused by repeated or trailing separators are skipped.
+    /// @tparam Flavor The rules used to interpret the path.
+    ///////////////////////////////////////
+    template<PathFlavor Flavor>
+    class PathView
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////////////
+        /// @brief An iterator over the segments of a path.
+        ///////////////////////////////////////
+        class const_iterator
+        {
+        public:
+            /// @brief The category of this iterator.
+            using iterator_category = std::forward_iterator_tag;
+            /// @brief The type yielded by this iterator.
+            using value_type = StringView;
+            /// @brief The type used to express the distance between two iterators.
+            using difference_type = std::ptrdiff_t;
+            /// @brief A pointer to the type yielded by this iterator.
+            using pointer = const StringView*;
+            /// @brief The type returned when this iterator is dereferenced.
+            using reference = const StringView&;
+        protected:
+            /// @brief The whole path being iterated over.
+            StringView Path;
+            /// @brief The segment being pointed to, or an empty view at the end of the path.
+            StringView Segment;
+
+            /// @brief Points this iterator at the first segment starting at or after a position.
+            /// @param Position The offset in the path to start searching from.
+            constexpr void Seek(size_t Position) noexcept
+            {
+                while( Position < this->Path.size() && PathView::IsSeparator(this->Path[Position]) )
+                    { ++Position; }
+                size_t End = Position;
+                while( End < this->Path.size() && !PathView::IsSeparator(this->Path[End]) )
+                    { ++End; }
+                this->Segment = this->Path.substr(Position,End - Position);
+            }
+        public:
+            /// @brief Blank constructor.
+            constexpr const_iterator() noexcept = default;
+            /// @brief Class constructor.
+            /// @param ToIterate The whole path to iterate over.
+            /// @param Position The offset in the path to start searching for a segment from.
+            constexpr const_iterator(const StringView ToIterate, const size_t Position) noexcept :
+                Path(ToIterate)
+                { this->Seek(Position); }
+
+            /// @brief Dereference operator.
+            /// @return Returns a view of the segment being pointed to.
+            [[nodiscard]]
+            constexpr reference operator*() const noexcept
+                { return this->Segment; }
+            /// @brief Member access operator.
+            /// @return Returns a pointer to the view of the segment being pointed to.
+            [[nodiscard]]
+            constexpr pointer operator->() const noexcept
+                { return &(this->Segment); }
+
+            /// @brief Pre-increment operator.
+            /// @return Returns a reference to this iterator after it has moved to the next segment.
+            constexpr const_iterator& operator++() noexcept
+            {
+                this->Seek( static_cast<size_t>( this->Segment.data() - this->Path.data() ) + this->Segment.size() );
+                return *this;
+            }
+            /// @brief Post-increment operator.
+            /// @return Returns a copy of this iterator from before it was incremented.
+            constexpr const_iterator operator++(int) noexcept
+            {
+                const_iterator Ret(*this);
+                ++(*this);
+                return Ret;
+            }
+
+            /// @brief Equality comparison operator.
+            /// @param Other The other iterator to compare to.
+            /// @return Returns true if both iterators point to the same segment of the same path.
+            [[nodiscard]]
+            constexpr Boole operator==(const const_iterator& Other) const noexcept
+            {
+                return ( this->Segment.data() == Other.Segment.data() &&
+                         this->Segment.size() == Other.Segment.size() );
+            }
+            /// @brief Inequality comparison operator.
+            /// @param Other The other iterator to compare to.
+            /// @return Returns true if the iterators point to different segments.
+            [[nodiscard]]
+            constexpr Boole operator!=(const const_iterator& Other) const noexcept
+                { return !( *this == Other ); }
+        };//const_iterator
+    protected:
+        /// @brief The path being viewed.
+        StringView Path;
+
+        /// @brief Gets the offset of the last separator in the path.
+        /// @return Returns the offset of the last separator, or npos if there are none.
+        [[nodiscard]]
+        constexpr size_t FindLastSeparator() const noexcept
+        {
+            size_t Position = this->Path.size();
+            while( Position > 0 )
+            {
+                --Position;
+                if( PathView::IsSeparator(this->Path[Position]) ) {
+                    return Position;
+                }
+            }
+            return StringView::npos;
+        }
+    public:
+        /// @brief Blank constructor.
+        constexpr PathView() noexcept = default;
+        /// @brief View constructor.
+        /// @param ToView The path to be viewed.
+        constexpr PathView(const StringView ToView) noexcept :
+            Path(ToView)
+            {  }
+        /// @brief C-String constructor.
+        /// @param ToView The null terminated path to be viewed.
+        constexpr PathView(const char* ToView) noexcept :
+            Path(ToView)
+            {  }
+        /// @brief String constructor.
+        /// @param ToView The path to be viewed.
+        PathView(const String& ToView) noexcept :
+            Path(ToView)
+            {  }
+
+        /// @brief Checks to see if a character separates directories in this flavor of path.
+        /// @param ToCheck The character to check.
+        /// @return Returns true if the character is a directory separator, false otherwise.
+        [[nodiscard]]
+        static constexpr Boole IsSeparator(const char ToCheck) noexcept
+        {
+            if constexpr( Flavor == PathFlavor::Windows ) {
+                return IsDirectorySeparator(ToCheck);
+            }else{
+                return IsDirectorySeparator_Posix(ToCheck);
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // Whole Path
+
+        /// @brief Gets the path being viewed.
+        /// @return Returns the whole path, exactly as it was provided.
+        [[nodiscard]]
+        constexpr StringView GetView() const noexcept
+            { return this->Path; }
+        /// @brief Gets the number of characters in the path.
+        /// @return Returns the length of the path.
+        [[nodiscard]]
+        constexpr size_t size() const noexcept
+            { return this->Path.size(); }
+        /// @brief Gets whether or not the path has any characters.
+        /// @return Returns true if the path is empty, false otherwise.
+        [[nodiscard]]
+        constexpr Boole empty() const noexcept
+            { return this->Path.empty(); }
+        /// @brief Gets whether or not the path is absolute.
+        /// @remarks This follows the same rules as IsPathAbsolute_Posix and IsPathAbsolute_Windows.
+        /// @return Returns true if the path defines an explicit location, false otherwise.
+        [[nodiscard]]
+        constexpr Boole IsAbsolute() const noexcept
+        {
+            if constexpr( Flavor == PathFlavor::Windows ) {
+                return ( this->Root().size() == 3 );
+            }else{
+                return !this->Root().empty();
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // Path Parts
+
+        /// @brief Gets the root of the path.
+        /// @remarks On Posix this is the leading '/' of an absolute path. On Windows this is a drive letter and
+        /// colon, followed by a separator if there is one, or a lone leading separator.
+        /// @return Returns a view of the root, or an empty view if the path has no root.
+        [[nodiscard]]
+        constexpr StringView Root() const noexcept
+        {
+            size_t RootLength = 0;
+            if constexpr( Flavor == PathFlavor::Windows ) {
+                const Boole HasDrive = ( this->Path.size() >= 2 && this->Path[1] == ':' &&
+                                         ( ( this->Path[0] >= 'A' && this->Path[0] <= 'Z' ) ||
+                                           ( this->Path[0] >= 'a' && this->Path[0] <= 'z' ) ) );
+                RootLength = ( HasDrive ? 2 : 0 );
+            }
+            if( RootLength < this->Path.size() && PathView::IsSeparator(this->Path[RootLength]) ) {
+                ++RootLength;
+            }
+            return this->Path.substr(0,RootLength);
+        }
+        /// @brief Gets the directory portion of the path.
+        /// @return Returns a view of everything up to and including the last separator, or an empty view if
+        /// there are no separators.
+        [[nodiscard]]
+        constexpr StringView DirName() const noexcept
+        {
+            const size_t SlashPos = this->FindLastSeparator();
+            return ( SlashPos == StringView::npos ? StringView() : this->Path.substr(0,SlashPos + 1) );
+        }
+        /// @brief Gets the file portion of the path.
+        /// @return Returns a view of everything after the last separator, or the whole path if there are no
+        /// separators.
+        [[nodiscard]]
+        constexpr StringView BaseName() const noexcept
+        {
+            const size_t SlashPos = this->FindLastSeparator();
+            return ( SlashPos == StringView::npos ? this->Path : this->Path.substr(SlashPos + 1) );
+        }
+        /// @brief Gets the extension of the file portion of the path.
+        /// @remarks A leading dot doesn't start an extension, so ".profile" has none, and neither do dot segments.
+        /// @return Returns a view of the last dot in the base name and everything after it, or an empty view if
+        /// the base name has no extension.
+        [[nodiscard]]
+        constexpr StringView Extension() const noexcept
+        {
+            const StringView Base = this->BaseName();
+            const size_t DotPos = Base.rfind('.');
+            if( DotPos == StringView::npos || DotPos == 0 || Base == ".." ) {
+                return StringView();
+            }
+            return Base.substr(DotPos);
+        }
+        /// @brief Gets the file portion of the path without its extension.
+        /// @return Returns a view of the base name up to but not including its extension.
+        [[nodiscard]]
+        constexpr StringView Stem() const noexcept
+        {
+            const StringView Base = this->BaseName();
+            return Base.substr(0,Base.size() - this->Extension().size());
+        }
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // Segment Iteration
+
+        /// @brief Gets an iterator to the first segment of the path.
+        /// @return Returns an iterator to the first name after the root.
+        [[nodiscard]]
+        constexpr const_iterator begin() const noexcept
+            { return const_iterator(this->Path,this->Root().size()); }
+        /// @brief Gets an iterator past the last segment of the path.
+        /// @return Returns an iterator marking the end of the segments.
+        [[nodiscard]]
+        constexpr const_iterator end() const noexcept
+            { return const_iterator(this->Path,this->Path.size()); }
+    };//PathView
+
+    /// @brief Convenience type for a view of a path interpreted by Posix rules.
+    using PosixPathView = PathView<PathFlavor::Posix>;
+    /// @brief Convenience type for a view of a path interpreted by Windows rules.
+    using WindowsPathView = PathView<PathFlavor::Windows>;
+    /// @brief Convenience type for a view of a path interpreted by the rules of the platform being compiled for.
+    using HostPathView = PathView<PathFlavor::Host>;
+}//Filesystem
+}//Mezzanine
+
+#endif
@@ -0,0 +1,308 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_SmallPath_h
+#define Mezz_Filesystem_SmallPath_h
+
+/// @file
+/// @brief An owning path that keeps short paths in inline storage so composing them doesn't allocate.
+
+#ifndef SWIG
+    #include "PathUtilities.h"
+
+    #include <algorithm>
+    #include <cstring>
+#endif
+
+namespace Mezzanine {
+namespace Filesystem {
+    ///////////////////////////////////////////////////////////////////////////////
+    /// @brief An owning path that keeps short paths in inline storage so composing them doesn't allocate.
+    /// @details Paths up to InlineCapacity characters are stored inside the object itself. Longer paths spill
+    /// into a String, which keeps its capacity if the path later shrinks back into the inline storage, so a
+    /// reused SmallPath only allocates when it grows past the largest path it has held. @n @n
+    /// Append adds characters exactly as given. Combine and Normalize use the Host rules of
+    /// CombinePathAndFileName_Host and RemoveDotSegments_Host, and give the same results. @n @n
+    /// The path is always null terminated and converts implicitly to a StringView, so it can be passed
+    /// directly to any of the filesystem functions.
+    /// @tparam InlineCapacity The number of characters that can be stored without allocating.
+    ///////////////////////////////////////
+    template<size_t InlineCapacity = 256>
+    class BasicSmallPath
+    {
+    protected:
+        /// @brief The storage used while the path fits, with room for the null terminator.
+        Char8 Inline[InlineCapacity + 1] = { '\0' };
+        /// @brief The storage used once the path has grown past InlineCapacity.
+        String Spilled;
+        /// @brief The number of characters in the path.
+        size_t Length = 0;
+        /// @brief Whether the path is currently stored in Spilled rather than Inline.
+        Boole IsSpilled = false;
+
+        /// @brief Gets the writable storage currently holding the path.
+        /// @return Returns a pointer to the first character of the path.
+        [[nodiscard]]
+        Char8* GetBuffer() noexcept
+            { return ( this->IsSpilled ? this->Spilled.data() : this->Inline ); }
+        /// @brief Changes the length of the path, moving it to the heap if it no longer fits inline.
+        /// @remarks The characters past the old length are left unset, but the path is null terminated.
+        /// @param NewLength The number of characters the path will have.
+        /// @return Returns a pointer to the first character of the path.
+        Char8* Resize(const size_t NewLength)
+        {
+            if( !this->IsSpilled && NewLength > InlineCapacity ) {
+                this->Spilled.reserve( std::max(NewLength,InlineCapacity * 2) );
+                this->Spilled.assign(this->Inline,this->Length);
+                this->IsSpilled = true;
+            }
+            if( this->IsSpilled ) {
+                this->Spilled.resize(NewLength);
+            }else{
+                this->Inline[NewLength] = '\0';
+            }
+            this->Length = NewLength;
+            return this->GetBuffer();
+        }
+    public:
+        /// @brief Blank constructor.
+        BasicSmallPath() = default;
+        /// @brief View constructor.
+        /// @param ToCopy The path to be copied.
+        BasicSmallPath(const StringView ToCopy)
+            { this->Assign(ToCopy); }
+        /// @brief C-String constructor.
+        /// @param ToCopy The null terminated path to be copied.
+        BasicSmallPath(const char* ToCopy)
+            { this->Assign( StringView(ToCopy) ); }
+        /// @brief String constructor.
+        /// @param ToCopy The path to be copied.
+        BasicSmallPath(const String& ToCopy)
+            { this->Assign( StringView(ToCopy) ); }
+        /// @brief Copy constructor.
+        /// @param Other The other path to be copied.
+        BasicSmallPath(const BasicSmallPath& Other)
+            { this->Assign( Other.GetView() ); }
+        /// @brief Move constructor.
+        /// @remarks The other path is left empty.
+        /// @param Other The other path to be moved.
+        BasicSmallPath(BasicSmallPath&& Other) noexcept
+            { *this = std::move(Other); }
+        /// @brief Class destructor.
+        ~BasicSmallPath() = default;
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // Operators
+
+        /// @brief Copy assignment operator.
+        /// @param Other The other path to be copied.
+        /// @return Returns a reference to this.
+        BasicSmallPath& operator=(const BasicSmallPath& Other)
+            { return this->Assign( Other.GetView() ); }
+        /// @brief Move assignment operator.
+        /// @remarks The other path is left empty.
+        /// @param Other The other path to be moved.
+        /// @return Returns a reference to this.
+        BasicSmallPath& operator=(BasicSmallPath&& Other) noexcept
+        {
+            if( this != &Other ) {
+                if( Other.IsSpilled ) {
+                    this->Spilled = std::move(Other.Spilled);
+                    this->IsSpilled = true;
+                    this->Length = Other.Length;
+                }else{
+                    std::memcpy(this->Inline,Other.Inline,Other.Length + 1);
+                    this->IsSpilled = false;
+                    this->Length = Other.Length;
+                }
+                Other.clear();
+            }
+            return *this;
+        }
+        /// @brief View assignment operator.
+        /// @param ToCopy The path to be copied.
+        /// @return Returns a reference to this.
+        BasicSmallPath& operator=(const StringView ToCopy)
+            { return this->Assign(ToCopy); }
+
+        /// @brief StringView conversion operator.
+        /// @return Returns a view of the whole path.
+        [[nodiscard]]
+        operator StringView() const noexcept
+            { return this->GetView(); }
+
+        /// @brief Equality comparison operator.
+        /// @param Other The path to compare to.
+        /// @return Returns true if both paths have exactly the same characters.
+        [[nodiscard]]
+        Boole operator==(const StringView Other) const noexcept
+            { return ( this->GetView() == Other ); }
+        /// @brief Inequality comparison operator.
+        /// @param Other The path to compare to.
+        /// @return Returns true if the paths have any different characters.
+        [[nodiscard]]
+        Boole operator!=(const StringView Other) const noexcept
+            { return ( this->GetView() != Other ); }
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // Whole Path
+
+        /// @brief Gets the path.
+        /// @return Returns a view of the whole path, valid until the path is next modified.
+        [[nodiscard]]
+        StringView GetView() const noexcept
+            { return StringView(this->data(),this->Length); }
+        /// @brief Gets the path as a null terminated string.
+        /// @return Returns a pointer to the first character of the path.
+        [[nodiscard]]
+        const char* c_str() const noexcept
+            { return this->data(); }
+        /// @brief Gets the characters of the path.
+        /// @return Returns a pointer to the first character of the path, which is always null terminated.
+        [[nodiscard]]
+        const char* data() const noexcept
+            { return ( this->IsSpilled ? this->Spilled.data() : this->Inline ); }
+        /// @brief Gets the number of characters in the path.
+        /// @return Returns the length of the path.
+        [[nodiscard]]
+        size_t size() const noexcept
+            { return this->Length; }
+        /// @brief Gets whether or not the path has any characters.
+        /// @return Returns true if the path is empty, false otherwise.
+        [[nodiscard]]
+        Boole empty() const noexcept
+            { return ( this->Length == 0 ); }
+        /// @brief Gets whether or not the path is being stored without a heap allocation.
+        /// @return Returns true if the path fits in the inline storage, false if it has spilled to the heap.
+        [[nodiscard]]
+        Boole IsInline() const noexcept
+            { return !this->IsSpilled; }
+        /// @brief Gets the number of characters that can be stored without allocating.
+        /// @return Returns InlineCapacity, or the capacity of the heap storage if it is larger.
+        [[nodiscard]]
+        size_t capacity() const noexcept
+            { return std::max(InlineCapacity,this->Spilled.capacity()); }
+        /// @brief Empties the path.
+        /// @remarks Any heap storage is kept, so it can be reused if the path grows past InlineCapacity again.
+        void clear() noexcept
+        {
+            this->Spilled.clear();
+            this->IsSpilled = false;
+            this->Length = 0;
+            this->Inline[0] = '\0';
+        }
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // Composition
+
+        /// @brief Replaces the path.
+        /// @param ToCopy The path to be copied. May be a view of this path.
+        /// @return Returns a reference to this.
+        BasicSmallPath& Assign(const StringView ToCopy)
+        {
+            if( ToCopy.size() > InlineCapacity ) {
+                // String::assign copes with ToCopy being a view of the spilled storage.
+                this->Spilled.assign(ToCopy.data(),ToCopy.size());
+                this->IsSpilled = true;
+            }else{
+                // Copy before clearing Spilled, in case ToCopy is a view of it.
+                std::memmove(this->Inline,ToCopy.data(),ToCopy.size());
+                this->Inline[ ToCopy.size() ] = '\0';
+                this->Spilled.clear();
+                this->IsSpilled = false;
+            }
+            this->Length = ToCopy.size();
+            return *this;
+        }
+        /// @brief Adds characters to the end of the path exactly as they are given.
+        /// @param ToAppend The characters to be added. May be a view of this path.
+        /// @return Returns a reference to this.
+        BasicSmallPath& Append(const StringView ToAppend)
+        {
+            const size_t OldLength = this->Length;
+            if( this->IsSpilled ) {
+                this->Spilled.append(ToAppend.data(),ToAppend.size());
+                this->Length = this->Spilled.size();
+            }else{
+                // Inline characters stay put when spilling, so a view of this path remains valid throughout.
+                Char8* Buffer = this->Resize(OldLength + ToAppend.size());
+                std::memmove(Buffer + OldLength,ToAppend.data(),ToAppend.size());
+            }
+            return *this;
+        }
+        /// @brief Adds a single character to the end of the path.
+        /// @param ToAppend The character to be added.
+        /// @return Returns a reference to this.
+        BasicSmallPath& Append(const Char8 ToAppend)
+            { return this->Append( StringView(&ToAppend,1) ); }
+        /// @brief Adds a name to the end of the path, placing a Host separator between them if needed.
+        /// @remarks This gives the same result as CombinePathAndFileName_Host. Only the Host separator counts as
+        /// already being there, so on Windows a path ending in '/' still gets a '\\' added.
+        /// @param ToCombine The directory or file name to be added.
+        /// @return Returns a reference to this.
+        BasicSmallPath& Combine(const StringView ToCombine)
+        {
+            if( !this->empty() && this->GetView().back() != GetDirectorySeparator_Host() ) {
+                this->Append( GetDirectorySeparator_Host() );
+            }
+            return this->Append(ToCombine);
+        }
+        /// @brief Removes all needless instances of "." or ".." from the path, following Host rules.
+        /// @remarks This gives the same result as RemoveDotSegments_Host, and never allocates.
+        /// @return Returns a reference to this.
+        BasicSmallPath& Normalize() noexcept
+        {
+            Char8* Buffer = this->GetBuffer();
+            const size_t NewLength = RemoveDotSegments_Host(StringView(Buffer,this->Length),Buffer,this->Length);
+            if( this->IsSpilled ) {
+                this->Spilled.resize(NewLength);
+            }else{
+                Buffer[NewLength] = '\0';
+            }
+            this->Length = NewLength;
+            return *this;
+        }
+    };//BasicSmallPath
+
+    /// @brief Convenience type for a path with the default amount of inline storage.
+    using SmallPath = BasicSmallPath<>;
+}//Filesystem
+}//Mezzanine
+
+#endif
@@ -0,0 +1,147 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_StringArena_h
+#define Mezz_Filesystem_StringArena_h
+
+#ifndef SWIG
+    #include "DataTypes.h"
+
+    #include <memory>
+    #include <vector>
+#endif
+
+namespace Mezzanine {
+namespace Filesystem {
+    /// @brief The size in bytes of each block allocated by a StringArena when no size is specified.
+    constexpr size_t DefaultStringArenaBlockSize = 64 * 1024;
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// @brief A region of memory that many strings can be copied into without individual allocations.
+    /// @details Strings are copied back to back into large blocks, and views of the copies are handed out. A new
+    /// block is only allocated when a string doesn't fit in the blocks already owned. Strings can't be freed
+    /// individually; instead the whole arena is cleared at once, which keeps every block so that filling the arena
+    /// again doesn't allocate. @n @n
+    /// Views into the arena stay valid until the arena is cleared, released or destroyed. Moving an arena doesn't
+    /// invalidate them.
+    ///////////////////////////////////////
+    class MEZZ_LIB StringArena
+    {
+    protected:
+        /// @brief A single allocation strings are copied into.
+        struct Block
+        {
+            /// @brief The memory of the block.
+            std::unique_ptr<char[]> Data;
+            /// @brief The size of the block in bytes.
+            size_t Size;
+        };//Block
+
+        /// @brief Every block owned by the arena.
+        std::vector<Block> Blocks;
+        /// @brief The size of each new block, unless a string that doesn't fit needs a larger one.
+        size_t BlockSize;
+        /// @brief The index of the block currently being filled.
+        size_t CurrentBlock = 0;
+        /// @brief The number of bytes used in the block currently being filled.
+        size_t CurrentUsed = 0;
+        /// @brief The number of bytes used by every string stored since the arena was last cleared.
+        size_t BytesUsed = 0;
+
+        /// @brief Finds room for a number of bytes, allocating a new block if needed.
+        /// @param Length The number of bytes needed.
+        /// @return Returns a pointer to the start of the room found.
+        [[nodiscard]]
+        char* Allocate(const size_t Length);
+    public:
+        /// @brief Class constructor.
+        /// @param NewBlockSize The size in bytes of each block the arena allocates. No memory is allocated until the
+        /// first string is stored.
+        explicit StringArena(const size_t NewBlockSize = DefaultStringArenaBlockSize) noexcept;
+        /// @brief Deleted copy constructor.
+        StringArena(const StringArena&) = delete;
+        /// @brief Move constructor.
+        /// @param Other The arena to take the blocks of.
+        StringArena(StringArena&& Other) noexcept = default;
+        /// @brief Class destructor.
+        ~StringArena() = default;
+
+        /// @brief Deleted copy assignment operator.
+        StringArena& operator=(const StringArena&) = delete;
+        /// @brief Move assignment operator.
+        /// @param Other The arena to take the blocks of.
+        /// @return Returns a reference to this.
+        StringArena& operator=(StringArena&& Other) noexcept = default;
+
+        /// @brief Copies a string into the arena.
+        /// @param ToStore The string to be copied.
+        /// @return Returns a view of the copy, which is followed by a null terminator.
+        [[nodiscard]]
+        StringView Store(const StringView ToStore);
+        /// @brief Forgets every string stored, while keeping the memory they used.
+        /// @remarks Every view returned by Store is invalidated.
+        void Clear() noexcept;
+        /// @brief Frees every block owned by the arena.
+        /// @remarks Every view returned by Store is invalidated.
+        void Release() noexcept;
+
+        /// @brief Gets the number of bytes used by the strings stored.
+        /// @return Returns the number of bytes stored since the arena was last cleared, including null terminators.
+        [[nodiscard]]
+        size_t GetBytesUsed() const noexcept
+            { return this->BytesUsed; }
+        /// @brief Gets the number of bytes owned by the arena.
+        /// @return Returns the combined size of every block.
+        [[nodiscard]]
+        size_t GetCapacity() const noexcept;
+        /// @brief Gets the number of blocks owned by the arena.
+        /// @return Returns the number of allocations the arena is holding on to.
+        [[nodiscard]]
+        size_t GetBlockCount() const noexcept
+            { return this->Blocks.size(); }
+        /// @brief Gets the size of each new block.
+        /// @return Returns the size in bytes of each block the arena allocates.
+        [[nodiscard]]
+        size_t GetBlockSize() const noexcept
+            { return this->BlockSize; }
+    };//StringArena
+}//Filesystem
+}//Mezzanine
+
+#endif
@@ -0,0 +1,269 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_TreeSnapshot_h
+#define Mezz_Filesystem_TreeSnapshot_h
+
+/// @file
+/// @brief A compact record of a directory tree that can be saved, loaded and compared against other trees.
+
+#ifndef SWIG
+    #include "DataTypes.h"
+    #include "ArchiveEntry.h"
+    #include "FilesystemManagement.h"
+
+    #include <vector>
+#endif
+
+namespace Mezzanine {
+namespace Filesystem {
+    /// @brief An enum for the ways an entry can differ between two trees.
+    enum class TreeChangeType
+    {
+        Added,   ///< The entry exists in the newer tree but not the older one.
+        Removed, ///< The entry exists in the older tree but not the newer one.
+        Modified ///< The entry exists in both trees, but its size, modification time or file ID changed.
+    };//TreeChangeType
+
+    /// @brief A single difference between two trees.
+    struct MEZZ_LIB TreeChange
+    {
+        /// @brief The path of the entry relative to the root of the tree, using '/' as the separator.
+        String Path;
+        /// @brief How the entry differs between the two trees.
+        TreeChangeType Change = TreeChangeType::Modified;
+        /// @brief Whether the entry is a File, Directory or Symlink.
+        /// @remarks For removed entries this is the type the entry had in the older tree.
+        EntryType Type = EntryType::Unknown;
+    };//TreeChange
+
+    /// @brief Convenience type for a collection of tree differences.
+    using TreeChangeVector = std::vector<TreeChange>;
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// @brief A record of every entry in a directory tree, with the metadata needed to tell when one has changed.
+    /// @details Every entry of the tree is stored as a node in a single array, with the root directory as the
+    /// first node. The children of each directory are stored next to each other, sorted by name, so a directory
+    /// only needs to know where its children start and how many it has. Names are stored in a single buffer
+    /// without separators or terminators. @n @n
+    /// Symlinks are recorded as Symlinks and never followed. Modification times are recorded to the
+    /// nanosecond where the system allows it, and the file ID is the inode of the entry on Posix systems and is
+    /// always zero on Windows.
+    ///////////////////////////////////////
+    class MEZZ_LIB TreeSnapshot
+    {
+        friend class TreeSnapshotBuilder;
+    public:
+        ///////////////////////////////////////////////////////////////////////////////
+        /// @brief A single entry in a tree snapshot.
+        ///////////////////////////////////////
+        struct MEZZ_LIB Node
+        {
+            /// @brief The size in bytes of the entry. Zero for directories.
+            UInt64 Size = 0;
+            /// @brief The last modification time of the entry.
+            UInt64 ModifyTime = 0;
+            /// @brief The value the system uses to identify the entry on its device.
+            UInt64 FileID = 0;
+            /// @brief The offset of the name of the entry in the name buffer.
+            UInt32 NameOffset = 0;
+            /// @brief The length of the name of the entry.
+            UInt32 NameLength = 0;
+            /// @brief The index of the first child of a directory. Zero for other entries.
+            UInt32 FirstChild = 0;
+            /// @brief The number of children a directory has. Zero for other entries.
+            UInt32 ChildCount = 0;
+            /// @brief Whether the entry is a File, Directory or Symlink.
+            EntryType Type = EntryType::Unknown;
+        };//Node
+
+        /// @brief The container storing every node in the snapshot.
+        using NodeContainer = std::vector<Node>;
+    protected:
+        /// @brief Every node in the snapshot, starting with the root directory.
+        NodeContainer Nodes;
+        /// @brief The name of every node in the snapshot.
+        String Names;
+        /// @brief The path the snapshot was captured from.
+        String RootPath;
+    public:
+        /// @brief Blank constructor.
+        TreeSnapshot() = default;
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // Capacity
+
+        /// @brief Gets the number of nodes in the snapshot.
+        /// @return Returns the number of entries in the tree, including the root directory.
+        [[nodiscard]]
+        size_t size() const noexcept
+            { return this->Nodes.size(); }
+        /// @brief Gets whether or not the snapshot has any nodes.
+        /// @remarks A snapshot is empty when it is default constructed or the root couldn't be read.
+        /// @return Returns true if there are no nodes stored, false otherwise.
+        [[nodiscard]]
+        Boole empty() const noexcept
+            { return this->Nodes.empty(); }
+        /// @brief Gets the path the snapshot was captured from.
+        /// @return Returns the root path that was passed in when the snapshot was captured.
+        [[nodiscard]]
+        const String& GetRootPath() const noexcept
+            { return this->RootPath; }
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // Node Access
+
+        /// @brief Gets a node in the snapshot.
+        /// @param Index The index of the node. Must be less than the size of the snapshot.
+        /// @return Returns a const reference to the requested node.
+        [[nodiscard]]
+        const Node& GetNode(const size_t Index) const noexcept
+            { return this->Nodes[Index]; }
+        /// @brief Gets every node in the snapshot.
+        /// @return Returns a const reference to the array of nodes, starting with the root directory.
+        [[nodiscard]]
+        const NodeContainer& GetNodes() const noexcept
+            { return this->Nodes; }
+        /// @brief Gets the name of a node.
+        /// @param Index The index of the node. Must be less than the size of the snapshot.
+        /// @return Returns a view of the name of the node. This is not null terminated.
+        [[nodiscard]]
+        StringView GetName(const size_t Index) const noexcept
+        {
+            const Node& Found = this->Nodes[Index];
+            return StringView(this->Names.data() + Found.NameOffset,Found.NameLength);
+        }
+        /// @brief Finds a node by its path.
+        /// @param RelativePath The path of the node relative to the root of the tree, using '/' as the separator.
+        /// An empty path is the root directory.
+        /// @return Returns the index of the node, or the size of the snapshot if it wasn't found.
+        [[nodiscard]]
+        size_t Find(const StringView RelativePath) const noexcept;
+        /// @brief Finds a child of a directory node by its name.
+        /// @param DirIndex The index of the directory node to search. Must be less than the size of the snapshot.
+        /// @param Name The name of the child to find.
+        /// @return Returns the index of the child, or the size of the snapshot if it wasn't found.
+        [[nodiscard]]
+        size_t FindChild(const size_t DirIndex, const StringView Name) const noexcept;
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // Serialization
+
+        /// @brief Converts the snapshot to a compact binary form.
+        /// @remarks The binary form is the same on every platform, with every number stored little endian.
+        /// @return Returns a String containing the binary form of the snapshot.
+        [[nodiscard]]
+        String Serialize() const;
+        /// @brief Replaces the contents of the snapshot with ones converted from binary form.
+        /// @remarks The snapshot is left empty if the data is malformed or from an unknown version.
+        /// @param Data The binary form of a snapshot, as produced by Serialize.
+        /// @return Returns true if the data was valid and loaded, false otherwise.
+        Boole Deserialize(const StringView Data);
+    };//TreeSnapshot
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Tree Snapshot Capturing
+
+    /// @brief Records every entry in a directory tree.
+    /// @param Path The directory at the root of the tree.
+    /// @return Returns a snapshot of the tree, which will be empty if the root couldn't be read.
+    [[nodiscard]]
+    TreeSnapshot MEZZ_LIB CaptureTreeSnapshot(const StringView Path);
+    /// @brief Records every entry in a directory tree, reusing what is known from an earlier snapshot.
+    /// @remarks A directory whose modification time and file ID match its node in Previous isn't read.
+    /// Instead its children are copied from Previous, and only its subdirectories are checked. This makes
+    /// capturing a tree that hasn't changed cost one call per directory rather than one per entry. @n @n
+    /// A directory's modification time only changes when entries are added to, removed from or renamed in it.
+    /// Files that are rewritten in place, rather than replaced, keep the metadata they had in Previous unless
+    /// something else changed in their directory. Use the single parameter overload when that matters.
+    /// @param Path The directory at the root of the tree.
+    /// @param Previous An earlier snapshot of the same tree.
+    /// @return Returns a snapshot of the tree, which will be empty if the root couldn't be read.
+    [[nodiscard]]
+    TreeSnapshot MEZZ_LIB CaptureTreeSnapshot(const StringView Path, const TreeSnapshot& Previous);
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Tree Snapshot Files
+
+    /// @brief Writes a snapshot to a file in binary form.
+    /// @remarks The file is written with AtomicWriteFile and flushed before it replaces any existing file at the
+    /// path, so a crash part way through the write can't leave a truncated snapshot behind.
+    /// @param Snapshot The snapshot to be saved.
+    /// @param FilePath The path of the file to write.
+    /// @return Returns a ModifyResult describing whether or not the file was written.
+    ModifyResult MEZZ_LIB SaveTreeSnapshot(const TreeSnapshot& Snapshot, const StringView FilePath);
+    /// @brief Reads a snapshot from a file written by SaveTreeSnapshot.
+    /// @param FilePath The path of the file to read.
+    /// @return Returns the snapshot in the file, or an empty Optional if it couldn't be read or is malformed.
+    [[nodiscard]]
+    Optional<TreeSnapshot> MEZZ_LIB LoadTreeSnapshot(const StringView FilePath);
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Tree Differences
+
+    /// @brief Gets every difference between two snapshots of a tree.
+    /// @remarks Changes are listed with each directory before its contents and the contents of a directory in
+    /// name order. An added or removed directory is listed along with everything inside of it. An entry that
+    /// changed type is listed as removed and then added. Directories are never listed as modified, since their
+    /// changes show up as the changes to their contents.
+    /// @param Older The earlier snapshot of the tree.
+    /// @param Newer The later snapshot of the tree.
+    /// @return Returns a vector of every entry that was added, removed or modified.
+    [[nodiscard]]
+    TreeChangeVector MEZZ_LIB DiffTreeSnapshots(const TreeSnapshot& Older, const TreeSnapshot& Newer);
+    /// @brief Gets every difference between a snapshot and the current state of a tree.
+    /// @param Older The earlier snapshot of the tree.
+    /// @param Path The directory at the root of the tree.
+    /// @return Returns a vector of every entry that was added, removed or modified.
+    [[nodiscard]]
+    TreeChangeVector MEZZ_LIB DiffTreeSnapshot(const TreeSnapshot& Older, const StringView Path);
+    /// @brief Gets every difference between a snapshot and the current state of a tree.
+    /// @param Older The earlier snapshot of the tree.
+    /// @param Path The directory at the root of the tree.
+    /// @param SkipUnchangedDirectories Whether or not to skip reading directories with the same modification
+    /// time and file ID as they had in Older. See the two parameter overload of CaptureTreeSnapshot for what
+    /// this can miss.
+    /// @return Returns a vector of every entry that was added, removed or modified.
+    [[nodiscard]]
+    TreeChangeVector MEZZ_LIB DiffTreeSnapshot(const TreeSnapshot& Older, const StringView Path,
+                                               const Boole SkipUnchangedDirectories);
+}//Filesystem
+}//Mezzanine
+
+#endif
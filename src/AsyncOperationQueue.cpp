@@ -0,0 +1,308 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#include "CrossPlatformExport.h"
+
+#include "AsyncOperationQueue.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "PlatformUndefs.h"
+
+namespace
+{
+    using namespace Mezzanine;
+
+    /// @brief Gets the index of the waiting list used for a priority.
+    /// @param Priority The priority to get the list of.
+    /// @return Returns the index of the list, with the highest priority at zero.
+    [[nodiscard]]
+    size_t GetPriorityIndex(const Filesystem::OperationPriority Priority) noexcept
+    {
+        switch( Priority )
+        {
+            case Filesystem::OperationPriority::High:    return 0;
+            case Filesystem::OperationPriority::Normal:  return 1;
+            case Filesystem::OperationPriority::Low:     return 2;
+        }
+        return 1;
+    }
+}
+
+namespace Mezzanine {
+namespace Filesystem {
+    ///////////////////////////////////////////////////////////////////////////////
+    // AsyncOperationQueue Methods
+
+    AsyncOperationQueue::AsyncOperationQueue() :
+        AsyncOperationQueue(AsyncQueueOptions())
+        {  }
+
+    AsyncOperationQueue::AsyncOperationQueue(const AsyncQueueOptions& Options) :
+        MaxQueueDepth( std::max<size_t>(Options.MaxQueueDepth,1) )
+    {
+        size_t ThreadCount = Options.ThreadCount;
+        if( ThreadCount == 0 ) {
+            ThreadCount = std::max<size_t>(std::thread::hardware_concurrency(),1);
+        }
+        this->Workers.reserve(ThreadCount);
+        for( size_t Count = 0 ; Count < ThreadCount ; ++Count )
+            { this->Workers.emplace_back([this](){ this->RunWorker(); }); }
+    }
+
+    AsyncOperationQueue::~AsyncOperationQueue()
+    {
+        {
+            std::lock_guard<std::mutex> Lock(this->QueueLock);
+            this->ShuttingDown = true;
+        }
+        this->OperationQueued.notify_all();
+        this->SpaceAvailable.notify_all();
+        for( std::thread& Worker : this->Workers )
+            { Worker.join(); }
+    }
+
+    void AsyncOperationQueue::RunWorker()
+    {
+        while( true )
+        {
+            QueuedOperation Next;
+            {
+                std::unique_lock<std::mutex> Lock(this->QueueLock);
+                this->OperationQueued.wait(Lock,[this](){ return this->WaitingCount > 0 || this->ShuttingDown; });
+                if( this->WaitingCount == 0 ) {
+                    return;
+                }
+                for( std::deque<QueuedOperation>& PriorityList : this->Waiting )
+                {
+                    if( !PriorityList.empty() ) {
+                        Next = std::move( PriorityList.front() );
+                        PriorityList.pop_front();
+                        break;
+                    }
+                }
+                --(this->WaitingCount);
+                ++(this->RunningCount);
+            }
+            this->SpaceAvailable.notify_one();
+
+            ModifyResult Result = ModifyResult::Unknown;
+            std::exception_ptr Error;
+            try {
+                Result = Next.ToRun();
+            }catch(...){
+                Error = std::current_exception();
+            }
+            Next.OnComplete(Result,Error);
+
+            {
+                std::lock_guard<std::mutex> Lock(this->QueueLock);
+                --(this->RunningCount);
+            }
+            this->OperationFinished.notify_all();
+        }
+    }
+
+    Boole AsyncOperationQueue::Enqueue(QueuedOperation&& ToQueue, const OperationPriority Priority, const Boole Block)
+    {
+        {
+            std::unique_lock<std::mutex> Lock(this->QueueLock);
+            if( Block ) {
+                this->SpaceAvailable.wait(Lock,[this](){
+                    return this->WaitingCount < this->MaxQueueDepth || this->ShuttingDown;
+                });
+            }
+            if( this->ShuttingDown || this->WaitingCount >= this->MaxQueueDepth ) {
+                return false;
+            }
+            this->Waiting[ GetPriorityIndex(Priority) ].push_back( std::move(ToQueue) );
+            ++(this->WaitingCount);
+        }
+        this->OperationQueued.notify_one();
+        return true;
+    }
+
+    std::future<ModifyResult> AsyncOperationQueue::EnqueueWithFuture(Operation ToRun,
+                                                                     const OperationPriority Priority,
+                                                                     const Boole Block)
+    {
+        // std::function needs copyable callables, so the promise has to be shared.
+        std::shared_ptr< std::promise<ModifyResult> > Promise = std::make_shared< std::promise<ModifyResult> >();
+        std::future<ModifyResult> Ret = Promise->get_future();
+        QueuedOperation ToQueue;
+        ToQueue.ToRun = std::move(ToRun);
+        ToQueue.OnComplete = [Promise](const ModifyResult Result, std::exception_ptr Error) {
+            if( Error ) {
+                Promise->set_exception(Error);
+            }else{
+                Promise->set_value(Result);
+            }
+        };
+        if( !this->Enqueue(std::move(ToQueue),Priority,Block) ) {
+            return std::future<ModifyResult>();
+        }
+        return Ret;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Submission
+
+    std::future<ModifyResult> AsyncOperationQueue::Submit(Operation ToRun, const OperationPriority Priority)
+        { return this->EnqueueWithFuture(std::move(ToRun),Priority,true); }
+
+    void AsyncOperationQueue::Submit(Operation ToRun, CompletionCallback OnComplete, const OperationPriority Priority)
+    {
+        QueuedOperation ToQueue;
+        ToQueue.ToRun = std::move(ToRun);
+        ToQueue.OnComplete = [Callback = std::move(OnComplete)](const ModifyResult Result, std::exception_ptr Error) {
+            Callback( Error ? ModifyResult::Unknown : Result );
+        };
+        // Enqueue only takes the operation if it is queued, so it can still be told it never ran.
+        if( !this->Enqueue(std::move(ToQueue),Priority,true) ) {
+            ToQueue.OnComplete(ModifyResult::OperationCanceled,std::exception_ptr());
+        }
+    }
+
+    std::future<ModifyResult> AsyncOperationQueue::TrySubmit(Operation ToRun, const OperationPriority Priority)
+        { return this->EnqueueWithFuture(std::move(ToRun),Priority,false); }
+
+    Boole AsyncOperationQueue::TrySubmit(Operation ToRun, CompletionCallback OnComplete,
+                                         const OperationPriority Priority)
+    {
+        QueuedOperation ToQueue;
+        ToQueue.ToRun = std::move(ToRun);
+        ToQueue.OnComplete = [Callback = std::move(OnComplete)](const ModifyResult Result, std::exception_ptr Error) {
+            Callback( Error ? ModifyResult::Unknown : Result );
+        };
+        return this->Enqueue(std::move(ToQueue),Priority,false);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Convenience Operations
+
+    std::future<ModifyResult> AsyncOperationQueue::CopyFile(const StringView OldFilePath,
+                                                            const StringView NewFilePath,
+                                                            const FileOverwrite IfExists,
+                                                            const OperationPriority Priority)
+    {
+        return this->Submit([OldPath = String(OldFilePath), NewPath = String(NewFilePath), IfExists](){
+            return Filesystem::CopyFile(OldPath,NewPath,IfExists);
+        },Priority);
+    }
+
+    std::future<ModifyResult> AsyncOperationQueue::MoveFile(const StringView OldFilePath,
+                                                            const StringView NewFilePath,
+                                                            const FileOverwrite IfExists,
+                                                            const OperationPriority Priority)
+    {
+        return this->Submit([OldPath = String(OldFilePath), NewPath = String(NewFilePath), IfExists](){
+            return Filesystem::MoveFile(OldPath,NewPath,IfExists);
+        },Priority);
+    }
+
+    std::future<ModifyResult> AsyncOperationQueue::RemoveFile(const StringView FilePath,
+                                                              const OperationPriority Priority)
+    {
+        return this->Submit([Path = String(FilePath)](){
+            return Filesystem::RemoveFile(Path);
+        },Priority);
+    }
+
+    std::future<ModifyResult> AsyncOperationQueue::CreateDirectoryPath(const StringView DirectoryPath,
+                                                                       const OperationPriority Priority)
+    {
+        return this->Submit([Path = String(DirectoryPath)](){
+            return Filesystem::CreateDirectoryPath(Path);
+        },Priority);
+    }
+
+    std::future<ModifyResult> AsyncOperationQueue::RemoveDirectory(const StringView DirectoryPath,
+                                                                   const OperationPriority Priority)
+    {
+        return this->Submit([Path = String(DirectoryPath)](){
+            return Filesystem::RemoveDirectory(Path);
+        },Priority);
+    }
+
+    std::future<ModifyResult> AsyncOperationQueue::RemoveDirectoryTree(const StringView DirectoryPath,
+                                                                       const OperationPriority Priority)
+    {
+        return this->Submit([Path = String(DirectoryPath)](){
+            return Filesystem::RemoveDirectoryTree(Path,1);
+        },Priority);
+    }
+
+    std::future<ModifyResult> AsyncOperationQueue::AtomicWriteFile(const StringView FilePath, const StringView Data,
+                                                                   const DurabilityPolicy Durability,
+                                                                   const OperationPriority Priority)
+    {
+        return this->Submit([Path = String(FilePath), Contents = String(Data), Durability](){
+            return Filesystem::AtomicWriteFile(Path,Contents,Durability);
+        },Priority);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Queue State
+
+    size_t AsyncOperationQueue::GetThreadCount() const noexcept
+        { return this->Workers.size(); }
+
+    size_t AsyncOperationQueue::GetMaxQueueDepth() const noexcept
+        { return this->MaxQueueDepth; }
+
+    size_t AsyncOperationQueue::GetWaitingCount() const
+    {
+        std::lock_guard<std::mutex> Lock(this->QueueLock);
+        return this->WaitingCount;
+    }
+
+    size_t AsyncOperationQueue::GetPendingCount() const
+    {
+        std::lock_guard<std::mutex> Lock(this->QueueLock);
+        return this->WaitingCount + this->RunningCount;
+    }
+
+    void AsyncOperationQueue::WaitForAll()
+    {
+        std::unique_lock<std::mutex> Lock(this->QueueLock);
+        this->OperationFinished.wait(Lock,[this](){ return this->WaitingCount + this->RunningCount == 0; });
+    }
+}//Filesystem
+}//Mezzanine
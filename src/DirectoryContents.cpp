@@ -54,11 +54,20 @@
 
     #include <Windows.h>
 #else
+    #include <errno.h>
     #include <stdio.h>
     #include <sys/stat.h>
     #include <sys/types.h>
     #include <dirent.h>
+    #include <fcntl.h>
     #include <unistd.h>
+    #if defined(MEZZ_Linux) && !defined(MEZZ_CompilerIsEmscripten)
+        #include <sys/syscall.h>
+        #if defined(STATX_BTIME)
+            // Older C libraries don't wrap statx, in which case we stick with fstatat.
+            #define MEZZ_FilesystemStatx
+        #endif
+    #endif
 #endif
 
 #include "PlatformUndefs.h"
@@ -231,114 +240,528 @@ namespace
             NewEntry.Size = static_cast<UInt64>(Original.st_size);
         }
     }
+  #ifdef MEZZ_FilesystemStatx
+    /// @brief Transposes all data from the Linux extended stat of an entry to a Mezzanine entry.
+    /// @remarks Unlike stat, statx can report when the entry was created. When the filesystem doesn't record that
+    /// the last time the metadata changed is used instead, same as for stat.
+    /// @param Original The entry produced by the OS to be transposed.
+    /// @param NewEntry The new Mezzanine entry to transpose to.
+    void TransposeEntry(const struct statx& Original, ArchiveEntry& NewEntry) noexcept
+    {
+        if( Original.stx_mask & STATX_BTIME ) {
+            NewEntry.CreateTime = static_cast<UInt64>( Original.stx_btime.tv_sec );
+        }else{
+            NewEntry.CreateTime = static_cast<UInt64>( Original.stx_ctime.tv_sec );
+        }
+        NewEntry.AccessTime = static_cast<UInt64>( Original.stx_atime.tv_sec );
+        NewEntry.ModifyTime = static_cast<UInt64>( Original.stx_mtime.tv_sec );
+        NewEntry.Permissions = static_cast<FilePermissions>( ConvertPosixPermissions(Original.stx_mode) );
+
+        if( S_ISDIR(Original.stx_mode) ) {
+            NewEntry.Entry = EntryType::Directory;
+        }else{
+            if( S_ISLNK(Original.stx_mode) ) {
+                NewEntry.Entry = EntryType::Symlink;
+            }else if( S_ISREG(Original.stx_mode) ) {
+                NewEntry.Entry = EntryType::File;
+            }else{
+                return;
+            }
+
+            NewEntry.Size = static_cast<UInt64>(Original.stx_size);
+        }
+    }
+    /// @brief Converts the metadata wanted for an entry to the fields statx should retrieve.
+    /// @param Metadata The metadata that needs to be populated.
+    /// @return Returns a STATX_* mask covering every field needed to populate the requested metadata.
+    [[nodiscard]]
+    unsigned ConvertToStatxMask(const Filesystem::EntryMetadata Metadata) noexcept
+    {
+        using Filesystem::EntryMetadata;
+        // The type is needed to know whether or not the size applies.
+        unsigned Ret = STATX_TYPE;
+        if( ( Metadata & EntryMetadata::Size ) != EntryMetadata::None ) {
+            Ret |= STATX_SIZE;
+        }
+        if( ( Metadata & EntryMetadata::Times ) != EntryMetadata::None ) {
+            Ret |= STATX_ATIME | STATX_MTIME | STATX_CTIME | STATX_BTIME;
+        }
+        if( ( Metadata & EntryMetadata::Permissions ) != EntryMetadata::None ) {
+            Ret |= STATX_MODE;
+        }
+        return Ret;
+    }
+  #endif // MEZZ_FilesystemStatx
+    /// @brief Gets the metadata of a file, directory or Symlink relative to an open directory.
+    /// @param DirectoryHandle The file descriptor of the open directory, or AT_FDCWD for the working directory.
+    /// @param EntryPath The path of the entry, relative to the directory.
+    /// @param Metadata The metadata that needs to be populated.
+    /// @param FollowSymlinks Whether a Symlink reports the metadata of what it points to, or of the link itself.
+    /// @param NewEntry The Mezzanine entry to populate. The name and archive type are not modified.
+    /// @return Returns true if NewEntry was populated, false if the entry couldn't be stat'd.
+    Boole StatEntryAt(const int DirectoryHandle, const char* EntryPath, const Filesystem::EntryMetadata Metadata,
+                      const Boole FollowSymlinks, ArchiveEntry& NewEntry) noexcept
+    {
+    #ifdef MEZZ_FilesystemStatx
+        const int StatxFlags = AT_NO_AUTOMOUNT | ( FollowSymlinks ? 0 : AT_SYMLINK_NOFOLLOW );
+        struct statx FileStatx;
+        if( ::statx(DirectoryHandle,EntryPath,StatxFlags,ConvertToStatxMask(Metadata),&FileStatx) == 0 ) {
+            TransposeEntry(FileStatx,NewEntry);
+            return true;
+        }else if( errno != ENOSYS ) {
+            return false;
+        }
+    #else
+        static_cast<void>(Metadata);
+    #endif
+        const int StatFlags = ( FollowSymlinks ? 0 : AT_SYMLINK_NOFOLLOW );
+        struct stat FileStat;
+        if( ::fstatat(DirectoryHandle,EntryPath,&FileStat,StatFlags) == -1 ) {
+            return false;
+        }
+        TransposeEntry(FileStat,NewEntry);
+        return true;
+    }
+    /// @brief Converts the type reported by a directory entry to a Mezzanine entry type.
+    /// @param DirType The DT_* value stored in the directory entry.
+    /// @return Returns the matching EntryType, or Unknown if the type isn't one we represent.
+    [[nodiscard]]
+    EntryType ConvertDirentType(const unsigned char DirType) noexcept
+    {
+        switch( DirType )
+        {
+            case DT_REG:  return EntryType::File;
+            case DT_DIR:  return EntryType::Directory;
+            case DT_LNK:  return EntryType::Symlink;
+            default:      return EntryType::Unknown;
+        }
+    }
+    /// @brief Gets the metadata of a single entry in a directory.
+    /// @remarks The entry is stat'd relative to the open directory so we don't need to build a full path for it,
+    /// or have the kernel walk that full path again for every entry. If only the type of the entry is needed and
+    /// the directory entry has it, no stat is done at all.
+    /// @param DirectoryHandle The file descriptor of the open directory containing the entry.
+    /// @param EntryName The name of the entry within the directory.
+    /// @param DirType The DT_* type reported by the directory entry.
+    /// @param Options The metadata that needs to be populated and whether or not to follow Symlinks.
+    /// @param NewEntry The Mezzanine entry to populate. Only fields that are populated will be modified.
+    /// @return Returns true if NewEntry was populated, false if the entry couldn't be stat'd.
+    Boole PopulateEntry(const int DirectoryHandle, const char* EntryName, const unsigned char DirType,
+                        const Filesystem::DirectoryContentsOptions& Options, ArchiveEntry& NewEntry)
+    {
+        using Filesystem::EntryMetadata;
+        const Boole TypeOnly = ( ( Options.Metadata | EntryMetadata::Type ) == EntryMetadata::Type );
+        const Boole TypeKnown = ( DirType != DT_UNKNOWN && ( DirType != DT_LNK || !Options.FollowSymlinks ) );
+        if( Options.Metadata == EntryMetadata::None || ( TypeOnly && TypeKnown ) ) {
+            NewEntry.Name = EntryName;
+            NewEntry.Archive = ArchiveType::FileSystem;
+            NewEntry.Entry = ConvertDirentType(DirType);
+            return true;
+        }
+
+        if( !StatEntryAt(DirectoryHandle,EntryName,Options.Metadata,Options.FollowSymlinks,NewEntry) ) {
+            return false;
+        }
+
+        NewEntry.Name = EntryName;
+        NewEntry.Archive = ArchiveType::FileSystem;
+        return true;
+    }
+
+  #if defined(MEZZ_Linux) && !defined(MEZZ_CompilerIsEmscripten)
+    /// @brief The layout of a single record returned by the getdents64 system call.
+    /// @remarks glibc only recently started exposing this, so we declare it ourselves to support older systems.
+    struct LinuxDirent64
+    {
+        /// @brief The inode number of the entry.
+        UInt64 d_ino;
+        /// @brief An opaque offset of the next entry in the directory stream.
+        Int64 d_off;
+        /// @brief The total size of this record, including the name and padding.
+        unsigned short d_reclen;
+        /// @brief The type of the entry, using the same DT_* values as readdir.
+        unsigned char d_type;
+        /// @brief The start of the null terminated name of the entry.
+        char d_name[1];
+    };//LinuxDirent64
+
+    /// @brief Reads entries from a directory in batches directly from the kernel.
+    /// @details readdir makes a library call for every entry, and the size of the buffer it reads with is out of
+    /// our hands. This instead fills a caller sized buffer with as many entries as will fit with each getdents64
+    /// call and walks the records in that buffer.
+    class DirentBatchReader
+    {
+    protected:
+        /// @brief The buffer the kernel writes the directory records to.
+        std::vector<char> Buffer;
+        /// @brief The offset of the next record to read in the buffer.
+        size_t BufferPos = 0;
+        /// @brief The number of valid bytes in the buffer.
+        size_t BufferEnd = 0;
+        /// @brief The file descriptor of the open directory.
+        int DirectoryHandle = -1;
+    public:
+        /// @brief The smallest buffer that is guaranteed to hold a record with a name of maximum length.
+        static constexpr size_t MinimumBatchSize = 512;
+
+        /// @brief Opening constructor.
+        /// @param DirectoryPath The directory to be read.
+        /// @param BatchSize The size of the buffer to read entries into.
+        DirentBatchReader(const StringView DirectoryPath, const size_t BatchSize) :
+            Buffer( std::max(BatchSize,MinimumBatchSize) )
+            { this->DirectoryHandle = ::open(DirectoryPath.data(),O_RDONLY | O_DIRECTORY | O_CLOEXEC); }
+        /// @brief Deleted copy constructor.
+        DirentBatchReader(const DirentBatchReader&) = delete;
+        /// @brief Class destructor.
+        ~DirentBatchReader()
+        {
+            if( this->DirectoryHandle != -1 ) {
+                ::close(this->DirectoryHandle);
+            }
+        }
+
+        /// @brief Deleted copy assignment operator.
+        DirentBatchReader& operator=(const DirentBatchReader&) = delete;
+
+        /// @brief Gets the file descriptor of the open directory.
+        /// @return Returns the file descriptor being read from, or -1 if the directory couldn't be opened.
+        [[nodiscard]]
+        int GetHandle() const noexcept
+            { return this->DirectoryHandle; }
+        /// @brief Gets whether or not the directory was successfully opened.
+        /// @return Returns true if the directory can be read from, false otherwise.
+        [[nodiscard]]
+        Boole IsOpen() const noexcept
+            { return ( this->DirectoryHandle != -1 ); }
+        /// @brief Gets the next record in the directory, reading another batch from the kernel if needed.
+        /// @return Returns a pointer to the next record, or nullptr if there are no more entries or an error occurred.
+        [[nodiscard]]
+        const LinuxDirent64* GetNextEntry() noexcept
+        {
+            if( this->BufferPos >= this->BufferEnd ) {
+                long BytesRead = ::syscall(SYS_getdents64,this->DirectoryHandle,
+                                           this->Buffer.data(),this->Buffer.size());
+                if( BytesRead <= 0 ) {
+                    return nullptr;
+                }
+                this->BufferPos = 0;
+                this->BufferEnd = static_cast<size_t>(BytesRead);
+            }
+            const LinuxDirent64* Ret = reinterpret_cast<const LinuxDirent64*>( &this->Buffer[this->BufferPos] );
+            this->BufferPos += Ret->d_reclen;
+            return Ret;
+        }
+    };//DirentBatchReader
+  #endif // MEZZ_Linux
 #endif // MEZZ_Windows
 }
 
 namespace Mezzanine {
 namespace Filesystem {
     ///////////////////////////////////////////////////////////////////////////////
-    // Directory Contents
-
-    StringVector GetDirectoryContentNames(const StringView DirectoryPath)
+    /// @brief The platform specific handle to an open directory that entries are read from.
+    ///////////////////////////////////////
+    class DirectoryStream
     {
-        StringVector Ret;
+    protected:
+        /// @brief The options the directory was opened with.
+        DirectoryContentsOptions Options;
     #ifdef MEZZ_Windows
+        /// @brief The data of the most recently found entry.
         WIN32_FIND_DATAW FileData;
+        /// @brief The handle to the open search of the directory.
         HANDLE FileHandle = INVALID_HANDLE_VALUE;
-
-        WideString ConvertedPath = PreparePathForWindows(DirectoryPath);
-        FileHandle = ::FindFirstFileW( ConvertedPath.data(), &FileData );
-        if( FileHandle == INVALID_HANDLE_VALUE ) {
-            return Ret;
+        /// @brief Whether or not FileData holds an entry that hasn't been read yet.
+        Boole HasPendingEntry = false;
+    #else
+      #if defined(MEZZ_Linux) && !defined(MEZZ_CompilerIsEmscripten)
+        /// @brief The batched reader used when a batch size is specified.
+        std::unique_ptr<DirentBatchReader> BatchReader;
+      #endif
+        /// @brief The portable directory stream used when there is no batch reader.
+        DIR* Directory = nullptr;
+    #endif
+    public:
+        /// @brief Opening constructor.
+        /// @param DirectoryPath The directory to be read.
+        /// @param ToUse The options for reading the directory.
+        DirectoryStream(const StringView DirectoryPath, const DirectoryContentsOptions& ToUse) :
+            Options(ToUse)
+        {
+        #ifdef MEZZ_Windows
+            WideString ConvertedPath = PreparePathForWindows(DirectoryPath);
+            this->FileHandle = ::FindFirstFileW( ConvertedPath.data(), &(this->FileData) );
+            this->HasPendingEntry = ( this->FileHandle != INVALID_HANDLE_VALUE );
+        #else
+          #if defined(MEZZ_Linux) && !defined(MEZZ_CompilerIsEmscripten)
+            if( this->Options.BatchSize > 0 ) {
+                this->BatchReader = std::make_unique<DirentBatchReader>(DirectoryPath,this->Options.BatchSize);
+                return;
+            }
+          #endif
+            this->Directory = ::opendir( DirectoryPath.data() );
+        #endif
         }
-
-        do{
-            String EntryName = ConvertToNarrowString( FileData.cFileName );
-            if( IsDotSegment(EntryName) ) {
-                continue;
+        /// @brief Deleted copy constructor.
+        DirectoryStream(const DirectoryStream&) = delete;
+        /// @brief Class destructor.
+        ~DirectoryStream()
+        {
+        #ifdef MEZZ_Windows
+            if( this->FileHandle != INVALID_HANDLE_VALUE ) {
+                ::FindClose(this->FileHandle);
             }
-            Ret.push_back( std::move(EntryName) );
-        }while( ::FindNextFileW( FileHandle, &FileData ) );
+        #else
+            if( this->Directory ) {
+                ::closedir(this->Directory);
+            }
+        #endif
+        }
 
-        ::FindClose(FileHandle);
-    #else
-        struct dirent* DirEntry;
-        DIR* Directory = ::opendir( DirectoryPath.data() );
-        if( Directory ) {
-            while( ( DirEntry = ::readdir(Directory) ) )
+        /// @brief Deleted copy assignment operator.
+        DirectoryStream& operator=(const DirectoryStream&) = delete;
+
+        /// @brief Gets whether or not the directory was successfully opened.
+        /// @return Returns true if the directory can be read from, false otherwise.
+        [[nodiscard]]
+        Boole IsOpen() const noexcept
+        {
+        #ifdef MEZZ_Windows
+            return ( this->FileHandle != INVALID_HANDLE_VALUE );
+        #else
+          #if defined(MEZZ_Linux) && !defined(MEZZ_CompilerIsEmscripten)
+            if( this->BatchReader ) {
+                return this->BatchReader->IsOpen();
+            }
+          #endif
+            return ( this->Directory != nullptr );
+        #endif
+        }
+        /// @brief Reads the next entry in the directory, skipping dot segments and entries that can't be stat'd.
+        /// @param NewEntry The entry to populate. Only fields covered by the requested metadata are modified.
+        /// @return Returns true if an entry was read, false if there are no more entries.
+        Boole ReadEntry(ArchiveEntry& NewEntry)
+        {
+            if( !this->IsOpen() ) {
+                return false;
+            }
+        #ifdef MEZZ_Windows
+            while( this->HasPendingEntry || ::FindNextFileW( this->FileHandle, &(this->FileData) ) )
             {
-                String EntryName = DirEntry->d_name;
-                if( IsDotSegment(EntryName) ) {
+                this->HasPendingEntry = false;
+                NewEntry.Name = ConvertToNarrowString( this->FileData.cFileName );
+                if( IsDotSegment(NewEntry.Name) ) {
                     continue;
                 }
 
-                Ret.push_back( std::move(EntryName) );
+                NewEntry.Archive = ArchiveType::FileSystem;
+                TransposeEntry(this->FileData,NewEntry);
+                return true;
+            }
+        #else
+          #if defined(MEZZ_Linux) && !defined(MEZZ_CompilerIsEmscripten)
+            if( this->BatchReader ) {
+                const LinuxDirent64* DirEntry;
+                while( ( DirEntry = this->BatchReader->GetNextEntry() ) )
+                {
+                    if( IsDotSegment(DirEntry->d_name) ) {
+                        continue;
+                    }
+                    if( PopulateEntry(this->BatchReader->GetHandle(),DirEntry->d_name,DirEntry->d_type,
+                                      this->Options,NewEntry) ) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+          #endif
+            struct dirent* DirEntry;
+            while( ( DirEntry = ::readdir(this->Directory) ) )
+            {
+                if( IsDotSegment(DirEntry->d_name) ) {
+                    continue;
+                }
+                if( PopulateEntry(::dirfd(this->Directory),DirEntry->d_name,DirEntry->d_type,
+                                  this->Options,NewEntry) ) {
+                    return true;
+                }
             }
+        #endif
+            return false;
+        }
+    };//DirectoryStream
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // DirectoryIterator Methods
+
+    DirectoryIterator::DirectoryIterator(DirectoryStream* ToRead) :
+        Stream(ToRead)
+        { this->Advance(); }
 
-            ::closedir(Directory);
+    void DirectoryIterator::Advance()
+    {
+        if( this->Stream == nullptr ) {
+            return;
         }
-    #endif
+        // Keep the name buffer around so short lived iterations don't reallocate it for every entry.
+        String NameBuffer = std::move(this->Current.Name);
+        this->Current = ArchiveEntry();
+        this->Current.Name = std::move(NameBuffer);
+        if( !this->Stream->ReadEntry(this->Current) ) {
+            this->Stream = nullptr;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // DirectoryRange Methods
+
+    DirectoryRange::DirectoryRange(const StringView DirectoryPath) :
+        DirectoryRange(DirectoryPath,DirectoryContentsOptions())
+        {  }
+
+    DirectoryRange::DirectoryRange(const StringView DirectoryPath, const DirectoryContentsOptions& Options) :
+        Stream( std::make_unique<DirectoryStream>(DirectoryPath,Options) )
+        {  }
+
+    DirectoryRange::DirectoryRange(DirectoryRange&& Other) noexcept = default;
+
+    DirectoryRange::~DirectoryRange() = default;
+
+    DirectoryRange& DirectoryRange::operator=(DirectoryRange&& Other) noexcept = default;
+
+    Boole DirectoryRange::IsOpen() const noexcept
+        { return ( this->Stream && this->Stream->IsOpen() ); }
+
+    DirectoryIterator DirectoryRange::begin()
+    {
+        if( this->IsOpen() ) {
+            return DirectoryIterator( this->Stream.get() );
+        }
+        return DirectoryIterator();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Directory Contents
+
+    StringVector GetDirectoryContentNames(const StringView DirectoryPath)
+    {
+        return GetDirectoryContentNames(DirectoryPath,DefaultDirectoryBatchSize);
+    }
+
+    StringVector GetDirectoryContentNames(const StringView DirectoryPath, const size_t BatchSize)
+    {
+        DirectoryContentsOptions Options;
+        Options.BatchSize = BatchSize;
+        Options.Metadata = EntryMetadata::None;
+
+        StringVector Ret;
+        for( const ArchiveEntry& Entry : DirectoryRange(DirectoryPath,Options) )
+            { Ret.push_back(Entry.Name); }
         return Ret;
     }
 
-    ArchiveEntryVector GetDirectoryContents(const StringView DirectoryPath)
+    size_t GetDirectoryContentNames(const StringView DirectoryPath, StringArena& Arena, StringViewVector& Names)
     {
-        ArchiveEntryVector Ret;
-    #ifdef MEZZ_Windows
-        WIN32_FIND_DATAW FileData;
-        HANDLE FileHandle = INVALID_HANDLE_VALUE;
+        DirectoryContentsOptions Options;
+        Options.Metadata = EntryMetadata::None;
 
-        WideString ConvertedPath = PreparePathForWindows(DirectoryPath);
-        FileHandle = ::FindFirstFileW( ConvertedPath.data(), &FileData );
-        if( FileHandle == INVALID_HANDLE_VALUE ) {
-            return Ret;
-        }
+        const size_t StartCount = Names.size();
+        for( const ArchiveEntry& Entry : DirectoryRange(DirectoryPath,Options) )
+            { Names.push_back( Arena.Store(Entry.Name) ); }
+        return Names.size() - StartCount;
+    }
 
-        do{
-            ArchiveEntry NewEntry;
-            NewEntry.Name = ConvertToNarrowString( FileData.cFileName );
-            if( IsDotSegment(NewEntry.Name) ) {
-                continue;
-            }
+    ArchiveEntryVector GetDirectoryContents(const StringView DirectoryPath)
+    {
+        return GetDirectoryContents(DirectoryPath,DefaultDirectoryBatchSize);
+    }
 
-            NewEntry.Archive = ArchiveType::FileSystem;
-            TransposeEntry(FileData,NewEntry);
-            Ret.push_back(NewEntry);
-        }while( ::FindNextFileW( FileHandle, &FileData ) );
+    ArchiveEntryVector GetDirectoryContents(const StringView DirectoryPath, const size_t BatchSize)
+    {
+        DirectoryContentsOptions Options;
+        Options.BatchSize = BatchSize;
+        return GetDirectoryContents(DirectoryPath,Options);
+    }
 
-        ::FindClose(FileHandle);
-    #else
-        struct dirent* DirEntry;
-        DIR* Directory = ::opendir( DirectoryPath.data() );
-        if( Directory ) {
-            struct stat FileStat;
-            while( ( DirEntry = ::readdir(Directory) ) )
-            {
-                String FullPath(DirectoryPath.data(),DirectoryPath.size());
-                if( !IsDirectorySeparator_Posix( FullPath.back() ) ) {
-                    FullPath.push_back( GetDirectorySeparator_Posix() );
-                }
-                FullPath.append(DirEntry->d_name);
+    ArchiveEntryVector GetDirectoryContents(const StringView DirectoryPath, const DirectoryContentsOptions& Options)
+    {
+        ArchiveEntryVector Ret;
+        for( const ArchiveEntry& Entry : DirectoryRange(DirectoryPath,Options) )
+            { Ret.push_back(Entry); }
+        return Ret;
+    }
 
-                if( ::stat(FullPath.data(),&FileStat) == -1 ) {
-                    continue;
-                }
+    ///////////////////////////////////////////////////////////////////////////////
+    // Path Metadata
 
-                ArchiveEntry NewEntry;
-                NewEntry.Name = DirEntry->d_name;
-                if( IsDotSegment(NewEntry.Name) ) {
-                    continue;
-                }
+    Optional<ArchiveEntry> StatPath(const StringView Path)
+    {
+        return StatPath(Path,EntryMetadata::All,true);
+    }
 
-                NewEntry.Archive = ArchiveType::FileSystem;
-                TransposeEntry(FileStat,NewEntry);
-                Ret.push_back(NewEntry);
+    Optional<ArchiveEntry> StatPath(const StringView Path, const EntryMetadata Metadata, const Boole FollowSymlinks)
+    {
+        if( Path.empty() ) {
+            return Optional<ArchiveEntry>();
+        }
+        ArchiveEntry Ret;
+        // Only trailing separators the host treats as separators are trimmed, on Posix '\\' is part of the name.
+        StringView NamePath = Path;
+    #ifdef MEZZ_Windows
+        while( NamePath.size() > 1 && IsDirectorySeparator(NamePath.back()) )
+            { NamePath.remove_suffix(1); }
+        Ret.Name = GetBaseName(NamePath);
+    #else
+        while( NamePath.size() > 1 && IsDirectorySeparator_Posix(NamePath.back()) )
+            { NamePath.remove_suffix(1); }
+        const size_t NameStart = NamePath.find_last_of( GetDirectorySeparator_Posix() );
+        Ret.Name = String( NameStart == StringView::npos ? NamePath : NamePath.substr(NameStart + 1) );
+    #endif
+        Ret.Archive = ArchiveType::FileSystem;
+    #ifdef MEZZ_Windows
+        static_cast<void>(Metadata);
+        const WideString WidePath = ConvertToWideString(Path);
+        // Reuse the find data layout so entries are transposed the same way they are in directory listings.
+        WIN32_FIND_DATAW FileData = {};
+        if( FollowSymlinks ) {
+            HANDLE PathHandle = ::CreateFileW(WidePath.c_str(),FILE_READ_ATTRIBUTES,
+                                              FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,nullptr,
+                                              OPEN_EXISTING,FILE_FLAG_BACKUP_SEMANTICS,nullptr);
+            if( PathHandle == INVALID_HANDLE_VALUE ) {
+                return Optional<ArchiveEntry>();
             }
-
-            ::closedir(Directory);
+            BY_HANDLE_FILE_INFORMATION HandleInfo;
+            const BOOL InfoResult = ::GetFileInformationByHandle(PathHandle,&HandleInfo);
+            ::CloseHandle(PathHandle);
+            if( InfoResult == 0 ) {
+                return Optional<ArchiveEntry>();
+            }
+            FileData.dwFileAttributes = HandleInfo.dwFileAttributes & ~FILE_ATTRIBUTE_REPARSE_POINT;
+            FileData.ftCreationTime = HandleInfo.ftCreationTime;
+            FileData.ftLastAccessTime = HandleInfo.ftLastAccessTime;
+            FileData.ftLastWriteTime = HandleInfo.ftLastWriteTime;
+            FileData.nFileSizeHigh = HandleInfo.nFileSizeHigh;
+            FileData.nFileSizeLow = HandleInfo.nFileSizeLow;
+        }else{
+            WIN32_FILE_ATTRIBUTE_DATA Attributes;
+            if( ::GetFileAttributesExW(WidePath.c_str(),GetFileExInfoStandard,&Attributes) == 0 ) {
+                return Optional<ArchiveEntry>();
+            }
+            FileData.dwFileAttributes = Attributes.dwFileAttributes;
+            FileData.ftCreationTime = Attributes.ftCreationTime;
+            FileData.ftLastAccessTime = Attributes.ftLastAccessTime;
+            FileData.ftLastWriteTime = Attributes.ftLastWriteTime;
+            FileData.nFileSizeHigh = Attributes.nFileSizeHigh;
+            FileData.nFileSizeLow = Attributes.nFileSizeLow;
+        }
+        TransposeEntry(FileData,Ret);
+    #else
+        const String TerminatedPath(Path);
+        if( !StatEntryAt(AT_FDCWD,TerminatedPath.c_str(),Metadata,FollowSymlinks,Ret) ) {
+            return Optional<ArchiveEntry>();
         }
     #endif
-        return Ret;
+        return Optional<ArchiveEntry>( std::move(Ret) );
     }
 }//Filesystem
 }//Mezzanine
@@ -0,0 +1,128 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_DirectoryIdentity_h
+#define Mezz_Filesystem_DirectoryIdentity_h
+
+/// @file
+/// @brief Internal utilities for telling whether two paths refer to the same directory.
+
+#include "DataTypes.h"
+
+#include <functional>
+
+#ifdef MEZZ_Windows
+    #include <Windows.h>
+#else
+    #include <sys/stat.h>
+    #include <sys/types.h>
+#endif
+
+namespace Mezzanine {
+namespace Filesystem {
+    /// @brief The pair of values that uniquely identify a directory on a system.
+    struct DirectoryIdentity
+    {
+        /// @brief The device (or volume on Windows) the directory is on.
+        UInt64 Device = 0;
+        /// @brief The inode (or file index on Windows) of the directory on its device.
+        UInt64 Node = 0;
+
+        /// @brief Equality comparison operator.
+        /// @param Other The other identity to compare to.
+        /// @return Returns true if both identities refer to the same directory.
+        [[nodiscard]]
+        Boole operator==(const DirectoryIdentity& Other) const noexcept
+            { return ( this->Device == Other.Device && this->Node == Other.Node ); }
+    };//DirectoryIdentity
+
+    /// @brief A hasher so DirectoryIdentity can be stored in unordered containers.
+    struct DirectoryIdentityHash
+    {
+        /// @brief Function call operator.
+        /// @param ToHash The identity to be hashed.
+        /// @return Returns a hash combining the device and node of the identity.
+        [[nodiscard]]
+        size_t operator()(const DirectoryIdentity& ToHash) const noexcept
+        {
+            const std::hash<UInt64> Hasher;
+            return Hasher(ToHash.Node) ^ ( Hasher(ToHash.Device) * 0x9E3779B97F4A7C15ull );
+        }
+    };//DirectoryIdentityHash
+
+    /// @brief Gets the values that uniquely identify a directory.
+    /// @param DirectoryPath The null terminated path of the directory to identify. Symlinks are followed.
+    /// @param Identity The identity to populate.
+    /// @return Returns true if the directory was identified, false otherwise.
+    inline Boole GetDirectoryIdentity(const StringView DirectoryPath, DirectoryIdentity& Identity)
+    {
+    #ifdef MEZZ_Windows
+        const int NarrowSize = static_cast<int>( DirectoryPath.size() );
+        std::wstring WidePath( static_cast<size_t>( ::MultiByteToWideChar(CP_UTF8,0,DirectoryPath.data(),
+                                                                          NarrowSize,nullptr,0) ), L'\0' );
+        ::MultiByteToWideChar(CP_UTF8,0,DirectoryPath.data(),NarrowSize,&WidePath[0],
+                              static_cast<int>( WidePath.size() ));
+        const DWORD ShareMode = FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE;
+        HANDLE DirHandle = ::CreateFileW(WidePath.c_str(),0,ShareMode,nullptr,OPEN_EXISTING,
+                                         FILE_FLAG_BACKUP_SEMANTICS,nullptr);
+        if( DirHandle == INVALID_HANDLE_VALUE ) {
+            return false;
+        }
+        BY_HANDLE_FILE_INFORMATION DirInfo;
+        Boole Result = ( ::GetFileInformationByHandle(DirHandle,&DirInfo) != 0 );
+        ::CloseHandle(DirHandle);
+        if( Result ) {
+            Identity.Device = DirInfo.dwVolumeSerialNumber;
+            Identity.Node = ( static_cast<UInt64>(DirInfo.nFileIndexHigh) << 32 ) | DirInfo.nFileIndexLow;
+        }
+        return Result;
+    #else
+        struct stat DirStat;
+        if( ::stat(DirectoryPath.data(),&DirStat) == -1 ) {
+            return false;
+        }
+        Identity.Device = static_cast<UInt64>(DirStat.st_dev);
+        Identity.Node = static_cast<UInt64>(DirStat.st_ino);
+        return true;
+    #endif
+    }
+}//Filesystem
+}//Mezzanine
+
+#endif
@@ -0,0 +1,135 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#include "CrossPlatformExport.h"
+
+#include "DirectorySnapshot.h"
+
+namespace Mezzanine {
+namespace Filesystem {
+    ///////////////////////////////////////////////////////////////////////////////
+    // DirectorySnapshot Methods
+
+    DirectorySnapshot::DirectorySnapshot(const ArchiveEntryVector& Entries)
+    {
+        size_t NameBytes = 0;
+        for( const ArchiveEntry& Entry : Entries )
+            { NameBytes += Entry.Name.size(); }
+        this->Reserve(Entries.size(),NameBytes);
+        for( const ArchiveEntry& Entry : Entries )
+            { this->Append(Entry); }
+    }
+
+    void DirectorySnapshot::Reserve(const size_t EntryCount, const size_t NameBytes)
+    {
+        this->Names.reserve(NameBytes + EntryCount);
+        this->NameOffsets.reserve(EntryCount + 1);
+        this->Types.reserve(EntryCount);
+        this->Sizes.reserve(EntryCount);
+        this->CreateTimes.reserve(EntryCount);
+        this->AccessTimes.reserve(EntryCount);
+        this->ModifyTimes.reserve(EntryCount);
+        this->Permissions.reserve(EntryCount);
+    }
+
+    void DirectorySnapshot::Append(const ArchiveEntry& ToAdd)
+    {
+        this->Names.append(ToAdd.Name);
+        this->Names.push_back('\0');
+        this->NameOffsets.push_back( this->Names.size() );
+        this->Types.push_back(ToAdd.Entry);
+        this->Sizes.push_back(ToAdd.Size);
+        this->CreateTimes.push_back(ToAdd.CreateTime);
+        this->AccessTimes.push_back(ToAdd.AccessTime);
+        this->ModifyTimes.push_back(ToAdd.ModifyTime);
+        this->Permissions.push_back(ToAdd.Permissions);
+    }
+
+    void DirectorySnapshot::Clear() noexcept
+    {
+        this->Names.clear();
+        this->NameOffsets.resize(1);
+        this->Types.clear();
+        this->Sizes.clear();
+        this->CreateTimes.clear();
+        this->AccessTimes.clear();
+        this->ModifyTimes.clear();
+        this->Permissions.clear();
+    }
+
+    ArchiveEntry DirectorySnapshot::GetEntry(const size_t Index) const
+    {
+        ArchiveEntry Ret;
+        Ret.Name = String( this->GetName(Index) );
+        Ret.Archive = ArchiveType::FileSystem;
+        Ret.Entry = this->Types[Index];
+        Ret.Size = this->Sizes[Index];
+        Ret.CreateTime = this->CreateTimes[Index];
+        Ret.AccessTime = this->AccessTimes[Index];
+        Ret.ModifyTime = this->ModifyTimes[Index];
+        Ret.Permissions = this->Permissions[Index];
+        return Ret;
+    }
+
+    ArchiveEntryVector DirectorySnapshot::ToArchiveEntries() const
+    {
+        ArchiveEntryVector Ret;
+        Ret.reserve( this->size() );
+        for( size_t Index = 0 ; Index < this->size() ; ++Index )
+            { Ret.push_back( this->GetEntry(Index) ); }
+        return Ret;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Directory Snapshots
+
+    DirectorySnapshot GetDirectorySnapshot(const StringView DirectoryPath)
+    {
+        return GetDirectorySnapshot(DirectoryPath,DirectoryContentsOptions());
+    }
+
+    DirectorySnapshot GetDirectorySnapshot(const StringView DirectoryPath, const DirectoryContentsOptions& Options)
+    {
+        DirectorySnapshot Ret;
+        for( const ArchiveEntry& Entry : DirectoryRange(DirectoryPath,Options) )
+            { Ret.Append(Entry); }
+        return Ret;
+    }
+}//Filesystem
+}//Mezzanine
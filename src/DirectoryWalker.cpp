@@ -0,0 +1,223 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#include "CrossPlatformExport.h"
+
+#ifdef MEZZ_Windows
+    // We want Windows Vista APIs and up.
+    #define _WIN32_WINNT 0x0601
+#endif
+
+#include "DirectoryWalker.h"
+#include "PathUtilities.h"
+
+#include <unordered_set>
+
+#ifdef MEZZ_Windows
+    #define WIN32_LEAN_AND_MEAN
+
+    #include <Windows.h>
+#endif
+
+#include "DirectoryIdentity.h"
+#include "WorkStealingPool.h"
+
+#include "PlatformUndefs.h"
+
+namespace
+{
+    using namespace Mezzanine;
+    using namespace Mezzanine::Filesystem;
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// @brief The state shared by every task participating in a single directory walk.
+    ///////////////////////////////////////
+    class TreeWalk
+    {
+    protected:
+        /// @brief The options the tree is being walked with.
+        const DirectoryWalkOptions& Options;
+        /// @brief The callback to invoke for every entry.
+        const DirectoryWalkVisitor& Visitor;
+        /// @brief The options used to read the contents of each directory.
+        DirectoryContentsOptions ListOptions;
+        /// @brief The pool running the tasks for each directory.
+        WorkStealingPool Pool;
+        /// @brief The tasks for each directory in the walk.
+        TaskGroup DirectoryTasks;
+        /// @brief The lock guarding the set of walked directories.
+        std::mutex WalkedLock;
+        /// @brief The directories that have been walked. Only populated when following Symlinks.
+        std::unordered_set<DirectoryIdentity,DirectoryIdentityHash> WalkedDirectories;
+        /// @brief The number of entries passed to the visitor.
+        std::atomic<Whole> EntriesVisited{0};
+        /// @brief The number of directories whose contents were read.
+        std::atomic<Whole> DirectoriesWalked{0};
+        /// @brief The number of directories that couldn't be opened.
+        std::atomic<Whole> DirectoriesFailed{0};
+        /// @brief The number of directories skipped because they had already been walked.
+        std::atomic<Whole> LoopsSkipped{0};
+        /// @brief Set when the walk should end as soon as possible.
+        std::atomic<Boole> Stopped{false};
+
+        /// @brief Records that a directory is being walked.
+        /// @param DirectoryPath The directory about to be walked.
+        /// @return Returns false if the directory has already been walked, true otherwise.
+        Boole MarkWalked(const String& DirectoryPath)
+        {
+            DirectoryIdentity Identity;
+            if( !GetDirectoryIdentity(DirectoryPath,Identity) ) {
+                // If it can't be identified it likely can't be opened either, let the open report the failure.
+                return true;
+            }
+            std::lock_guard<std::mutex> Lock(this->WalkedLock);
+            return this->WalkedDirectories.insert(Identity).second;
+        }
+        /// @brief Visits every entry in a single directory and queues a task for each subdirectory.
+        /// @param DirectoryPath The directory to walk, ending with a separator.
+        /// @param Depth The depth of the entries in the directory.
+        void WalkDirectory(const String& DirectoryPath, const Whole Depth)
+        {
+            if( this->Stopped.load(std::memory_order_relaxed) ) {
+                return;
+            }
+            if( this->Options.Symlinks == SymlinkPolicy::Follow && !this->MarkWalked(DirectoryPath) ) {
+                this->LoopsSkipped.fetch_add(1,std::memory_order_relaxed);
+                return;
+            }
+            DirectoryRange Contents(DirectoryPath,this->ListOptions);
+            if( !Contents.IsOpen() ) {
+                this->DirectoriesFailed.fetch_add(1,std::memory_order_relaxed);
+                return;
+            }
+            this->DirectoriesWalked.fetch_add(1,std::memory_order_relaxed);
+
+            Whole Visited = 0;
+            try{
+                for( const ArchiveEntry& Entry : Contents )
+                {
+                    if( this->Stopped.load(std::memory_order_relaxed) ) {
+                        break;
+                    }
+                    ++Visited;
+                    const WalkAction Action = this->Visitor(DirectoryPath,Entry,Depth);
+                    if( Action == WalkAction::Stop ) {
+                        this->Stopped.store(true,std::memory_order_relaxed);
+                        break;
+                    }
+                    if( Action == WalkAction::Continue && Entry.Entry == EntryType::Directory &&
+                        Depth < this->Options.MaxDepth )
+                    {
+                        String SubdirectoryPath;
+                        SubdirectoryPath.reserve( DirectoryPath.size() + Entry.Name.size() + 1 );
+                        SubdirectoryPath.append(DirectoryPath).append(Entry.Name);
+                        SubdirectoryPath.append( 1, GetDirectorySeparator_Host() );
+                        this->DirectoryTasks.Run([this,Path = std::move(SubdirectoryPath),Depth](){
+                            this->WalkDirectory(Path,Depth + 1);
+                        });
+                    }
+                }
+            }catch(...){
+                this->Stopped.store(true,std::memory_order_relaxed);
+                this->EntriesVisited.fetch_add(Visited,std::memory_order_relaxed);
+                throw;
+            }
+            this->EntriesVisited.fetch_add(Visited,std::memory_order_relaxed);
+        }
+    public:
+        /// @brief Options constructor.
+        /// @param ToUse The options to walk the tree with.
+        /// @param ToVisit The callback to invoke for every entry.
+        /// @param ThreadCount The total number of threads to walk with, including the calling thread.
+        TreeWalk(const DirectoryWalkOptions& ToUse, const DirectoryWalkVisitor& ToVisit, const size_t ThreadCount) :
+            Options(ToUse),
+            Visitor(ToVisit),
+            Pool(ThreadCount - 1),
+            DirectoryTasks(Pool)
+        {
+            this->ListOptions.BatchSize = ToUse.BatchSize;
+            this->ListOptions.Metadata = ToUse.Metadata | EntryMetadata::Type;
+            this->ListOptions.FollowSymlinks = ( ToUse.Symlinks == SymlinkPolicy::Follow );
+        }
+
+        /// @brief Walks the tree, blocking until every task has completed.
+        /// @param RootPath The directory to start walking from.
+        /// @return Returns a summary of the entries and directories encountered.
+        DirectoryWalkResult Run(const StringView RootPath)
+        {
+            String RootDirectory(RootPath);
+            if( !RootDirectory.empty() && !IsDirectorySeparator_Host( RootDirectory.back() ) ) {
+                RootDirectory.append( 1, GetDirectorySeparator_Host() );
+            }
+            this->DirectoryTasks.Run([this,&RootDirectory](){ this->WalkDirectory(RootDirectory,0); });
+            this->DirectoryTasks.Wait();
+
+            DirectoryWalkResult Ret;
+            Ret.EntriesVisited = this->EntriesVisited.load();
+            Ret.DirectoriesWalked = this->DirectoriesWalked.load();
+            Ret.DirectoriesFailed = this->DirectoriesFailed.load();
+            Ret.LoopsSkipped = this->LoopsSkipped.load();
+            Ret.Stopped = this->Stopped.load();
+            return Ret;
+        }
+    };//TreeWalk
+}
+
+namespace Mezzanine {
+namespace Filesystem {
+    ///////////////////////////////////////////////////////////////////////////////
+    // Directory Walking
+
+    DirectoryWalkResult WalkDirectoryTree(const StringView RootPath, const DirectoryWalkVisitor& Visitor)
+    {
+        return WalkDirectoryTree(RootPath,Visitor,DirectoryWalkOptions());
+    }
+
+    DirectoryWalkResult WalkDirectoryTree(const StringView RootPath, const DirectoryWalkVisitor& Visitor,
+                                          const DirectoryWalkOptions& Options)
+    {
+        size_t ThreadCount = Options.ThreadCount;
+        if( ThreadCount == 0 ) {
+            ThreadCount = std::max<size_t>(std::thread::hardware_concurrency(),1);
+        }
+        TreeWalk Walk(Options,Visitor,ThreadCount);
+        return Walk.Run(RootPath);
+    }
+}//Filesystem
+}//Mezzanine
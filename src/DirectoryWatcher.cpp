@@ -0,0 +1,412 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#include "CrossPlatformExport.h"
+
+#include "DirectoryWatcher.h"
+#include "DirectoryContents.h"
+
+#include <algorithm>
+#include <cerrno>
+
+#if defined(MEZZ_Linux) && !defined(MEZZ_CompilerIsEmscripten)
+    #include <poll.h>
+    #include <sys/eventfd.h>
+    #include <sys/inotify.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #include <climits>
+    #define MEZZ_DirectoryWatcherInotify
+#endif
+
+#include "PlatformUndefs.h"
+
+namespace
+{
+    using namespace Mezzanine;
+
+#ifdef MEZZ_DirectoryWatcherInotify
+    /// @brief Every change to a directory or its entries that is reported.
+    constexpr UInt32 WatchMask = IN_ATTRIB | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_DELETE_SELF | IN_MODIFY |
+                                 IN_MOVE_SELF | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR | IN_EXCL_UNLINK;
+
+    /// @brief Gets the modification time of a directory.
+    /// @param DirectoryPath The path of the directory.
+    /// @return Returns the time the directory was last modified in nanoseconds, or 0 if it couldn't be stat'd.
+    [[nodiscard]]
+    UInt64 GetModifyTimeNanoseconds(const String& DirectoryPath) noexcept
+    {
+        struct stat DirStat;
+        if( ::stat(DirectoryPath.c_str(),&DirStat) != 0 ) {
+            return 0;
+        }
+        return ( static_cast<UInt64>(DirStat.st_mtim.tv_sec) * 1000000000 ) +
+               static_cast<UInt64>(DirStat.st_mtim.tv_nsec);
+    }
+    /// @brief Lists the name and type of every entry in a directory.
+    /// @param DirectoryPath The path of the directory.
+    /// @return Returns the name of every entry, and whether or not each is a directory.
+    [[nodiscard]]
+    std::unordered_map<String,Boole> ListEntries(const String& DirectoryPath)
+    {
+        Filesystem::DirectoryContentsOptions TypeOnly;
+        TypeOnly.Metadata = Filesystem::EntryMetadata::Type;
+        // Don't follow Symlinks, or a link to a directory could have us watching outside the tree.
+        TypeOnly.FollowSymlinks = false;
+
+        std::unordered_map<String,Boole> Ret;
+        for( const ArchiveEntry& Entry : Filesystem::DirectoryRange(DirectoryPath,TypeOnly) )
+            { Ret.emplace(Entry.Name,Entry.Entry == EntryType::Directory); }
+        return Ret;
+    }
+#endif
+}
+
+namespace Mezzanine {
+namespace Filesystem {
+    ///////////////////////////////////////////////////////////////////////////////
+    // DirectoryWatcher Methods
+
+    DirectoryWatcher::DirectoryWatcher(const StringView DirectoryPath, WatchCallback OnChange) :
+        DirectoryWatcher(DirectoryPath,std::move(OnChange),DirectoryWatcherOptions())
+        {  }
+
+    DirectoryWatcher::DirectoryWatcher(const StringView DirectoryPath, WatchCallback OnChange,
+                                       const DirectoryWatcherOptions& ToUse) :
+        RootPath(DirectoryPath),
+        Callback(std::move(OnChange)),
+        Options(ToUse)
+    {
+        while( this->RootPath.size() > 1 && this->RootPath.back() == '/' )
+            { this->RootPath.pop_back(); }
+    #ifdef MEZZ_DirectoryWatcherInotify
+        this->EventHandle = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        this->WakeHandle = ::eventfd(0,EFD_NONBLOCK | EFD_CLOEXEC);
+        if( this->EventHandle == -1 || this->WakeHandle == -1 ) {
+            return;
+        }
+        this->AddWatch(this->RootPath,false);
+        if( !this->Watches.empty() ) {
+            this->WatchThread = std::thread(&DirectoryWatcher::RunWatcher,this);
+        }
+    #endif
+    }
+
+    DirectoryWatcher::~DirectoryWatcher()
+    {
+    #ifdef MEZZ_DirectoryWatcherInotify
+        if( this->WatchThread.joinable() ) {
+            const UInt64 Wake = 1;
+            static_cast<void>( ::write(this->WakeHandle,&Wake,sizeof(Wake)) );
+            this->WatchThread.join();
+        }
+        if( this->EventHandle != -1 ) {
+            ::close(this->EventHandle);
+        }
+        if( this->WakeHandle != -1 ) {
+            ::close(this->WakeHandle);
+        }
+    #endif
+    }
+
+    void DirectoryWatcher::RunWatcher()
+    {
+    #ifdef MEZZ_DirectoryWatcherInotify
+        struct pollfd Handles[2];
+        Handles[0].fd = this->EventHandle;
+        Handles[0].events = POLLIN;
+        Handles[1].fd = this->WakeHandle;
+        Handles[1].events = POLLIN;
+        while( true )
+        {
+            int Timeout = -1;
+            if( !this->Pending.empty() ) {
+                const auto Remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    this->BatchDeadline - ClockType::now() );
+                Timeout = static_cast<int>( std::max(Remaining.count(),decltype(Remaining.count())(0)) );
+            }
+            const int Ready = ::poll(Handles,2,Timeout);
+            if( Ready < 0 && errno != EINTR ) {
+                break;
+            }
+            if( Handles[1].revents != 0 ) {
+                break;
+            }
+            if( Handles[0].revents != 0 ) {
+                this->ReadEvents();
+            }
+            if( !this->Pending.empty() && ClockType::now() >= this->BatchDeadline ) {
+                this->DeliverBatch();
+            }
+        }
+    #endif
+    }
+
+    void DirectoryWatcher::AddWatch(const String& DirectoryPath, const Boole ReportContents)
+    {
+    #ifdef MEZZ_DirectoryWatcherInotify
+        // Start watching before listing, so nothing created in between can be missed.
+        const int Watch = ::inotify_add_watch(this->EventHandle,DirectoryPath.c_str(),WatchMask);
+        if( Watch == -1 ) {
+            return;
+        }
+        WatchedDirectory& Watched = this->Watches[Watch];
+        Watched.Path = DirectoryPath;
+        Watched.ListedTime = GetModifyTimeNanoseconds(DirectoryPath);
+        Watched.Entries = ListEntries(DirectoryPath);
+        Watched.Changed = false;
+        this->WatchCount.store(this->Watches.size(),std::memory_order_relaxed);
+
+        // Copied, since watching subdirectories can rehash the watches.
+        const std::unordered_map<String,Boole> Entries = Watched.Entries;
+        for( const auto& Entry : Entries )
+        {
+            const String EntryPath = DirectoryPath + "/" + Entry.first;
+            if( ReportContents ) {
+                this->QueueEvent(EntryPath,WatchEventType::Created,Entry.second);
+            }
+            if( Entry.second && this->Options.Recursive ) {
+                this->AddWatch(EntryPath,ReportContents);
+            }
+        }
+    #else
+        static_cast<void>(DirectoryPath);
+        static_cast<void>(ReportContents);
+    #endif
+    }
+
+    void DirectoryWatcher::RemoveWatches(const String& DirectoryPath)
+    {
+    #ifdef MEZZ_DirectoryWatcherInotify
+        auto WatchIt = this->Watches.begin();
+        while( WatchIt != this->Watches.end() )
+        {
+            const String& WatchedPath = WatchIt->second.Path;
+            const Boole InTree = WatchedPath.compare(0,DirectoryPath.size(),DirectoryPath) == 0 &&
+                                 ( WatchedPath.size() == DirectoryPath.size() ||
+                                   WatchedPath[DirectoryPath.size()] == '/' );
+            if( InTree ) {
+                static_cast<void>( ::inotify_rm_watch(this->EventHandle,WatchIt->first) );
+                WatchIt = this->Watches.erase(WatchIt);
+            }else{
+                ++WatchIt;
+            }
+        }
+        this->WatchCount.store(this->Watches.size(),std::memory_order_relaxed);
+    #else
+        static_cast<void>(DirectoryPath);
+    #endif
+    }
+
+    void DirectoryWatcher::Rescan(const int Watch)
+    {
+    #ifdef MEZZ_DirectoryWatcherInotify
+        auto WatchIt = this->Watches.find(Watch);
+        if( WatchIt == this->Watches.end() ) {
+            return;
+        }
+        const String DirectoryPath = WatchIt->second.Path;
+        const UInt64 ModifyTime = GetModifyTimeNanoseconds(DirectoryPath);
+        if( !WatchIt->second.Changed && ModifyTime == WatchIt->second.ListedTime ) {
+            return;
+        }
+
+        std::unordered_map<String,Boole> OldEntries = std::move(WatchIt->second.Entries);
+        WatchIt->second.Entries = ListEntries(DirectoryPath);
+        WatchIt->second.ListedTime = ModifyTime;
+        WatchIt->second.Changed = false;
+        const std::unordered_map<String,Boole> NewEntries = WatchIt->second.Entries;
+
+        for( const auto& OldEntry : OldEntries )
+        {
+            if( NewEntries.count(OldEntry.first) == 0 ) {
+                const String EntryPath = DirectoryPath + "/" + OldEntry.first;
+                this->QueueEvent(EntryPath,WatchEventType::Removed,OldEntry.second);
+                if( OldEntry.second && this->Options.Recursive ) {
+                    this->RemoveWatches(EntryPath);
+                }
+            }
+        }
+        for( const auto& NewEntry : NewEntries )
+        {
+            if( OldEntries.count(NewEntry.first) == 0 ) {
+                const String EntryPath = DirectoryPath + "/" + NewEntry.first;
+                this->QueueEvent(EntryPath,WatchEventType::Created,NewEntry.second);
+                if( NewEntry.second && this->Options.Recursive ) {
+                    this->AddWatch(EntryPath,true);
+                }
+            }
+        }
+    #else
+        static_cast<void>(Watch);
+    #endif
+    }
+
+    void DirectoryWatcher::RescanChanged()
+    {
+        std::vector<int> ToRescan;
+        ToRescan.reserve( this->Watches.size() );
+        for( const auto& Watched : this->Watches )
+            { ToRescan.push_back(Watched.first); }
+        for( const int Watch : ToRescan )
+            { this->Rescan(Watch); }
+    }
+
+    void DirectoryWatcher::ReadEvents()
+    {
+    #ifdef MEZZ_DirectoryWatcherInotify
+        alignas(struct inotify_event) char EventBuffer[16 * ( sizeof(struct inotify_event) + NAME_MAX + 1 )];
+        Boole Overflowed = false;
+        ssize_t BytesRead = 0;
+        while( ( BytesRead = ::read(this->EventHandle,EventBuffer,sizeof(EventBuffer)) ) > 0 )
+        {
+            const char* CurrEvent = EventBuffer;
+            const char* BufferEnd = EventBuffer + BytesRead;
+            while( CurrEvent < BufferEnd )
+            {
+                const struct inotify_event* Event = reinterpret_cast<const struct inotify_event*>(CurrEvent);
+                CurrEvent += sizeof(struct inotify_event) + Event->len;
+
+                if( Event->mask & IN_Q_OVERFLOW ) {
+                    Overflowed = true;
+                    continue;
+                }
+                auto WatchIt = this->Watches.find(Event->wd);
+                if( WatchIt == this->Watches.end() ) {
+                    continue;
+                }
+                if( Event->len == 0 ) {
+                    // The watched directory itself was removed or moved away.
+                    if( Event->mask & IN_IGNORED ) {
+                        this->Watches.erase(WatchIt);
+                        this->WatchCount.store(this->Watches.size(),std::memory_order_relaxed);
+                    }else if( Event->mask & IN_MOVE_SELF ) {
+                        static_cast<void>( ::inotify_rm_watch(this->EventHandle,Event->wd) );
+                    }
+                    continue;
+                }
+
+                WatchedDirectory& Watched = WatchIt->second;
+                const String EntryPath = Watched.Path + "/" + Event->name;
+                const Boole IsDirectory = ( Event->mask & IN_ISDIR ) != 0;
+                if( Event->mask & ( IN_CREATE | IN_MOVED_TO ) ) {
+                    Watched.Entries[Event->name] = IsDirectory;
+                    Watched.Changed = true;
+                    this->QueueEvent(EntryPath,WatchEventType::Created,IsDirectory);
+                    if( IsDirectory && this->Options.Recursive ) {
+                        // Anything created in the directory before the watch started needs to be reported too.
+                        this->AddWatch(EntryPath,true);
+                    }
+                }else if( Event->mask & ( IN_DELETE | IN_MOVED_FROM ) ) {
+                    Watched.Entries.erase(Event->name);
+                    Watched.Changed = true;
+                    this->QueueEvent(EntryPath,WatchEventType::Removed,IsDirectory);
+                    if( IsDirectory && this->Options.Recursive ) {
+                        this->RemoveWatches(EntryPath);
+                    }
+                }else{
+                    this->QueueEvent(EntryPath,WatchEventType::Modified,IsDirectory);
+                }
+            }
+        }
+        if( Overflowed ) {
+            this->OverflowCount.fetch_add(1,std::memory_order_relaxed);
+            if( !this->OverflowPending ) {
+                this->QueueEvent(this->RootPath,WatchEventType::Overflow,true);
+            }
+            this->RescanChanged();
+        }
+    #endif
+    }
+
+    void DirectoryWatcher::QueueEvent(const String& Path, const WatchEventType Type, const Boole IsDirectory)
+    {
+        if( this->Pending.empty() ) {
+            this->BatchDeadline = ClockType::now() + std::chrono::milliseconds(this->Options.CoalesceInterval);
+        }
+        if( Type == WatchEventType::Overflow ) {
+            this->OverflowPending = true;
+            this->Pending.push_back( { Path, Type, IsDirectory } );
+            return;
+        }
+
+        auto Existing = this->PendingIndex.find(Path);
+        if( Existing == this->PendingIndex.end() ) {
+            this->PendingIndex.emplace(Path,this->Pending.size());
+            this->Pending.push_back( { Path, Type, IsDirectory } );
+            return;
+        }
+
+        WatchEvent& Coalesced = this->Pending[Existing->second];
+        Coalesced.IsDirectory = IsDirectory;
+        switch( Coalesced.Type )
+        {
+            case WatchEventType::Created:
+                if( Type == WatchEventType::Removed ) {
+                    // It came and went within the batch, so as far as anyone can tell nothing happened.
+                    Coalesced.Path.clear();
+                    this->PendingIndex.erase(Existing);
+                }
+                break;
+            case WatchEventType::Removed:
+                Coalesced.Type = ( Type == WatchEventType::Created ? WatchEventType::Modified : Type );
+                break;
+            default:
+                if( Type == WatchEventType::Removed ) {
+                    Coalesced.Type = WatchEventType::Removed;
+                }
+                break;
+        }
+    }
+
+    void DirectoryWatcher::DeliverBatch()
+    {
+        WatchEventBatch Batch;
+        Batch.swap(this->Pending);
+        this->PendingIndex.clear();
+        this->OverflowPending = false;
+        Batch.erase(std::remove_if(Batch.begin(),Batch.end(),[](const WatchEvent& Event) {
+            return Event.Path.empty();
+        }),Batch.end());
+        if( !Batch.empty() && this->Callback ) {
+            this->Callback(Batch);
+        }
+    }
+}//Filesystem
+}//Mezzanine
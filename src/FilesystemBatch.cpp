@@ -0,0 +1,787 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#include "CrossPlatformExport.h"
+
+#include "FilesystemBatch.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#ifdef MEZZ_Windows
+    #define WIN32_LEAN_AND_MEAN
+
+    #include <Windows.h>
+#else
+    #include <sys/stat.h>
+    #include <sys/types.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #if defined(MEZZ_Linux) && !defined(MEZZ_CompilerIsEmscripten) && __has_include(<linux/io_uring.h>)
+        #include <linux/io_uring.h>
+        #include <sys/mman.h>
+        #include <sys/syscall.h>
+        #if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(__NR_io_uring_register)
+            // Many C libraries don't wrap the io_uring system calls, and liburing isn't a dependency we want.
+            #define MEZZ_FilesystemBatchIOUring
+        #endif
+    #endif
+#endif
+
+#include "SystemErrors.h"
+
+#include "PlatformUndefs.h"
+
+namespace
+{
+    using namespace Mezzanine;
+    using Filesystem::ConvertErrNo;
+
+#ifdef MEZZ_Windows
+    /// @brief Converts a narrow (8-bit) String to a wide (16-bit) String.
+    /// @param Narrow The String to be converted.
+    /// @return Returns a wide String with the converted contents.
+    [[nodiscard]]
+    std::wstring ConvertToWideString(const StringView Narrow)
+    {
+        std::wstring Ret;
+        if( !Narrow.empty() ) {
+            const int NarrowLength = static_cast<int>( Narrow.size() );
+            const int WideLength = ::MultiByteToWideChar(CP_UTF8,0,Narrow.data(),NarrowLength,nullptr,0);
+            Ret.resize(static_cast<size_t>(WideLength),L'\0');
+            ::MultiByteToWideChar(CP_UTF8,0,Narrow.data(),NarrowLength,&Ret[0],WideLength);
+        }
+        return Ret;
+    }
+    /// @brief Converts a system time type to a standard time type.
+    /// @param TimeVal the system time type to convert.
+    /// @return Returns a converted standard time value.
+    [[nodiscard]]
+    UInt64 ConvertTime(const FILETIME TimeVal) noexcept
+    {
+        LARGE_INTEGER Converter;
+        Converter.HighPart = static_cast<LONG>(TimeVal.dwHighDateTime);
+        Converter.LowPart = TimeVal.dwLowDateTime;
+        return static_cast<UInt64>(Converter.QuadPart);
+    }
+    /// @brief Gets the metadata of a file or directory with a blocking call.
+    /// @param Path The path of the file or directory.
+    /// @param Result The entry to write the metadata to.
+    /// @return Returns Success if the metadata was retrieved, or the error encountered otherwise.
+    [[nodiscard]]
+    Filesystem::ModifyResult StatSynchronously(const char* Path, ArchiveEntry& Result)
+    {
+        WIN32_FILE_ATTRIBUTE_DATA Attributes;
+        std::wstring WidePath = ConvertToWideString(Path);
+        if( ::GetFileAttributesExW(WidePath.c_str(),GetFileExInfoStandard,&Attributes) == 0 ) {
+            return ConvertErrNo( ::GetLastError() );
+        }
+        Result.CreateTime = ConvertTime(Attributes.ftCreationTime);
+        Result.AccessTime = ConvertTime(Attributes.ftLastAccessTime);
+        Result.ModifyTime = ConvertTime(Attributes.ftLastWriteTime);
+        Result.Permissions = FilePermissions::Owner_Read;
+        if( ( Attributes.dwFileAttributes & FILE_ATTRIBUTE_READONLY ) == 0 ) {
+            Result.Permissions = Result.Permissions | FilePermissions::Owner_Write;
+        }
+        if( Attributes.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY ) {
+            Result.Entry = EntryType::Directory;
+        }else{
+            Result.Entry = EntryType::File;
+            Result.Size = ( static_cast<UInt64>(Attributes.nFileSizeHigh) << 32 ) | Attributes.nFileSizeLow;
+        }
+        return Filesystem::ModifyResult::Success;
+    }
+#else // MEZZ_Windows
+    /// @brief Transposes the metadata reported by the system to a Mezzanine entry.
+    /// @param Mode The type and permissions of the file.
+    /// @param Size The size of the file in bytes.
+    /// @param CreateTime The time the file was created, or the last time its metadata changed if that isn't known.
+    /// @param AccessTime The last time the file was read.
+    /// @param ModifyTime The last time the file was written.
+    /// @param Result The entry to write the metadata to.
+    void TransposeMetadata(const mode_t Mode, const UInt64 Size, const UInt64 CreateTime, const UInt64 AccessTime,
+                           const UInt64 ModifyTime, ArchiveEntry& Result) noexcept
+    {
+        Result.CreateTime = CreateTime;
+        Result.AccessTime = AccessTime;
+        Result.ModifyTime = ModifyTime;
+        Result.Permissions = static_cast<FilePermissions>( Mode & ( S_IRWXU | S_IRWXG | S_IRWXO ) );
+        if( S_ISDIR(Mode) ) {
+            Result.Entry = EntryType::Directory;
+        }else if( S_ISREG(Mode) ) {
+            Result.Entry = EntryType::File;
+            Result.Size = Size;
+        }
+    }
+  #if defined(MEZZ_Linux) && !defined(MEZZ_CompilerIsEmscripten) && defined(STATX_BTIME)
+    /// @brief The fields requested from statx for every Stat operation.
+    constexpr unsigned StatMask = STATX_BASIC_STATS | STATX_BTIME;
+
+    /// @brief Transposes the metadata reported by statx to a Mezzanine entry.
+    /// @param Stat The metadata of the file reported by the system.
+    /// @param Result The entry to write the metadata to.
+    void TransposeMetadata(const struct statx& Stat, ArchiveEntry& Result) noexcept
+    {
+        const struct statx_timestamp& CreateTime = ( Stat.stx_mask & STATX_BTIME ? Stat.stx_btime : Stat.stx_ctime );
+        TransposeMetadata(Stat.stx_mode,Stat.stx_size,static_cast<UInt64>(CreateTime.tv_sec),
+                          static_cast<UInt64>(Stat.stx_atime.tv_sec),static_cast<UInt64>(Stat.stx_mtime.tv_sec),
+                          Result);
+    }
+  #endif
+    /// @brief Gets the metadata of a file or directory with a blocking call.
+    /// @param Path The path of the file or directory.
+    /// @param Result The entry to write the metadata to.
+    /// @return Returns Success if the metadata was retrieved, or the error encountered otherwise.
+    [[nodiscard]]
+    Filesystem::ModifyResult StatSynchronously(const char* Path, ArchiveEntry& Result)
+    {
+      #if defined(MEZZ_Linux) && !defined(MEZZ_CompilerIsEmscripten) && defined(STATX_BTIME)
+        struct statx PathStatx;
+        if( ::statx(AT_FDCWD,Path,AT_NO_AUTOMOUNT,StatMask,&PathStatx) == 0 ) {
+            TransposeMetadata(PathStatx,Result);
+            return Filesystem::ModifyResult::Success;
+        }else if( errno != ENOSYS ) {
+            return ConvertErrNo(errno);
+        }
+      #endif
+        struct stat PathStat;
+        if( ::stat(Path,&PathStat) == -1 ) {
+            return ConvertErrNo(errno);
+        }
+        TransposeMetadata(PathStat.st_mode,static_cast<UInt64>(PathStat.st_size),
+                          static_cast<UInt64>(PathStat.st_ctime),static_cast<UInt64>(PathStat.st_atime),
+                          static_cast<UInt64>(PathStat.st_mtime),Result);
+        return Filesystem::ModifyResult::Success;
+    }
+#endif // MEZZ_Windows
+
+    /// @brief Performs a single operation with a blocking call.
+    /// @param Operation The kind of operation to perform.
+    /// @param FirstPath The path the operation acts on.
+    /// @param SecondPath The second path used by the operation, if it uses one.
+    /// @param StatResult Where to write the metadata for Stat operations.
+    /// @return Returns the result of the operation.
+    [[nodiscard]]
+    Filesystem::ModifyResult PerformSynchronously(const Filesystem::BatchOperation Operation, const char* FirstPath,
+                                                  const char* SecondPath, ArchiveEntry* StatResult)
+    {
+        switch( Operation )
+        {
+            case Filesystem::BatchOperation::CreateDirectory:  return Filesystem::CreateDirectory(FirstPath);
+            case Filesystem::BatchOperation::RemoveFile:       return Filesystem::RemoveFile(FirstPath);
+            case Filesystem::BatchOperation::RemoveDirectory:  return Filesystem::RemoveDirectory(FirstPath);
+            case Filesystem::BatchOperation::Move:
+                return Filesystem::MoveFile(FirstPath,SecondPath,Filesystem::FileOverwrite::Allow);
+            case Filesystem::BatchOperation::CreateSymlink:    return Filesystem::CreateSymlink(FirstPath,SecondPath);
+            case Filesystem::BatchOperation::Stat:             return StatSynchronously(FirstPath,*StatResult);
+        }
+        return Filesystem::ModifyResult::Unknown;
+    }
+
+#ifdef MEZZ_FilesystemBatchIOUring
+    /// @brief The io_uring opcodes used by batches.
+    /// @remarks These values are part of the kernel ABI. They're spelled out here so the library still builds
+    /// against headers older than the kernels that support them, the probe decides whether they're used.
+    enum IOUringOpcode : UInt8
+    {
+        StatxOpcode = 21,
+        RenameAtOpcode = 35,
+        UnlinkAtOpcode = 36,
+        MkdirAtOpcode = 37,
+        SymlinkAtOpcode = 38
+    };//IOUringOpcode
+
+    /// @brief The most entries a batch will ask for in its submission queue.
+    constexpr unsigned MaxRingEntries = 1024;
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// @brief A minimal io_uring, set up and driven with the raw system calls.
+    /// @details The submission and completion queues are shared with the kernel through memory maps. Entries are
+    /// written to the submission queue and the tail is published with a release store, then io_uring_enter tells
+    /// the kernel about them and waits for completions. Completions are read up to the tail the kernel published,
+    /// and the head is advanced to hand those slots back.
+    ///////////////////////////////////////
+    class IOUring
+    {
+    protected:
+        /// @brief The opcodes the running kernel reports it supports.
+        Boole SupportedOpcodes[256] = {};
+        /// @brief The mapping of the submission queue ring.
+        void* SubmitRing = MAP_FAILED;
+        /// @brief The mapping of the completion queue ring, which may be the same as the submission ring.
+        void* CompleteRing = MAP_FAILED;
+        /// @brief The mapping of the submission queue entries.
+        void* EntryMap = MAP_FAILED;
+        /// @brief The size of the submission queue ring mapping.
+        size_t SubmitRingSize = 0;
+        /// @brief The size of the completion queue ring mapping.
+        size_t CompleteRingSize = 0;
+        /// @brief The size of the submission queue entries mapping.
+        size_t EntryMapSize = 0;
+        /// @brief The submission queue entries.
+        io_uring_sqe* Entries = nullptr;
+        /// @brief The completion queue entries.
+        io_uring_cqe* Completions = nullptr;
+        /// @brief The tail of the submission queue, written by us and read by the kernel.
+        unsigned* SubmitTail = nullptr;
+        /// @brief The mask for turning submission queue positions into indexes.
+        unsigned* SubmitMask = nullptr;
+        /// @brief The indirection array of the submission queue.
+        unsigned* SubmitArray = nullptr;
+        /// @brief The head of the completion queue, written by us and read by the kernel.
+        unsigned* CompleteHead = nullptr;
+        /// @brief The tail of the completion queue, written by the kernel and read by us.
+        unsigned* CompleteTail = nullptr;
+        /// @brief The mask for turning completion queue positions into indexes.
+        unsigned* CompleteMask = nullptr;
+        /// @brief The number of entries in the submission queue.
+        unsigned EntryCount = 0;
+        /// @brief The tail of the submission queue including entries not yet published to the kernel.
+        unsigned LocalTail = 0;
+        /// @brief The file descriptor of the ring.
+        int RingHandle = -1;
+
+        /// @brief Unmaps the queues and closes the ring.
+        void Release() noexcept
+        {
+            if( this->EntryMap != MAP_FAILED ) {
+                ::munmap(this->EntryMap,this->EntryMapSize);
+            }
+            if( this->CompleteRing != MAP_FAILED && this->CompleteRing != this->SubmitRing ) {
+                ::munmap(this->CompleteRing,this->CompleteRingSize);
+            }
+            if( this->SubmitRing != MAP_FAILED ) {
+                ::munmap(this->SubmitRing,this->SubmitRingSize);
+            }
+            if( this->RingHandle != -1 ) {
+                ::close(this->RingHandle);
+            }
+            this->EntryMap = this->CompleteRing = this->SubmitRing = MAP_FAILED;
+            this->RingHandle = -1;
+        }
+        /// @brief Asks the kernel which opcodes it supports.
+        /// @remarks Kernels before 5.6 can't be probed, but they also don't support any of the opcodes we use.
+        void Probe()
+        {
+            const size_t ProbeSize = sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op);
+            std::vector<UInt64> ProbeBuffer( ( ProbeSize + sizeof(UInt64) - 1 ) / sizeof(UInt64), 0 );
+            io_uring_probe* KernelProbe = reinterpret_cast<io_uring_probe*>( ProbeBuffer.data() );
+            if( ::syscall(__NR_io_uring_register,this->RingHandle,IORING_REGISTER_PROBE,KernelProbe,256) < 0 ) {
+                return;
+            }
+            for( unsigned OpIndex = 0 ; OpIndex < KernelProbe->ops_len ; ++OpIndex )
+            {
+                if( KernelProbe->ops[OpIndex].flags & IO_URING_OP_SUPPORTED ) {
+                    this->SupportedOpcodes[ KernelProbe->ops[OpIndex].op ] = true;
+                }
+            }
+        }
+    public:
+        /// @brief Size constructor.
+        /// @param RequestedEntries The number of entries wanted in the submission queue.
+        explicit IOUring(const unsigned RequestedEntries)
+        {
+            io_uring_params Params;
+            std::memset(&Params,0,sizeof(Params));
+            this->RingHandle = static_cast<int>( ::syscall(__NR_io_uring_setup,RequestedEntries,&Params) );
+            if( this->RingHandle < 0 ) {
+                // Unsupported, or disabled by seccomp or the io_uring_disabled sysctl.
+                this->RingHandle = -1;
+                return;
+            }
+
+            this->SubmitRingSize = Params.sq_off.array + Params.sq_entries * sizeof(unsigned);
+            this->CompleteRingSize = Params.cq_off.cqes + Params.cq_entries * sizeof(io_uring_cqe);
+            const Boole SingleMap = ( Params.features & IORING_FEAT_SINGLE_MMAP );
+            if( SingleMap ) {
+                this->SubmitRingSize = this->CompleteRingSize = std::max(this->SubmitRingSize,this->CompleteRingSize);
+            }
+            this->SubmitRing = ::mmap(nullptr,this->SubmitRingSize,PROT_READ | PROT_WRITE,MAP_SHARED | MAP_POPULATE,
+                                      this->RingHandle,IORING_OFF_SQ_RING);
+            if( this->SubmitRing == MAP_FAILED ) {
+                this->Release();
+                return;
+            }
+            if( SingleMap ) {
+                this->CompleteRing = this->SubmitRing;
+            }else{
+                this->CompleteRing = ::mmap(nullptr,this->CompleteRingSize,PROT_READ | PROT_WRITE,
+                                            MAP_SHARED | MAP_POPULATE,this->RingHandle,IORING_OFF_CQ_RING);
+            }
+            this->EntryMapSize = Params.sq_entries * sizeof(io_uring_sqe);
+            this->EntryMap = ::mmap(nullptr,this->EntryMapSize,PROT_READ | PROT_WRITE,MAP_SHARED | MAP_POPULATE,
+                                    this->RingHandle,IORING_OFF_SQES);
+            if( this->CompleteRing == MAP_FAILED || this->EntryMap == MAP_FAILED ) {
+                this->Release();
+                return;
+            }
+
+            char* SubmitBase = static_cast<char*>(this->SubmitRing);
+            char* CompleteBase = static_cast<char*>(this->CompleteRing);
+            this->SubmitTail = reinterpret_cast<unsigned*>(SubmitBase + Params.sq_off.tail);
+            this->SubmitMask = reinterpret_cast<unsigned*>(SubmitBase + Params.sq_off.ring_mask);
+            this->SubmitArray = reinterpret_cast<unsigned*>(SubmitBase + Params.sq_off.array);
+            this->CompleteHead = reinterpret_cast<unsigned*>(CompleteBase + Params.cq_off.head);
+            this->CompleteTail = reinterpret_cast<unsigned*>(CompleteBase + Params.cq_off.tail);
+            this->CompleteMask = reinterpret_cast<unsigned*>(CompleteBase + Params.cq_off.ring_mask);
+            this->Completions = reinterpret_cast<io_uring_cqe*>(CompleteBase + Params.cq_off.cqes);
+            this->Entries = static_cast<io_uring_sqe*>(this->EntryMap);
+            this->EntryCount = Params.sq_entries;
+            this->LocalTail = *(this->SubmitTail);
+            this->Probe();
+        }
+        /// @brief Deleted copy constructor.
+        IOUring(const IOUring&) = delete;
+        /// @brief Class destructor.
+        ~IOUring()
+            { this->Release(); }
+
+        /// @brief Deleted copy assignment operator.
+        IOUring& operator=(const IOUring&) = delete;
+
+        /// @brief Gets whether the ring was successfully set up.
+        /// @return Returns true if the ring can be used, false otherwise.
+        [[nodiscard]]
+        Boole IsValid() const noexcept
+            { return ( this->RingHandle != -1 ); }
+        /// @brief Gets whether the kernel supports an opcode.
+        /// @param Opcode The opcode to check.
+        /// @return Returns true if entries with the opcode can be submitted, false otherwise.
+        [[nodiscard]]
+        Boole IsSupported(const UInt8 Opcode) const noexcept
+            { return this->SupportedOpcodes[Opcode]; }
+        /// @brief Gets the number of entries in the submission queue.
+        /// @return Returns the most entries that can be in flight at once.
+        [[nodiscard]]
+        unsigned GetCapacity() const noexcept
+            { return this->EntryCount; }
+
+        /// @brief Gets the next free submission queue entry, cleared.
+        /// @remarks The caller is responsible for not having more entries in flight than the capacity.
+        /// @return Returns the entry to fill in.
+        [[nodiscard]]
+        io_uring_sqe* GetEntry() noexcept
+        {
+            const unsigned Index = this->LocalTail & *(this->SubmitMask);
+            io_uring_sqe* Entry = &(this->Entries[Index]);
+            std::memset(Entry,0,sizeof(io_uring_sqe));
+            this->SubmitArray[Index] = Index;
+            ++(this->LocalTail);
+            return Entry;
+        }
+        /// @brief Publishes filled entries to the kernel and waits for completions.
+        /// @param ToSubmit The number of filled entries not yet consumed by the kernel.
+        /// @param WaitFor The number of completions to wait for.
+        /// @return Returns the number of entries consumed, or a negated errno value if none were.
+        int Enter(const unsigned ToSubmit, const unsigned WaitFor) noexcept
+        {
+            __atomic_store_n(this->SubmitTail,this->LocalTail,__ATOMIC_RELEASE);
+            long Result = 0;
+            do{
+                Result = ::syscall(__NR_io_uring_enter,this->RingHandle,ToSubmit,WaitFor,IORING_ENTER_GETEVENTS,
+                                   nullptr,0);
+            }while( Result < 0 && errno == EINTR );
+            return ( Result < 0 ? -errno : static_cast<int>(Result) );
+        }
+        /// @brief Processes every completion the kernel has published.
+        /// @param Handler A callable taking the user data and result of each completion.
+        /// @return Returns the number of completions processed.
+        template<typename CompletionHandler>
+        unsigned Reap(CompletionHandler&& Handler)
+        {
+            unsigned Head = *(this->CompleteHead);
+            const unsigned Tail = __atomic_load_n(this->CompleteTail,__ATOMIC_ACQUIRE);
+            unsigned Reaped = 0;
+            while( Head != Tail )
+            {
+                const io_uring_cqe& Completion = this->Completions[ Head & *(this->CompleteMask) ];
+                Handler(Completion.user_data,Completion.res);
+                ++Head;
+                ++Reaped;
+            }
+            __atomic_store_n(this->CompleteHead,Head,__ATOMIC_RELEASE);
+            return Reaped;
+        }
+    };//IOUring
+
+    /// @brief Gets the opcode used to perform an operation through io_uring.
+    /// @param Operation The kind of operation to be performed.
+    /// @return Returns the matching io_uring opcode.
+    [[nodiscard]]
+    UInt8 GetOpcode(const Filesystem::BatchOperation Operation) noexcept
+    {
+        switch( Operation )
+        {
+            case Filesystem::BatchOperation::CreateDirectory:  return MkdirAtOpcode;
+            case Filesystem::BatchOperation::RemoveFile:       return UnlinkAtOpcode;
+            case Filesystem::BatchOperation::RemoveDirectory:  return UnlinkAtOpcode;
+            case Filesystem::BatchOperation::Move:             return RenameAtOpcode;
+            case Filesystem::BatchOperation::CreateSymlink:    return SymlinkAtOpcode;
+            case Filesystem::BatchOperation::Stat:             return StatxOpcode;
+        }
+        return 0;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// @brief The state for submitting one batch through an io_uring.
+    /// @details Every operation in flight is given a slot, which holds the index of the operation and the buffer
+    /// for its statx result. The slot number is passed through the ring as the user data, so each completion can
+    /// be matched to its operation without any searching.
+    ///////////////////////////////////////
+    class BatchRingSubmission
+    {
+    protected:
+        /// @brief A place for an operation that has been given to the kernel.
+        struct InFlightSlot
+        {
+            /// @brief The buffer the kernel writes the result of statx to.
+            struct statx StatBuffer;
+            /// @brief The index of the operation in the batch.
+            size_t OperationIndex;
+            /// @brief Whether the operation in this slot has been given to the ring and not yet completed.
+            Boole InUse;
+        };//InFlightSlot
+
+        /// @brief The ring the operations are submitted through.
+        IOUring& Ring;
+        /// @brief The start of the buffer holding every path in the batch.
+        const char* PathBase;
+        /// @brief The results of every operation in the batch.
+        Filesystem::FilesystemBatch::ResultContainer& Results;
+        /// @brief Every slot, one for each entry in the submission queue.
+        std::vector<InFlightSlot> Slots;
+        /// @brief The slots that aren't in use.
+        std::vector<unsigned> FreeSlots;
+        /// @brief The operations given to the ring, in the order they were given.
+        std::vector<unsigned> Filled;
+        /// @brief The number of entries of Filled that the kernel has consumed.
+        size_t Consumed = 0;
+        /// @brief Set if the ring has failed and every remaining operation should be performed one at a time.
+        Boole Failed = false;
+    public:
+        /// @brief Class constructor.
+        /// @param ToUse The ring to submit through.
+        /// @param Paths The start of the buffer holding every path in the batch.
+        /// @param ResultsDest The results of every operation in the batch.
+        BatchRingSubmission(IOUring& ToUse, const char* Paths,
+                            Filesystem::FilesystemBatch::ResultContainer& ResultsDest) :
+            Ring(ToUse),
+            PathBase(Paths),
+            Results(ResultsDest),
+            Slots(ToUse.GetCapacity())
+        {
+            this->FreeSlots.reserve( this->Slots.size() );
+            for( unsigned SlotIndex = static_cast<unsigned>( this->Slots.size() ) ; SlotIndex > 0 ; --SlotIndex )
+                { this->FreeSlots.push_back(SlotIndex - 1); }
+        }
+
+        /// @brief Performs a range of operations, returning once all of them have completed.
+        /// @param Operations Every operation in the batch.
+        /// @param Begin The index of the first operation in the range.
+        /// @param End One past the index of the last operation in the range.
+        template<typename OperationContainer>
+        void Perform(const OperationContainer& Operations, const size_t Begin, const size_t End)
+        {
+            if( this->Failed ) {
+                this->PerformRemaining(Operations,Begin,End);
+                return;
+            }
+            auto HandleCompletion = [&](const UInt64 UserData, const Int32 Result) {
+                InFlightSlot& Slot = this->Slots[UserData];
+                const auto& Queued = Operations[Slot.OperationIndex];
+                if( Result >= 0 ) {
+                    this->Results[Slot.OperationIndex] = Filesystem::ModifyResult::Success;
+                    if( Queued.Operation == Filesystem::BatchOperation::Stat ) {
+                        TransposeMetadata(Slot.StatBuffer,*Queued.StatResult);
+                    }
+                }else if( Result == -EXDEV && Queued.Operation == Filesystem::BatchOperation::Move ) {
+                    // rename can't cross filesystems, but MoveFile can.
+                    this->Results[Slot.OperationIndex] =
+                        PerformSynchronously(Queued.Operation,this->PathBase + Queued.FirstPath,
+                                             this->PathBase + Queued.SecondPath,Queued.StatResult);
+                }else{
+                    this->Results[Slot.OperationIndex] = ConvertErrNo(-Result);
+                }
+                Slot.InUse = false;
+                this->FreeSlots.push_back( static_cast<unsigned>(UserData) );
+            };
+
+            size_t Next = Begin;
+            while( Next < End || this->FreeSlots.size() < this->Slots.size() )
+            {
+                while( Next < End && !this->FreeSlots.empty() )
+                {
+                    const auto& Queued = Operations[Next];
+                    const UInt8 Opcode = GetOpcode(Queued.Operation);
+                    if( !this->Ring.IsSupported(Opcode) ) {
+                        this->Results[Next] = PerformSynchronously(Queued.Operation,this->PathBase + Queued.FirstPath,
+                                                                   this->PathBase + Queued.SecondPath,
+                                                                   Queued.StatResult);
+                        ++Next;
+                        continue;
+                    }
+
+                    const unsigned SlotIndex = this->FreeSlots.back();
+                    this->FreeSlots.pop_back();
+                    InFlightSlot& Slot = this->Slots[SlotIndex];
+                    Slot.OperationIndex = Next;
+                    Slot.InUse = true;
+
+                    io_uring_sqe* Entry = this->Ring.GetEntry();
+                    Entry->opcode = Opcode;
+                    Entry->fd = AT_FDCWD;
+                    Entry->user_data = SlotIndex;
+                    switch( Queued.Operation )
+                    {
+                        case Filesystem::BatchOperation::CreateDirectory:
+                            Entry->addr = reinterpret_cast<UInt64>(this->PathBase + Queued.FirstPath);
+                            Entry->len = 0755;
+                            break;
+                        case Filesystem::BatchOperation::RemoveFile:
+                            Entry->addr = reinterpret_cast<UInt64>(this->PathBase + Queued.FirstPath);
+                            break;
+                        case Filesystem::BatchOperation::RemoveDirectory:
+                            Entry->addr = reinterpret_cast<UInt64>(this->PathBase + Queued.FirstPath);
+                            Entry->rw_flags = AT_REMOVEDIR;
+                            break;
+                        case Filesystem::BatchOperation::Move:
+                            Entry->addr = reinterpret_cast<UInt64>(this->PathBase + Queued.FirstPath);
+                            Entry->addr2 = reinterpret_cast<UInt64>(this->PathBase + Queued.SecondPath);
+                            Entry->len = static_cast<UInt32>(AT_FDCWD);
+                            break;
+                        case Filesystem::BatchOperation::CreateSymlink:
+                            // Symlinks are queued link first, but symlinkat takes the target first.
+                            Entry->addr = reinterpret_cast<UInt64>(this->PathBase + Queued.SecondPath);
+                            Entry->addr2 = reinterpret_cast<UInt64>(this->PathBase + Queued.FirstPath);
+                            break;
+                        case Filesystem::BatchOperation::Stat:
+                            Entry->addr = reinterpret_cast<UInt64>(this->PathBase + Queued.FirstPath);
+                            Entry->addr2 = reinterpret_cast<UInt64>(&Slot.StatBuffer);
+                            Entry->len = StatMask;
+                            break;
+                    }
+                    this->Filled.push_back(SlotIndex);
+                    ++Next;
+                }
+
+                const unsigned ToSubmit = static_cast<unsigned>( this->Filled.size() - this->Consumed );
+                const unsigned InFlight = static_cast<unsigned>( this->Slots.size() - this->FreeSlots.size() );
+                if( InFlight == 0 ) {
+                    continue;
+                }
+                const int EnterResult = this->Ring.Enter(ToSubmit,1);
+                if( EnterResult >= 0 ) {
+                    this->Consumed += static_cast<size_t>(EnterResult);
+                }else if( EnterResult != -EAGAIN && EnterResult != -EBUSY ) {
+                    this->Ring.Reap(HandleCompletion);
+                    this->Abandon(Operations,EnterResult);
+                    this->PerformRemaining(Operations,Next,End);
+                    return;
+                }
+                this->Ring.Reap(HandleCompletion);
+            }
+            this->Filled.clear();
+            this->Consumed = 0;
+        }
+        /// @brief Performs operations after the ring has failed, one at a time.
+        /// @param Operations Every operation in the batch.
+        /// @param Begin The index of the first operation to perform.
+        /// @param End One past the index of the last operation to perform.
+        template<typename OperationContainer>
+        void PerformRemaining(const OperationContainer& Operations, const size_t Begin, const size_t End)
+        {
+            for( size_t Index = Begin ; Index < End ; ++Index )
+            {
+                const auto& Queued = Operations[Index];
+                this->Results[Index] = PerformSynchronously(Queued.Operation,this->PathBase + Queued.FirstPath,
+                                                            this->PathBase + Queued.SecondPath,Queued.StatResult);
+            }
+        }
+        /// @brief Deals with every operation given to the ring after it has failed.
+        /// @remarks Operations the kernel never consumed are performed one at a time instead. Operations it did
+        /// consume but hasn't completed may or may not happen, so they report the error the ring failed with.
+        /// @param Operations Every operation in the batch.
+        /// @param Error The negated errno value the ring failed with.
+        template<typename OperationContainer>
+        void Abandon(const OperationContainer& Operations, const int Error)
+        {
+            for( size_t FilledIndex = this->Consumed ; FilledIndex < this->Filled.size() ; ++FilledIndex )
+            {
+                InFlightSlot& Slot = this->Slots[ this->Filled[FilledIndex] ];
+                const auto& Queued = Operations[Slot.OperationIndex];
+                this->Results[Slot.OperationIndex] =
+                    PerformSynchronously(Queued.Operation,this->PathBase + Queued.FirstPath,
+                                         this->PathBase + Queued.SecondPath,Queued.StatResult);
+            }
+            for( size_t FilledIndex = 0 ; FilledIndex < this->Consumed ; ++FilledIndex )
+            {
+                InFlightSlot& Slot = this->Slots[ this->Filled[FilledIndex] ];
+                if( Slot.InUse ) {
+                    this->Results[Slot.OperationIndex] = ConvertErrNo(-Error);
+                }
+            }
+            this->Filled.clear();
+            this->Consumed = 0;
+            this->Failed = true;
+        }
+    };//BatchRingSubmission
+#endif // MEZZ_FilesystemBatchIOUring
+}
+
+namespace Mezzanine {
+namespace Filesystem {
+    ///////////////////////////////////////////////////////////////////////////////
+    // FilesystemBatch Methods
+
+    FilesystemBatch::FilesystemBatch() :
+        Backend(BatchBackend::Auto)
+        {  }
+
+    FilesystemBatch::FilesystemBatch(const BatchBackend ToUse) :
+        Backend(ToUse)
+        {  }
+
+    size_t FilesystemBatch::StorePath(const StringView ToStore)
+    {
+        const size_t Offset = this->PathBuffer.size();
+        this->PathBuffer.append(ToStore.data(),ToStore.size());
+        this->PathBuffer.push_back('\0');
+        return Offset;
+    }
+
+    void FilesystemBatch::QueueOperation(const BatchOperation Operation, const StringView FirstPath,
+                                         const StringView SecondPath, ArchiveEntry* StatResult)
+    {
+        QueuedOperation NewOperation;
+        NewOperation.StatResult = StatResult;
+        NewOperation.FirstPath = this->StorePath(FirstPath);
+        NewOperation.SecondPath = ( SecondPath.empty() ? NewOperation.FirstPath : this->StorePath(SecondPath) );
+        NewOperation.Operation = Operation;
+        NewOperation.AfterBarrier = this->BarrierPending;
+        this->Operations.push_back(NewOperation);
+        this->BarrierPending = false;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Queueing
+
+    void FilesystemBatch::CreateDirectory(const StringView DirectoryPath)
+        { this->QueueOperation(BatchOperation::CreateDirectory,DirectoryPath,StringView(),nullptr); }
+
+    void FilesystemBatch::RemoveFile(const StringView FilePath)
+        { this->QueueOperation(BatchOperation::RemoveFile,FilePath,StringView(),nullptr); }
+
+    void FilesystemBatch::RemoveDirectory(const StringView DirectoryPath)
+        { this->QueueOperation(BatchOperation::RemoveDirectory,DirectoryPath,StringView(),nullptr); }
+
+    void FilesystemBatch::MoveFile(const StringView OldPath, const StringView NewPath)
+        { this->QueueOperation(BatchOperation::Move,OldPath,NewPath,nullptr); }
+
+    void FilesystemBatch::CreateSymlink(const StringView SymPath, const StringView TargetPath)
+        { this->QueueOperation(BatchOperation::CreateSymlink,SymPath,TargetPath,nullptr); }
+
+    void FilesystemBatch::Stat(const StringView Path, ArchiveEntry& Result)
+        { this->QueueOperation(BatchOperation::Stat,Path,StringView(),&Result); }
+
+    void FilesystemBatch::Barrier()
+        { this->BarrierPending = !this->Operations.empty(); }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Submission
+
+    size_t FilesystemBatch::GetOperationCount() const noexcept
+        { return this->Operations.size(); }
+
+    BatchBackend FilesystemBatch::GetBackend() const noexcept
+        { return this->Backend; }
+
+    void FilesystemBatch::Clear() noexcept
+    {
+        this->PathBuffer.clear();
+        this->Operations.clear();
+        this->BarrierPending = false;
+    }
+
+    FilesystemBatch::ResultContainer FilesystemBatch::Submit()
+    {
+        ResultContainer Results(this->Operations.size(),ModifyResult::Success);
+        const char* PathBase = this->PathBuffer.c_str();
+    #ifdef MEZZ_FilesystemBatchIOUring
+        if( this->Backend == BatchBackend::Auto && !this->Operations.empty() ) {
+            const unsigned RingEntries =
+                static_cast<unsigned>( std::min<size_t>(this->Operations.size(),MaxRingEntries) );
+            IOUring Ring(RingEntries);
+            if( Ring.IsValid() ) {
+                BatchRingSubmission Submission(Ring,PathBase,Results);
+                size_t PhaseBegin = 0;
+                while( PhaseBegin < this->Operations.size() )
+                {
+                    size_t PhaseEnd = PhaseBegin + 1;
+                    while( PhaseEnd < this->Operations.size() && !this->Operations[PhaseEnd].AfterBarrier )
+                        { ++PhaseEnd; }
+                    Submission.Perform(this->Operations,PhaseBegin,PhaseEnd);
+                    PhaseBegin = PhaseEnd;
+                }
+                this->Clear();
+                return Results;
+            }
+        }
+    #endif // MEZZ_FilesystemBatchIOUring
+        for( size_t Index = 0 ; Index < this->Operations.size() ; ++Index )
+        {
+            const QueuedOperation& Queued = this->Operations[Index];
+            Results[Index] = PerformSynchronously(Queued.Operation,PathBase + Queued.FirstPath,
+                                                  PathBase + Queued.SecondPath,Queued.StatResult);
+        }
+        this->Clear();
+        return Results;
+    }
+
+    Boole FilesystemBatch::IsAsyncSupported()
+    {
+    #ifdef MEZZ_FilesystemBatchIOUring
+        static const Boole Supported = IOUring(1).IsValid();
+        return Supported;
+    #else
+        return false;
+    #endif
+    }
+}//Filesystem
+}//Mezzanine
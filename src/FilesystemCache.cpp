@@ -0,0 +1,407 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#include "CrossPlatformExport.h"
+
+#include "FilesystemCache.h"
+#include "DirectoryContents.h"
+#include "FilesystemManagement.h"
+#include "PathUtilities.h"
+
+#include <algorithm>
+
+#if defined(MEZZ_Linux) && !defined(MEZZ_CompilerIsEmscripten)
+    #include <sys/inotify.h>
+    #include <unistd.h>
+    #include <climits>
+    #define MEZZ_FilesystemCacheInotify
+#endif
+
+#include "PlatformUndefs.h"
+
+namespace
+{
+    using namespace Mezzanine;
+
+    /// @brief Checks if a character separates the parts of a path on this platform.
+    /// @param ToCheck The character to check.
+    /// @return Returns true if ToCheck is a path separator, false otherwise.
+    [[nodiscard]]
+    constexpr Boole IsSeparator(const char ToCheck) noexcept
+    {
+    #ifdef MEZZ_Windows
+        return ( ToCheck == '/' || ToCheck == '\\' );
+    #else
+        return ( ToCheck == '/' );
+    #endif
+    }
+    /// @brief Removes any trailing separators from a path, leaving a root separator alone.
+    /// @param ToTrim The path to trim.
+    /// @return Returns a view of the path without trailing separators.
+    [[nodiscard]]
+    StringView TrimTrailingSeparators(StringView ToTrim) noexcept
+    {
+        while( ToTrim.size() > 1 && IsSeparator( ToTrim.back() ) )
+            { ToTrim.remove_suffix(1); }
+        return ToTrim;
+    }
+
+#ifdef MEZZ_FilesystemCacheInotify
+    /// @brief Every change to a directory or its entries that should invalidate what's cached.
+    constexpr UInt32 WatchMask = IN_ATTRIB | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_DELETE_SELF | IN_MODIFY |
+                                 IN_MOVE_SELF | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+    /// @brief The changes to entries that also change the times of the directory holding them.
+    constexpr UInt32 DirectoryChangeMask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO;
+    /// @brief The changes that end the watch on a directory.
+    constexpr UInt32 WatchEndedMask = IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED | IN_UNMOUNT;
+#endif
+}
+
+namespace Mezzanine {
+namespace Filesystem {
+    ///////////////////////////////////////////////////////////////////////////////
+    // FilesystemCache Methods
+
+    FilesystemCache::FilesystemCache(const FilesystemCacheOptions& ToUse) :
+        Options(ToUse),
+        NextEventCheck( ClockType::now() )
+    {
+        this->Options.MaxDirectories = std::max(this->Options.MaxDirectories,size_t(1));
+    #ifdef MEZZ_FilesystemCacheInotify
+        if( this->Options.UseWatches ) {
+            this->EventHandle = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        }
+    #endif
+    }
+
+    FilesystemCache::~FilesystemCache()
+    {
+    #ifdef MEZZ_FilesystemCacheInotify
+        if( this->EventHandle != -1 ) {
+            // Closing the instance removes every watch along with it.
+            ::close(this->EventHandle);
+        }
+    #endif
+    }
+
+    Boole FilesystemCache::SplitPath(const StringView Path)
+    {
+        const StringView Trimmed = TrimTrailingSeparators(Path);
+        size_t SeparatorPos = Trimmed.size();
+        while( SeparatorPos > 0 && !IsSeparator( Trimmed[SeparatorPos - 1] ) )
+            { --SeparatorPos; }
+
+        const StringView Name = Trimmed.substr(SeparatorPos);
+        if( Name.empty() || IsDotSegment(Name) ) {
+            return false;
+        }
+        if( SeparatorPos == 0 ) {
+            this->DirectoryKey.assign(".");
+        }else{
+            this->DirectoryKey.assign( TrimTrailingSeparators( Trimmed.substr(0,SeparatorPos) ) );
+        }
+        this->NameKey.assign(Name);
+        return true;
+    }
+
+    FilesystemCache::DirectoryRecord& FilesystemCache::AcquireRecord(const String& DirectoryPath)
+    {
+        RecordContainer::iterator Found = this->Records.find(DirectoryPath);
+        if( Found != this->Records.end() ) {
+            this->UsageOrder.splice(this->UsageOrder.begin(),this->UsageOrder,Found->second.UsagePos);
+            this->ExpireIfStale(Found->second);
+            return Found->second;
+        }
+
+        if( this->Records.size() >= this->Options.MaxDirectories ) {
+            RecordContainer::iterator Oldest = this->Records.find( this->UsageOrder.back() );
+            static_cast<void>( this->ForgetRecord(Oldest) );
+            ++(this->Statistics.Evictions);
+        }
+
+        this->UsageOrder.push_front(DirectoryPath);
+        DirectoryRecord& Ret = this->Records[DirectoryPath];
+        Ret.UsagePos = this->UsageOrder.begin();
+        Ret.ExpireTime = ClockType::now() + std::chrono::milliseconds(this->Options.PollInterval);
+    #ifdef MEZZ_FilesystemCacheInotify
+        // The watch is started before anything is retrieved, so no change made after retrieval can be missed.
+        if( this->EventHandle != -1 ) {
+            Ret.Watch = ::inotify_add_watch(this->EventHandle,DirectoryPath.c_str(),WatchMask);
+            if( Ret.Watch != -1 ) {
+                this->WatchedPaths[Ret.Watch].push_back(DirectoryPath);
+            }
+        }
+    #endif
+        return Ret;
+    }
+
+    size_t FilesystemCache::ForgetRecord(RecordContainer::iterator ToForget)
+    {
+        if( ToForget == this->Records.end() ) {
+            return 0;
+        }
+        DirectoryRecord& Record = ToForget->second;
+    #ifdef MEZZ_FilesystemCacheInotify
+        if( Record.Watch != -1 ) {
+            auto Watched = this->WatchedPaths.find(Record.Watch);
+            if( Watched != this->WatchedPaths.end() ) {
+                StringVector& Paths = Watched->second;
+                Paths.erase(std::remove(Paths.begin(),Paths.end(),ToForget->first),Paths.end());
+                // Other spellings of the same directory still rely on the watch until they are forgotten too.
+                if( Paths.empty() ) {
+                    static_cast<void>( ::inotify_rm_watch(this->EventHandle,Record.Watch) );
+                    this->WatchedPaths.erase(Watched);
+                }
+            }
+        }
+    #endif
+        const size_t Ret = Record.Entries.size() + ( Record.Listing ? 1 : 0 );
+        this->UsageOrder.erase(Record.UsagePos);
+        this->Records.erase(ToForget);
+        return Ret;
+    }
+
+    void FilesystemCache::InvalidateEntry(const StringView DirectoryPath, const StringView Name)
+    {
+        this->DirectoryKey.assign(DirectoryPath);
+        RecordContainer::iterator Found = this->Records.find(this->DirectoryKey);
+        if( Found == this->Records.end() ) {
+            return;
+        }
+        DirectoryRecord& Record = Found->second;
+        this->NameKey.assign(Name);
+        this->Statistics.Invalidations += Record.Entries.erase(this->NameKey);
+        if( Record.Listing ) {
+            Record.Listing.reset();
+            ++(this->Statistics.Invalidations);
+        }
+    }
+
+    void FilesystemCache::ExpireIfStale(DirectoryRecord& ToCheck)
+    {
+        if( ToCheck.Watch != -1 ) {
+            return;
+        }
+        const ClockType::time_point Now = ClockType::now();
+        if( Now >= ToCheck.ExpireTime ) {
+            this->Statistics.Invalidations += ToCheck.Entries.size() + ( ToCheck.Listing ? 1 : 0 );
+            ToCheck.Entries.clear();
+            ToCheck.Listing.reset();
+            ToCheck.ExpireTime = Now + std::chrono::milliseconds(this->Options.PollInterval);
+        }
+    }
+
+    void FilesystemCache::ProcessEvents()
+    {
+    #ifdef MEZZ_FilesystemCacheInotify
+        if( this->EventHandle == -1 ) {
+            return;
+        }
+        alignas(struct inotify_event) char EventBuffer[16 * ( sizeof(struct inotify_event) + NAME_MAX + 1 )];
+        ssize_t BytesRead = 0;
+        while( ( BytesRead = ::read(this->EventHandle,EventBuffer,sizeof(EventBuffer)) ) > 0 )
+        {
+            const char* CurrEvent = EventBuffer;
+            const char* BufferEnd = EventBuffer + BytesRead;
+            while( CurrEvent < BufferEnd )
+            {
+                const struct inotify_event* Event = reinterpret_cast<const struct inotify_event*>(CurrEvent);
+                CurrEvent += sizeof(struct inotify_event) + Event->len;
+
+                if( Event->mask & IN_Q_OVERFLOW ) {
+                    // Changes were dropped, so we can't know what is still accurate.
+                    for( auto& RecordPair : this->Records )
+                    {
+                        DirectoryRecord& Record = RecordPair.second;
+                        this->Statistics.Invalidations += Record.Entries.size() + ( Record.Listing ? 1 : 0 );
+                        Record.Entries.clear();
+                        Record.Listing.reset();
+                    }
+                    continue;
+                }
+                auto Watched = this->WatchedPaths.find(Event->wd);
+                if( Watched == this->WatchedPaths.end() ) {
+                    continue;
+                }
+                // Copied, since the records may be forgotten below.
+                const StringVector DirectoryPaths = Watched->second;
+                const Boole WatchEnded = ( Event->len == 0 && ( Event->mask & WatchEndedMask ) );
+                if( WatchEnded ) {
+                    // The watch is gone either way, so make sure it isn't removed again.
+                    this->WatchedPaths.erase(Watched);
+                }
+                for( const String& DirectoryPath : DirectoryPaths )
+                {
+                    Boole DirectoryChanged = ( Event->mask & DirectoryChangeMask ) != 0;
+                    if( Event->len > 0 ) {
+                        this->InvalidateEntry(DirectoryPath,Event->name);
+                    }else{
+                        DirectoryChanged = true;
+                        if( WatchEnded ) {
+                            RecordContainer::iterator Found = this->Records.find(DirectoryPath);
+                            if( Found != this->Records.end() ) {
+                                Found->second.Watch = -1;
+                                this->Statistics.Invalidations += this->ForgetRecord(Found);
+                            }
+                        }
+                    }
+                    if( DirectoryChanged && this->SplitPath(DirectoryPath) ) {
+                        const String ParentPath = this->DirectoryKey;
+                        const String DirectoryName = this->NameKey;
+                        this->InvalidateEntry(ParentPath,DirectoryName);
+                    }
+                }
+            }
+        }
+    #endif
+    }
+
+    void FilesystemCache::RefreshIfDue()
+    {
+        if( this->EventHandle == -1 ) {
+            return;
+        }
+        const ClockType::time_point Now = ClockType::now();
+        if( Now >= this->NextEventCheck ) {
+            this->ProcessEvents();
+            this->NextEventCheck = Now + std::chrono::milliseconds(this->Options.EventCheckInterval);
+        }
+    }
+
+    const Optional<ArchiveEntry>* FilesystemCache::LookupEntry(const StringView Path)
+    {
+        this->RefreshIfDue();
+        if( !this->SplitPath(Path) ) {
+            ++(this->Statistics.Misses);
+            return nullptr;
+        }
+        // Entries are keyed and stat'd without trailing separators, so every spelling caches the same metadata.
+        const StringView Trimmed = TrimTrailingSeparators(Path);
+        DirectoryRecord& Record = this->AcquireRecord(this->DirectoryKey);
+        auto Found = Record.Entries.find(this->NameKey);
+        if( Found != Record.Entries.end() ) {
+            ++(this->Statistics.Hits);
+        }else{
+            ++(this->Statistics.Misses);
+            Found = Record.Entries.emplace( this->NameKey, Filesystem::StatPath(Trimmed) ).first;
+        }
+        // A trailing separator only resolves for directories, so anything else is left to the system to answer.
+        const Boole IsDirectory = ( Found->second.has_value() && Found->second->Entry == EntryType::Directory );
+        if( Trimmed.size() != Path.size() && !IsDirectory ) {
+            return nullptr;
+        }
+        return &(Found->second);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Queries
+
+    FilesystemCache::ListingPointer FilesystemCache::GetDirectoryContents(const StringView DirectoryPath)
+    {
+        this->RefreshIfDue();
+        const StringView Trimmed = TrimTrailingSeparators(DirectoryPath);
+        this->DirectoryKey.assign( Trimmed.empty() ? StringView(".") : Trimmed );
+        DirectoryRecord& Record = this->AcquireRecord(this->DirectoryKey);
+        if( Record.Listing ) {
+            ++(this->Statistics.Hits);
+            return Record.Listing;
+        }
+        ++(this->Statistics.Misses);
+        Record.Listing = std::make_shared<const ArchiveEntryVector>( Filesystem::GetDirectoryContents(DirectoryPath) );
+        return Record.Listing;
+    }
+
+    Optional<ArchiveEntry> FilesystemCache::StatPath(const StringView Path)
+    {
+        const Optional<ArchiveEntry>* Cached = this->LookupEntry(Path);
+        return ( Cached ? *Cached : Filesystem::StatPath(Path) );
+    }
+
+    Boole FilesystemCache::FileExists(const StringView FilePath)
+    {
+        const Optional<ArchiveEntry>* Cached = this->LookupEntry(FilePath);
+        if( Cached == nullptr ) {
+            return Filesystem::FileExists(FilePath);
+        }
+        return ( Cached->has_value() && (*Cached)->Entry == EntryType::File );
+    }
+
+    Boole FilesystemCache::DirectoryExists(const StringView DirectoryPath)
+    {
+        const Optional<ArchiveEntry>* Cached = this->LookupEntry(DirectoryPath);
+        if( Cached == nullptr ) {
+            return Filesystem::DirectoryExists(DirectoryPath);
+        }
+        return ( Cached->has_value() && (*Cached)->Entry == EntryType::Directory );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Maintenance
+
+    void FilesystemCache::Refresh()
+    {
+        this->ProcessEvents();
+        this->NextEventCheck = ClockType::now() + std::chrono::milliseconds(this->Options.EventCheckInterval);
+        for( auto& RecordPair : this->Records )
+            { this->ExpireIfStale(RecordPair.second); }
+    }
+
+    void FilesystemCache::Invalidate(const StringView Path)
+    {
+        const StringView Trimmed = TrimTrailingSeparators(Path);
+        this->DirectoryKey.assign( Trimmed.empty() ? StringView(".") : Trimmed );
+        RecordContainer::iterator Found = this->Records.find(this->DirectoryKey);
+        if( Found != this->Records.end() && Found->second.Listing ) {
+            Found->second.Listing.reset();
+            ++(this->Statistics.Invalidations);
+        }
+        if( this->SplitPath(Path) ) {
+            const String ParentPath = this->DirectoryKey;
+            const String Name = this->NameKey;
+            this->InvalidateEntry(ParentPath,Name);
+        }
+    }
+
+    void FilesystemCache::Clear()
+    {
+        while( !this->Records.empty() )
+            { static_cast<void>( this->ForgetRecord( this->Records.begin() ) ); }
+    }
+}//Filesystem
+}//Mezzanine
@@ -46,11 +46,19 @@
 #endif
 
 #include "FilesystemManagement.h"
+#include "DirectoryContents.h"
 #include "PathUtilities.h"
 #include "StringTools.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
 
 #ifdef MEZZ_Windows
     #define WIN32_LEAN_AND_MEAN
@@ -60,14 +68,30 @@
     #include <stdio.h>
     #include <sys/stat.h>
     #include <sys/types.h>
+    #include <dirent.h>
+    #include <fcntl.h>
     #include <unistd.h>
+    #if defined(MEZZ_Linux) && !defined(MEZZ_CompilerIsEmscripten)
+        #include <sys/ioctl.h>
+        #include <sys/sendfile.h>
+        #include <sys/syscall.h>
+        #ifndef FICLONE
+            // Defined in linux/fs.h since 4.5, which conflicts with other system headers on some distros.
+            #define FICLONE _IOW(0x94, 9, int)
+        #endif
+    #endif
 #endif
 
+#include "DirectoryIdentity.h"
+#include "SystemErrors.h"
+#include "WorkStealingPool.h"
+
 #include "PlatformUndefs.h"
 
 namespace
 {
     using namespace Mezzanine;
+    using Filesystem::ConvertErrNo;
 
 #ifdef MEZZ_Windows
     /// @brief Converts a narrow (8-bit) String to a wide (16-bit) String.
@@ -217,84 +241,1152 @@ namespace
         }
         return Ret;
     }
+#else // MEZZ_Windows
+    /// @brief The size of the buffer used when file data has to be copied through user space.
+    constexpr size_t CopyBufferSize = 1024 * 1024;
+    /// @brief A length large enough to copy everything up to the end of any file.
+    constexpr UInt64 CopyToEnd = std::numeric_limits<UInt64>::max();
 
-    /// @brief Converts the system error number to a Mezzanine ModifyResult.
-    /// @param err The system error to be converted.
-    /// @return Returns a ModifyResult value corresponding to the system error code.
+  #if defined(MEZZ_Linux) && !defined(MEZZ_CompilerIsEmscripten)
+    /// @brief The most data to ask the kernel to copy with a single system call.
+    /// @remarks The kernel caps each call at just under 2 GiB regardless, this just keeps the request sane.
+    constexpr size_t KernelCopyChunkSize = 1024 * 1024 * 1024;
+
+    /// @brief Checks if an error from a kernel copy means the method can't be used, rather than that it failed.
+    /// @param Error The errno value set by the copy.
+    /// @return Returns true if another method of copying should be tried, false if the error is real.
     [[nodiscard]]
-    Filesystem::ModifyResult ConvertErrNo(DWORD err) noexcept
+    Boole IsKernelCopyUnsupported(const int Error) noexcept
     {
-        switch( err )
+        return ( Error == ENOSYS || Error == EXDEV || Error == EINVAL ||
+                 Error == EOPNOTSUPP || Error == ENOTSUP || Error == EBADF );
+    }
+  #endif // MEZZ_Linux
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// @brief Copies ranges of data between two open files using the fastest method that works for them.
+    /// @details On Linux copy_file_range is tried first, which lets the filesystem copy the data without it ever
+    /// leaving the kernel, and on some filesystems without copying it at all. If that isn't supported (such as
+    /// across filesystems on older kernels) sendfile is tried, which still keeps the data in the kernel. If that
+    /// isn't supported either the data is copied through a large user space buffer. Methods found to be
+    /// unsupported aren't tried again for later ranges. @n @n
+    /// Every method uses and advances the file offsets of both files, so ranges are copied from and to wherever
+    /// the files are positioned and a fallback can pick up right where the previous method left off.
+    ///////////////////////////////////////
+    class FileDataCopier
+    {
+    protected:
+        /// @brief The buffer used when data has to be copied through user space. Allocated when first needed.
+        std::unique_ptr<char[]> CopyBuffer;
+        /// @brief The file descriptor of the file to read from.
+        int SourceHandle = -1;
+        /// @brief The file descriptor of the file to write to.
+        int DestHandle = -1;
+        /// @brief The method that copied the most recent range.
+        Filesystem::CopyMethod Method = Filesystem::CopyMethod::None;
+    #if defined(MEZZ_Linux) && !defined(MEZZ_CompilerIsEmscripten)
+        /// @brief Whether copy_file_range may still be used.
+        Boole UseCopyRange = true;
+        /// @brief Whether sendfile may still be used.
+        Boole UseSendFile = true;
+
+        /// @brief The possible outcomes of attempting to have the kernel copy a range.
+        enum class KernelCopyResult
+        {
+            Complete,   ///< The range was copied or a real error occurred.
+            Unsupported ///< Nothing was copied and another method should be tried.
+        };//KernelCopyResult
+
+        /// @brief Copies a range with a kernel copy system call.
+        /// @param CopyChunk A callable taking the two file descriptors and a size that copies up to that many
+        /// bytes and returns the number copied, or -1 and sets errno on failure.
+        /// @param Length The number of bytes to copy, stopping early at the end of the source.
+        /// @param Supported Cleared if the system call turns out to be unsupported for these files.
+        /// @param Result The outcome of the copy, if it Completed.
+        /// @return Returns Complete if the copy finished or failed with a real error, or Unsupported otherwise.
+        template<typename CopyFunct>
+        KernelCopyResult CopyKernel(CopyFunct&& CopyChunk, UInt64 Length, Boole& Supported,
+                                    Filesystem::ModifyResult& Result)
         {
-            case ERROR_SUCCESS:            return Filesystem::ModifyResult::Success;
-            case ERROR_ALREADY_EXISTS:     return Filesystem::ModifyResult::AlreadyExists;
-            case ERROR_FILE_EXISTS:        return Filesystem::ModifyResult::AlreadyExists;
-            case ERROR_FILE_NOT_FOUND:     return Filesystem::ModifyResult::DoesNotExist;
-            case ERROR_PATH_NOT_FOUND:     return Filesystem::ModifyResult::DoesNotExist;
-            case ERROR_INVALID_NAME:       return Filesystem::ModifyResult::InvalidPath;
-            case ERROR_BAD_PATHNAME:       return Filesystem::ModifyResult::InvalidPath;
-            case ERROR_ACCESS_DENIED:      return Filesystem::ModifyResult::PermissionDenied;
-            case ERROR_DIR_NOT_EMPTY:      return Filesystem::ModifyResult::NotEmpty;
-            case ERROR_NOT_ENOUGH_MEMORY:  return Filesystem::ModifyResult::NoSpace;
-            case ERROR_OUTOFMEMORY:        return Filesystem::ModifyResult::NoSpace;
-            case ERROR_DISK_FULL:          return Filesystem::ModifyResult::NoSpace;
-            case ERROR_PRIVILEGE_NOT_HELD: return Filesystem::ModifyResult::PrivilegeNotHeld;
-            case ERROR_PATH_BUSY:          return Filesystem::ModifyResult::CurrentlyBusy;
-            case ERROR_REQUEST_ABORTED:    return Filesystem::ModifyResult::OperationCanceled;
-            default:
+            Boole CopiedAny = false;
+            while( Length > 0 )
             {
-            #ifdef MEZZ_Debug
-                wchar_t WideBuffer[256];
-                FormatMessageW(FORMAT_MESSAGE_FROM_SYSTEM | FORMAT_MESSAGE_IGNORE_INSERTS,
-                               nullptr,
-                               err,
-                               MAKELANGID(LANG_NEUTRAL, SUBLANG_DEFAULT),
-                               WideBuffer,
-                               sizeof(WideBuffer) / sizeof(wchar_t),
-                               nullptr);
-                std::wstringstream ErrorStream;
-                ErrorStream << "Filesystem Modification failed: " << err << "\n" << WideBuffer << "\n";
-                std::wcerr << ErrorStream.str();
+                const size_t ChunkSize = static_cast<size_t>( std::min<UInt64>(Length,KernelCopyChunkSize) );
+                ssize_t BytesCopied = CopyChunk(this->SourceHandle,this->DestHandle,ChunkSize);
+                if( BytesCopied > 0 ) {
+                    CopiedAny = true;
+                    Length -= static_cast<UInt64>(BytesCopied);
+                    continue;
+                }else if( BytesCopied == 0 ) {
+                    // Some pseudo filesystems report a size of zero but still have data that can be read, and the
+                    // kernel copies will happily copy nothing from them. Let a read confirm there is nothing there.
+                    if( !CopiedAny ) {
+                        return KernelCopyResult::Unsupported;
+                    }
+                    break;
+                }
+
+                if( errno == EINTR ) {
+                    continue;
+                }else if( !CopiedAny && IsKernelCopyUnsupported(errno) ) {
+                    Supported = false;
+                    return KernelCopyResult::Unsupported;
+                }
+                Result = ConvertErrNo(errno);
+                return KernelCopyResult::Complete;
+            }
+            Result = Filesystem::ModifyResult::Success;
+            return KernelCopyResult::Complete;
+        }
+    #endif // MEZZ_Linux
+
+        /// @brief Copies a range by reading it into a buffer and writing it out.
+        /// @param Length The number of bytes to copy, stopping early at the end of the source.
+        /// @return Returns Success if the range was copied, or the error encountered.
+        [[nodiscard]]
+        Filesystem::ModifyResult CopyBuffered(UInt64 Length)
+        {
+            if( !this->CopyBuffer ) {
+                this->CopyBuffer.reset( new char[CopyBufferSize] );
+            }
+            while( Length > 0 )
+            {
+                const size_t ReadSize = static_cast<size_t>( std::min<UInt64>(Length,CopyBufferSize) );
+                ssize_t BytesRead = ::read(this->SourceHandle,this->CopyBuffer.get(),ReadSize);
+                if( BytesRead == 0 ) {
+                    break;
+                }else if( BytesRead < 0 ) {
+                    if( errno == EINTR ) {
+                        continue;
+                    }
+                    return ConvertErrNo(errno);
+                }
+                Length -= static_cast<UInt64>(BytesRead);
+
+                size_t BytesToWrite = static_cast<size_t>(BytesRead);
+                const char* WritePos = this->CopyBuffer.get();
+                while( BytesToWrite > 0 )
+                {
+                    ssize_t BytesWritten = ::write(this->DestHandle,WritePos,BytesToWrite);
+                    if( BytesWritten < 0 ) {
+                        if( errno == EINTR ) {
+                            continue;
+                        }
+                        return ConvertErrNo(errno);
+                    }
+                    BytesToWrite -= static_cast<size_t>(BytesWritten);
+                    WritePos += BytesWritten;
+                }
+            }
+            return Filesystem::ModifyResult::Success;
+        }
+    public:
+        /// @brief Class constructor.
+        /// @param Source The file descriptor of the file to read from.
+        /// @param Dest The file descriptor of the file to write to.
+        /// @param AllowCopyRange Whether copy_file_range may be used. It may share data between the files on
+        /// some filesystems, so it must be avoided when an independent copy is required.
+        FileDataCopier(const int Source, const int Dest, const Boole AllowCopyRange) :
+            SourceHandle(Source),
+            DestHandle(Dest)
+        {
+        #if defined(MEZZ_Linux) && !defined(MEZZ_CompilerIsEmscripten)
+            this->UseCopyRange = AllowCopyRange;
+        #else
+            static_cast<void>(AllowCopyRange);
+        #endif
+        }
+
+        /// @brief Gets the method that copied the most recent range.
+        /// @return Returns the method used, or the method that failed if the last copy failed.
+        [[nodiscard]]
+        Filesystem::CopyMethod GetMethod() const noexcept
+            { return this->Method; }
+        /// @brief Copies a range of data from the current position of the source to that of the destination.
+        /// @param Length The number of bytes to copy, stopping early at the end of the source.
+        /// @return Returns Success if the range was copied, or the error encountered.
+        [[nodiscard]]
+        Filesystem::ModifyResult Copy(const UInt64 Length)
+        {
+        #if defined(MEZZ_Linux) && !defined(MEZZ_CompilerIsEmscripten)
+            Filesystem::ModifyResult Result = Filesystem::ModifyResult::Success;
+            this->Method = Filesystem::CopyMethod::SystemCopy;
+          #ifdef SYS_copy_file_range
+            if( this->UseCopyRange ) {
+                // Called directly since glibc didn't provide a wrapper until 2.27.
+                auto CopyRange = [](const int Source, const int Dest, const size_t ChunkSize) {
+                    return static_cast<ssize_t>(
+                        ::syscall(SYS_copy_file_range,Source,nullptr,Dest,nullptr,ChunkSize,0u) );
+                };
+                if( this->CopyKernel(CopyRange,Length,this->UseCopyRange,Result) == KernelCopyResult::Complete ) {
+                    return Result;
+                }
+            }
+          #endif // SYS_copy_file_range
+            if( this->UseSendFile ) {
+                auto SendFile = [](const int Source, const int Dest, const size_t ChunkSize) {
+                    return ::sendfile(Dest,Source,nullptr,ChunkSize);
+                };
+                if( this->CopyKernel(SendFile,Length,this->UseSendFile,Result) == KernelCopyResult::Complete ) {
+                    return Result;
+                }
+            }
+        #endif // MEZZ_Linux
+            this->Method = Filesystem::CopyMethod::BufferedCopy;
+            return this->CopyBuffered(Length);
+        }
+    };//FileDataCopier
+
+    /// @brief Copies only the data extents of a sparse file, leaving holes in the destination where the source
+    /// has them.
+    /// @remarks Data extents are found with lseek SEEK_DATA and SEEK_HOLE. Filesystems that don't track holes
+    /// report the whole file as one extent, so this degrades to copying everything.
+    /// @param SourceHandle The file descriptor of the file to read from.
+    /// @param DestHandle The file descriptor of the empty file to write to.
+    /// @param SourceSize The size of the source file in bytes.
+    /// @param Copier The copier to copy each extent with.
+    /// @return Returns Success if all of the data was copied, or the error encountered otherwise.
+    [[nodiscard]]
+    Filesystem::ModifyResult CopySparseFileData(const int SourceHandle, const int DestHandle, const off_t SourceSize,
+                                                FileDataCopier& Copier)
+    {
+    #ifdef SEEK_DATA
+        off_t ExtentEnd = 0;
+        while( ExtentEnd < SourceSize )
+        {
+            const off_t ExtentStart = ::lseek(SourceHandle,ExtentEnd,SEEK_DATA);
+            if( ExtentStart == -1 ) {
+                if( errno == ENXIO ) {
+                    // Nothing but a hole left.
+                    break;
+                }
+                return ConvertErrNo(errno);
+            }
+            ExtentEnd = ::lseek(SourceHandle,ExtentStart,SEEK_HOLE);
+            if( ExtentEnd == -1 ) {
+                return ConvertErrNo(errno);
+            }
+            if( ::lseek(SourceHandle,ExtentStart,SEEK_SET) == -1 || ::lseek(DestHandle,ExtentStart,SEEK_SET) == -1 ) {
+                return ConvertErrNo(errno);
+            }
+            Filesystem::ModifyResult Result = Copier.Copy( static_cast<UInt64>(ExtentEnd - ExtentStart) );
+            if( Result != Filesystem::ModifyResult::Success ) {
+                return Result;
+            }
+        }
+        // Skipped holes at the end of the file won't have extended the destination.
+        if( ::ftruncate(DestHandle,SourceSize) == -1 ) {
+            return ConvertErrNo(errno);
+        }
+        return Filesystem::ModifyResult::Success;
+    #else // SEEK_DATA
+        static_cast<void>(SourceHandle);
+        static_cast<void>(DestHandle);
+        static_cast<void>(SourceSize);
+        return Copier.Copy(CopyToEnd);
+    #endif // SEEK_DATA
+    }
+
+    /// @brief Copies all of the data of one open file to another using the fastest method the strategy allows.
+    /// @remarks On Linux a copy-on-write clone is attempted first when the strategy allows it. Otherwise the data
+    /// is copied with a FileDataCopier. Sparse files only have their data extents copied, so holes stay holes. @n @n
+    /// The destination is only truncated once the data is actually going to be copied into it, so if the clone
+    /// fails with ReflinkOnly the existing contents of the destination are left untouched.
+    /// @param SourceHandle The file descriptor of the file to read from.
+    /// @param DestHandle The file descriptor of the file to write to, whose contents will be replaced.
+    /// @param SourceStat The stat of the source file.
+    /// @param Strategy How the data of the file should be duplicated.
+    /// @param SameDevice Whether or not both files are on the same device.
+    /// @param MethodUsed Set to the method that copied the data, or the last one attempted if the copy failed.
+    /// @return Returns Success if all of the data was copied, or the error encountered otherwise.
+    [[nodiscard]]
+    Filesystem::ModifyResult CopyFileData(const int SourceHandle, const int DestHandle, const struct stat& SourceStat,
+                                          const Filesystem::CopyStrategy Strategy, const Boole SameDevice,
+                                          Filesystem::CopyMethod& MethodUsed)
+    {
+        using Filesystem::CopyStrategy;
+        using Filesystem::CopyMethod;
+  #if defined(MEZZ_Linux) && !defined(MEZZ_CompilerIsEmscripten)
+        const Boole TryReflink = ( Strategy == CopyStrategy::ReflinkOnly || Strategy == CopyStrategy::ReflinkOrCopy ||
+                                   ( Strategy == CopyStrategy::Auto && SameDevice ) );
+        if( TryReflink ) {
+            MethodUsed = CopyMethod::Reflink;
+            if( ::ioctl(DestHandle,FICLONE,SourceHandle) == 0 ) {
+                // The clone leaves anything past the end of the source in place, so trim it off.
+                if( ::ftruncate(DestHandle,SourceStat.st_size) == -1 ) {
+                    return ConvertErrNo(errno);
+                }
+                return Filesystem::ModifyResult::Success;
+            }else if( errno != ENOTTY && !IsKernelCopyUnsupported(errno) ) {
+                return ConvertErrNo(errno);
+            }
+        }
+  #else // MEZZ_Linux
+        static_cast<void>(SameDevice);
+  #endif // MEZZ_Linux
+        if( Strategy == CopyStrategy::ReflinkOnly ) {
+            MethodUsed = CopyMethod::None;
+            return Filesystem::ModifyResult::NotSupported;
+        }else if( ::ftruncate(DestHandle,0) == -1 ) {
+            return ConvertErrNo(errno);
+        }
+
+        FileDataCopier Copier(SourceHandle,DestHandle,Strategy != CopyStrategy::FullCopy);
+        Filesystem::ModifyResult Result = Filesystem::ModifyResult::Success;
+        // st_blocks is always in 512 byte units, regardless of the block size of the filesystem.
+        const Boole IsSparse = ( S_ISREG(SourceStat.st_mode) &&
+                                 static_cast<off_t>(SourceStat.st_blocks) * 512 < SourceStat.st_size );
+        if( IsSparse ) {
+            Result = CopySparseFileData(SourceHandle,DestHandle,SourceStat.st_size,Copier);
+        }else{
+            Result = Copier.Copy(CopyToEnd);
+        }
+        MethodUsed = Copier.GetMethod();
+        return Result;
+    }
+#endif // MEZZ_Windows
+
+    /// @brief Copies the permissions and times of a filesystem entry to another, as allowed by the options.
+    /// @param SourcePath The entry to copy the metadata of.
+    /// @param DestPath The entry to apply the metadata to.
+    /// @param IsSymlink Whether the entries are Symlinks, in which case the links themselves are used.
+    /// @param Options The options stating which metadata is to be copied.
+    /// @return Returns Success if the metadata was copied, or the error encountered otherwise.
+    [[nodiscard]]
+    Filesystem::ModifyResult CopyEntryMetadata(const String& SourcePath, const String& DestPath,
+                                               const Boole IsSymlink, const Filesystem::DirectoryCopyOptions& Options)
+    {
+    #ifdef MEZZ_Windows
+        // CopyFileEx already carries over the times and attributes of files.
+        static_cast<void>(SourcePath);
+        static_cast<void>(DestPath);
+        static_cast<void>(IsSymlink);
+        static_cast<void>(Options);
+        return Filesystem::ModifyResult::Success;
+    #else // MEZZ_Windows
+        if( !Options.PreservePermissions && !Options.PreserveTimestamps ) {
+            return Filesystem::ModifyResult::Success;
+        }
+        struct stat SourceStat;
+        const int StatResult = ( IsSymlink ? ::lstat(SourcePath.c_str(),&SourceStat) :
+                                             ::stat(SourcePath.c_str(),&SourceStat) );
+        if( StatResult == -1 ) {
+            return ConvertErrNo(errno);
+        }
+        // Symlinks don't have permissions of their own on most systems.
+        if( Options.PreservePermissions && !IsSymlink && ::chmod(DestPath.c_str(),SourceStat.st_mode & 07777) == -1 ) {
+            return ConvertErrNo(errno);
+        }
+        if( Options.PreserveTimestamps ) {
+        #ifdef MEZZ_MacOSX
+            const struct timespec Times[2] = { SourceStat.st_atimespec, SourceStat.st_mtimespec };
+        #else
+            const struct timespec Times[2] = { SourceStat.st_atim, SourceStat.st_mtim };
+        #endif
+            const int TimeFlags = ( IsSymlink ? AT_SYMLINK_NOFOLLOW : 0 );
+            if( ::utimensat(AT_FDCWD,DestPath.c_str(),Times,TimeFlags) == -1 ) {
+                return ConvertErrNo(errno);
+            }
+        }
+        return Filesystem::ModifyResult::Success;
+    #endif // MEZZ_Windows
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// @brief The state shared by every task participating in copying a directory tree.
+    ///////////////////////////////////////
+    class TreeCopy
+    {
+    protected:
+        /// @brief A pair of directories whose metadata needs to be copied after their contents are.
+        struct DirectoryPair
+        {
+            /// @brief The path of the directory in the source tree.
+            String SourcePath;
+            /// @brief The path of the directory in the destination tree.
+            String DestPath;
+        };//DirectoryPair
+
+        /// @brief The options the tree is being copied with.
+        const Filesystem::DirectoryCopyOptions& Options;
+        /// @brief The options used to read the contents of each directory.
+        Filesystem::DirectoryContentsOptions ListOptions;
+        /// @brief The pool running the copy tasks.
+        Filesystem::WorkStealingPool Pool;
+        /// @brief The tasks for each directory and file being copied.
+        Filesystem::TaskGroup CopyTasks;
+        /// @brief The lock guarding the containers of directories below and the first error.
+        std::mutex CopyLock;
+        /// @brief Every directory created in the destination, in the order they were created.
+        std::vector<DirectoryPair> CopiedDirectories;
+        /// @brief The source directories that have been or are being copied.
+        std::unordered_set<Filesystem::DirectoryIdentity,Filesystem::DirectoryIdentityHash> VisitedDirectories;
+        /// @brief The first error encountered.
+        Filesystem::ModifyResult FirstError = Filesystem::ModifyResult::Success;
+        /// @brief Set when an error has been encountered and the copy should end as soon as possible.
+        std::atomic<Boole> Failed{false};
+
+        /// @brief Records an error, stopping the copy.
+        /// @param Error The error encountered.
+        void Fail(const Filesystem::ModifyResult Error)
+        {
+            std::lock_guard<std::mutex> Lock(this->CopyLock);
+            if( this->FirstError == Filesystem::ModifyResult::Success ) {
+                this->FirstError = Error;
+            }
+            this->Failed.store(true,std::memory_order_relaxed);
+        }
+        /// @brief Records that a source directory is being copied.
+        /// @param SourcePath The directory about to be copied.
+        /// @return Returns false if the directory has already been copied, true otherwise.
+        Boole MarkVisited(const String& SourcePath)
+        {
+            Filesystem::DirectoryIdentity Identity;
+            if( !Filesystem::GetDirectoryIdentity(SourcePath,Identity) ) {
+                // If it can't be identified it likely can't be opened either, let the open report the failure.
+                return true;
+            }
+            std::lock_guard<std::mutex> Lock(this->CopyLock);
+            return this->VisitedDirectories.insert(Identity).second;
+        }
+        /// @brief Creates a directory in the destination, or accepts it if it already exists.
+        /// @param SourcePath The directory in the source tree being copied.
+        /// @param DestPath The directory to create in the destination tree.
+        /// @return Returns true if the directory exists and can be copied into, false if it failed.
+        Boole MakeDirectory(const String& SourcePath, const String& DestPath)
+        {
+            Filesystem::ModifyResult Result = Filesystem::CreateDirectory(DestPath);
+            if( Result == Filesystem::ModifyResult::AlreadyExists && Filesystem::DirectoryExists(DestPath) ) {
+                Result = Filesystem::ModifyResult::Success;
+            }
+            if( Result != Filesystem::ModifyResult::Success ) {
+                this->Fail(Result);
+                return false;
+            }
+            std::lock_guard<std::mutex> Lock(this->CopyLock);
+            this->CopiedDirectories.push_back( DirectoryPair{ SourcePath, DestPath } );
+            return true;
+        }
+        /// @brief Copies a single file along with its metadata.
+        /// @param SourcePath The file to copy.
+        /// @param DestPath The location to copy the file to.
+        void CopySingleFile(const String& SourcePath, const String& DestPath)
+        {
+            if( this->Failed.load(std::memory_order_relaxed) ) {
+                return;
+            }
+            Filesystem::ModifyResult Result =
+                Filesystem::CopyFile(SourcePath,DestPath,this->Options.IfExists,this->Options.Strategy);
+            if( Result == Filesystem::ModifyResult::Success ) {
+                Result = CopyEntryMetadata(SourcePath,DestPath,false,this->Options);
+            }
+            if( Result != Filesystem::ModifyResult::Success ) {
+                this->Fail(Result);
+            }
+        }
+        /// @brief Recreates a Symlink along with its times.
+        /// @param SourcePath The Symlink to copy.
+        /// @param DestPath The location to create the new Symlink.
+        /// @param IsDirectory Whether the Symlink points to a directory, which matters on Windows.
+        void CopySymlink(const String& SourcePath, const String& DestPath, const Boole IsDirectory)
+        {
+            Optional<String> Target = Filesystem::GetSymlinkTargetPath(SourcePath);
+            if( !Target.has_value() ) {
+                this->Fail(Filesystem::ModifyResult::DoesNotExist);
+                return;
+            }
+            auto MakeLink = [&](){
+                return ( IsDirectory ? Filesystem::CreateDirectorySymlink(DestPath,Target.value()) :
+                                       Filesystem::CreateSymlink(DestPath,Target.value()) );
+            };
+            Filesystem::ModifyResult Result = MakeLink();
+            const Boole CanReplace = ( this->Options.IfExists == Filesystem::FileOverwrite::Allow );
+            if( Result == Filesystem::ModifyResult::AlreadyExists && CanReplace ) {
+                Result = Filesystem::RemoveSymlink(DestPath);
+                if( Result == Filesystem::ModifyResult::Success ) {
+                    Result = MakeLink();
+                }
+            }
+            if( Result == Filesystem::ModifyResult::Success ) {
+                Result = CopyEntryMetadata(SourcePath,DestPath,true,this->Options);
+            }
+            if( Result != Filesystem::ModifyResult::Success ) {
+                this->Fail(Result);
+            }
+        }
+        /// @brief Reads a source directory, creating its subdirectories and queueing tasks for everything in it.
+        /// @param SourceDir The directory in the source tree to copy, ending with a separator.
+        /// @param DestDir The already created directory to copy into, ending with a separator.
+        void CopyDirectory(const String& SourceDir, const String& DestDir)
+        {
+            if( this->Failed.load(std::memory_order_relaxed) ) {
+                return;
+            }
+            Filesystem::DirectoryRange Contents(SourceDir,this->ListOptions);
+            if( !Contents.IsOpen() ) {
+            #ifdef MEZZ_Windows
+                this->Fail( ConvertErrNo( ::GetLastError() ) );
+            #else
+                this->Fail( ConvertErrNo(errno) );
             #endif
-                return Filesystem::ModifyResult::Unknown;
+                return;
+            }
+            for( const ArchiveEntry& Entry : Contents )
+            {
+                if( this->Failed.load(std::memory_order_relaxed) ) {
+                    return;
+                }
+                String SourcePath = SourceDir + Entry.Name;
+                String DestPath = DestDir + Entry.Name;
+                if( Entry.Entry == EntryType::Directory ) {
+                    SourcePath.append( 1, Filesystem::GetDirectorySeparator_Host() );
+                    DestPath.append( 1, Filesystem::GetDirectorySeparator_Host() );
+                    if( !this->MarkVisited(SourcePath) || !this->MakeDirectory(SourcePath,DestPath) ) {
+                        continue;
+                    }
+                    this->CopyTasks.Run([this,Source = std::move(SourcePath),Dest = std::move(DestPath)](){
+                        this->CopyDirectory(Source,Dest);
+                    });
+                }else if( Entry.Entry == EntryType::Symlink ) {
+                    this->CopySymlink(SourcePath,DestPath,Filesystem::DirectoryExists(SourcePath));
+                }else if( Entry.Entry == EntryType::File ) {
+                    this->CopyTasks.Run([this,Source = std::move(SourcePath),Dest = std::move(DestPath)](){
+                        this->CopySingleFile(Source,Dest);
+                    });
+                }
             }
         }
+    public:
+        /// @brief Options constructor.
+        /// @param ToUse The options to copy the tree with.
+        /// @param ThreadCount The total number of threads to copy with, including the calling thread.
+        TreeCopy(const Filesystem::DirectoryCopyOptions& ToUse, const size_t ThreadCount) :
+            Options(ToUse),
+            Pool(ThreadCount - 1),
+            CopyTasks(Pool)
+        {
+            this->ListOptions.Metadata = Filesystem::EntryMetadata::Type;
+            this->ListOptions.FollowSymlinks = !ToUse.PreserveSymlinks;
+        }
+
+        /// @brief Copies the tree, blocking until every task has completed.
+        /// @param SourcePath The directory to be copied.
+        /// @param DestPath The directory to copy to.
+        /// @return Returns the first error encountered, or Success.
+        Filesystem::ModifyResult Run(const StringView SourcePath, const StringView DestPath)
+        {
+            String SourceRoot(SourcePath);
+            String DestRoot(DestPath);
+            for( String* Root : { &SourceRoot, &DestRoot } )
+            {
+                if( !Root->empty() && !Filesystem::IsDirectorySeparator_Host( Root->back() ) ) {
+                    Root->append( 1, Filesystem::GetDirectorySeparator_Host() );
+                }
+            }
+            if( !Filesystem::DirectoryExists(SourceRoot) ) {
+                return ( Filesystem::FileExists(SourceRoot.substr(0,SourceRoot.size() - 1)) ?
+                         Filesystem::ModifyResult::NotADirectory :
+                         Filesystem::ModifyResult::DoesNotExist );
+            }
+            this->MarkVisited(SourceRoot);
+            if( !this->MakeDirectory(SourceRoot,DestRoot) ) {
+                return this->FirstError;
+            }
+            // Mark the destination as visited so copying a directory into itself can't recurse forever.
+            this->MarkVisited(DestRoot);
+
+            this->CopyTasks.Run([this,&SourceRoot,&DestRoot](){ this->CopyDirectory(SourceRoot,DestRoot); });
+            this->CopyTasks.Wait();
+
+            // Writing the contents of a directory updates its times, so they can only be set once it is done.
+            // Deepest first, in case a parent is made read only.
+            if( this->FirstError == Filesystem::ModifyResult::Success ) {
+                for( auto DirIt = this->CopiedDirectories.rbegin() ; DirIt != this->CopiedDirectories.rend() ; ++DirIt )
+                {
+                    Filesystem::ModifyResult Result = CopyEntryMetadata(DirIt->SourcePath,DirIt->DestPath,
+                                                                        false,this->Options);
+                    if( Result != Filesystem::ModifyResult::Success ) {
+                        return Result;
+                    }
+                }
+            }
+            return this->FirstError;
+        }
+    };//TreeCopy
+
+#ifdef MEZZ_Windows
+    /// @brief Removes everything in a directory, and then the directory itself.
+    /// @remarks Directory Symlinks and junctions are removed without touching what they point to.
+    /// @param DirectoryPath The wide path of the directory to remove, without a trailing separator.
+    /// @return Returns Success if the directory was removed, or the first error encountered otherwise.
+    [[nodiscard]]
+    Filesystem::ModifyResult RemoveDirectoryTreeWindows(const std::wstring& DirectoryPath)
+    {
+        WIN32_FIND_DATAW FileData;
+        const std::wstring SearchPath = DirectoryPath + L"\\*";
+        HANDLE FindHandle = ::FindFirstFileExW(SearchPath.c_str(),FindExInfoBasic,&FileData,
+                                               FindExSearchNameMatch,nullptr,FIND_FIRST_EX_LARGE_FETCH);
+        if( FindHandle == INVALID_HANDLE_VALUE ) {
+            return ConvertErrNo( ::GetLastError() );
+        }
+        Filesystem::ModifyResult Result = Filesystem::ModifyResult::Success;
+        do{
+            const std::wstring Name(FileData.cFileName);
+            if( Name == L"." || Name == L".." ) {
+                continue;
+            }
+            const std::wstring EntryPath = DirectoryPath + L"\\" + Name;
+            const DWORD Attributes = FileData.dwFileAttributes;
+            if( Attributes & FILE_ATTRIBUTE_READONLY ) {
+                ::SetFileAttributesW(EntryPath.c_str(),Attributes & ~DWORD(FILE_ATTRIBUTE_READONLY));
+            }
+            if( ( Attributes & FILE_ATTRIBUTE_DIRECTORY ) && !( Attributes & FILE_ATTRIBUTE_REPARSE_POINT ) ) {
+                Result = RemoveDirectoryTreeWindows(EntryPath);
+            }else if( Attributes & FILE_ATTRIBUTE_DIRECTORY ) {
+                if( ::RemoveDirectoryW(EntryPath.c_str()) == 0 ) {
+                    Result = ConvertErrNo( ::GetLastError() );
+                }
+            }else if( ::DeleteFileW(EntryPath.c_str()) == 0 ) {
+                Result = ConvertErrNo( ::GetLastError() );
+            }
+        }while( Result == Filesystem::ModifyResult::Success && ::FindNextFileW(FindHandle,&FileData) );
+        ::FindClose(FindHandle);
+
+        if( Result == Filesystem::ModifyResult::Success && ::RemoveDirectoryW(DirectoryPath.c_str()) == 0 ) {
+            Result = ConvertErrNo( ::GetLastError() );
+        }
+        return Result;
     }
 #else // MEZZ_Windows
-    /// @brief Converts the system error number to a Mezzanine ModifyResult.
-    /// @param err The system error to be converted.
-    /// @return Returns a ModifyResult value corresponding to the system error code.
-    [[nodiscard]]
-    Filesystem::ModifyResult ConvertErrNo(int err) noexcept
+    ///////////////////////////////////////////////////////////////////////////////
+    /// @brief The state shared by every task participating in removing a directory tree.
+    /// @details Every directory is opened relative to the file descriptor of its parent, and everything in it is
+    /// removed relative to its own file descriptor, so no paths are ever built and the kernel never has to walk
+    /// one. Symlinks are never followed, they are unlinked like any other file. @n @n
+    /// Each subdirectory is emptied by its own task, so independent subtrees are removed in parallel. A directory
+    /// keeps count of its own listing and its subdirectories that haven't been removed yet, and whichever task
+    /// brings that count to zero removes it from its parent and then decrements the count of the parent.
+    ///////////////////////////////////////
+    class TreeRemoval
     {
-        switch( err )
+    protected:
+        /// @brief A directory being removed.
+        struct DirectoryNode
+        {
+            /// @brief The directory containing this one, or nullptr if this is the root.
+            std::shared_ptr<DirectoryNode> Parent;
+            /// @brief The name of this directory within its parent.
+            String Name;
+            /// @brief The open file descriptor of this directory.
+            int Handle = -1;
+            /// @brief The number of things preventing this directory from being removed.
+            std::atomic<size_t> Pending{1};
+        };//DirectoryNode
+
+        /// @brief The pool running the removal tasks.
+        Filesystem::WorkStealingPool Pool;
+        /// @brief The tasks for each directory being removed.
+        Filesystem::TaskGroup RemoveTasks;
+        /// @brief The lock guarding the first error.
+        std::mutex ErrorLock;
+        /// @brief The first error encountered.
+        Filesystem::ModifyResult FirstError = Filesystem::ModifyResult::Success;
+        /// @brief Set when an error has been encountered and the removal should end as soon as possible.
+        std::atomic<Boole> Failed{false};
+
+        /// @brief Records an error, stopping the removal.
+        /// @param Error The error encountered.
+        void Fail(const Filesystem::ModifyResult Error)
         {
-            case EEXIST:        return Filesystem::ModifyResult::AlreadyExists;
-            case ENOENT:        return Filesystem::ModifyResult::DoesNotExist;
-            case EINVAL:        return Filesystem::ModifyResult::InvalidPath;
-            case ELOOP:         return Filesystem::ModifyResult::LoopingPath;
-            case ENAMETOOLONG:  return Filesystem::ModifyResult::NameTooLong;
-            case EACCES:        return Filesystem::ModifyResult::PermissionDenied;
-            case EPERM:         return Filesystem::ModifyResult::PermissionDenied;
-            case EROFS:         return Filesystem::ModifyResult::ReadOnly;
-            case ENOTDIR:       return Filesystem::ModifyResult::NotADirectory;
-            case EISDIR:        return Filesystem::ModifyResult::IsADirectory;
-            case ENOTEMPTY:     return Filesystem::ModifyResult::NotEmpty;
-            case EIO:           return Filesystem::ModifyResult::IOError;
-            case ENOSPC:        return Filesystem::ModifyResult::NoSpace;
-            case EMLINK:        return Filesystem::ModifyResult::MaxLinksExceeded;
-            case EBUSY:         return Filesystem::ModifyResult::CurrentlyBusy;
-            case ECANCELED:     return Filesystem::ModifyResult::OperationCanceled;
-            default:
+            std::lock_guard<std::mutex> Lock(this->ErrorLock);
+            if( this->FirstError == Filesystem::ModifyResult::Success ) {
+                this->FirstError = Error;
+            }
+            this->Failed.store(true,std::memory_order_relaxed);
+        }
+        /// @brief Releases one of the things keeping a directory from being removed, removing it if it was the last.
+        /// @param Node The directory to release.
+        void ReleaseDirectory(std::shared_ptr<DirectoryNode> Node)
+        {
+            while( Node && Node->Pending.fetch_sub(1,std::memory_order_acq_rel) == 1 )
             {
-            #ifdef MEZZ_Debug
-                std::stringstream ErrorStream;
-                ErrorStream << "Filesystem Modification failed: " << err << "\n" << strerror(err) << "\n";
-                std::cerr << ErrorStream.str();
-            #endif
-                return Filesystem::ModifyResult::Unknown;
+                if( Node->Handle != -1 ) {
+                    ::close(Node->Handle);
+                    Node->Handle = -1;
+                }
+                if( !Node->Parent ) {
+                    // The root is removed by path once every task is done.
+                    return;
+                }
+                if( !this->Failed.load(std::memory_order_relaxed) &&
+                    ::unlinkat(Node->Parent->Handle,Node->Name.c_str(),AT_REMOVEDIR) == -1 )
+                {
+                    this->Fail( ConvertErrNo(errno) );
+                }
+                Node = Node->Parent;
+            }
+        }
+        /// @brief Removes everything in a directory, queueing a task for each subdirectory.
+        /// @param Node The directory to empty.
+        void RemoveContents(std::shared_ptr<DirectoryNode> Node)
+        {
+            if( Node->Parent && !this->Failed.load(std::memory_order_relaxed) ) {
+                Node->Handle = ::openat(Node->Parent->Handle,Node->Name.c_str(),
+                                        O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+                if( Node->Handle == -1 ) {
+                    this->Fail( ConvertErrNo(errno) );
+                }
+            }
+            // The directory stream takes ownership of the descriptor it is given, and we need ours for unlinkat.
+            const int ListHandle = ( Node->Handle != -1 ? ::fcntl(Node->Handle,F_DUPFD_CLOEXEC,0) : -1 );
+            DIR* Directory = ( ListHandle != -1 ? ::fdopendir(ListHandle) : nullptr );
+            if( Directory == nullptr ) {
+                if( ListHandle != -1 ) {
+                    ::close(ListHandle);
+                }
+                if( Node->Handle != -1 ) {
+                    this->Fail( ConvertErrNo(errno) );
+                }
+                this->ReleaseDirectory( std::move(Node) );
+                return;
+            }
+
+            struct dirent* DirEntry;
+            while( !this->Failed.load(std::memory_order_relaxed) && ( DirEntry = ::readdir(Directory) ) )
+            {
+                if( Filesystem::IsDotSegment(DirEntry->d_name) ) {
+                    continue;
+                }
+                Boole IsDirectory = ( DirEntry->d_type == DT_DIR );
+                if( DirEntry->d_type == DT_UNKNOWN ) {
+                    struct stat EntryStat;
+                    if( ::fstatat(Node->Handle,DirEntry->d_name,&EntryStat,AT_SYMLINK_NOFOLLOW) == -1 ) {
+                        this->Fail( ConvertErrNo(errno) );
+                        break;
+                    }
+                    IsDirectory = S_ISDIR(EntryStat.st_mode);
+                }
+
+                if( IsDirectory ) {
+                    std::shared_ptr<DirectoryNode> Child = std::make_shared<DirectoryNode>();
+                    Child->Parent = Node;
+                    Child->Name = DirEntry->d_name;
+                    Node->Pending.fetch_add(1,std::memory_order_acq_rel);
+                    this->RemoveTasks.Run([this,Child](){ this->RemoveContents(Child); });
+                }else if( ::unlinkat(Node->Handle,DirEntry->d_name,0) == -1 ) {
+                    this->Fail( ConvertErrNo(errno) );
+                }
+            }
+            ::closedir(Directory);
+            this->ReleaseDirectory( std::move(Node) );
+        }
+    public:
+        /// @brief Thread count constructor.
+        /// @param ThreadCount The total number of threads to remove with, including the calling thread.
+        explicit TreeRemoval(const size_t ThreadCount) :
+            Pool(ThreadCount - 1),
+            RemoveTasks(Pool)
+            {  }
+
+        /// @brief Removes the tree, blocking until every task has completed.
+        /// @param DirectoryPath The directory to remove.
+        /// @return Returns the first error encountered, or Success.
+        Filesystem::ModifyResult Run(const StringView DirectoryPath)
+        {
+            // A trailing separator would make the kernel follow a Symlink at the root.
+            String RootPath(DirectoryPath);
+            while( RootPath.size() > 1 && Filesystem::IsDirectorySeparator_Posix( RootPath.back() ) )
+                { RootPath.pop_back(); }
+
+            std::shared_ptr<DirectoryNode> Root = std::make_shared<DirectoryNode>();
+            Root->Handle = ::open(RootPath.c_str(),O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+            if( Root->Handle == -1 ) {
+                return ( errno == ELOOP ? Filesystem::ModifyResult::NotADirectory : ConvertErrNo(errno) );
+            }
+            this->RemoveTasks.Run([this,Root](){ this->RemoveContents(Root); });
+            this->RemoveTasks.Wait();
+
+            if( this->FirstError == Filesystem::ModifyResult::Success && ::rmdir(RootPath.c_str()) == -1 ) {
+                return ConvertErrNo(errno);
+            }
+            return this->FirstError;
+        }
+    };//TreeRemoval
+#endif // MEZZ_Windows
+
+#ifdef MEZZ_Windows
+    /// @brief Writes the contents of a file from a writer to an open file, then flushes it if requested.
+    /// @param Handle The file to write to.
+    /// @param Writer The callable producing the contents of the file.
+    /// @param Durability Whether or not the file should be flushed to disk.
+    /// @return Returns Success if everything was written, or the reason it wasn't otherwise.
+    [[nodiscard]]
+    Filesystem::ModifyResult WriteFileContents(HANDLE Handle, const Filesystem::FileDataWriter& Writer,
+                                               const Filesystem::DurabilityPolicy Durability)
+    {
+        Filesystem::ModifyResult SinkResult = Filesystem::ModifyResult::Success;
+        Filesystem::FileDataSink Sink = [Handle,&SinkResult](StringView Data) {
+            while( SinkResult == Filesystem::ModifyResult::Success && !Data.empty() )
+            {
+                const DWORD ToWrite = static_cast<DWORD>( std::min<size_t>(Data.size(),MAXDWORD) );
+                DWORD BytesWritten = 0;
+                if( ::WriteFile(Handle,Data.data(),ToWrite,&BytesWritten,nullptr) == 0 ) {
+                    SinkResult = ConvertErrNo( ::GetLastError() );
+                }
+                Data.remove_prefix(BytesWritten);
+            }
+            return ( SinkResult == Filesystem::ModifyResult::Success );
+        };
+        const Boole Completed = Writer(Sink);
+        if( SinkResult != Filesystem::ModifyResult::Success ) {
+            return SinkResult;
+        }else if( !Completed ) {
+            return Filesystem::ModifyResult::OperationCanceled;
+        }else if( Durability != Filesystem::DurabilityPolicy::None && ::FlushFileBuffers(Handle) == 0 ) {
+            return ConvertErrNo( ::GetLastError() );
+        }
+        return Filesystem::ModifyResult::Success;
+    }
+#else // MEZZ_Windows
+    /// @brief Writes the contents of a file from a writer to an open file, then flushes it if requested.
+    /// @param Handle The file to write to.
+    /// @param Writer The callable producing the contents of the file.
+    /// @param Durability Whether or not the file should be flushed to disk.
+    /// @return Returns Success if everything was written, or the reason it wasn't otherwise.
+    [[nodiscard]]
+    Filesystem::ModifyResult WriteFileContents(const int Handle, const Filesystem::FileDataWriter& Writer,
+                                               const Filesystem::DurabilityPolicy Durability)
+    {
+        Filesystem::ModifyResult SinkResult = Filesystem::ModifyResult::Success;
+        Filesystem::FileDataSink Sink = [Handle,&SinkResult](StringView Data) {
+            while( SinkResult == Filesystem::ModifyResult::Success && !Data.empty() )
+            {
+                ssize_t BytesWritten = ::write(Handle,Data.data(),Data.size());
+                if( BytesWritten >= 0 ) {
+                    Data.remove_prefix( static_cast<size_t>(BytesWritten) );
+                }else if( errno != EINTR ) {
+                    SinkResult = ConvertErrNo(errno);
+                }
+            }
+            return ( SinkResult == Filesystem::ModifyResult::Success );
+        };
+        const Boole Completed = Writer(Sink);
+        if( SinkResult != Filesystem::ModifyResult::Success ) {
+            return SinkResult;
+        }else if( !Completed ) {
+            return Filesystem::ModifyResult::OperationCanceled;
+        }else if( Durability != Filesystem::DurabilityPolicy::None && ::fsync(Handle) == -1 ) {
+            return ConvertErrNo(errno);
+        }
+        return Filesystem::ModifyResult::Success;
+    }
+
+    /// @brief Gives a new file the permissions of the file it will replace.
+    /// @param Handle The new file.
+    /// @param OldStat The stat of the file being replaced, or nullptr if there isn't one.
+    /// @return Returns Success if the permissions were set or didn't need to be, or the error otherwise.
+    [[nodiscard]]
+    Filesystem::ModifyResult KeepPermissions(const int Handle, const struct stat* OldStat)
+    {
+        if( OldStat != nullptr && ::fchmod(Handle,OldStat->st_mode & 07777) == -1 ) {
+            return ConvertErrNo(errno);
+        }
+        return Filesystem::ModifyResult::Success;
+    }
+
+    /// @brief Creates a name for a temporary file that will replace another.
+    /// @remarks The name is hidden, and unique within this process. Callers should still create the file
+    /// exclusively, and try another name if it exists.
+    /// @param DirectoryPath The directory of the file to be replaced, with a trailing separator or empty.
+    /// @param FileName The name of the file to be replaced.
+    /// @return Returns a path next to the file to be replaced.
+    [[nodiscard]]
+    String MakeTemporaryPath(const String& DirectoryPath, const String& FileName)
+    {
+        static std::atomic<UInt64> TemporaryCount{0};
+        return DirectoryPath + "." + FileName + "." + std::to_string( ::getpid() ) + "." +
+               std::to_string( TemporaryCount.fetch_add(1,std::memory_order_relaxed) ) + ".tmp";
+    }
+
+    /// @brief Writes a file under a temporary name, then renames it over the file it replaces.
+    /// @param TargetPath The path of the file to write.
+    /// @param DirectoryPath The directory of the file to write, with a trailing separator or empty.
+    /// @param FileName The name of the file to write.
+    /// @param OldStat The stat of the file being replaced, or nullptr if there isn't one.
+    /// @param Writer The callable producing the contents of the file.
+    /// @param Durability Whether or not the file should be flushed to disk.
+    /// @return Returns Success if the file was replaced, or the reason it wasn't otherwise.
+    [[nodiscard]]
+    Filesystem::ModifyResult WriteAndRename(const String& TargetPath, const String& DirectoryPath,
+                                            const String& FileName, const struct stat* OldStat,
+                                            const Filesystem::FileDataWriter& Writer,
+                                            const Filesystem::DurabilityPolicy Durability)
+    {
+        String TempPath;
+        int TempHandle = -1;
+        do{
+            TempPath = MakeTemporaryPath(DirectoryPath,FileName);
+            TempHandle = ::open(TempPath.c_str(),O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC,0666);
+        }while( TempHandle == -1 && errno == EEXIST );
+        if( TempHandle == -1 ) {
+            return ConvertErrNo(errno);
+        }
+
+        Filesystem::ModifyResult Result = KeepPermissions(TempHandle,OldStat);
+        if( Result == Filesystem::ModifyResult::Success ) {
+            Result = WriteFileContents(TempHandle,Writer,Durability);
+        }
+        // Some filesystems (such as NFS) only report write errors on close.
+        if( ::close(TempHandle) == -1 && Result == Filesystem::ModifyResult::Success ) {
+            Result = ConvertErrNo(errno);
+        }
+        if( Result == Filesystem::ModifyResult::Success && ::rename(TempPath.c_str(),TargetPath.c_str()) == -1 ) {
+            Result = ConvertErrNo(errno);
+        }
+        if( Result != Filesystem::ModifyResult::Success ) {
+            ::unlink(TempPath.c_str());
+        }
+        return Result;
+    }
+
+  #if defined(MEZZ_Linux) && !defined(MEZZ_CompilerIsEmscripten) && defined(O_TMPFILE)
+    /// @brief Gives an unnamed O_TMPFILE a name.
+    /// @remarks linkat with AT_EMPTY_PATH needs CAP_DAC_READ_SEARCH, so when that is refused the magic link to
+    /// the file in /proc is linked instead, which needs /proc to be mounted.
+    /// @param Handle The unnamed file.
+    /// @param NewPath The name to give the file. Nothing can exist at this path.
+    /// @return Returns 0 if the file was linked, or -1 with errno set otherwise.
+    int LinkUnnamedFile(const int Handle, const String& NewPath)
+    {
+        if( ::linkat(Handle,"",AT_FDCWD,NewPath.c_str(),AT_EMPTY_PATH) == 0 ) {
+            return 0;
+        }else if( errno != ENOENT && errno != EPERM ) {
+            return -1;
+        }
+        const String HandlePath = "/proc/self/fd/" + std::to_string(Handle);
+        return ::linkat(AT_FDCWD,HandlePath.c_str(),AT_FDCWD,NewPath.c_str(),AT_SYMLINK_FOLLOW);
+    }
+    /// @brief Links a file under a temporary name next to the file it will replace.
+    /// @param Handle The unnamed file.
+    /// @param DirectoryPath The directory of the file to be replaced, with a trailing separator or empty.
+    /// @param FileName The name of the file to be replaced.
+    /// @param TempPath The string to populate with the temporary name the file was linked to.
+    /// @return Returns 0 if the file was linked, or -1 with errno set otherwise.
+    int LinkUnnamedFileTemporarily(const int Handle, const String& DirectoryPath, const String& FileName,
+                                   String& TempPath)
+    {
+        int LinkResult = -1;
+        do{
+            TempPath = MakeTemporaryPath(DirectoryPath,FileName);
+            LinkResult = LinkUnnamedFile(Handle,TempPath);
+        }while( LinkResult == -1 && errno == EEXIST );
+        return LinkResult;
+    }
+    /// @brief Checks that an unnamed file can be given a name once it has been written.
+    /// @remarks Writers can only be run once, so this has to be known before the file is written. If the magic
+    /// link in /proc can't be used, this tries linking the still empty file with AT_EMPTY_PATH and removes the
+    /// name again.
+    /// @param Handle The unnamed file.
+    /// @param DirectoryPath The directory of the file to be written, with a trailing separator or empty.
+    /// @param FileName The name of the file to be written.
+    /// @return Returns true if LinkUnnamedFile is expected to work on the file, false otherwise.
+    [[nodiscard]]
+    Boole CanLinkUnnamedFile(const int Handle, const String& DirectoryPath, const String& FileName)
+    {
+        const String HandlePath = "/proc/self/fd/" + std::to_string(Handle);
+        if( ::access(HandlePath.c_str(),F_OK) == 0 ) {
+            return true;
+        }
+        String TempPath;
+        if( LinkUnnamedFileTemporarily(Handle,DirectoryPath,FileName,TempPath) == -1 ) {
+            return false;
+        }
+        ::unlink(TempPath.c_str());
+        return true;
+    }
+
+    /// @brief Writes a file into an unnamed O_TMPFILE, then links it into place.
+    /// @param TargetPath The path of the file to write.
+    /// @param DirectoryPath The directory of the file to write, with a trailing separator or empty.
+    /// @param FileName The name of the file to write.
+    /// @param OldStat The stat of the file being replaced, or nullptr if there isn't one.
+    /// @param Writer The callable producing the contents of the file.
+    /// @param Durability Whether or not the file should be flushed to disk.
+    /// @return Returns Success if the file was written, or the reason it wasn't written otherwise. Returns nothing
+    /// without calling the Writer if the filesystem can't create unnamed files, or they can't be linked.
+    [[nodiscard]]
+    Optional<Filesystem::ModifyResult> WriteAndLink(const String& TargetPath, const String& DirectoryPath,
+                                          const String& FileName, const struct stat* OldStat,
+                                          const Filesystem::FileDataWriter& Writer,
+                                          const Filesystem::DurabilityPolicy Durability)
+    {
+        const String OpenPath = ( DirectoryPath.empty() ? String(".") : DirectoryPath );
+        int TempHandle = ::open(OpenPath.c_str(),O_TMPFILE | O_WRONLY | O_CLOEXEC,0666);
+        if( TempHandle == -1 ) {
+            // Kernels older than 3.11 treat O_TMPFILE as O_DIRECTORY, and report opening one to write as EISDIR.
+            if( errno == EOPNOTSUPP || errno == EISDIR || errno == EINVAL ) {
+                return Optional<Filesystem::ModifyResult>();
+            }
+            return ConvertErrNo(errno);
+        }else if( !CanLinkUnnamedFile(TempHandle,DirectoryPath,FileName) ) {
+            ::close(TempHandle);
+            return Optional<Filesystem::ModifyResult>();
+        }
+
+        Filesystem::ModifyResult Result = KeepPermissions(TempHandle,OldStat);
+        if( Result == Filesystem::ModifyResult::Success ) {
+            Result = WriteFileContents(TempHandle,Writer,Durability);
+        }
+        if( Result == Filesystem::ModifyResult::Success ) {
+            Boole Linked = false;
+            if( OldStat == nullptr ) {
+                if( LinkUnnamedFile(TempHandle,TargetPath) == 0 ) {
+                    Linked = true;
+                }else if( errno != EEXIST ) {
+                    Result = ConvertErrNo(errno);
+                }
+            }
+            if( !Linked && Result == Filesystem::ModifyResult::Success ) {
+                // linkat won't replace a file, so link under a temporary name and rename that over the old file.
+                String TempPath;
+                if( LinkUnnamedFileTemporarily(TempHandle,DirectoryPath,FileName,TempPath) == -1 ) {
+                    Result = ConvertErrNo(errno);
+                }else if( ::rename(TempPath.c_str(),TargetPath.c_str()) == -1 ) {
+                    Result = ConvertErrNo(errno);
+                    ::unlink(TempPath.c_str());
+                }
+            }
+        }
+        ::close(TempHandle);
+        return Result;
+    }
+  #endif // MEZZ_Linux && O_TMPFILE
+
+    /// @brief Flushes a directory to disk, so that names recently added to it survive power loss.
+    /// @param DirectoryPath The directory to flush, or empty for the working directory.
+    /// @return Returns Success if the directory was flushed, or the error encountered otherwise.
+    [[nodiscard]]
+    Filesystem::ModifyResult SyncDirectory(const String& DirectoryPath)
+    {
+        const String OpenPath = ( DirectoryPath.empty() ? String(".") : DirectoryPath );
+        int DirHandle = ::open(OpenPath.c_str(),O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if( DirHandle == -1 ) {
+            return ConvertErrNo(errno);
+        }
+        Filesystem::ModifyResult Result = Filesystem::ModifyResult::Success;
+        if( ::fsync(DirHandle) == -1 ) {
+            Result = ConvertErrNo(errno);
+        }
+        ::close(DirHandle);
+        return Result;
+    }
+
+    /// @brief Checks whether a directory has any entries.
+    /// @param DirectoryPath The path of the directory to check.
+    /// @return Returns Success if the directory is empty, NotEmpty if it isn't, or the reason it couldn't be read.
+    [[nodiscard]]
+    Filesystem::ModifyResult CheckDirectoryEmpty(const String& DirectoryPath)
+    {
+        DIR* Directory = ::opendir( DirectoryPath.c_str() );
+        if( Directory == nullptr ) {
+            return ConvertErrNo(errno);
+        }
+        Filesystem::ModifyResult Result = Filesystem::ModifyResult::Success;
+        while( struct dirent* DirEntry = ::readdir(Directory) )
+        {
+            if( !Filesystem::IsDotSegment(DirEntry->d_name) ) {
+                Result = Filesystem::ModifyResult::NotEmpty;
+                break;
             }
         }
+        ::closedir(Directory);
+        return Result;
+    }
+
+    /// @brief Moves a file, Symlink or directory tree to another filesystem.
+    /// @remarks rename can't move anything between filesystems, so the original is copied with its permissions
+    /// and timestamps and then removed. Everything is copied under a temporary name and renamed into place, so an
+    /// existing destination is replaced in one step as it would be by rename, and left alone if the copy fails.
+    /// @param OldPath The path of the file, Symlink or directory to move.
+    /// @param NewPath The path to move it to.
+    /// @return Returns Success if the move completed, or the first error encountered otherwise. If the original
+    /// couldn't be removed after it was copied, both copies will exist.
+    [[nodiscard]]
+    Filesystem::ModifyResult MoveAcrossDevices(const String& OldPath, const String& NewPath)
+    {
+        struct stat OldStat;
+        if( ::lstat(OldPath.c_str(),&OldStat) == -1 ) {
+            return ConvertErrNo(errno);
+        }
+        // The data is going to another device, where the kernel can still copy it without a trip through userspace.
+        Filesystem::DirectoryCopyOptions Options;
+        Options.IfExists = Filesystem::FileOverwrite::Deny;
+        Options.Strategy = Filesystem::CopyStrategy::Auto;
+
+        String Destination(NewPath);
+        while( Destination.size() > 1 && Destination.back() == '/' )
+            { Destination.pop_back(); }
+        const String NewDirectory = Filesystem::GetDirName(Destination);
+        const String NewName = Filesystem::GetBaseName(Destination);
+        String TempPath;
+
+        if( S_ISDIR(OldStat.st_mode) ) {
+            // Match rename, which only replaces empty directories. This is checked up front so a tree isn't copied
+            // only to be thrown away.
+            struct stat NewStat;
+            if( ::lstat(Destination.c_str(),&NewStat) == 0 ) {
+                if( !S_ISDIR(NewStat.st_mode) ) {
+                    return Filesystem::ModifyResult::NotADirectory;
+                }
+                const Filesystem::ModifyResult EmptyResult = CheckDirectoryEmpty(Destination);
+                if( EmptyResult != Filesystem::ModifyResult::Success ) {
+                    return EmptyResult;
+                }
+            }
+            struct stat TempStat;
+            do{
+                TempPath = MakeTemporaryPath(NewDirectory,NewName);
+            }while( ::lstat(TempPath.c_str(),&TempStat) == 0 );
+
+            Filesystem::ModifyResult Result = Filesystem::CopyDirectoryTree(OldPath,TempPath,Options);
+            if( Result == Filesystem::ModifyResult::Success && ::rename(TempPath.c_str(),Destination.c_str()) == -1 ) {
+                Result = ConvertErrNo(errno);
+            }
+            if( Result != Filesystem::ModifyResult::Success ) {
+                // The temporary tree didn't exist before the copy, so everything in it is ours to remove.
+                static_cast<void>( Filesystem::RemoveDirectoryTree(TempPath) );
+                return Result;
+            }
+            return Filesystem::RemoveDirectoryTree(OldPath);
+        }
+
+        const Boole IsSymlink = S_ISLNK(OldStat.st_mode);
+        Optional<String> LinkTarget;
+        if( IsSymlink ) {
+            LinkTarget = Filesystem::GetSymlinkTargetPath(OldPath);
+            if( !LinkTarget ) {
+                return ConvertErrNo(errno);
+            }
+        }
+        Filesystem::ModifyResult Result = Filesystem::ModifyResult::Success;
+        do{
+            TempPath = MakeTemporaryPath(NewDirectory,NewName);
+            Result = ( IsSymlink ?
+                       Filesystem::CreateSymlink(TempPath,LinkTarget.value()) :
+                       Filesystem::CopyFile(OldPath,TempPath,Filesystem::FileOverwrite::Deny,Options.Strategy) );
+        }while( Result == Filesystem::ModifyResult::AlreadyExists );
+
+        if( Result == Filesystem::ModifyResult::Success ) {
+            Result = CopyEntryMetadata(OldPath,TempPath,IsSymlink,Options);
+        }
+        if( Result == Filesystem::ModifyResult::Success && ::rename(TempPath.c_str(),Destination.c_str()) == -1 ) {
+            Result = ConvertErrNo(errno);
+        }
+        if( Result != Filesystem::ModifyResult::Success ) {
+            ::unlink(TempPath.c_str());
+            return Result;
+        }
+        return ( ::unlink(OldPath.c_str()) == 0 ? Filesystem::ModifyResult::Success : ConvertErrNo(errno) );
     }
 #endif // MEZZ_Windows
 }
@@ -346,28 +1438,87 @@ namespace Filesystem {
 
     ModifyResult CopyFile(const StringView OldFilePath, const StringView NewFilePath, const FileOverwrite IfExists)
     {
+        CopyMethod MethodUsed = CopyMethod::None;
+        return CopyFile(OldFilePath,NewFilePath,IfExists,CopyStrategy::Auto,MethodUsed);
+    }
+
+    ModifyResult CopyFile(const StringView OldFilePath, const StringView NewFilePath, const FileOverwrite IfExists,
+                          const CopyStrategy Strategy)
+    {
+        CopyMethod MethodUsed = CopyMethod::None;
+        return CopyFile(OldFilePath,NewFilePath,IfExists,Strategy,MethodUsed);
+    }
+
+    ModifyResult CopyFile(const StringView OldFilePath, const StringView NewFilePath, const FileOverwrite IfExists,
+                          const CopyStrategy Strategy, CopyMethod& MethodUsed)
+    {
+        MethodUsed = CopyMethod::None;
     #ifdef MEZZ_Windows
+        if( Strategy == CopyStrategy::ReflinkOnly ) {
+            return ModifyResult::NotSupported;
+        }
         DWORD CopyFlags = COPY_FILE_COPY_SYMLINK;
         if( IfExists == FileOverwrite::Deny ) {
             CopyFlags |= COPY_FILE_FAIL_IF_EXISTS;
         }
         std::wstring WideOldPath = ConvertToWideString(OldFilePath);
         std::wstring WideNewPath = ConvertToWideString(NewFilePath);
+        MethodUsed = CopyMethod::SystemCopy;
         return ( ::CopyFileExW(WideOldPath.c_str(),WideNewPath.c_str(),NULL,NULL,NULL,CopyFlags) != 0 ?
                  ModifyResult::Success :
                  ConvertErrNo( ::GetLastError() ) );
     #else // MEZZ_Windows
-        if( IfExists == FileOverwrite::Deny && FileExists(NewFilePath.data()) ) {
-            return ModifyResult::AlreadyExists;
+        int SourceHandle = ::open(OldFilePath.data(),O_RDONLY | O_CLOEXEC);
+        if( SourceHandle == -1 ) {
+            return ConvertErrNo(errno);
+        }
+        struct stat SourceStat;
+        if( ::fstat(SourceHandle,&SourceStat) == -1 ) {
+            ModifyResult Result = ConvertErrNo(errno);
+            ::close(SourceHandle);
+            return Result;
+        }else if( S_ISDIR(SourceStat.st_mode) ) {
+            ::close(SourceHandle);
+            return ModifyResult::IsADirectory;
         }
-        std::ifstream SrcStream;
-        std::ofstream DestStream;
 
-        SrcStream.open(String(OldFilePath),std::ios_base::binary | std::ios_base::in);//Converting to String is Ew.
-        DestStream.open(String(NewFilePath),std::ios_base::binary | std::ios_base::out);//Converting to String is Ew.
+        // Don't truncate on open, in case the destination turns out to be the source or the copy can't be done.
+        // Creating exclusively first tells us whether a failed copy leaves behind a file that is ours to remove.
+        Boole CreatedDest = true;
+        int DestHandle = ::open(NewFilePath.data(),O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC,0666);
+        if( DestHandle == -1 && errno == EEXIST && IfExists == FileOverwrite::Allow ) {
+            CreatedDest = false;
+            DestHandle = ::open(NewFilePath.data(),O_WRONLY | O_CLOEXEC);
+        }
+        if( DestHandle == -1 ) {
+            ModifyResult Result = ConvertErrNo(errno);
+            ::close(SourceHandle);
+            return Result;
+        }
+        struct stat DestStat;
+        if( ::fstat(DestHandle,&DestStat) == -1 ) {
+            ModifyResult Result = ConvertErrNo(errno);
+            ::close(DestHandle);
+            ::close(SourceHandle);
+            return Result;
+        }else if( DestStat.st_dev == SourceStat.st_dev && DestStat.st_ino == SourceStat.st_ino ) {
+            ::close(DestHandle);
+            ::close(SourceHandle);
+            return ModifyResult::AlreadyExists;
+        }
 
-        DestStream << SrcStream.rdbuf();
-        return ModifyResult::Success;
+        const Boole SameDevice = ( SourceStat.st_dev == DestStat.st_dev );
+        ModifyResult Result = CopyFileData(SourceHandle,DestHandle,SourceStat,Strategy,SameDevice,MethodUsed);
+        // Some filesystems (such as NFS) only report write errors on close.
+        if( ::close(DestHandle) == -1 && Result == ModifyResult::Success ) {
+            Result = ConvertErrNo(errno);
+        }
+        ::close(SourceHandle);
+        if( Result != ModifyResult::Success && CreatedDest ) {
+            // Don't leave a partial copy around pretending to be complete, but only remove a file this call made.
+            ::unlink(NewFilePath.data());
+        }
+        return Result;
     #endif // MEZZ_Windows
     }
 
@@ -387,9 +1538,12 @@ namespace Filesystem {
         if( IfExists == FileOverwrite::Deny && FileExists(NewFilePath.data()) ) {
             return ModifyResult::AlreadyExists;
         }
-        return ( ::rename(OldFilePath.data(),NewFilePath.data()) == 0 ?
-                 ModifyResult::Success :
-                 ConvertErrNo(errno) );
+        if( ::rename(OldFilePath.data(),NewFilePath.data()) == 0 ) {
+            return ModifyResult::Success;
+        }else if( errno == EXDEV ) {
+            return MoveAcrossDevices(String(OldFilePath),String(NewFilePath));
+        }
+        return ConvertErrNo(errno);
     #endif // MEZZ_Windows
     }
 
@@ -407,6 +1561,88 @@ namespace Filesystem {
     #endif // MEZZ_Windows
     }
 
+    ///////////////////////////////////////////////////////////////////////////////
+    // Atomic File Writing
+
+    ModifyResult AtomicWriteFile(const StringView FilePath, const StringView Data, const DurabilityPolicy Durability)
+    {
+        return AtomicWriteFile(FilePath,[Data](const FileDataSink& Sink){ return Sink(Data); },Durability);
+    }
+
+    ModifyResult AtomicWriteFile(const StringView FilePath, const FileDataWriter& Writer,
+                                 const DurabilityPolicy Durability)
+    {
+        const String DirectoryPath = GetDirName(FilePath);
+        const String FileName = GetBaseName(FilePath);
+        if( FileName.empty() ) {
+            return ModifyResult::IsADirectory;
+        }
+    #ifdef MEZZ_Windows
+        std::wstring WideDirectory = ConvertToWideString(DirectoryPath);
+        if( WideDirectory.empty() ) {
+            WideDirectory = L".";
+        }
+        wchar_t TempPath[MAX_PATH];
+        if( ::GetTempFileNameW(WideDirectory.c_str(),L"mzt",0,TempPath) == 0 ) {
+            return ConvertErrNo( ::GetLastError() );
+        }
+        HANDLE TempHandle = ::CreateFileW(TempPath,GENERIC_WRITE,0,nullptr,CREATE_ALWAYS,FILE_ATTRIBUTE_NORMAL,nullptr);
+        if( TempHandle == INVALID_HANDLE_VALUE ) {
+            ModifyResult Result = ConvertErrNo( ::GetLastError() );
+            ::DeleteFileW(TempPath);
+            return Result;
+        }
+        ModifyResult Result = WriteFileContents(TempHandle,Writer,Durability);
+        ::CloseHandle(TempHandle);
+        if( Result == ModifyResult::Success ) {
+            // ReplaceFile gives the new file the security descriptor and attributes of the one it replaces.
+            std::wstring WideFilePath = ConvertToWideString(FilePath);
+            if( ::ReplaceFileW(WideFilePath.c_str(),TempPath,nullptr,REPLACEFILE_IGNORE_MERGE_ERRORS,
+                               nullptr,nullptr) == 0 )
+            {
+                // Either there was nothing to replace, or the old file is gone and the new one is still at its
+                // temporary name. Both leave a plain move to finish the job.
+                const DWORD ReplaceError = ::GetLastError();
+                DWORD MoveFlags = MOVEFILE_REPLACE_EXISTING;
+                if( Durability != DurabilityPolicy::None ) {
+                    MoveFlags |= MOVEFILE_WRITE_THROUGH;
+                }
+                if( ReplaceError != ERROR_FILE_NOT_FOUND && ReplaceError != ERROR_UNABLE_TO_MOVE_REPLACEMENT ) {
+                    Result = ConvertErrNo(ReplaceError);
+                }else if( ::MoveFileExW(TempPath,WideFilePath.c_str(),MoveFlags) == 0 ) {
+                    Result = ConvertErrNo( ::GetLastError() );
+                }
+            }
+        }
+        if( Result != ModifyResult::Success ) {
+            ::DeleteFileW(TempPath);
+        }
+        return Result;
+    #else // MEZZ_Windows
+        const String TargetPath(FilePath);
+        struct stat OldStat;
+        const struct stat* ReplacedStat = nullptr;
+        if( ::stat(TargetPath.c_str(),&OldStat) == 0 ) {
+            if( S_ISDIR(OldStat.st_mode) ) {
+                return ModifyResult::IsADirectory;
+            }
+            ReplacedStat = &OldStat;
+        }
+
+        Optional<ModifyResult> LinkResult;
+      #if defined(MEZZ_Linux) && !defined(MEZZ_CompilerIsEmscripten) && defined(O_TMPFILE)
+        LinkResult = WriteAndLink(TargetPath,DirectoryPath,FileName,ReplacedStat,Writer,Durability);
+      #endif
+        ModifyResult Result = ( LinkResult.has_value() ?
+                                LinkResult.value() :
+                                WriteAndRename(TargetPath,DirectoryPath,FileName,ReplacedStat,Writer,Durability) );
+        if( Result == ModifyResult::Success && Durability == DurabilityPolicy::FlushFileAndDirectory ) {
+            Result = SyncDirectory(DirectoryPath);
+        }
+        return Result;
+    #endif // MEZZ_Windows
+    }
+
     ///////////////////////////////////////////////////////////////////////////////
     // Symlinks
 
@@ -607,5 +1843,51 @@ namespace Filesystem {
                  ConvertErrNo(errno) );
     #endif // MEZZ_Windows
     }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Directory Tree Management
+
+    ModifyResult CopyDirectoryTree(const StringView SourcePath, const StringView DestPath)
+    {
+        return CopyDirectoryTree(SourcePath,DestPath,DirectoryCopyOptions());
+    }
+
+    ModifyResult CopyDirectoryTree(const StringView SourcePath, const StringView DestPath,
+                                   const DirectoryCopyOptions& Options)
+    {
+        size_t ThreadCount = Options.ThreadCount;
+        if( ThreadCount == 0 ) {
+            ThreadCount = std::max<size_t>(std::thread::hardware_concurrency(),1);
+        }
+        TreeCopy Copy(Options,ThreadCount);
+        return Copy.Run(SourcePath,DestPath);
+    }
+
+    ModifyResult RemoveDirectoryTree(const StringView DirectoryPath)
+    {
+        return RemoveDirectoryTree(DirectoryPath,0);
+    }
+
+    ModifyResult RemoveDirectoryTree(const StringView DirectoryPath, const size_t ThreadCount)
+    {
+    #ifdef MEZZ_Windows
+        static_cast<void>(ThreadCount);
+        std::wstring WidePath = ConvertToWideString(DirectoryPath);
+        while( !WidePath.empty() && ( WidePath.back() == L'\\' || WidePath.back() == L'/' ) )
+            { WidePath.pop_back(); }
+        const DWORD Attributes = ::GetFileAttributesW(WidePath.c_str());
+        if( Attributes == INVALID_FILE_ATTRIBUTES ) {
+            return ConvertErrNo( ::GetLastError() );
+        }else if( !( Attributes & FILE_ATTRIBUTE_DIRECTORY ) || ( Attributes & FILE_ATTRIBUTE_REPARSE_POINT ) ) {
+            return ModifyResult::NotADirectory;
+        }
+        return RemoveDirectoryTreeWindows(WidePath);
+    #else // MEZZ_Windows
+        const size_t RemoveThreads =
+            ( ThreadCount == 0 ? std::max<size_t>(std::thread::hardware_concurrency(),1) : ThreadCount );
+        TreeRemoval Removal(RemoveThreads);
+        return Removal.Run(DirectoryPath);
+    #endif // MEZZ_Windows
+    }
 }//Filesystem
 }//Mezzanine
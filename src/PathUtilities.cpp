@@ -40,6 +40,9 @@
 
 #include "PathUtilities.h"
 #include "MezzException.h"
+#include "SeparatorScan.h"
+
+#include <cstring>
 
 namespace
 {
@@ -47,33 +50,25 @@ namespace
 
     /// @brief Gets how many directories deep a path is.
     /// @param Directory The directory to check the depth of.
-    /// @param DirSep The directory separator(s) for splitting and rebuilding the path.
+    /// @param DirSep The directory separator(s) for splitting the path.
     /// @param ExitIfNegative If true, the function to return immediately if the depth count becomes negative.
     /// @return Returns an Integer representing how many directories down (or up, if negative) the path goes.
-    Integer GetDirectoryDepth_Common(const StringView Directory, const StringView DirSep, const Boole ExitIfNegative)
+    Integer GetDirectoryDepth_Common(const StringView Directory, const Filesystem::ScanCharacters& DirSep,
+                                     const Boole ExitIfNegative)
     {
         Integer Depth = 0;
-        String TempDir;
-
-        StringView::const_iterator StrIt = Directory.begin();
-        while( StrIt != Directory.end() )
-        {
-            if( DirSep.find_first_of(*StrIt) != StringView::npos ) {
-                if( TempDir == ".." ) {
-                    Depth--;
-                }else if( !TempDir.empty() && TempDir != "." ) {
-                    Depth++;
-                }
-                TempDir.clear();
-
-                if( ExitIfNegative && Depth < 0 ) {
-                    break;
-                }
-            }else{
-                TempDir.append(1,*StrIt);
+        size_t SegmentStart = 0;
+
+        Filesystem::ForEachSeparator(Directory,DirSep,[&](const size_t SeparatorPos) {
+            const StringView Segment = Directory.substr(SegmentStart,SeparatorPos - SegmentStart);
+            if( Segment == ".." ) {
+                Depth--;
+            }else if( !Segment.empty() && Segment != "." ) {
+                Depth++;
             }
-            ++StrIt;
-        }
+            SegmentStart = SeparatorPos + 1;
+            return !( ExitIfNegative && Depth < 0 );
+        });
         return Depth;
     }
 
@@ -106,28 +101,96 @@ namespace
         return Ret;
     }
 
-    /// @brief Removes all needless instances of "." or ".." and makes appropriate edits to the provided path.
+    /// @brief Removes all needless instances of "." or ".." from a path, writing the result to a buffer.
+    /// @details This is done in a single pass without splitting the path. Kept directory names are moved towards
+    /// the front of the buffer as they are found, and the directory names already written act as the stack of
+    /// segments that a ".." pops from. The result is never longer than the original path and is written no
+    /// further along than what has already been read, so the buffer may be the memory being read from. @n @n
+    /// Everything after the last separator is treated as a file name and copied as is.
     /// @param ToRemove The path to remove dot segments from.
-    /// @param DirSep The directory separator(s) for splitting and rebuilding the path.
-    /// @param IsAbsolute Whether or not the provided path is absolute.
-    /// @return Returns a vector that is the tokenized path with extraneous parts of the path removed.
-    StringVector RemoveDotSegments_Common(const StringView ToRemove, const StringView DirSep, const Boole IsAbsolute)
-    {
-        StringVector RetSegments;
-        StringVector SplitPath = StringTools::Split(ToRemove,DirSep);
-        for( StringVector::iterator VecIt = SplitPath.begin() ; VecIt != SplitPath.end() ; ++VecIt )
+    /// @param RootLength The number of characters at the start of the path that make it absolute, if any.
+    /// @param IsSeparator A callable returning whether or not a character separates directories.
+    /// @param Separator The directory separator to write after each kept directory name.
+    /// @param Buffer The buffer to write the result to. Must be able to hold at least ToRemove.size() characters.
+    /// @return Returns the number of characters written to Buffer.
+    template<typename SeparatorCheck>
+    size_t RemoveDotSegments_Common(const StringView ToRemove, const size_t RootLength, SeparatorCheck IsSeparator,
+                                    const Char8 Separator, Char8* Buffer) noexcept
+    {
+        const Char8* Source = ToRemove.data();
+        size_t DirEnd = ToRemove.size();
+        while( DirEnd > RootLength && !IsSeparator(Source[DirEnd - 1]) )
+            { --DirEnd; }
+
+        std::memmove(Buffer,Source,RootLength);
+        size_t Written = RootLength;
+        size_t Read = RootLength;
+        while( Read < DirEnd )
         {
-            if( (*VecIt) == ".." ) {
-                if( !RetSegments.empty() ) {
-                    RetSegments.pop_back();
-                }else if( !IsAbsolute ) {
-                    RetSegments.push_back(*VecIt);
+            if( IsSeparator(Source[Read]) ) {
+                ++Read;
+                continue;
+            }
+            // The character just before DirEnd is always a separator, so this can't run past it.
+            const size_t NameStart = Read;
+            while( !IsSeparator(Source[Read]) )
+                { ++Read; }
+            const StringView Name(Source + NameStart,Read - NameStart);
+
+            if( Name == "." ) {
+                continue;
+            }else if( Name == ".." ) {
+                // The last name written is the top of the stack, and ends with the separator written after it.
+                size_t PrevStart = Written;
+                StringView PrevName;
+                if( Written > RootLength ) {
+                    PrevStart = Written - 1;
+                    while( PrevStart > RootLength && Buffer[PrevStart - 1] != Separator )
+                        { --PrevStart; }
+                    PrevName = StringView(Buffer + PrevStart,( Written - 1 ) - PrevStart);
                 }
-            }else if( (*VecIt) != "." ) {
-                RetSegments.push_back(*VecIt);
+                if( !PrevName.empty() && PrevName != ".." ) {
+                    Written = PrevStart;
+                }else if( RootLength == 0 ) {
+                    Buffer[Written++] = '.';
+                    Buffer[Written++] = '.';
+                    Buffer[Written++] = Separator;
+                }
+                continue;
             }
+            std::memmove(Buffer + Written,Name.data(),Name.size());
+            Written += Name.size();
+            Buffer[Written++] = Separator;
         }
-        return RetSegments;
+
+        const size_t FileLength = ToRemove.size() - DirEnd;
+        std::memmove(Buffer + Written,Source + DirEnd,FileLength);
+        return Written + FileLength;
+    }
+
+    /// @brief The number of characters IsSubPath can normalize into a stack buffer before it needs the heap.
+    constexpr size_t SubPathBufferSize = 512;
+    /// @brief Convenience type for the buffer versions of RemoveDotSegments.
+    using BufferedDotSegmentRemover = size_t(*)(const StringView, Char8*, const size_t) noexcept;
+
+    /// @brief Removes the dot segments from a path, using a caller provided buffer when the path fits in it.
+    /// @param ToRemove The path to remove the dot segments from.
+    /// @param Buffer The buffer to try to write the normalized path to.
+    /// @param BufferSize The number of characters that can be written to Buffer.
+    /// @param Overflow A String that will hold the normalized path if it doesn't fit in Buffer.
+    /// @param Remover The RemoveDotSegments version to normalize with.
+    /// @return Returns a view of the normalized path, which points into either Buffer or Overflow.
+    StringView RemoveDotSegmentsBuffered(const StringView ToRemove, Char8* Buffer, const size_t BufferSize,
+                                         String& Overflow, BufferedDotSegmentRemover Remover)
+    {
+        size_t Length = Remover(ToRemove,Buffer,BufferSize);
+        if( Length != StringView::npos ) {
+            return StringView(Buffer,Length);
+        }
+        Overflow.resize( ToRemove.size() );
+        Length = Remover(ToRemove,Overflow.data(),Overflow.size());
+        Overflow.resize(Length);
+        return Overflow;
     }
 
     /// @brief Convenience method to verify the necessary separator is present when concatenating.
@@ -157,23 +220,13 @@ namespace Filesystem {
 
     String GetDirName(const char* FileName)
     {
-        size_t SlashPos = String::npos, CurrPos = 0;
-        while( FileName[CurrPos] != '\0' )
-        {
-            if( FileName[CurrPos] == '\\' || FileName[CurrPos] == '/' ) {
-                SlashPos = CurrPos;
-            }
-            ++CurrPos;
-        }
-        if( SlashPos != String::npos ) {
-            return String(FileName,SlashPos + 1);
-        }
-        return String();
+        return GetDirName( StringView(FileName) );
     }
 
     String GetDirName(const StringView FileName)
     {
-        size_t SlashPos = FileName.find_last_of("\\/");
+        const ScanCharacters AnySeparator = MakeScanCharacters('\\','/');
+        size_t SlashPos = FindLastSeparator(FileName,AnySeparator);
         if( FileName.npos == SlashPos ) {
             return String();
         }else{
@@ -183,23 +236,13 @@ namespace Filesystem {
 
     String GetBaseName(const char* FileName)
     {
-        size_t SlashPos = String::npos, CurrPos = 0;
-        while( FileName[CurrPos] != '\0' )
-        {
-            if( FileName[CurrPos] == '\\' || FileName[CurrPos] == '/' ) {
-                SlashPos = CurrPos;
-            }
-            ++CurrPos;
-        }
-        if( SlashPos != String::npos ) {
-            return String(FileName + (SlashPos + 1),(CurrPos - SlashPos) - 1);
-        }
-        return String(FileName,CurrPos);
+        return GetBaseName( StringView(FileName) );
     }
 
     String GetBaseName(const StringView FileName)
     {
-        size_t SlashPos = FileName.find_last_of("\\/");
+        const ScanCharacters AnySeparator = MakeScanCharacters('\\','/');
+        size_t SlashPos = FindLastSeparator(FileName,AnySeparator);
         if( FileName.npos == SlashPos ) {
             return String( FileName );
         }else{
@@ -291,13 +334,14 @@ namespace Filesystem {
 
     Integer GetDirectoryDepth_Posix(const StringView ToCheck, const Boole ExitIfNegative)
     {
-        String Separators = { GetDirectorySeparator_Posix() };
+        const ScanCharacters Separators = MakeScanCharacters( GetDirectorySeparator_Posix() );
         return GetDirectoryDepth_Common(ToCheck,Separators,ExitIfNegative);
     }
 
     Integer GetDirectoryDepth_Windows(const StringView ToCheck, const Boole ExitIfNegative)
     {
-        String Separators = { GetDirectorySeparator_Posix(), GetDirectorySeparator_Windows() };
+        const ScanCharacters Separators =
+            MakeScanCharacters( GetDirectorySeparator_Posix(), GetDirectorySeparator_Windows() );
         if( IsPathAbsolute_Windows(ToCheck) ) {
             return GetDirectoryDepth_Common(ToCheck.substr(2),Separators,ExitIfNegative);
         }else{
@@ -328,24 +372,19 @@ namespace Filesystem {
                            "Attempting to compare relative base path with absolute sub-path.")
         }
 
-        String NormBasePath = RemoveDotSegments_Posix(BasePath);
-        String NormCheckPath = RemoveDotSegments_Posix(CheckPath);
-        String::const_iterator BaseIt = NormBasePath.begin();
-        String::const_iterator BaseEnd = NormBasePath.end();
-        String::const_iterator CheckIt = NormCheckPath.begin();
-        String::const_iterator CheckEnd = NormCheckPath.end();
-
-        while( BaseIt != BaseEnd )
-        {
-            if( CheckIt == CheckEnd || (*BaseIt) != (*CheckIt) ) {
-                return false;
-            }
-
-            ++BaseIt;
-            ++CheckIt;
+        Char8 BaseBuffer[SubPathBufferSize];
+        Char8 CheckBuffer[SubPathBufferSize];
+        String BaseOverflow;
+        String CheckOverflow;
+        const StringView NormBasePath =
+            RemoveDotSegmentsBuffered(BasePath,BaseBuffer,SubPathBufferSize,BaseOverflow,RemoveDotSegments_Posix);
+        const StringView NormCheckPath =
+            RemoveDotSegmentsBuffered(CheckPath,CheckBuffer,SubPathBufferSize,CheckOverflow,RemoveDotSegments_Posix);
+
+        if( NormCheckPath.substr(0,NormBasePath.size()) != NormBasePath ) {
+            return false;
         }
-
-        String CheckRemains(CheckIt,CheckEnd);
+        const StringView CheckRemains = NormCheckPath.substr( NormBasePath.size() );
         return ( GetDirectoryDepth_Posix(CheckRemains,true) > 0 );
     }
 
@@ -363,31 +402,26 @@ namespace Filesystem {
                            "Attempting to compare relative base path with absolute sub-path.")
         }
 
-        String NormBasePath = RemoveDotSegments_Windows(BasePath);
-        String NormCheckPath = RemoveDotSegments_Windows(CheckPath);
-        String::const_iterator BaseIt = NormBasePath.begin();
-        String::const_iterator BaseEnd = NormBasePath.end();
-        String::const_iterator CheckIt = NormCheckPath.begin();
-        String::const_iterator CheckEnd = NormCheckPath.end();
+        Char8 BaseBuffer[SubPathBufferSize];
+        Char8 CheckBuffer[SubPathBufferSize];
+        String BaseOverflow;
+        String CheckOverflow;
+        StringView NormBasePath =
+            RemoveDotSegmentsBuffered(BasePath,BaseBuffer,SubPathBufferSize,BaseOverflow,RemoveDotSegments_Windows);
+        StringView NormCheckPath =
+            RemoveDotSegmentsBuffered(CheckPath,CheckBuffer,SubPathBufferSize,CheckOverflow,RemoveDotSegments_Windows);
 
         if( IsPathAbsolute_Windows(NormBasePath) ) {
-            std::advance(BaseIt,2);
+            NormBasePath.remove_prefix(2);
         }
         if( IsPathAbsolute_Windows(NormCheckPath) ) {
-            std::advance(CheckIt,2);
+            NormCheckPath.remove_prefix(2);
         }
 
-        while( BaseIt != BaseEnd )
-        {
-            if( CheckIt == CheckEnd || (*BaseIt) != (*CheckIt) ) {
-                return false;
-            }
-
-            ++BaseIt;
-            ++CheckIt;
+        if( NormCheckPath.substr(0,NormBasePath.size()) != NormBasePath ) {
+            return false;
         }
-
-        String CheckRemains(CheckIt,CheckEnd);
+        const StringView CheckRemains = NormCheckPath.substr( NormBasePath.size() );
         return ( GetDirectoryDepth_Windows(CheckRemains,true) > 0 );
     }
 
@@ -424,30 +458,68 @@ namespace Filesystem {
 
     String RemoveDotSegments_Posix(const StringView ToRemove)
     {
-        Boole AbsolutePath = IsPathAbsolute_Posix(ToRemove);
-        String Separators = { GetDirectorySeparator_Posix() };
-        size_t SplitStart = AbsolutePath ? ToRemove.find_first_of(Separators) + 1 : 0;
-        size_t SplitEnd = ToRemove.find_last_of(Separators);
-        size_t FileStart = ( SplitEnd != StringView::npos ? SplitEnd + 1 : SplitEnd );
-
-        StringVector SplitPath = RemoveDotSegments_Common(ToRemove.substr(SplitStart,SplitEnd),"/",AbsolutePath);
-        const StringView PathRoot = ToRemove.substr(0,SplitStart);
-        const StringView FileName = ( FileStart != StringView::npos ? ToRemove.substr(FileStart) : StringView() );
-        return BuildPath_Posix(PathRoot,SplitPath,FileName);
+        String Ret(ToRemove);
+        RemoveDotSegmentsInPlace_Posix(Ret);
+        return Ret;
     }
 
     String RemoveDotSegments_Windows(const StringView ToRemove)
     {
-        Boole AbsPath = IsPathAbsolute_Windows(ToRemove);
-        String Separators = { GetDirectorySeparator_Posix(), GetDirectorySeparator_Windows() };
-        size_t SplitStart = AbsPath ? ToRemove.find_first_of(Separators) + 1 : 0;
-        size_t SplitEnd = ToRemove.find_last_of(Separators);
-        size_t FileStart = ( SplitEnd != StringView::npos ? SplitEnd + 1 : SplitEnd );
+        String Ret(ToRemove);
+        RemoveDotSegmentsInPlace_Windows(Ret);
+        return Ret;
+    }
+
+    size_t RemoveDotSegments_Host(const StringView ToRemove, Char8* Buffer, const size_t BufferSize) noexcept
+    {
+    #ifdef MEZZ_Windows
+        return RemoveDotSegments_Windows(ToRemove,Buffer,BufferSize);
+    #else
+        return RemoveDotSegments_Posix(ToRemove,Buffer,BufferSize);
+    #endif
+    }
+
+    size_t RemoveDotSegments_Posix(const StringView ToRemove, Char8* Buffer, const size_t BufferSize) noexcept
+    {
+        if( BufferSize < ToRemove.size() ) {
+            return StringView::npos;
+        }
+        const size_t RootLength = ( IsPathAbsolute_Posix(ToRemove) ? 1 : 0 );
+        auto IsSeparator = [](const Char8 ToCheck) {
+            return IsDirectorySeparator_Posix(ToCheck);
+        };
+        return RemoveDotSegments_Common(ToRemove,RootLength,IsSeparator,GetDirectorySeparator_Posix(),Buffer);
+    }
 
-        StringVector SplitPath = RemoveDotSegments_Common(ToRemove.substr(SplitStart,SplitEnd),Separators,AbsPath);
-        const StringView PathRoot = ToRemove.substr(0,SplitStart);
-        const StringView FileName = ( FileStart != StringView::npos ? ToRemove.substr(FileStart) : StringView() );
-        return BuildPath_Windows(PathRoot,SplitPath,FileName);
+    size_t RemoveDotSegments_Windows(const StringView ToRemove, Char8* Buffer, const size_t BufferSize) noexcept
+    {
+        if( BufferSize < ToRemove.size() ) {
+            return StringView::npos;
+        }
+        const size_t RootLength = ( IsPathAbsolute_Windows(ToRemove) ? 3 : 0 );
+        auto IsSeparator = [](const Char8 ToCheck) {
+            return IsDirectorySeparator(ToCheck);
+        };
+        return RemoveDotSegments_Common(ToRemove,RootLength,IsSeparator,GetDirectorySeparator_Windows(),Buffer);
+    }
+
+    void RemoveDotSegmentsInPlace_Host(String& ToNormalize)
+    {
+    #ifdef MEZZ_Windows
+        RemoveDotSegmentsInPlace_Windows(ToNormalize);
+    #else
+        RemoveDotSegmentsInPlace_Posix(ToNormalize);
+    #endif
+    }
+
+    void RemoveDotSegmentsInPlace_Posix(String& ToNormalize)
+    {
+        ToNormalize.resize( RemoveDotSegments_Posix(ToNormalize,ToNormalize.data(),ToNormalize.size()) );
+    }
+
+    void RemoveDotSegmentsInPlace_Windows(String& ToNormalize)
+    {
+        ToNormalize.resize( RemoveDotSegments_Windows(ToNormalize,ToNormalize.data(),ToNormalize.size()) );
     }
 
     String CombinePathAndFileName_Host(const StringView FilePath, const StringView FileName)
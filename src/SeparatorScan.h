@@ -0,0 +1,267 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_SeparatorScan_h
+#define Mezz_Filesystem_SeparatorScan_h
+
+/// @file
+/// @brief Internal utilities for finding separator characters in a path one block of characters at a time.
+
+#include "DataTypes.h"
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define MEZZ_SeparatorScanAVX2
+#elif defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+    #include <emmintrin.h>
+    #define MEZZ_SeparatorScanSSE2
+#elif defined(__ARM_NEON) && ( defined(__aarch64__) || defined(_M_ARM64) )
+    #include <arm_neon.h>
+    #define MEZZ_SeparatorScanNEON
+#endif
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+namespace Mezzanine {
+namespace Filesystem {
+    /// @brief A set of up to three characters to scan for.
+    /// @remarks When fewer than three characters are wanted the unused slots should repeat one that is wanted.
+    struct ScanCharacters
+    {
+        /// @brief The first character to scan for.
+        Char8 First;
+        /// @brief The second character to scan for.
+        Char8 Second;
+        /// @brief The third character to scan for.
+        Char8 Third;
+    };//ScanCharacters
+
+    /// @brief Creates a set of characters to scan for with a single character.
+    /// @param Only The one character to scan for.
+    /// @return Returns a ScanCharacters that will match only the provided character.
+    [[nodiscard]]
+    constexpr ScanCharacters MakeScanCharacters(const Char8 Only) noexcept
+        { return { Only, Only, Only }; }
+    /// @brief Creates a set of characters to scan for with two characters.
+    /// @param First The first character to scan for.
+    /// @param Second The second character to scan for.
+    /// @return Returns a ScanCharacters that will match either of the provided characters.
+    [[nodiscard]]
+    constexpr ScanCharacters MakeScanCharacters(const Char8 First, const Char8 Second) noexcept
+        { return { First, Second, Second }; }
+
+    /// @brief Checks a single character against a set of characters to scan for.
+    /// @param ToCheck The character to check.
+    /// @param Chars The set of characters being scanned for.
+    /// @return Returns true if the character is in the set, false otherwise.
+    [[nodiscard]]
+    constexpr Boole IsScanMatch(const Char8 ToCheck, const ScanCharacters& Chars) noexcept
+        { return ( ToCheck == Chars.First || ToCheck == Chars.Second || ToCheck == Chars.Third ); }
+
+    /// @brief A bitmask with one bit set for each character in a block that matched.
+    /// @remarks The lowest bit corresponds to the first character in the block.
+    using ScanMask = UInt32;
+
+    /// @brief The number of characters checked by each call to MatchBlock.
+#ifdef MEZZ_SeparatorScanAVX2
+    constexpr size_t ScanBlockSize = 32;
+#else
+    constexpr size_t ScanBlockSize = 16;
+#endif
+
+    /// @brief Checks a full block of characters against a set of characters to scan for.
+    /// @remarks The block must have at least ScanBlockSize readable characters. No alignment is required.
+    /// @param Block A pointer to the first character in the block to check.
+    /// @param Chars The set of characters being scanned for.
+    /// @return Returns a mask with a bit set for each character in the block that is in the set.
+    [[nodiscard]]
+    inline ScanMask MatchBlock(const Char8* Block, const ScanCharacters& Chars) noexcept
+    {
+    #if defined(MEZZ_SeparatorScanAVX2)
+        const __m256i Data = _mm256_loadu_si256( reinterpret_cast<const __m256i*>(Block) );
+        const __m256i Matches = _mm256_or_si256(
+            _mm256_or_si256( _mm256_cmpeq_epi8( Data, _mm256_set1_epi8(Chars.First) ),
+                             _mm256_cmpeq_epi8( Data, _mm256_set1_epi8(Chars.Second) ) ),
+            _mm256_cmpeq_epi8( Data, _mm256_set1_epi8(Chars.Third) ) );
+        return static_cast<ScanMask>( _mm256_movemask_epi8(Matches) );
+    #elif defined(MEZZ_SeparatorScanSSE2)
+        const __m128i Data = _mm_loadu_si128( reinterpret_cast<const __m128i*>(Block) );
+        const __m128i Matches = _mm_or_si128(
+            _mm_or_si128( _mm_cmpeq_epi8( Data, _mm_set1_epi8(Chars.First) ),
+                          _mm_cmpeq_epi8( Data, _mm_set1_epi8(Chars.Second) ) ),
+            _mm_cmpeq_epi8( Data, _mm_set1_epi8(Chars.Third) ) );
+        return static_cast<ScanMask>( _mm_movemask_epi8(Matches) );
+    #elif defined(MEZZ_SeparatorScanNEON)
+        // NEON has no movemask, so weight each matching lane by its bit and add up each half of the vector.
+        static const UInt8 LaneBits[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+        const uint8x16_t Data = vld1q_u8( reinterpret_cast<const UInt8*>(Block) );
+        const uint8x16_t Matches = vorrq_u8(
+            vorrq_u8( vceqq_u8( Data, vdupq_n_u8( static_cast<UInt8>(Chars.First) ) ),
+                      vceqq_u8( Data, vdupq_n_u8( static_cast<UInt8>(Chars.Second) ) ) ),
+            vceqq_u8( Data, vdupq_n_u8( static_cast<UInt8>(Chars.Third) ) ) );
+        const uint8x16_t Bits = vandq_u8( Matches, vld1q_u8(LaneBits) );
+        return static_cast<ScanMask>( vaddv_u8( vget_low_u8(Bits) ) ) |
+               ( static_cast<ScanMask>( vaddv_u8( vget_high_u8(Bits) ) ) << 8 );
+    #else
+        ScanMask Ret = 0;
+        for( size_t CurrChar = 0 ; CurrChar < ScanBlockSize ; ++CurrChar )
+        {
+            if( IsScanMatch(Block[CurrChar],Chars) ) {
+                Ret |= ( ScanMask(1) << CurrChar );
+            }
+        }
+        return Ret;
+    #endif
+    }
+
+    /// @brief Gets the position of the lowest set bit in a mask.
+    /// @param Mask The mask to check. Must not be zero.
+    /// @return Returns the index of the lowest bit that is set.
+    [[nodiscard]]
+    inline size_t GetLowestMatch(const ScanMask Mask) noexcept
+    {
+    #ifdef _MSC_VER
+        unsigned long Index = 0;
+        _BitScanForward(&Index,Mask);
+        return static_cast<size_t>(Index);
+    #else
+        return static_cast<size_t>( __builtin_ctz(Mask) );
+    #endif
+    }
+
+    /// @brief Gets the position of the highest set bit in a mask.
+    /// @param Mask The mask to check. Must not be zero.
+    /// @return Returns the index of the highest bit that is set.
+    [[nodiscard]]
+    inline size_t GetHighestMatch(const ScanMask Mask) noexcept
+    {
+    #ifdef _MSC_VER
+        unsigned long Index = 0;
+        _BitScanReverse(&Index,Mask);
+        return static_cast<size_t>(Index);
+    #else
+        return static_cast<size_t>( 31 - __builtin_clz(Mask) );
+    #endif
+    }
+
+    /// @brief Finds the first character in a string that is in a set of characters.
+    /// @param Text The string to search.
+    /// @param Chars The set of characters being scanned for.
+    /// @param Start The position in the string to start searching from.
+    /// @return Returns the position of the first match at or after Start, or StringView::npos if there is none.
+    [[nodiscard]]
+    inline size_t FindFirstSeparator(const StringView Text, const ScanCharacters& Chars, size_t Start = 0) noexcept
+    {
+        while( Start + ScanBlockSize <= Text.size() )
+        {
+            const ScanMask Mask = MatchBlock(Text.data() + Start,Chars);
+            if( Mask != 0 ) {
+                return Start + GetLowestMatch(Mask);
+            }
+            Start += ScanBlockSize;
+        }
+        for( ; Start < Text.size() ; ++Start )
+        {
+            if( IsScanMatch(Text[Start],Chars) ) {
+                return Start;
+            }
+        }
+        return StringView::npos;
+    }
+
+    /// @brief Finds the last character in a string that is in a set of characters.
+    /// @param Text The string to search.
+    /// @param Chars The set of characters being scanned for.
+    /// @return Returns the position of the last match, or StringView::npos if there is none.
+    [[nodiscard]]
+    inline size_t FindLastSeparator(const StringView Text, const ScanCharacters& Chars) noexcept
+    {
+        size_t Remaining = Text.size();
+        while( Remaining >= ScanBlockSize )
+        {
+            Remaining -= ScanBlockSize;
+            const ScanMask Mask = MatchBlock(Text.data() + Remaining,Chars);
+            if( Mask != 0 ) {
+                return Remaining + GetHighestMatch(Mask);
+            }
+        }
+        while( Remaining > 0 )
+        {
+            --Remaining;
+            if( IsScanMatch(Text[Remaining],Chars) ) {
+                return Remaining;
+            }
+        }
+        return StringView::npos;
+    }
+
+    /// @brief Invokes a callable with the position of every character in a string that is in a set of characters.
+    /// @tparam Visitor A callable that accepts a size_t position and returns a Boole.
+    /// @param Text The string to search.
+    /// @param Chars The set of characters being scanned for.
+    /// @param ToCall The callable to invoke in order for each match. Return false from it to stop scanning early.
+    template<typename Visitor>
+    void ForEachSeparator(const StringView Text, const ScanCharacters& Chars, Visitor&& ToCall)
+    {
+        size_t Position = 0;
+        while( Position + ScanBlockSize <= Text.size() )
+        {
+            ScanMask Mask = MatchBlock(Text.data() + Position,Chars);
+            while( Mask != 0 )
+            {
+                if( !ToCall( Position + GetLowestMatch(Mask) ) ) {
+                    return;
+                }
+                Mask &= Mask - 1;
+            }
+            Position += ScanBlockSize;
+        }
+        for( ; Position < Text.size() ; ++Position )
+        {
+            if( IsScanMatch(Text[Position],Chars) && !ToCall(Position) ) {
+                return;
+            }
+        }
+    }
+}//Filesystem
+}//Mezzanine
+
+#endif
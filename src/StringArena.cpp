@@ -0,0 +1,111 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#include "CrossPlatformExport.h"
+
+#include "StringArena.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Mezzanine {
+namespace Filesystem {
+    ///////////////////////////////////////////////////////////////////////////////
+    // StringArena Methods
+
+    StringArena::StringArena(const size_t NewBlockSize) noexcept :
+        BlockSize( std::max(NewBlockSize,size_t(1)) )
+        {  }
+
+    char* StringArena::Allocate(const size_t Length)
+    {
+        if( !this->Blocks.empty() && this->Blocks[this->CurrentBlock].Size - this->CurrentUsed >= Length ) {
+            char* Ret = this->Blocks[this->CurrentBlock].Data.get() + this->CurrentUsed;
+            this->CurrentUsed += Length;
+            return Ret;
+        }
+        // Move on to the next block we already own that's large enough. Any blocks skipped over are left unused
+        // until the arena is cleared.
+        size_t NextBlock = ( this->Blocks.empty() ? 0 : this->CurrentBlock + 1 );
+        while( NextBlock < this->Blocks.size() && this->Blocks[NextBlock].Size < Length )
+            { ++NextBlock; }
+        if( NextBlock == this->Blocks.size() ) {
+            const size_t NewSize = std::max(this->BlockSize,Length);
+            this->Blocks.push_back( { std::make_unique<char[]>(NewSize), NewSize } );
+        }
+        this->CurrentBlock = NextBlock;
+        this->CurrentUsed = Length;
+        return this->Blocks[NextBlock].Data.get();
+    }
+
+    StringView StringArena::Store(const StringView ToStore)
+    {
+        const size_t Length = ToStore.size() + 1;
+        char* Copy = this->Allocate(Length);
+        if( !ToStore.empty() ) {
+            std::memcpy(Copy,ToStore.data(),ToStore.size());
+        }
+        Copy[ToStore.size()] = '\0';
+        this->BytesUsed += Length;
+        return StringView(Copy,ToStore.size());
+    }
+
+    void StringArena::Clear() noexcept
+    {
+        this->CurrentBlock = 0;
+        this->CurrentUsed = 0;
+        this->BytesUsed = 0;
+    }
+
+    void StringArena::Release() noexcept
+    {
+        this->Blocks.clear();
+        this->Blocks.shrink_to_fit();
+        this->Clear();
+    }
+
+    size_t StringArena::GetCapacity() const noexcept
+    {
+        size_t Ret = 0;
+        for( const Block& CurrBlock : this->Blocks )
+            { Ret += CurrBlock.Size; }
+        return Ret;
+    }
+}//Filesystem
+}//Mezzanine
@@ -0,0 +1,149 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_SystemErrors_h
+#define Mezz_Filesystem_SystemErrors_h
+
+/// @file
+/// @brief Internal conversions from the error codes reported by the system to ModifyResult values.
+
+#include "FilesystemManagement.h"
+
+#include <iostream>
+#include <sstream>
+
+#ifdef MEZZ_Windows
+    #include <Windows.h>
+#else
+    #include <cerrno>
+    #include <cstring>
+#endif
+
+namespace Mezzanine {
+namespace Filesystem {
+#ifdef MEZZ_Windows
+    /// @brief Converts the system error number to a Mezzanine ModifyResult.
+    /// @param err The system error to be converted.
+    /// @return Returns a ModifyResult value corresponding to the system error code.
+    [[nodiscard]]
+    inline ModifyResult ConvertErrNo(DWORD err) noexcept
+    {
+        switch( err )
+        {
+            case ERROR_SUCCESS:            return ModifyResult::Success;
+            case ERROR_ALREADY_EXISTS:     return ModifyResult::AlreadyExists;
+            case ERROR_FILE_EXISTS:        return ModifyResult::AlreadyExists;
+            case ERROR_FILE_NOT_FOUND:     return ModifyResult::DoesNotExist;
+            case ERROR_PATH_NOT_FOUND:     return ModifyResult::DoesNotExist;
+            case ERROR_INVALID_NAME:       return ModifyResult::InvalidPath;
+            case ERROR_BAD_PATHNAME:       return ModifyResult::InvalidPath;
+            case ERROR_ACCESS_DENIED:      return ModifyResult::PermissionDenied;
+            case ERROR_DIR_NOT_EMPTY:      return ModifyResult::NotEmpty;
+            case ERROR_NOT_ENOUGH_MEMORY:  return ModifyResult::NoSpace;
+            case ERROR_OUTOFMEMORY:        return ModifyResult::NoSpace;
+            case ERROR_DISK_FULL:          return ModifyResult::NoSpace;
+            case ERROR_PRIVILEGE_NOT_HELD: return ModifyResult::PrivilegeNotHeld;
+            case ERROR_PATH_BUSY:          return ModifyResult::CurrentlyBusy;
+            case ERROR_REQUEST_ABORTED:    return ModifyResult::OperationCanceled;
+            case ERROR_NOT_SUPPORTED:      return ModifyResult::NotSupported;
+            default:
+            {
+            #ifdef MEZZ_Debug
+                wchar_t WideBuffer[256];
+                FormatMessageW(FORMAT_MESSAGE_FROM_SYSTEM | FORMAT_MESSAGE_IGNORE_INSERTS,
+                               nullptr,
+                               err,
+                               MAKELANGID(LANG_NEUTRAL, SUBLANG_DEFAULT),
+                               WideBuffer,
+                               sizeof(WideBuffer) / sizeof(wchar_t),
+                               nullptr);
+                std::wstringstream ErrorStream;
+                ErrorStream << "Filesystem Modification failed: " << err << "\n" << WideBuffer << "\n";
+                std::wcerr << ErrorStream.str();
+            #endif
+                return ModifyResult::Unknown;
+            }
+        }
+    }
+#else // MEZZ_Windows
+    /// @brief Converts the system error number to a Mezzanine ModifyResult.
+    /// @param err The system error to be converted.
+    /// @return Returns a ModifyResult value corresponding to the system error code.
+    [[nodiscard]]
+    inline ModifyResult ConvertErrNo(int err) noexcept
+    {
+        switch( err )
+        {
+            case EEXIST:        return ModifyResult::AlreadyExists;
+            case ENOENT:        return ModifyResult::DoesNotExist;
+            case EINVAL:        return ModifyResult::InvalidPath;
+            case ELOOP:         return ModifyResult::LoopingPath;
+            case ENAMETOOLONG:  return ModifyResult::NameTooLong;
+            case EACCES:        return ModifyResult::PermissionDenied;
+            case EPERM:         return ModifyResult::PermissionDenied;
+            case EROFS:         return ModifyResult::ReadOnly;
+            case ENOTDIR:       return ModifyResult::NotADirectory;
+            case EISDIR:        return ModifyResult::IsADirectory;
+            case ENOTEMPTY:     return ModifyResult::NotEmpty;
+            case EIO:           return ModifyResult::IOError;
+            case ENOSPC:        return ModifyResult::NoSpace;
+            case EMLINK:        return ModifyResult::MaxLinksExceeded;
+            case EBUSY:         return ModifyResult::CurrentlyBusy;
+            case ECANCELED:     return ModifyResult::OperationCanceled;
+            case ENOSYS:        return ModifyResult::NotSupported;
+            case EOPNOTSUPP:    return ModifyResult::NotSupported;
+        #if defined(ENOTSUP) && ENOTSUP != EOPNOTSUPP
+            case ENOTSUP:       return ModifyResult::NotSupported;
+        #endif
+            default:
+            {
+            #ifdef MEZZ_Debug
+                std::stringstream ErrorStream;
+                ErrorStream << "Filesystem Modification failed: " << err << "\n" << strerror(err) << "\n";
+                std::cerr << ErrorStream.str();
+            #endif
+                return ModifyResult::Unknown;
+            }
+        }
+    }
+#endif // MEZZ_Windows
+}//Filesystem
+}//Mezzanine
+
+#endif
@@ -41,6 +41,7 @@
 #include "SystemPathUtilities.h"
 #include "DirectoryContents.h"
 #include "PathUtilities.h"
+#include "SeparatorScan.h"
 
 namespace Mezzanine {
 namespace Filesystem {
@@ -50,17 +51,14 @@ namespace Filesystem {
     StringVector GetSystemPATH(const StringView PATH)
     {
         StringVector Results;
-        String OneEntry;
+        size_t EntryStart = 0;
 
-        for( StringView::const_iterator Current = PATH.begin() ; PATH.end() != Current ; ++Current )
-        {
-            if( IsPathSeparator_Host( *Current ) ) {
-                Results.push_back( OneEntry );
-                OneEntry.clear();
-            }else{
-                OneEntry.push_back( *Current );
-            }
-        }
+        // Anything after the last separator is not treated as an entry.
+        ForEachSeparator(PATH,MakeScanCharacters( GetPathSeparator_Host() ),[&](const size_t SeparatorPos) {
+            Results.emplace_back( PATH.substr(EntryStart,SeparatorPos - EntryStart) );
+            EntryStart = SeparatorPos + 1;
+            return true;
+        });
         return Results;
     }
 
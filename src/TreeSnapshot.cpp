@@ -0,0 +1,761 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#include "CrossPlatformExport.h"
+
+#include "TreeSnapshot.h"
+#include "DirectoryContents.h"
+
+#include <algorithm>
+#include <limits>
+
+#ifdef MEZZ_Windows
+    #define WIN32_LEAN_AND_MEAN
+
+    #include <Windows.h>
+#else
+    #include <cerrno>
+    #include <sys/stat.h>
+    #include <sys/types.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#include "PlatformUndefs.h"
+
+namespace
+{
+    using namespace Mezzanine;
+
+    /// @brief The characters every serialized snapshot starts with.
+    constexpr char SnapshotMagic[4] = { 'M', 'Z', 'T', 'S' };
+    /// @brief The version of the serialized form written by this build.
+    constexpr UInt32 SnapshotVersion = 1;
+    /// @brief The number of bytes each node takes up in serialized form.
+    constexpr size_t SerializedNodeSize = ( 8 * 3 ) + ( 4 * 4 ) + 1;
+    /// @brief The number of bytes the fixed part of the serialized form takes up before the root path.
+    constexpr size_t SerializedHeaderSize = sizeof(SnapshotMagic) + 4 + ( 8 * 3 );
+
+    /// @brief The name and metadata of an entry read from a directory.
+    struct LiveEntry
+    {
+        /// @brief The name of the entry.
+        String Name;
+        /// @brief The size in bytes of the entry.
+        UInt64 Size = 0;
+        /// @brief The last modification time of the entry.
+        UInt64 ModifyTime = 0;
+        /// @brief The value the system uses to identify the entry on its device.
+        UInt64 FileID = 0;
+        /// @brief Whether the entry is a File, Directory or Symlink.
+        EntryType Type = EntryType::Unknown;
+    };//LiveEntry
+
+    /// @brief Convenience type for the entries read from a directory.
+    using LiveEntryVector = std::vector<LiveEntry>;
+
+    /// @brief Appends a number to a String in little endian order.
+    /// @param Dest The String to append to.
+    /// @param Value The number to append.
+    /// @param ByteCount The number of bytes of the number to append.
+    void AppendLittleEndian(String& Dest, const UInt64 Value, const size_t ByteCount)
+    {
+        for( size_t ByteIndex = 0 ; ByteIndex < ByteCount ; ++ByteIndex )
+            { Dest.push_back( static_cast<char>( ( Value >> ( ByteIndex * 8 ) ) & 0xFF ) ); }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// @brief A cursor for reading little endian numbers from serialized data.
+    ///////////////////////////////////////
+    class LittleEndianReader
+    {
+    protected:
+        /// @brief The data being read.
+        StringView Data;
+        /// @brief The offset of the next byte to be read.
+        size_t Position = 0;
+    public:
+        /// @brief Class constructor.
+        /// @param ToRead The data to be read.
+        explicit LittleEndianReader(const StringView ToRead) :
+            Data(ToRead)
+            {  }
+
+        /// @brief Gets the number of bytes that haven't been read.
+        /// @return Returns the number of bytes left in the data.
+        [[nodiscard]]
+        size_t GetRemaining() const noexcept
+            { return this->Data.size() - this->Position; }
+        /// @brief Reads a number.
+        /// @param ByteCount The number of bytes the number takes up.
+        /// @param Value The number to populate.
+        /// @return Returns true if the number was read, false if there isn't enough data left.
+        Boole Read(const size_t ByteCount, UInt64& Value) noexcept
+        {
+            if( this->GetRemaining() < ByteCount ) {
+                return false;
+            }
+            Value = 0;
+            for( size_t ByteIndex = 0 ; ByteIndex < ByteCount ; ++ByteIndex )
+            {
+                const UInt64 Byte = static_cast<UInt8>( this->Data[this->Position++] );
+                Value |= ( Byte << ( ByteIndex * 8 ) );
+            }
+            return true;
+        }
+        /// @brief Reads a range of bytes.
+        /// @param ByteCount The number of bytes to read.
+        /// @param Bytes The view to populate.
+        /// @return Returns true if the bytes were read, false if there isn't enough data left.
+        Boole Read(const size_t ByteCount, StringView& Bytes) noexcept
+        {
+            if( this->GetRemaining() < ByteCount ) {
+                return false;
+            }
+            Bytes = this->Data.substr(this->Position,ByteCount);
+            this->Position += ByteCount;
+            return true;
+        }
+    };//LittleEndianReader
+
+#ifdef MEZZ_Windows
+    /// @brief Convenience type for Windows wide strings.
+    using WideString = std::wstring;
+
+    /// @brief Converts a narrow (8-bit) string to a wide (16-bit) string.
+    /// @param Thin The string to be converted.
+    /// @return Returns a wide string with the converted contents.
+    [[nodiscard]]
+    WideString ConvertToWideString(const StringView Thin)
+    {
+        WideString Ret;
+        const int ThinSize = static_cast<int>( Thin.size() );
+        if( ThinSize > 0 ) {
+            const int WideLength = ::MultiByteToWideChar(CP_UTF8,0,Thin.data(),ThinSize,nullptr,0);
+            Ret.resize(static_cast<size_t>(WideLength),L'\0');
+            ::MultiByteToWideChar(CP_UTF8,0,Thin.data(),ThinSize,&Ret[0],WideLength);
+        }
+        return Ret;
+    }
+#else // MEZZ_Windows
+    /// @brief Gets the modification time of an entry.
+    /// @param EntryStat The metadata of the entry.
+    /// @return Returns the time the entry was last modified in nanoseconds.
+    [[nodiscard]]
+    UInt64 GetModifyTimeNanoseconds(const struct stat& EntryStat) noexcept
+    {
+    #ifdef MEZZ_MacOSX
+        return ( static_cast<UInt64>(EntryStat.st_mtimespec.tv_sec) * 1000000000 ) +
+               static_cast<UInt64>(EntryStat.st_mtimespec.tv_nsec);
+    #else
+        return ( static_cast<UInt64>(EntryStat.st_mtim.tv_sec) * 1000000000 ) +
+               static_cast<UInt64>(EntryStat.st_mtim.tv_nsec);
+    #endif
+    }
+#endif // MEZZ_Windows
+
+    /// @brief Gets the metadata of a directory itself.
+    /// @param DirectoryPath The path of the directory.
+    /// @param FollowSymlinks Whether a Symlink to a directory counts as a directory.
+    /// @param ModifyTime The modification time to populate.
+    /// @param FileID The file ID to populate. Windows doesn't report one without opening the directory.
+    /// @return Returns true if the path is a directory and its metadata was retrieved, false otherwise.
+    Boole GetDirectoryInfo(const String& DirectoryPath, const Boole FollowSymlinks, UInt64& ModifyTime,
+                           UInt64& FileID)
+    {
+    #ifdef MEZZ_Windows
+        const Filesystem::EntryMetadata Metadata = Filesystem::EntryMetadata::Type | Filesystem::EntryMetadata::Times;
+        const Optional<ArchiveEntry> DirEntry = Filesystem::StatPath(DirectoryPath,Metadata,FollowSymlinks);
+        if( !DirEntry || DirEntry->Entry != EntryType::Directory ) {
+            return false;
+        }
+        ModifyTime = DirEntry->ModifyTime;
+        FileID = 0;
+    #else
+        struct stat DirStat;
+        const int StatResult = FollowSymlinks ? ::stat(DirectoryPath.c_str(),&DirStat) :
+                                                ::lstat(DirectoryPath.c_str(),&DirStat);
+        if( StatResult != 0 || !S_ISDIR(DirStat.st_mode) ) {
+            return false;
+        }
+        ModifyTime = GetModifyTimeNanoseconds(DirStat);
+        FileID = static_cast<UInt64>(DirStat.st_ino);
+    #endif
+        return true;
+    }
+    /// @brief Reads every entry in a directory.
+    /// @remarks Entries are read with a DirectoryRange. Windows listings already carry a modification time
+    /// precise enough to compare, but Posix listings only report seconds and no inode, so on Posix systems
+    /// only the names are listed and each entry is then stat'd once for the rest of its metadata.
+    /// @param DirectoryPath The path of the directory.
+    /// @param Entries The vector to append the entries to.
+    void ListDirectory(const String& DirectoryPath, LiveEntryVector& Entries)
+    {
+        Filesystem::DirectoryContentsOptions Options;
+        // Don't follow Symlinks, or a link to a directory could have us recording outside the tree.
+        Options.FollowSymlinks = false;
+    #ifdef MEZZ_Windows
+        Options.Metadata = Filesystem::EntryMetadata::Type | Filesystem::EntryMetadata::Size |
+                           Filesystem::EntryMetadata::Times;
+        for( const ArchiveEntry& Entry : Filesystem::DirectoryRange(DirectoryPath,Options) )
+        {
+            LiveEntry NewEntry;
+            NewEntry.Name = Entry.Name;
+            NewEntry.ModifyTime = Entry.ModifyTime;
+            NewEntry.Type = Entry.Entry;
+            if( NewEntry.Type != EntryType::Directory ) {
+                NewEntry.Size = Entry.Size;
+            }
+            Entries.push_back( std::move(NewEntry) );
+        }
+    #else
+        Options.Metadata = Filesystem::EntryMetadata::None;
+        String EntryPath = DirectoryPath;
+        if( EntryPath.empty() || EntryPath.back() != '/' ) {
+            EntryPath.push_back('/');
+        }
+        const size_t NameStart = EntryPath.size();
+        for( const ArchiveEntry& Entry : Filesystem::DirectoryRange(DirectoryPath,Options) )
+        {
+            EntryPath.resize(NameStart);
+            EntryPath.append(Entry.Name);
+            struct stat EntryStat;
+            if( ::lstat(EntryPath.c_str(),&EntryStat) != 0 ) {
+                // Removed between being listed and stat'd.
+                continue;
+            }
+            LiveEntry NewEntry;
+            NewEntry.Name = Entry.Name;
+            NewEntry.ModifyTime = GetModifyTimeNanoseconds(EntryStat);
+            NewEntry.FileID = static_cast<UInt64>(EntryStat.st_ino);
+            if( S_ISDIR(EntryStat.st_mode) ) {
+                NewEntry.Type = EntryType::Directory;
+            }else if( S_ISLNK(EntryStat.st_mode) ) {
+                NewEntry.Type = EntryType::Symlink;
+                NewEntry.Size = static_cast<UInt64>(EntryStat.st_size);
+            }else if( S_ISREG(EntryStat.st_mode) ) {
+                NewEntry.Type = EntryType::File;
+                NewEntry.Size = static_cast<UInt64>(EntryStat.st_size);
+            }
+            Entries.push_back( std::move(NewEntry) );
+        }
+    #endif
+    }
+
+    /// @brief Builds the path of a child entry.
+    /// @param Path The path of the parent directory relative to the root, which will have the child appended.
+    /// @param Name The name of the child.
+    void AppendChildName(String& Path, const StringView Name)
+    {
+        if( !Path.empty() ) {
+            Path.push_back('/');
+        }
+        Path.append(Name.data(),Name.size());
+    }
+    /// @brief Lists a node and everything inside of it as a single kind of change.
+    /// @param Tree The snapshot holding the node.
+    /// @param Index The index of the node in the snapshot.
+    /// @param Path The path of the node relative to the root. This is restored before returning.
+    /// @param Change The kind of change to list every entry as.
+    /// @param Changes The vector to append the changes to.
+    void ListSubtree(const Filesystem::TreeSnapshot& Tree, const size_t Index, String& Path,
+                     const Filesystem::TreeChangeType Change, Filesystem::TreeChangeVector& Changes)
+    {
+        const Filesystem::TreeSnapshot::Node& Listed = Tree.GetNode(Index);
+        Changes.push_back( { Path, Change, Listed.Type } );
+        const size_t PathLength = Path.size();
+        for( size_t Child = Listed.FirstChild ; Child < Listed.FirstChild + Listed.ChildCount ; ++Child )
+        {
+            AppendChildName(Path,Tree.GetName(Child));
+            ListSubtree(Tree,Child,Path,Change,Changes);
+            Path.resize(PathLength);
+        }
+    }
+    /// @brief Lists the differences between the contents of two directory nodes.
+    /// @param Older The earlier snapshot.
+    /// @param OldIndex The index of the directory node in the earlier snapshot.
+    /// @param Newer The later snapshot.
+    /// @param NewIndex The index of the directory node in the later snapshot.
+    /// @param Path The path of the directory relative to the root. This is restored before returning.
+    /// @param Changes The vector to append the changes to.
+    void DiffChildren(const Filesystem::TreeSnapshot& Older, const size_t OldIndex,
+                      const Filesystem::TreeSnapshot& Newer, const size_t NewIndex,
+                      String& Path, Filesystem::TreeChangeVector& Changes)
+    {
+        using Filesystem::TreeChangeType;
+        const Filesystem::TreeSnapshot::Node& OldDir = Older.GetNode(OldIndex);
+        const Filesystem::TreeSnapshot::Node& NewDir = Newer.GetNode(NewIndex);
+        size_t OldChild = OldDir.FirstChild;
+        size_t NewChild = NewDir.FirstChild;
+        const size_t OldEnd = OldDir.FirstChild + OldDir.ChildCount;
+        const size_t NewEnd = NewDir.FirstChild + NewDir.ChildCount;
+        const size_t PathLength = Path.size();
+
+        // Children are sorted by name, so both sets can be walked together.
+        while( OldChild < OldEnd || NewChild < NewEnd )
+        {
+            int Comparison = 0;
+            if( OldChild == OldEnd ) {
+                Comparison = 1;
+            }else if( NewChild == NewEnd ) {
+                Comparison = -1;
+            }else{
+                Comparison = Older.GetName(OldChild).compare( Newer.GetName(NewChild) );
+            }
+
+            if( Comparison < 0 ) {
+                AppendChildName(Path,Older.GetName(OldChild));
+                ListSubtree(Older,OldChild,Path,TreeChangeType::Removed,Changes);
+                ++OldChild;
+            }else if( Comparison > 0 ) {
+                AppendChildName(Path,Newer.GetName(NewChild));
+                ListSubtree(Newer,NewChild,Path,TreeChangeType::Added,Changes);
+                ++NewChild;
+            }else{
+                const Filesystem::TreeSnapshot::Node& OldNode = Older.GetNode(OldChild);
+                const Filesystem::TreeSnapshot::Node& NewNode = Newer.GetNode(NewChild);
+                AppendChildName(Path,Newer.GetName(NewChild));
+                if( OldNode.Type != NewNode.Type ) {
+                    ListSubtree(Older,OldChild,Path,TreeChangeType::Removed,Changes);
+                    ListSubtree(Newer,NewChild,Path,TreeChangeType::Added,Changes);
+                }else if( NewNode.Type == EntryType::Directory ) {
+                    DiffChildren(Older,OldChild,Newer,NewChild,Path,Changes);
+                }else if( OldNode.Size != NewNode.Size || OldNode.ModifyTime != NewNode.ModifyTime ||
+                          OldNode.FileID != NewNode.FileID )
+                {
+                    Changes.push_back( { Path, TreeChangeType::Modified, NewNode.Type } );
+                }
+                ++OldChild;
+                ++NewChild;
+            }
+            Path.resize(PathLength);
+        }
+    }
+}
+
+namespace Mezzanine {
+namespace Filesystem {
+    ///////////////////////////////////////////////////////////////////////////////
+    /// @brief A helper class for populating a TreeSnapshot from a live directory tree.
+    ///////////////////////////////////////
+    class TreeSnapshotBuilder
+    {
+    protected:
+        /// @brief The snapshot being populated.
+        TreeSnapshot& Snapshot;
+        /// @brief An earlier snapshot of the tree to reuse unchanged directories from, or nullptr.
+        const TreeSnapshot* Previous;
+
+        /// @brief Adds a node to the end of the snapshot.
+        /// @param Name The name of the entry.
+        /// @param Type Whether the entry is a File, Directory or Symlink.
+        /// @param Size The size in bytes of the entry.
+        /// @param ModifyTime The last modification time of the entry.
+        /// @param FileID The value the system uses to identify the entry.
+        void AppendNode(const StringView Name, const EntryType Type, const UInt64 Size, const UInt64 ModifyTime,
+                        const UInt64 FileID)
+        {
+            TreeSnapshot::Node NewNode;
+            NewNode.Size = Size;
+            NewNode.ModifyTime = ModifyTime;
+            NewNode.FileID = FileID;
+            NewNode.NameOffset = static_cast<UInt32>( this->Snapshot.Names.size() );
+            NewNode.NameLength = static_cast<UInt32>( Name.size() );
+            NewNode.Type = Type;
+            this->Snapshot.Names.append(Name.data(),Name.size());
+            this->Snapshot.Nodes.push_back(NewNode);
+        }
+        /// @brief Records the contents of a directory, and then the contents of its subdirectories.
+        /// @param DirPath The path of the directory to record.
+        /// @param DirIndex The index of the node for the directory, which has already been added.
+        /// @param PreviousIndex The index of the directory in the earlier snapshot, or its size if it isn't there.
+        void CaptureChildren(const String& DirPath, const size_t DirIndex, const size_t PreviousIndex)
+        {
+            const Boole HasPrevious = ( this->Previous != nullptr && PreviousIndex < this->Previous->size() &&
+                                        this->Previous->Nodes[PreviousIndex].Type == EntryType::Directory );
+            Boole Reused = false;
+            const size_t FirstChild = this->Snapshot.Nodes.size();
+            if( HasPrevious ) {
+                const TreeSnapshot::Node& OldDir = this->Previous->Nodes[PreviousIndex];
+                const TreeSnapshot::Node& NewDir = this->Snapshot.Nodes[DirIndex];
+                Reused = ( OldDir.ModifyTime == NewDir.ModifyTime && OldDir.FileID == NewDir.FileID );
+            }
+
+            if( Reused ) {
+                const TreeSnapshot::Node& OldDir = this->Previous->Nodes[PreviousIndex];
+                const size_t OldEnd = OldDir.FirstChild + OldDir.ChildCount;
+                for( size_t OldChild = OldDir.FirstChild ; OldChild < OldEnd ; ++OldChild )
+                {
+                    const TreeSnapshot::Node& OldNode = this->Previous->Nodes[OldChild];
+                    this->AppendNode(this->Previous->GetName(OldChild),OldNode.Type,OldNode.Size,
+                                     OldNode.ModifyTime,OldNode.FileID);
+                }
+            }else{
+                LiveEntryVector Entries;
+                ListDirectory(DirPath,Entries);
+                std::sort(Entries.begin(),Entries.end(),[](const LiveEntry& Left, const LiveEntry& Right) {
+                    return Left.Name < Right.Name;
+                });
+                for( const LiveEntry& Entry : Entries )
+                    { this->AppendNode(Entry.Name,Entry.Type,Entry.Size,Entry.ModifyTime,Entry.FileID); }
+            }
+
+            const size_t ChildCount = this->Snapshot.Nodes.size() - FirstChild;
+            if( ChildCount > 0 ) {
+                this->Snapshot.Nodes[DirIndex].FirstChild = static_cast<UInt32>(FirstChild);
+                this->Snapshot.Nodes[DirIndex].ChildCount = static_cast<UInt32>(ChildCount);
+            }
+            for( size_t Child = FirstChild ; Child < FirstChild + ChildCount ; ++Child )
+            {
+                if( this->Snapshot.Nodes[Child].Type != EntryType::Directory ) {
+                    continue;
+                }
+                const StringView ChildName = this->Snapshot.GetName(Child);
+                String ChildPath = DirPath;
+                if( ChildPath.empty() || ChildPath.back() != '/' ) {
+                    ChildPath.push_back('/');
+                }
+                ChildPath.append(ChildName.data(),ChildName.size());
+                size_t PreviousChild = this->Previous != nullptr ? this->Previous->size() : 0;
+                if( Reused ) {
+                    // Reused nodes have the metadata the subdirectory had, but its contents may have changed since.
+                    TreeSnapshot::Node& ChildNode = this->Snapshot.Nodes[Child];
+                    if( !GetDirectoryInfo(ChildPath,false,ChildNode.ModifyTime,ChildNode.FileID) ) {
+                        continue;
+                    }
+                    PreviousChild = this->Previous->Nodes[PreviousIndex].FirstChild + ( Child - FirstChild );
+                }else if( HasPrevious ) {
+                    PreviousChild = this->Previous->FindChild(PreviousIndex,ChildName);
+                }
+                this->CaptureChildren(ChildPath,Child,PreviousChild);
+            }
+        }
+    public:
+        /// @brief Class constructor.
+        /// @param Target The snapshot to be populated.
+        /// @param Earlier An earlier snapshot of the tree to reuse unchanged directories from, or nullptr.
+        TreeSnapshotBuilder(TreeSnapshot& Target, const TreeSnapshot* Earlier) :
+            Snapshot(Target),
+            Previous(Earlier)
+            {  }
+
+        /// @brief Records every entry in a directory tree.
+        /// @param Path The directory at the root of the tree.
+        void Capture(const StringView Path)
+        {
+            this->Snapshot.RootPath.assign(Path.data(),Path.size());
+            UInt64 ModifyTime = 0;
+            UInt64 FileID = 0;
+            if( !GetDirectoryInfo(this->Snapshot.RootPath,true,ModifyTime,FileID) ) {
+                return;
+            }
+            this->AppendNode(StringView(),EntryType::Directory,0,ModifyTime,FileID);
+            this->CaptureChildren(this->Snapshot.RootPath,0,0);
+        }
+    };//TreeSnapshotBuilder
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // TreeSnapshot Methods
+
+    size_t TreeSnapshot::Find(const StringView RelativePath) const noexcept
+    {
+        if( this->Nodes.empty() ) {
+            return 0;
+        }
+        size_t Current = 0;
+        size_t NameStart = 0;
+        while( NameStart < RelativePath.size() )
+        {
+            size_t NameEnd = RelativePath.find('/',NameStart);
+            if( NameEnd == StringView::npos ) {
+                NameEnd = RelativePath.size();
+            }
+            if( NameEnd > NameStart ) {
+                Current = this->FindChild(Current,RelativePath.substr(NameStart,NameEnd - NameStart));
+                if( Current == this->Nodes.size() ) {
+                    return Current;
+                }
+            }
+            NameStart = NameEnd + 1;
+        }
+        return Current;
+    }
+
+    size_t TreeSnapshot::FindChild(const size_t DirIndex, const StringView Name) const noexcept
+    {
+        const Node& Dir = this->Nodes[DirIndex];
+        size_t Low = Dir.FirstChild;
+        size_t High = Dir.FirstChild + Dir.ChildCount;
+        while( Low < High )
+        {
+            const size_t Middle = Low + ( ( High - Low ) / 2 );
+            const int Comparison = this->GetName(Middle).compare(Name);
+            if( Comparison == 0 ) {
+                return Middle;
+            }else if( Comparison < 0 ) {
+                Low = Middle + 1;
+            }else{
+                High = Middle;
+            }
+        }
+        return this->Nodes.size();
+    }
+
+    String TreeSnapshot::Serialize() const
+    {
+        String Ret;
+        Ret.reserve( SerializedHeaderSize + this->RootPath.size() + this->Names.size() +
+                     ( this->Nodes.size() * SerializedNodeSize ) );
+        Ret.append(SnapshotMagic,sizeof(SnapshotMagic));
+        AppendLittleEndian(Ret,SnapshotVersion,4);
+        AppendLittleEndian(Ret,this->Nodes.size(),8);
+        AppendLittleEndian(Ret,this->Names.size(),8);
+        AppendLittleEndian(Ret,this->RootPath.size(),8);
+        Ret.append(this->RootPath);
+        Ret.append(this->Names);
+        for( const Node& Current : this->Nodes )
+        {
+            AppendLittleEndian(Ret,Current.Size,8);
+            AppendLittleEndian(Ret,Current.ModifyTime,8);
+            AppendLittleEndian(Ret,Current.FileID,8);
+            AppendLittleEndian(Ret,Current.NameOffset,4);
+            AppendLittleEndian(Ret,Current.NameLength,4);
+            AppendLittleEndian(Ret,Current.FirstChild,4);
+            AppendLittleEndian(Ret,Current.ChildCount,4);
+            AppendLittleEndian(Ret,static_cast<UInt64>(Current.Type),1);
+        }
+        return Ret;
+    }
+
+    Boole TreeSnapshot::Deserialize(const StringView Data)
+    {
+        this->Nodes.clear();
+        this->Names.clear();
+        this->RootPath.clear();
+
+        LittleEndianReader Reader(Data);
+        StringView Magic;
+        UInt64 Version = 0;
+        UInt64 NodeCount = 0;
+        UInt64 NameBytes = 0;
+        UInt64 RootBytes = 0;
+        if( !Reader.Read(sizeof(SnapshotMagic),Magic) || Magic != StringView(SnapshotMagic,sizeof(SnapshotMagic)) ||
+            !Reader.Read(4,Version) || Version != SnapshotVersion ||
+            !Reader.Read(8,NodeCount) || !Reader.Read(8,NameBytes) || !Reader.Read(8,RootBytes) )
+        {
+            return false;
+        }
+        // Check the sizes against what's actually there before trusting them with an allocation.
+        const UInt64 Remaining = Reader.GetRemaining();
+        if( RootBytes > Remaining || NameBytes > Remaining - RootBytes ||
+            NodeCount > ( Remaining - RootBytes - NameBytes ) / SerializedNodeSize ||
+            NodeCount > std::numeric_limits<UInt32>::max() || NameBytes > std::numeric_limits<UInt32>::max() )
+        {
+            return false;
+        }
+        StringView RootView;
+        StringView NameView;
+        static_cast<void>( Reader.Read(static_cast<size_t>(RootBytes),RootView) );
+        static_cast<void>( Reader.Read(static_cast<size_t>(NameBytes),NameView) );
+
+        NodeContainer Loaded;
+        Loaded.reserve( static_cast<size_t>(NodeCount) );
+        for( UInt64 Index = 0 ; Index < NodeCount ; ++Index )
+        {
+            UInt64 Fields[7] = { 0, 0, 0, 0, 0, 0, 0 };
+            for( size_t Field = 0 ; Field < 7 ; ++Field )
+                { static_cast<void>( Reader.Read(( Field < 3 ? 8 : 4 ),Fields[Field]) ); }
+            UInt64 Type = 0;
+            static_cast<void>( Reader.Read(1,Type) );
+
+            Node Current;
+            Current.Size = Fields[0];
+            Current.ModifyTime = Fields[1];
+            Current.FileID = Fields[2];
+            Current.NameOffset = static_cast<UInt32>(Fields[3]);
+            Current.NameLength = static_cast<UInt32>(Fields[4]);
+            Current.FirstChild = static_cast<UInt32>(Fields[5]);
+            Current.ChildCount = static_cast<UInt32>(Fields[6]);
+            Current.Type = static_cast<EntryType>(Type);
+
+            // Children must come after their parent so a malformed snapshot can't make the tree loop.
+            const Boole ValidType = ( Type <= static_cast<UInt64>(EntryType::Symlink) );
+            const Boole ValidName = ( Fields[3] + Fields[4] <= NameBytes );
+            const Boole ValidChildren = ( Current.ChildCount == 0 ||
+                                          ( Current.Type == EntryType::Directory && Fields[5] > Index &&
+                                            Fields[5] + Fields[6] <= NodeCount ) );
+            if( !ValidType || !ValidName || !ValidChildren ) {
+                return false;
+            }
+            Loaded.push_back(Current);
+        }
+        if( !Loaded.empty() && Loaded.front().Type != EntryType::Directory ) {
+            return false;
+        }
+
+        this->Nodes = std::move(Loaded);
+        this->Names.assign(NameView.data(),NameView.size());
+        this->RootPath.assign(RootView.data(),RootView.size());
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Tree Snapshot Capturing
+
+    TreeSnapshot CaptureTreeSnapshot(const StringView Path)
+    {
+        TreeSnapshot Ret;
+        TreeSnapshotBuilder(Ret,nullptr).Capture(Path);
+        return Ret;
+    }
+
+    TreeSnapshot CaptureTreeSnapshot(const StringView Path, const TreeSnapshot& Previous)
+    {
+        TreeSnapshot Ret;
+        TreeSnapshotBuilder(Ret,&Previous).Capture(Path);
+        return Ret;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Tree Snapshot Files
+
+    ModifyResult SaveTreeSnapshot(const TreeSnapshot& Snapshot, const StringView FilePath)
+    {
+        return AtomicWriteFile(FilePath,Snapshot.Serialize(),DurabilityPolicy::FlushFile);
+    }
+
+    Optional<TreeSnapshot> LoadTreeSnapshot(const StringView FilePath)
+    {
+        String Data;
+    #ifdef MEZZ_Windows
+        const WideString WidePath = ConvertToWideString(FilePath);
+        HANDLE FileHandle = ::CreateFileW(WidePath.c_str(),GENERIC_READ,FILE_SHARE_READ,nullptr,OPEN_EXISTING,
+                                          FILE_ATTRIBUTE_NORMAL,nullptr);
+        if( FileHandle == INVALID_HANDLE_VALUE ) {
+            return std::nullopt;
+        }
+        LARGE_INTEGER FileSize;
+        if( ::GetFileSizeEx(FileHandle,&FileSize) == 0 ) {
+            ::CloseHandle(FileHandle);
+            return std::nullopt;
+        }
+        Data.resize( static_cast<size_t>(FileSize.QuadPart) );
+        size_t ReadTotal = 0;
+        while( ReadTotal < Data.size() )
+        {
+            const DWORD ToRead = static_cast<DWORD>( std::min<size_t>(Data.size() - ReadTotal,0x40000000) );
+            DWORD ReadCount = 0;
+            if( ::ReadFile(FileHandle,&Data[ReadTotal],ToRead,&ReadCount,nullptr) == 0 || ReadCount == 0 ) {
+                break;
+            }
+            ReadTotal += ReadCount;
+        }
+        ::CloseHandle(FileHandle);
+    #else
+        const String NarrowPath(FilePath);
+        const int FileHandle = ::open(NarrowPath.c_str(),O_RDONLY | O_CLOEXEC);
+        if( FileHandle == -1 ) {
+            return std::nullopt;
+        }
+        struct stat FileStat;
+        if( ::fstat(FileHandle,&FileStat) != 0 ) {
+            ::close(FileHandle);
+            return std::nullopt;
+        }
+        Data.resize( static_cast<size_t>(FileStat.st_size) );
+        size_t ReadTotal = 0;
+        while( ReadTotal < Data.size() )
+        {
+            const ssize_t ReadCount = ::read(FileHandle,&Data[ReadTotal],Data.size() - ReadTotal);
+            if( ReadCount == -1 && errno == EINTR ) {
+                continue;
+            }else if( ReadCount <= 0 ) {
+                break;
+            }
+            ReadTotal += static_cast<size_t>(ReadCount);
+        }
+        ::close(FileHandle);
+    #endif
+        Data.resize(ReadTotal);
+
+        TreeSnapshot Ret;
+        if( !Ret.Deserialize(Data) ) {
+            return std::nullopt;
+        }
+        return Ret;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Tree Differences
+
+    TreeChangeVector DiffTreeSnapshots(const TreeSnapshot& Older, const TreeSnapshot& Newer)
+    {
+        TreeChangeVector Ret;
+        String Path;
+        if( !Older.empty() && !Newer.empty() ) {
+            DiffChildren(Older,0,Newer,0,Path,Ret);
+        }else if( !Older.empty() || !Newer.empty() ) {
+            // One side has no tree at all, so everything in the other was either added or removed.
+            const TreeSnapshot& Listed = ( Older.empty() ? Newer : Older );
+            const TreeChangeType Change = ( Older.empty() ? TreeChangeType::Added : TreeChangeType::Removed );
+            const TreeSnapshot::Node& Root = Listed.GetNode(0);
+            for( size_t Child = Root.FirstChild ; Child < Root.FirstChild + Root.ChildCount ; ++Child )
+            {
+                Path.assign( Listed.GetName(Child) );
+                ListSubtree(Listed,Child,Path,Change,Ret);
+            }
+        }
+        return Ret;
+    }
+
+    TreeChangeVector DiffTreeSnapshot(const TreeSnapshot& Older, const StringView Path)
+    {
+        return DiffTreeSnapshots(Older,CaptureTreeSnapshot(Path));
+    }
+
+    TreeChangeVector DiffTreeSnapshot(const TreeSnapshot& Older, const StringView Path,
+                                      const Boole SkipUnchangedDirectories)
+    {
+        if( SkipUnchangedDirectories ) {
+            return DiffTreeSnapshots(Older,CaptureTreeSnapshot(Path,Older));
+        }
+        return DiffTreeSnapshot(Older,Path);
+    }
+}//Filesystem
+}//Mezzanine
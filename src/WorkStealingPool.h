@@ -0,0 +1,317 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_WorkStealingPool_h
+#define Mezz_Filesystem_WorkStealingPool_h
+
+/// @file
+/// @brief A small internal thread pool used to spread filesystem work over several threads.
+
+#include "DataTypes.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Mezzanine {
+namespace Filesystem {
+    ///////////////////////////////////////////////////////////////////////////////
+    /// @brief A fixed size pool of threads where each thread has its own queue of tasks and idle threads steal
+    /// tasks from the queues of busy threads.
+    /// @details Tasks submitted from a worker thread are pushed onto that worker's own queue and the worker pops
+    /// them from the back, so recursive work such as walking a directory tree tends to stay on the thread that
+    /// found it and stays depth first. Idle workers steal from the front of other queues, which holds the oldest
+    /// and usually largest pieces of work. Tasks submitted from outside the pool go to a shared queue. @n @n
+    /// This is intentionally simple, each queue is guarded by its own mutex. Filesystem tasks are dominated by
+    /// system calls, so contention on the queues is not a concern.
+    ///////////////////////////////////////
+    class WorkStealingPool
+    {
+    public:
+        /// @brief The type of callable the pool runs.
+        using TaskType = std::function<void()>;
+    protected:
+        /// @brief A queue of tasks and the lock guarding it.
+        struct TaskQueue
+        {
+            /// @brief The lock that must be held to access the tasks.
+            std::mutex QueueLock;
+            /// @brief The tasks waiting to be run.
+            std::deque<TaskType> Tasks;
+        };//TaskQueue
+
+        /// @brief One queue per worker, followed by the queue for tasks submitted from outside the pool.
+        std::vector< std::unique_ptr<TaskQueue> > Queues;
+        /// @brief The threads running tasks.
+        std::vector<std::thread> Workers;
+        /// @brief The lock used with WorkAvailable to put idle workers to sleep.
+        std::mutex SleepLock;
+        /// @brief Signaled whenever a task is submitted or the pool is shutting down.
+        std::condition_variable WorkAvailable;
+        /// @brief The number of tasks sitting in any queue.
+        std::atomic<size_t> QueuedTasks{0};
+        /// @brief Set when the pool is being destroyed.
+        std::atomic<Boole> Stopping{false};
+
+        /// @brief Gets the index of the queue the calling thread should push to and pop from.
+        /// @return Returns the index of the calling worker, or the index of the shared queue for other threads.
+        size_t GetLocalQueueIndex() const noexcept
+        {
+            const std::pair<const WorkStealingPool*,size_t>& Local = GetThreadWorker();
+            return ( Local.first == this ? Local.second : this->Workers.size() );
+        }
+        /// @brief Gets which pool and worker the calling thread belongs to.
+        /// @return Returns a reference to the thread local pool and worker index of the calling thread.
+        static std::pair<const WorkStealingPool*,size_t>& GetThreadWorker() noexcept
+        {
+            static thread_local std::pair<const WorkStealingPool*,size_t> ThreadWorker(nullptr,0);
+            return ThreadWorker;
+        }
+        /// @brief Takes a task to run, first from the local queue, then the shared queue, then other workers.
+        /// @param Local The index of the queue belonging to the calling thread.
+        /// @param ToRun The task taken from a queue, if any.
+        /// @return Returns true if a task was taken, false if every queue was empty.
+        Boole TakeTask(const size_t Local, TaskType& ToRun)
+        {
+            if( this->QueuedTasks.load(std::memory_order_acquire) == 0 ) {
+                return false;
+            }
+            const size_t QueueCount = this->Queues.size();
+            for( size_t Offset = 0 ; Offset < QueueCount ; ++Offset )
+            {
+                const size_t Index = ( Local + Offset ) % QueueCount;
+                TaskQueue& Queue = *( this->Queues[Index] );
+                std::lock_guard<std::mutex> Lock(Queue.QueueLock);
+                if( Queue.Tasks.empty() ) {
+                    continue;
+                }
+                // Our own work is taken newest first, stolen work is taken oldest first.
+                if( Offset == 0 ) {
+                    ToRun = std::move( Queue.Tasks.back() );
+                    Queue.Tasks.pop_back();
+                }else{
+                    ToRun = std::move( Queue.Tasks.front() );
+                    Queue.Tasks.pop_front();
+                }
+                this->QueuedTasks.fetch_sub(1,std::memory_order_acq_rel);
+                return true;
+            }
+            return false;
+        }
+        /// @brief The loop run by every worker thread.
+        /// @param Index The index of the worker, and of its queue.
+        void WorkerLoop(const size_t Index)
+        {
+            GetThreadWorker() = std::make_pair(this,Index);
+            TaskType ToRun;
+            while( !this->Stopping.load(std::memory_order_acquire) )
+            {
+                if( this->TakeTask(Index,ToRun) ) {
+                    ToRun();
+                    ToRun = nullptr;
+                    continue;
+                }
+                std::unique_lock<std::mutex> Lock(this->SleepLock);
+                this->WorkAvailable.wait(Lock,[this](){
+                    return this->QueuedTasks.load(std::memory_order_acquire) > 0 ||
+                           this->Stopping.load(std::memory_order_acquire);
+                });
+            }
+        }
+    public:
+        /// @brief Thread count constructor.
+        /// @param ThreadCount The number of worker threads to start. This can be zero, in which case tasks are
+        /// only run by threads waiting on a TaskGroup.
+        explicit WorkStealingPool(const size_t ThreadCount)
+        {
+            for( size_t QueueNum = 0 ; QueueNum <= ThreadCount ; ++QueueNum )
+                { this->Queues.push_back( std::make_unique<TaskQueue>() ); }
+            for( size_t WorkerNum = 0 ; WorkerNum < ThreadCount ; ++WorkerNum )
+                { this->Workers.emplace_back([this,WorkerNum](){ this->WorkerLoop(WorkerNum); }); }
+        }
+        /// @brief Deleted copy constructor.
+        WorkStealingPool(const WorkStealingPool&) = delete;
+        /// @brief Class destructor.
+        /// @remarks Tasks that haven't started yet are discarded. Running tasks are waited on.
+        ~WorkStealingPool()
+        {
+            {
+                std::lock_guard<std::mutex> Lock(this->SleepLock);
+                this->Stopping.store(true,std::memory_order_release);
+            }
+            this->WorkAvailable.notify_all();
+            for( std::thread& Worker : this->Workers )
+                { Worker.join(); }
+        }
+
+        /// @brief Deleted copy assignment operator.
+        WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+        /// @brief Gets the number of worker threads in the pool.
+        /// @return Returns the number of threads running tasks.
+        size_t GetThreadCount() const noexcept
+            { return this->Workers.size(); }
+        /// @brief Adds a task to be run by the pool.
+        /// @param ToRun The task to be run.
+        void Submit(TaskType ToRun)
+        {
+            {
+                TaskQueue& Queue = *( this->Queues[ this->GetLocalQueueIndex() ] );
+                std::lock_guard<std::mutex> Lock(Queue.QueueLock);
+                Queue.Tasks.push_back( std::move(ToRun) );
+                this->QueuedTasks.fetch_add(1,std::memory_order_acq_rel);
+            }
+            // Briefly take the sleep lock so a worker can't miss the notify between checking and sleeping.
+            { std::lock_guard<std::mutex> Lock(this->SleepLock); }
+            this->WorkAvailable.notify_one();
+        }
+        /// @brief Runs one queued task on the calling thread, if there are any.
+        /// @remarks This allows threads waiting on tasks to help complete them rather than sitting idle.
+        /// @return Returns true if a task was run, false if there were none queued.
+        Boole RunPendingTask()
+        {
+            TaskType ToRun;
+            if( this->TakeTask(this->GetLocalQueueIndex(),ToRun) ) {
+                ToRun();
+                return true;
+            }
+            return false;
+        }
+    };//WorkStealingPool
+
+    ///////////////////////////////////////////////////////////////////////////////
+    /// @brief A set of related tasks submitted to a WorkStealingPool that can be waited on together.
+    /// @details Tasks in a group may add more tasks to the same group. Waiting on a group runs queued tasks on the
+    /// waiting thread until every task in the group has completed, so it is safe for a task to wait on a group of
+    /// tasks it submitted. If a task throws, the first exception is kept and rethrown by Wait.
+    ///////////////////////////////////////
+    class TaskGroup
+    {
+    protected:
+        /// @brief The pool running the tasks.
+        WorkStealingPool& Pool;
+        /// @brief The lock guarding the outstanding count and first exception, and used to sleep while waiting.
+        std::mutex GroupLock;
+        /// @brief Signaled when the last outstanding task completes.
+        std::condition_variable Finished;
+        /// @brief The first exception thrown by a task in this group.
+        std::exception_ptr FirstException;
+        /// @brief The number of tasks submitted that haven't completed.
+        size_t Outstanding = 0;
+    public:
+        /// @brief Pool constructor.
+        /// @param ToUse The pool that will run tasks in this group.
+        explicit TaskGroup(WorkStealingPool& ToUse) :
+            Pool(ToUse)
+            {  }
+        /// @brief Deleted copy constructor.
+        TaskGroup(const TaskGroup&) = delete;
+        /// @brief Class destructor.
+        /// @remarks Waits for outstanding tasks, since they reference this group.
+        ~TaskGroup()
+        {
+            try{
+                this->Wait();
+            }catch(...){
+                // Anyone who cared about the exception would have called Wait themselves.
+            }
+        }
+
+        /// @brief Deleted copy assignment operator.
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        /// @brief Submits a task to the pool as part of this group.
+        /// @param ToRun The task to be run.
+        void Run(WorkStealingPool::TaskType ToRun)
+        {
+            {
+                std::lock_guard<std::mutex> Lock(this->GroupLock);
+                ++(this->Outstanding);
+            }
+            this->Pool.Submit([this,Task = std::move(ToRun)](){
+                std::exception_ptr Thrown;
+                try{
+                    Task();
+                }catch(...){
+                    Thrown = std::current_exception();
+                }
+                // Everything is done under the lock, since Wait can return and the group be destroyed as soon
+                // as the lock is released after the count reaches zero.
+                std::lock_guard<std::mutex> Lock(this->GroupLock);
+                if( Thrown && !this->FirstException ) {
+                    this->FirstException = Thrown;
+                }
+                if( --(this->Outstanding) == 0 ) {
+                    this->Finished.notify_all();
+                }
+            });
+        }
+        /// @brief Blocks until every task in the group has completed, helping to run queued tasks meanwhile.
+        /// @exception Rethrows the first exception thrown by a task in this group, if any.
+        void Wait()
+        {
+            std::unique_lock<std::mutex> Lock(this->GroupLock);
+            while( this->Outstanding > 0 )
+            {
+                Lock.unlock();
+                const Boole RanTask = this->Pool.RunPendingTask();
+                Lock.lock();
+                if( !RanTask && this->Outstanding > 0 ) {
+                    // Nothing to help with, sleep a little in case more tasks get queued that we could help with.
+                    this->Finished.wait_for(Lock,std::chrono::milliseconds(1));
+                }
+            }
+            if( this->FirstException ) {
+                std::exception_ptr ToThrow = this->FirstException;
+                this->FirstException = nullptr;
+                std::rethrow_exception(ToThrow);
+            }
+        }
+    };//TaskGroup
+}//Filesystem
+}//Mezzanine
+
+#endif
@@ -0,0 +1,91 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_AllocationCounter_h
+#define Mezz_Filesystem_AllocationCounter_h
+
+/// @file
+/// @brief Replaces the global allocation functions so tests and benchmarks can count heap allocations.
+/// @warning This may only be included in the single translation unit that makes up the test executable.
+
+#include "DataTypes.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace Mezzanine {
+namespace Filesystem {
+    /// @brief Gets the counter of every allocation made through the global operator new.
+    /// @return Returns a reference to the counter incremented by the replacement allocation functions.
+    inline std::atomic<size_t>& GetAllocationCounter()
+    {
+        static std::atomic<size_t> Counter{0};
+        return Counter;
+    }
+    /// @brief Counts the heap allocations made while running a callable.
+    /// @remarks Allocations made by other threads while the callable runs are counted as well.
+    /// @param ToCount The callable to be run.
+    /// @return Returns the number of times the global operator new was called while ToCount ran.
+    template<typename Callable>
+    size_t CountAllocations(Callable&& ToCount)
+    {
+        size_t Before = GetAllocationCounter().load(std::memory_order_relaxed);
+        ToCount();
+        return GetAllocationCounter().load(std::memory_order_relaxed) - Before;
+    }
+}//Filesystem
+}//Mezzanine
+
+void* operator new(std::size_t Size)
+{
+    Mezzanine::Filesystem::GetAllocationCounter().fetch_add(1,std::memory_order_relaxed);
+    if( void* Ret = std::malloc( Size > 0 ? Size : 1 ) ) {
+        return Ret;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ToFree) noexcept
+    { std::free(ToFree); }
+
+void operator delete(void* ToFree, std::size_t) noexcept
+    { std::free(ToFree); }
+
+#endif
@@ -0,0 +1,169 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_AsyncOperationQueueTests_h
+#define Mezz_Filesystem_AsyncOperationQueueTests_h
+
+/// @file
+/// @brief A few tests of running filesystem operations on dedicated threads.
+
+#include "MezzTest.h"
+
+#include "AsyncOperationQueue.h"
+#include "FilesystemManagement.h"
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+
+AUTOMATIC_TEST_GROUP(AsyncOperationQueueTests,AsyncOperationQueue)
+{
+    using namespace Mezzanine;
+    using Priority = Filesystem::OperationPriority;
+    const Filesystem::ModifyResult Success = Filesystem::ModifyResult::Success;
+
+    {// Futures and Callbacks
+        const String AsyncDir("./AsyncQueue/");
+        Filesystem::AsyncOperationQueue Queue;
+        TEST_EQUAL("AsyncOperationQueue::GetThreadCount()-Default",size_t(2),Queue.GetThreadCount())
+        TEST_EQUAL("AsyncOperationQueue::GetMaxQueueDepth()-Default",size_t(1024),Queue.GetMaxQueueDepth())
+
+        std::future<Filesystem::ModifyResult> Created = Queue.CreateDirectoryPath(AsyncDir + "Deep/Deeper/");
+        TEST_EQUAL("AsyncOperationQueue::CreateDirectoryPath(const_StringView,const_OperationPriority)",
+                   true,Created.get() == Success)
+        TEST_EQUAL("AsyncOperationQueue::AtomicWriteFile(...)",
+                   true,Queue.AtomicWriteFile(AsyncDir + "Data.txt","Async data.",
+                                              Filesystem::DurabilityPolicy::None).get() == Success)
+        TEST_EQUAL("AsyncOperationQueue::CopyFile(...)",
+                   true,Queue.CopyFile(AsyncDir + "Data.txt",AsyncDir + "Deep/Copy.txt",
+                                       Filesystem::FileOverwrite::Deny).get() == Success)
+        TEST_EQUAL("AsyncOperationQueue::MoveFile(...)",
+                   true,Queue.MoveFile(AsyncDir + "Deep/Copy.txt",AsyncDir + "Deep/Deeper/Moved.txt",
+                                       Filesystem::FileOverwrite::Deny).get() == Success)
+        TEST_EQUAL("AsyncOperationQueue::RemoveFile(const_StringView,const_OperationPriority)-Missing",
+                   true,Queue.RemoveFile(AsyncDir + "NotAFile.txt").get() == Filesystem::ModifyResult::DoesNotExist)
+
+        std::atomic<Whole> CallbackCount{0};
+        std::atomic<Whole> CallbackSuccesses{0};
+        const Whole CallbackOps = 50;
+        for( Whole OpNum = 0 ; OpNum < CallbackOps ; ++OpNum )
+        {
+            const String FileName = AsyncDir + "Callback" + std::to_string(OpNum) + ".txt";
+            Queue.Submit([FileName](){
+                return Filesystem::AtomicWriteFile(FileName,FileName,Filesystem::DurabilityPolicy::None);
+            },[&](const Filesystem::ModifyResult Result){
+                CallbackSuccesses += ( Result == Filesystem::ModifyResult::Success );
+                ++CallbackCount;
+            });
+        }
+        Queue.WaitForAll();
+        TEST_EQUAL("AsyncOperationQueue::Submit(Operation,CompletionCallback,const_OperationPriority)-Count",
+                   CallbackOps,CallbackCount.load())
+        TEST_EQUAL("AsyncOperationQueue::Submit(Operation,CompletionCallback,const_OperationPriority)-Results",
+                   CallbackOps,CallbackSuccesses.load())
+        TEST_EQUAL("AsyncOperationQueue::GetPendingCount()-AfterWait",size_t(0),Queue.GetPendingCount())
+
+        std::future<Filesystem::ModifyResult> Throwing = Queue.Submit([]() -> Filesystem::ModifyResult {
+            throw std::runtime_error("Operation failed.");
+        });
+        TEST_THROW("AsyncOperationQueue::Submit(Operation,const_OperationPriority)-Throws",std::runtime_error,[&](){
+            static_cast<void>( Throwing.get() );
+        });
+        std::promise<Filesystem::ModifyResult> ThrownResult;
+        Queue.Submit([]() -> Filesystem::ModifyResult {
+            throw std::runtime_error("Operation failed.");
+        },[&](const Filesystem::ModifyResult Result){
+            ThrownResult.set_value(Result);
+        });
+        TEST_EQUAL("AsyncOperationQueue::Submit(Operation,CompletionCallback,const_OperationPriority)-Throws",
+                   true,ThrownResult.get_future().get() == Filesystem::ModifyResult::Unknown)
+
+        TEST_EQUAL("AsyncOperationQueue::RemoveDirectoryTree(const_StringView,const_OperationPriority)",
+                   true,Queue.RemoveDirectoryTree(AsyncDir).get() == Success)
+    }// Futures and Callbacks
+
+    {// Priorities and Queue Depth
+        Filesystem::AsyncQueueOptions Options;
+        Options.ThreadCount = 1;
+        Options.MaxQueueDepth = 3;
+        Filesystem::AsyncOperationQueue Queue(Options);
+
+        // Hold the only thread so everything else has to wait in the queue.
+        std::promise<void> Gate;
+        std::shared_future<void> GateOpened = Gate.get_future().share();
+        std::promise<void> Started;
+        Queue.Submit([GateOpened,&Started](){
+            Started.set_value();
+            GateOpened.wait();
+            return Filesystem::ModifyResult::Success;
+        },[](const Filesystem::ModifyResult){  });
+        Started.get_future().wait();
+
+        std::mutex OrderLock;
+        StringVector Order;
+        auto Record = [&](const String& Name) {
+            return [&,Name](){
+                std::lock_guard<std::mutex> Lock(OrderLock);
+                Order.push_back(Name);
+                return Filesystem::ModifyResult::Success;
+            };
+        };
+        std::future<Filesystem::ModifyResult> LowResult = Queue.TrySubmit(Record("Low"),Priority::Low);
+        std::future<Filesystem::ModifyResult> NormalResult = Queue.TrySubmit(Record("Normal"),Priority::Normal);
+        Boole HighQueued = Queue.TrySubmit(Record("High"),[](const Filesystem::ModifyResult){  },Priority::High);
+        std::future<Filesystem::ModifyResult> Rejected = Queue.TrySubmit(Record("Rejected"),Priority::High);
+
+        TEST_EQUAL("AsyncOperationQueue::TrySubmit(Operation,const_OperationPriority)-Queued",
+                   true,LowResult.valid() && NormalResult.valid() && HighQueued)
+        TEST_EQUAL("AsyncOperationQueue::GetWaitingCount()-Full",size_t(3),Queue.GetWaitingCount())
+        TEST_EQUAL("AsyncOperationQueue::GetPendingCount()-Full",size_t(4),Queue.GetPendingCount())
+        TEST_EQUAL("AsyncOperationQueue::TrySubmit(Operation,const_OperationPriority)-Full",
+                   false,Rejected.valid())
+        TEST_EQUAL("AsyncOperationQueue::TrySubmit(Operation,CompletionCallback,const_OperationPriority)-Full",
+                   false,Queue.TrySubmit(Record("Rejected"),[](const Filesystem::ModifyResult){  }))
+
+        Gate.set_value();
+        Queue.WaitForAll();
+        TEST_EQUAL("AsyncOperationQueue-PriorityOrder",
+                   true,Order == StringVector({ "High", "Normal", "Low" }))
+    }// Priorities and Queue Depth
+}
+
+#endif
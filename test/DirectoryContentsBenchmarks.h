@@ -0,0 +1,220 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_DirectoryContentsBenchmarks_h
+#define Mezz_Filesystem_DirectoryContentsBenchmarks_h
+
+/// @file
+/// @brief Timings of the different ways directory contents can be retrieved.
+
+#include "MezzTest.h"
+
+#include "AllocationCounter.h"
+#include "DirectoryContents.h"
+#include "FilesystemManagement.h"
+
+#include <chrono>
+
+#ifndef MEZZ_Windows
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+BENCHMARK_TEST_GROUP(DirectoryContentsBenchmarks,DirectoryContentsBenchmarks)
+{
+    using namespace Mezzanine;
+    using BenchClock = std::chrono::steady_clock;
+    using Milliseconds = std::chrono::duration<double,std::milli>;
+
+    const String BenchDir("./ContentBench/");
+    const Whole EntryCount = 100000;
+    const Whole Iterations = 5;
+
+    /// @brief Runs a callable several times and returns the fastest run, in milliseconds.
+    auto BestOf = [Iterations](auto&& ToTime) {
+        double Best = std::numeric_limits<double>::max();
+        for( Whole Iteration = 0 ; Iteration < Iterations ; ++Iteration )
+        {
+            BenchClock::time_point Start = BenchClock::now();
+            ToTime();
+            Best = std::min( Best, Milliseconds( BenchClock::now() - Start ).count() );
+        }
+        return Best;
+    };
+
+    if( Filesystem::CreateDirectory(BenchDir) == false ) {
+        TEST_RESULT("CreateBenchDir",Testing::TestResult::Failed)
+        return;
+    }
+    StringVector BenchFiles;
+    BenchFiles.reserve(EntryCount);
+    for( Whole FileNum = 0 ; FileNum < EntryCount ; ++FileNum )
+    {
+        BenchFiles.push_back( BenchDir + "AssetFileWithAReasonablyLongName" + std::to_string(FileNum) + ".dat" );
+        std::ofstream BenchFile(BenchFiles.back());
+    }
+    TestLog << "Listing a directory of " << EntryCount << " files, best of " << Iterations << " runs.\n";
+
+    {// Batched getdents64 vs readdir
+        ArchiveEntryVector PortableEntries;
+        ArchiveEntryVector BatchedEntries;
+        StringVector PortableNames;
+        StringVector BatchedNames;
+
+        double PortableTime = BestOf([&](){ PortableEntries = Filesystem::GetDirectoryContents(BenchDir,0); });
+        double BatchedTime = BestOf([&](){ BatchedEntries = Filesystem::GetDirectoryContents(BenchDir); });
+        double PortableNameTime = BestOf([&](){ PortableNames = Filesystem::GetDirectoryContentNames(BenchDir,0); });
+        double BatchedNameTime = BestOf([&](){ BatchedNames = Filesystem::GetDirectoryContentNames(BenchDir); });
+
+        TestLog << "GetDirectoryContents - readdir: " << PortableTime << "ms, "
+                << "batched: " << BatchedTime << "ms.\n";
+        TestLog << "GetDirectoryContentNames - readdir: " << PortableNameTime << "ms, "
+                << "batched: " << BatchedNameTime << "ms.\n";
+        for( size_t BatchSize : { size_t(4 * 1024), size_t(32 * 1024), size_t(256 * 1024), size_t(1024 * 1024) } )
+        {
+            double BatchSizeTime = BestOf([&](){
+                BatchedNames = Filesystem::GetDirectoryContentNames(BenchDir,BatchSize);
+            });
+            TestLog << "GetDirectoryContentNames - " << ( BatchSize / 1024 ) << "KiB batches: "
+                    << BatchSizeTime << "ms.\n";
+        }
+
+        TEST_EQUAL("Batched-ContentsCount",PortableEntries.size(),BatchedEntries.size())
+        TEST_EQUAL("Batched-NamesCount",PortableNames.size(),BatchedNames.size())
+    }// Batched getdents64 vs readdir
+
+    {// Full metadata vs type only
+        Filesystem::DirectoryContentsOptions TypeOnlyOptions;
+        TypeOnlyOptions.Metadata = Filesystem::EntryMetadata::Type;
+        ArchiveEntryVector FullEntries;
+        ArchiveEntryVector TypeEntries;
+
+        double FullTime = BestOf([&](){ FullEntries = Filesystem::GetDirectoryContents(BenchDir); });
+        double TypeTime = BestOf([&](){ TypeEntries = Filesystem::GetDirectoryContents(BenchDir,TypeOnlyOptions); });
+
+        TestLog << "GetDirectoryContents - all metadata: " << FullTime << "ms, "
+                << "type only: " << TypeTime << "ms.\n";
+        TEST_EQUAL("TypeOnly-Count",FullEntries.size(),TypeEntries.size())
+    }// Full metadata vs type only
+
+    {// StringVector vs arena backed names
+        StringVector VectorNames;
+        size_t VectorAllocs = 0;
+        double VectorTime = BestOf([&](){
+            VectorAllocs = Filesystem::CountAllocations([&](){
+                VectorNames = Filesystem::GetDirectoryContentNames(BenchDir);
+            });
+        });
+
+        // Warm the arena and vector up once, the same as a loop polling a directory would.
+        Filesystem::StringArena NameArena;
+        Filesystem::StringViewVector ArenaNames;
+        static_cast<void>( Filesystem::GetDirectoryContentNames(BenchDir,NameArena,ArenaNames) );
+        size_t ArenaAllocs = 0;
+        double ArenaTime = BestOf([&](){
+            NameArena.Clear();
+            ArenaNames.clear();
+            ArenaAllocs = Filesystem::CountAllocations([&](){
+                static_cast<void>( Filesystem::GetDirectoryContentNames(BenchDir,NameArena,ArenaNames) );
+            });
+        });
+
+        TestLog << "GetDirectoryContentNames - StringVector: " << VectorTime << "ms, " << VectorAllocs
+                << " allocations, arena: " << ArenaTime << "ms, " << ArenaAllocs << " allocations.\n";
+        TEST_EQUAL("ArenaNames-Count",VectorNames.size(),ArenaNames.size())
+        // Only the directory stream and its buffers should be allocated, however many entries there are.
+        TEST_EQUAL("ArenaNames-FixedAllocations",true,ArenaAllocs < 8)
+    }// StringVector vs arena backed names
+
+#ifndef MEZZ_Windows
+    {// Full path stat vs dirfd relative fstatat
+        StringVector BenchNames = Filesystem::GetDirectoryContentNames(BenchDir);
+        struct stat FileStat;
+        size_t FullPathAllocs = 0;
+        size_t RelativeAllocs = 0;
+
+        double FullPathTime = BestOf([&](){
+            FullPathAllocs = Filesystem::CountAllocations([&](){
+                for( const String& BenchName : BenchNames )
+                {
+                    String FullPath(BenchDir);
+                    FullPath.append(BenchName);
+                    static_cast<void>( ::stat(FullPath.c_str(),&FileStat) );
+                }
+            });
+        });
+        int DirHandle = ::open(BenchDir.c_str(),O_RDONLY | O_DIRECTORY);
+        double RelativeTime = BestOf([&](){
+            RelativeAllocs = Filesystem::CountAllocations([&](){
+                for( const String& BenchName : BenchNames )
+                    { static_cast<void>( ::fstatat(DirHandle,BenchName.c_str(),&FileStat,0) ); }
+            });
+        });
+        ::close(DirHandle);
+
+        ArchiveEntryVector BenchEntries;
+        size_t ContentsAllocs = Filesystem::CountAllocations([&](){
+            BenchEntries = Filesystem::GetDirectoryContents(BenchDir);
+        });
+
+        TestLog << "stat on full paths: " << FullPathTime << "ms, " << FullPathAllocs << " allocations.\n";
+        TestLog << "fstatat relative to the directory: " << RelativeTime << "ms, "
+                << RelativeAllocs << " allocations.\n";
+        TestLog << "GetDirectoryContents: " << ContentsAllocs << " allocations for "
+                << BenchEntries.size() << " entries.\n";
+
+        TEST_EQUAL("FullPathStat-Allocations",BenchNames.size(),FullPathAllocs)
+        TEST_EQUAL("RelativeStat-Allocations",size_t(0),RelativeAllocs)
+    }// Full path stat vs dirfd relative fstatat
+#endif
+
+    for( const String& BenchFile : BenchFiles )
+    {
+        if( Filesystem::RemoveFile(BenchFile) == false ) {
+            TEST_RESULT("BenchFile-CleanupFailed",Testing::TestResult::Warning)
+            break;
+        }
+    }
+    if( Filesystem::RemoveDirectory(BenchDir) == false ) {
+        TEST_RESULT("BenchDir-CleanupFailed",Testing::TestResult::Warning)
+    }
+}
+
+#endif
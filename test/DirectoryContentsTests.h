@@ -103,6 +103,17 @@ AUTOMATIC_TEST_GROUP(DirectoryContentsTests,DirectoryContents)
         TEST_EQUAL("GetDirectoryContentNames-FourthFound",
                    true,std::find(ContentNames.begin(),ContentNames.end(),"NameTestFile4.txt") != ContentNames.end())
 
+        Filesystem::StringArena NameArena;
+        Filesystem::StringViewVector ArenaNames = { "Existing" };
+        TEST_EQUAL("GetDirectoryContentNames(const_StringView,StringArena&,StringViewVector&)-Count",
+                   ContentNames.size(),Filesystem::GetDirectoryContentNames("Content/",NameArena,ArenaNames))
+        TEST_EQUAL("GetDirectoryContentNames(const_StringView,StringArena&,StringViewVector&)-Appended",
+                   true,ArenaNames.size() == ContentNames.size() + 1 && ArenaNames.front() == "Existing")
+        TEST_EQUAL("GetDirectoryContentNames(const_StringView,StringArena&,StringViewVector&)-Names",
+                   true,std::is_permutation(ContentNames.begin(),ContentNames.end(),ArenaNames.begin() + 1))
+        TEST_EQUAL("GetDirectoryContentNames(const_StringView,StringArena&,StringViewVector&)-Missing",
+                   size_t(0),Filesystem::GetDirectoryContentNames("Content/NotADir/",NameArena,ArenaNames))
+
         if( Filesystem::RemoveFile("Content/NameTestFile1.txt") == false ) {
             TEST_RESULT("NameTestFile1-CleanupFailed",Testing::TestResult::Warning)
         }
@@ -226,6 +237,170 @@ AUTOMATIC_TEST_GROUP(DirectoryContentsTests,DirectoryContents)
             TEST_RESULT("GetDirectoryContents-FourthSize",Testing::TestResult::Failed)
         }
 
+        {// Batch Sizes
+            auto SameEntries = [](ArchiveEntryVector Left, ArchiveEntryVector Right) {
+                auto NameSorter = [](const ArchiveEntry& First, const ArchiveEntry& Second) {
+                    return First.Name < Second.Name;
+                };
+                std::sort(Left.begin(),Left.end(),NameSorter);
+                std::sort(Right.begin(),Right.end(),NameSorter);
+                return std::equal(Left.begin(),Left.end(),Right.begin(),Right.end(),
+                                  [](const ArchiveEntry& First, const ArchiveEntry& Second) {
+                    return First.Name == Second.Name &&
+                           First.Entry == Second.Entry &&
+                           First.Size == Second.Size &&
+                           First.ModifyTime == Second.ModifyTime;
+                });
+            };
+
+            ArchiveEntryVector PortableEntries = Filesystem::GetDirectoryContents("Content/",0);
+            ArchiveEntryVector TinyBatchEntries = Filesystem::GetDirectoryContents("Content/",1);
+            TEST_EQUAL("GetDirectoryContents(const_StringView,const_size_t)-Portable",
+                       true,SameEntries(ContentEntries,PortableEntries))
+            TEST_EQUAL("GetDirectoryContents(const_StringView,const_size_t)-TinyBatch",
+                       true,SameEntries(ContentEntries,TinyBatchEntries))
+
+            StringVector PortableNames = Filesystem::GetDirectoryContentNames("Content/",0);
+            StringVector TinyBatchNames = Filesystem::GetDirectoryContentNames("Content/",1);
+            std::sort(PortableNames.begin(),PortableNames.end());
+            std::sort(TinyBatchNames.begin(),TinyBatchNames.end());
+            TEST_EQUAL("GetDirectoryContentNames(const_StringView,const_size_t)-Count",
+                       ContentEntries.size(),PortableNames.size())
+            TEST_EQUAL("GetDirectoryContentNames(const_StringView,const_size_t)-Batched",
+                       true,PortableNames == TinyBatchNames)
+        }// Batch Sizes
+
+        {// Type Only Listings
+            Filesystem::DirectoryContentsOptions TypeOnlyOptions;
+            TypeOnlyOptions.Metadata = Filesystem::EntryMetadata::Type;
+            ArchiveEntryVector TypeEntries = Filesystem::GetDirectoryContents("Content/",TypeOnlyOptions);
+            TEST_EQUAL("GetDirectoryContents(const_StringView,const_DirectoryContentsOptions&)-TypeOnly-Count",
+                       ContentEntries.size(),TypeEntries.size())
+
+            Boole TypesMatch = ( ContentEntries.size() == TypeEntries.size() );
+            for( const ArchiveEntry& TypeEntry : TypeEntries )
+            {
+                EntryIt = std::find_if(ContentEntries.begin(),ContentEntries.end(),[&](const ArchiveEntry& Entry){
+                    return ( Entry.Name == TypeEntry.Name );
+                });
+                TypesMatch = TypesMatch && EntryIt != ContentEntries.end() &&
+                             (*EntryIt).Entry == TypeEntry.Entry &&
+                             TypeEntry.Archive == ArchiveType::FileSystem;
+            }
+            TEST_EQUAL("GetDirectoryContents(const_StringView,const_DirectoryContentsOptions&)-TypeOnly-Types",
+                       true,TypesMatch)
+
+            TypeOnlyOptions.BatchSize = 0;
+            ArchiveEntryVector PortableTypeEntries = Filesystem::GetDirectoryContents("Content/",TypeOnlyOptions);
+            TEST_EQUAL("GetDirectoryContents(const_StringView,const_DirectoryContentsOptions&)-TypeOnly-Portable",
+                       TypeEntries.size(),PortableTypeEntries.size())
+        }// Type Only Listings
+
+        {// DirectoryRange
+            Whole RangeCount = 0;
+            Boole RangeEntriesFound = true;
+            for( const ArchiveEntry& RangeEntry : Filesystem::DirectoryRange("Content/") )
+            {
+                EntryIt = std::find_if(ContentEntries.begin(),ContentEntries.end(),[&](const ArchiveEntry& Entry){
+                    return ( Entry.Name == RangeEntry.Name && Entry.Size == RangeEntry.Size );
+                });
+                RangeEntriesFound = RangeEntriesFound && EntryIt != ContentEntries.end();
+                ++RangeCount;
+            }
+            TEST_EQUAL("DirectoryRange-Count",ContentEntries.size(),RangeCount)
+            TEST_EQUAL("DirectoryRange-EntriesFound",true,RangeEntriesFound)
+
+            Filesystem::DirectoryRange SearchRange("Content/");
+            TEST_EQUAL("DirectoryRange::IsOpen()-Pass",true,SearchRange.IsOpen())
+            Filesystem::DirectoryIterator Found = std::find_if(SearchRange.begin(),SearchRange.end(),
+                                                               [](const ArchiveEntry& Entry){
+                return ( Entry.Name == "TestDir" );
+            });
+            TEST_EQUAL("DirectoryIterator-EarlyExit-Found",true,Found != SearchRange.end())
+            if( Found != SearchRange.end() ) {
+                TEST_EQUAL("DirectoryIterator-EarlyExit-EntryType",
+                           static_cast<int>(EntryType::Directory),static_cast<int>(Found->Entry))
+            }else{
+                TEST_RESULT("DirectoryIterator-EarlyExit-EntryType",Testing::TestResult::Failed)
+            }
+
+            Filesystem::DirectoryRange MissingRange("Content/NotADir/");
+            TEST_EQUAL("DirectoryRange::IsOpen()-Fail",false,MissingRange.IsOpen())
+            TEST_EQUAL("DirectoryRange-Empty",true,MissingRange.begin() == MissingRange.end())
+        }// DirectoryRange
+
+        {// StatPath
+            Optional<ArchiveEntry> FileStat = Filesystem::StatPath("Content/ContentTestFile3.txt");
+            TEST_EQUAL("StatPath(const_StringView)-File-Found",true,FileStat.has_value())
+            if( FileStat ) {
+                EntryIt = std::find_if(ContentEntries.begin(),ContentEntries.end(),[](const ArchiveEntry& Entry){
+                    return ( Entry.Name == "ContentTestFile3.txt" );
+                });
+                TEST_EQUAL("StatPath(const_StringView)-File-Name",String("ContentTestFile3.txt"),FileStat->Name)
+                TEST_EQUAL("StatPath(const_StringView)-File-Type",
+                           static_cast<int>(EntryType::File),static_cast<int>(FileStat->Entry))
+                TEST_EQUAL("StatPath(const_StringView)-File-Size",UInt64(FileData3.size()),FileStat->Size)
+                TEST_EQUAL("StatPath(const_StringView)-File-MatchesListing",
+                           true,EntryIt != ContentEntries.end() && (*EntryIt).ModifyTime == FileStat->ModifyTime &&
+                                (*EntryIt).CreateTime == FileStat->CreateTime)
+                TEST_EQUAL("StatPath(const_StringView)-File-CreateTime",
+                           true,FileStat->CreateTime > 0 && FileStat->CreateTime <= FileStat->ModifyTime + 1)
+            }else{
+                TEST_RESULT("StatPath(const_StringView)-File-Name",Testing::TestResult::Failed)
+            }
+
+            Optional<ArchiveEntry> DirStat = Filesystem::StatPath("Content/TestDir/");
+            TEST_EQUAL("StatPath(const_StringView)-Directory-Found",true,DirStat.has_value())
+            TEST_EQUAL("StatPath(const_StringView)-Directory-Name",
+                       String("TestDir"),( DirStat ? DirStat->Name : String() ))
+            TEST_EQUAL("StatPath(const_StringView)-Directory-Type",
+                       static_cast<int>(EntryType::Directory),
+                       static_cast<int>( DirStat ? DirStat->Entry : EntryType::Unknown ))
+            TEST_EQUAL("StatPath(const_StringView)-Missing",
+                       false,Filesystem::StatPath("Content/NotAFile.txt").has_value())
+            TEST_EQUAL("StatPath(const_StringView)-Empty",false,Filesystem::StatPath("").has_value())
+
+            Optional<ArchiveEntry> TypeStat = Filesystem::StatPath("Content/ContentTestFile4.txt",
+                                                                   Filesystem::EntryMetadata::Type,true);
+            TEST_EQUAL("StatPath(const_StringView,const_EntryMetadata,const_Boole)-TypeOnly",
+                       static_cast<int>(EntryType::File),
+                       static_cast<int>( TypeStat ? TypeStat->Entry : EntryType::Unknown ))
+
+        #ifndef MEZZ_Windows
+            if( Filesystem::CreateSymlink("Content/StatLink","ContentTestFile2.txt") ==
+                Filesystem::ModifyResult::Success )
+            {
+                Optional<ArchiveEntry> Followed = Filesystem::StatPath("Content/StatLink");
+                TEST_EQUAL("StatPath(const_StringView,const_EntryMetadata,const_Boole)-FollowSymlink",
+                           static_cast<int>(EntryType::File),
+                           static_cast<int>( Followed ? Followed->Entry : EntryType::Unknown ))
+                TEST_EQUAL("StatPath(const_StringView,const_EntryMetadata,const_Boole)-FollowSymlink-Size",
+                           UInt64(FileData2.size()),( Followed ? Followed->Size : UInt64(0) ))
+                Optional<ArchiveEntry> NotFollowed = Filesystem::StatPath("Content/StatLink",
+                                                                          Filesystem::EntryMetadata::All,false);
+                TEST_EQUAL("StatPath(const_StringView,const_EntryMetadata,const_Boole)-NoFollowSymlink",
+                           static_cast<int>(EntryType::Symlink),
+                           static_cast<int>( NotFollowed ? NotFollowed->Entry : EntryType::Unknown ))
+                if( Filesystem::RemoveFile("Content/StatLink") == false ) {
+                    TEST_RESULT("StatLink-CleanupFailed",Testing::TestResult::Warning)
+                }
+            }else{
+                TEST_RESULT("StatPath-CreateSymlink",Testing::TestResult::Warning)
+            }
+
+            {
+                std::ofstream BackslashFile("Content/Trailing\\");
+                BackslashFile << "Backslashes are part of the name on Posix.";
+            }
+            Optional<ArchiveEntry> BackslashStat = Filesystem::StatPath("Content/Trailing\\");
+            TEST_EQUAL("StatPath(const_StringView)-TrailingBackslash-Name",
+                       String("Trailing\\"),( BackslashStat ? BackslashStat->Name : String() ))
+            if( Filesystem::RemoveFile("Content/Trailing\\") == false ) {
+                TEST_RESULT("TrailingBackslash-CleanupFailed",Testing::TestResult::Warning)
+            }
+        #endif
+        }// StatPath
+
         if( Filesystem::RemoveFile("Content/ContentTestFile2.txt") == false ) {
             TEST_RESULT("ContentTestFile1-CleanupFailed",Testing::TestResult::Warning)
         }
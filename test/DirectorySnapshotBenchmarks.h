@@ -0,0 +1,161 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_DirectorySnapshotBenchmarks_h
+#define Mezz_Filesystem_DirectorySnapshotBenchmarks_h
+
+/// @file
+/// @brief Timings of scanning and filtering a snapshot against the equivalent ArchiveEntryVector.
+
+#include "MezzTest.h"
+
+#include "DirectorySnapshot.h"
+
+#include <chrono>
+
+BENCHMARK_TEST_GROUP(DirectorySnapshotBenchmarks,DirectorySnapshotBenchmarks)
+{
+    using namespace Mezzanine;
+    using BenchClock = std::chrono::steady_clock;
+    using Milliseconds = std::chrono::duration<double,std::milli>;
+
+    const size_t EntryCount = 1000000;
+    const Whole PassCount = 10;
+    const UInt64 SizeThreshold = 512 * 1024;
+    const UInt64 TimeThreshold = 1500000000;
+
+    // Build a listing that looks like a large asset directory, with names long enough to not fit in the small
+    // string buffer of most standard libraries.
+    ArchiveEntryVector Entries;
+    Entries.resize(EntryCount);
+    UInt64 Seed = 0x2545F4914F6CDD1D;
+    for( size_t Index = 0 ; Index < EntryCount ; ++Index )
+    {
+        Seed ^= Seed << 13;
+        Seed ^= Seed >> 7;
+        Seed ^= Seed << 17;
+        ArchiveEntry& Entry = Entries[Index];
+        Entry.Name = "SnapshotBenchmarkAsset_" + std::to_string(Index) + ".texture";
+        Entry.Archive = ArchiveType::FileSystem;
+        Entry.Entry = ( Seed % 10 == 0 ? EntryType::Directory : EntryType::File );
+        Entry.Size = Seed % ( 1024 * 1024 );
+        Entry.CreateTime = 1400000000 + ( Seed % 100000000 );
+        Entry.AccessTime = Entry.CreateTime;
+        Entry.ModifyTime = 1400000000 + ( ( Seed >> 20 ) % 200000000 );
+    }
+
+    // Times a callable over every pass, in milliseconds.
+    auto TimePasses = [&](auto&& ToTime) {
+        BenchClock::time_point Start = BenchClock::now();
+        for( Whole Pass = 0 ; Pass < PassCount ; ++Pass )
+            { ToTime(); }
+        return Milliseconds( BenchClock::now() - Start ).count();
+    };
+
+    double ConvertTime = 0.0;
+    Filesystem::DirectorySnapshot Snapshot;
+    {
+        BenchClock::time_point Start = BenchClock::now();
+        Snapshot = Filesystem::DirectorySnapshot(Entries);
+        ConvertTime = Milliseconds( BenchClock::now() - Start ).count();
+    }
+    TestLog << "Converted " << EntryCount << " entries to a snapshot in " << ConvertTime << "ms.\n";
+
+    {// Scanning sizes
+        UInt64 VectorTotal = 0;
+        double VectorTime = TimePasses([&](){
+            for( const ArchiveEntry& Entry : Entries )
+                { VectorTotal += Entry.Size; }
+        });
+        UInt64 SnapshotTotal = 0;
+        double SnapshotTime = TimePasses([&](){
+            for( const UInt64 Size : Snapshot.GetSizes() )
+                { SnapshotTotal += Size; }
+        });
+        TestLog << "Summing sizes - vector: " << VectorTime << "ms, snapshot: " << SnapshotTime << "ms.\n";
+        TEST_EQUAL("ScanSizes-Matches",VectorTotal,SnapshotTotal)
+    }// Scanning sizes
+
+    {// Filtering
+        Whole VectorMatches = 0;
+        double VectorTime = TimePasses([&](){
+            for( const ArchiveEntry& Entry : Entries )
+            {
+                VectorMatches += ( Entry.Entry == EntryType::File && Entry.Size > SizeThreshold &&
+                                   Entry.ModifyTime > TimeThreshold );
+            }
+        });
+        Whole SnapshotMatches = 0;
+        double SnapshotTime = TimePasses([&](){
+            const Filesystem::DirectorySnapshot::TypeContainer& Types = Snapshot.GetTypes();
+            const Filesystem::DirectorySnapshot::UInt64Container& Sizes = Snapshot.GetSizes();
+            const Filesystem::DirectorySnapshot::UInt64Container& ModifyTimes = Snapshot.GetModifyTimes();
+            for( size_t Index = 0 ; Index < Types.size() ; ++Index )
+            {
+                SnapshotMatches += ( Types[Index] == EntryType::File && Sizes[Index] > SizeThreshold &&
+                                     ModifyTimes[Index] > TimeThreshold );
+            }
+        });
+        TestLog << "Filtering by type, size and time - vector: " << VectorTime << "ms, "
+                << "snapshot: " << SnapshotTime << "ms.\n";
+        TEST_EQUAL("Filter-Matches",VectorMatches,SnapshotMatches)
+    }// Filtering
+
+    {// Filtering names
+        Whole VectorMatches = 0;
+        double VectorTime = TimePasses([&](){
+            for( const ArchiveEntry& Entry : Entries )
+                { VectorMatches += ( Entry.Size > SizeThreshold && Entry.Name.find('7') != String::npos ); }
+        });
+        Whole SnapshotMatches = 0;
+        double SnapshotTime = TimePasses([&](){
+            for( const Filesystem::DirectorySnapshot::EntryView Entry : Snapshot )
+            {
+                SnapshotMatches += ( Entry.GetSize() > SizeThreshold &&
+                                     Entry.GetName().find('7') != StringView::npos );
+            }
+        });
+        TestLog << "Filtering by size and name - vector: " << VectorTime << "ms, "
+                << "snapshot: " << SnapshotTime << "ms.\n";
+        TEST_EQUAL("FilterNames-Matches",VectorMatches,SnapshotMatches)
+        TEST_EQUAL("FilterNames-FoundAny",true,VectorMatches > 0)
+    }// Filtering names
+}
+
+#endif
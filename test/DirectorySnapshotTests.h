@@ -0,0 +1,170 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_DirectorySnapshotTests_h
+#define Mezz_Filesystem_DirectorySnapshotTests_h
+
+/// @file
+/// @brief A few tests of the structure of arrays directory listing.
+
+#include "MezzTest.h"
+
+#include "DirectorySnapshot.h"
+#include "FilesystemManagement.h"
+
+#include <algorithm>
+
+AUTOMATIC_TEST_GROUP(DirectorySnapshotTests,DirectorySnapshot)
+{
+    using namespace Mezzanine;
+
+    {// Conversion
+        ArchiveEntryVector Entries(3);
+        Entries[0].Name = "First.txt";
+        Entries[0].Entry = EntryType::File;
+        Entries[0].Size = 100;
+        Entries[0].CreateTime = 10;
+        Entries[0].AccessTime = 30;
+        Entries[0].ModifyTime = 20;
+        Entries[0].Permissions = FilePermissions::Owner_Read | FilePermissions::Owner_Write;
+        Entries[1].Name = "Second";
+        Entries[1].Entry = EntryType::Directory;
+        Entries[1].ModifyTime = 40;
+        Entries[2].Name = "";
+        Entries[2].Entry = EntryType::Symlink;
+        Entries[2].Size = 7;
+        for( ArchiveEntry& Entry : Entries )
+            { Entry.Archive = ArchiveType::FileSystem; }
+
+        Filesystem::DirectorySnapshot Snapshot(Entries);
+        TEST_EQUAL("DirectorySnapshot::size()",size_t(3),Snapshot.size())
+        TEST_EQUAL("DirectorySnapshot::empty()",false,Snapshot.empty())
+        TEST_EQUAL("DirectorySnapshot::GetNameBufferSize()",size_t(18),Snapshot.GetNameBufferSize())
+        TEST_EQUAL("DirectorySnapshot::GetName(const_size_t)",String("Second"),String( Snapshot.GetName(1) ))
+        TEST_EQUAL("DirectorySnapshot::GetName(const_size_t)-Terminated",'\0',*( Snapshot.GetName(0).data() + 9 ))
+        TEST_EQUAL("DirectorySnapshot::GetName(const_size_t)-Empty",true,Snapshot.GetName(2).empty())
+        TEST_EQUAL("DirectorySnapshot::GetType(const_size_t)",
+                   static_cast<int>(EntryType::Directory),static_cast<int>( Snapshot.GetType(1) ))
+        TEST_EQUAL("DirectorySnapshot::GetSize(const_size_t)",UInt64(100),Snapshot.GetSize(0))
+        TEST_EQUAL("DirectorySnapshot::GetCreateTime(const_size_t)",UInt64(10),Snapshot.GetCreateTime(0))
+        TEST_EQUAL("DirectorySnapshot::GetAccessTime(const_size_t)",UInt64(30),Snapshot.GetAccessTime(0))
+        TEST_EQUAL("DirectorySnapshot::GetModifyTime(const_size_t)",UInt64(40),Snapshot.GetModifyTime(1))
+        TEST_EQUAL("DirectorySnapshot::GetPermissions(const_size_t)",
+                   static_cast<UInt32>(Entries[0].Permissions),static_cast<UInt32>( Snapshot.GetPermissions(0) ))
+        TEST_EQUAL("DirectorySnapshot::GetSizes()",true,Snapshot.GetSizes() == std::vector<UInt64>({ 100, 0, 7 }))
+        TEST_EQUAL("DirectorySnapshot::GetModifyTimes()",
+                   true,Snapshot.GetModifyTimes() == std::vector<UInt64>({ 20, 40, 0 }))
+
+        Filesystem::DirectorySnapshot::EntryView View = Snapshot[0];
+        TEST_EQUAL("DirectorySnapshot::operator[](const_size_t)-Name",String("First.txt"),String( View.GetName() ))
+        TEST_EQUAL("DirectorySnapshot::operator[](const_size_t)-Size",UInt64(100),View.GetSize())
+        TEST_EQUAL("DirectorySnapshot::operator[](const_size_t)-Index",size_t(0),View.GetIndex())
+
+        ArchiveEntryVector Converted = Snapshot.ToArchiveEntries();
+        Boole RoundTripped = ( Converted.size() == Entries.size() );
+        for( size_t Index = 0 ; RoundTripped && Index < Entries.size() ; ++Index )
+        {
+            RoundTripped = Converted[Index].Name == Entries[Index].Name &&
+                           Converted[Index].Archive == Entries[Index].Archive &&
+                           Converted[Index].Entry == Entries[Index].Entry &&
+                           Converted[Index].Size == Entries[Index].Size &&
+                           Converted[Index].CreateTime == Entries[Index].CreateTime &&
+                           Converted[Index].AccessTime == Entries[Index].AccessTime &&
+                           Converted[Index].ModifyTime == Entries[Index].ModifyTime &&
+                           Converted[Index].Permissions == Entries[Index].Permissions;
+        }
+        TEST_EQUAL("DirectorySnapshot::ToArchiveEntries()",true,RoundTripped)
+
+        StringVector IteratedNames;
+        for( const Filesystem::DirectorySnapshot::EntryView Entry : Snapshot )
+            { IteratedNames.push_back( String( Entry.GetName() ) ); }
+        TEST_EQUAL("DirectorySnapshot::begin()",true,IteratedNames == StringVector({ "First.txt", "Second", "" }))
+        TEST_EQUAL("DirectorySnapshot::end()",std::ptrdiff_t(3),Snapshot.end() - Snapshot.begin())
+        TEST_EQUAL("DirectorySnapshot::const_iterator::operator[](const_difference_type)",
+                   String("Second"),String( Snapshot.begin()[1].GetName() ))
+        using EntryView = Filesystem::DirectorySnapshot::EntryView;
+        auto Found = std::find_if(Snapshot.begin(),Snapshot.end(),[](const EntryView Entry){
+            return Entry.GetType() == EntryType::Symlink;
+        });
+        TEST_EQUAL("DirectorySnapshot-FindIf",std::ptrdiff_t(2),Found - Snapshot.begin())
+
+        Snapshot.Clear();
+        TEST_EQUAL("DirectorySnapshot::Clear()",true,Snapshot.empty() && Snapshot.GetNameBufferSize() == 0)
+        Snapshot.Append(Entries[1]);
+        TEST_EQUAL("DirectorySnapshot::Append(const_ArchiveEntry&)",String("Second"),String( Snapshot.GetName(0) ))
+    }// Conversion
+
+    {// GetDirectorySnapshot
+        if( Filesystem::CreateDirectory("Snapshot/") == false ) {
+            TEST_RESULT("CreateSnapshotDir",Testing::TestResult::Failed)
+            return;
+        }
+        const String FileData = "Some data to give the file a size.";
+        {
+            std::ofstream SnapshotFile("Snapshot/SnapshotFile.txt");
+            SnapshotFile << FileData;
+        }
+        static_cast<void>( Filesystem::CreateDirectory("Snapshot/SnapshotDir/") );
+
+        Filesystem::DirectorySnapshot Snapshot = Filesystem::GetDirectorySnapshot("Snapshot/");
+        ArchiveEntryVector Listing = Filesystem::GetDirectoryContents("Snapshot/");
+        TEST_EQUAL("GetDirectorySnapshot(const_StringView)-Count",Listing.size(),Snapshot.size())
+        Boole ListingMatches = ( Listing.size() == Snapshot.size() );
+        for( size_t Index = 0 ; ListingMatches && Index < Listing.size() ; ++Index )
+        {
+            ListingMatches = Listing[Index].Name == Snapshot.GetName(Index) &&
+                             Listing[Index].Entry == Snapshot.GetType(Index) &&
+                             Listing[Index].Size == Snapshot.GetSize(Index);
+        }
+        TEST_EQUAL("GetDirectorySnapshot(const_StringView)-MatchesListing",true,ListingMatches)
+
+        Filesystem::DirectoryContentsOptions Options;
+        Options.Metadata = Filesystem::EntryMetadata::None;
+        TEST_EQUAL("GetDirectorySnapshot(const_StringView,const_DirectoryContentsOptions&)",
+                   size_t(2),Filesystem::GetDirectorySnapshot("Snapshot/",Options).size())
+        TEST_EQUAL("GetDirectorySnapshot(const_StringView)-Missing",
+                   true,Filesystem::GetDirectorySnapshot("Snapshot/NotADir/").empty())
+
+        if( Filesystem::RemoveDirectoryTree("Snapshot/") == false ) {
+            TEST_RESULT("SnapshotDir-CleanupFailed",Testing::TestResult::Warning)
+        }
+    }// GetDirectorySnapshot
+}
+
+#endif
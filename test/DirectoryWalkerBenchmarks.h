@@ -0,0 +1,147 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_DirectoryWalkerBenchmarks_h
+#define Mezz_Filesystem_DirectoryWalkerBenchmarks_h
+
+/// @file
+/// @brief Timings of walking a directory tree with different numbers of threads.
+
+#include "MezzTest.h"
+
+#include "DirectoryWalker.h"
+#include "FilesystemManagement.h"
+
+#include <atomic>
+#include <chrono>
+
+BENCHMARK_TEST_GROUP(DirectoryWalkerBenchmarks,DirectoryWalkerBenchmarks)
+{
+    using namespace Mezzanine;
+    using BenchClock = std::chrono::steady_clock;
+    using Milliseconds = std::chrono::duration<double,std::milli>;
+
+    const String BenchDir("./WalkBench/");
+    const Whole BranchCount = 16;
+    const Whole FilesPerDir = 40;
+    const Whole Iterations = 5;
+
+    /// @brief Runs a callable several times and returns the fastest run, in milliseconds.
+    auto BestOf = [Iterations](auto&& ToTime) {
+        double Best = std::numeric_limits<double>::max();
+        for( Whole Iteration = 0 ; Iteration < Iterations ; ++Iteration )
+        {
+            BenchClock::time_point Start = BenchClock::now();
+            ToTime();
+            Best = std::min( Best, Milliseconds( BenchClock::now() - Start ).count() );
+        }
+        return Best;
+    };
+
+    // Two levels of BranchCount directories, with FilesPerDir files in each leaf.
+    StringVector BenchDirs;
+    StringVector BenchFiles;
+    BenchDirs.push_back(BenchDir);
+    for( Whole Branch = 0 ; Branch < BranchCount ; ++Branch )
+    {
+        const String BranchDir = BenchDir + "Branch" + std::to_string(Branch) + "/";
+        BenchDirs.push_back(BranchDir);
+        for( Whole Leaf = 0 ; Leaf < BranchCount ; ++Leaf )
+        {
+            const String LeafDir = BranchDir + "Leaf" + std::to_string(Leaf) + "/";
+            BenchDirs.push_back(LeafDir);
+            for( Whole FileNum = 0 ; FileNum < FilesPerDir ; ++FileNum )
+                { BenchFiles.push_back( LeafDir + "AssetFile" + std::to_string(FileNum) + ".dat" ); }
+        }
+    }
+    for( const String& Dir : BenchDirs )
+    {
+        if( Filesystem::CreateDirectory(Dir) == false ) {
+            TEST_RESULT("CreateBenchDir",Testing::TestResult::Failed)
+            return;
+        }
+    }
+    for( const String& File : BenchFiles )
+        { std::ofstream BenchFile(File); }
+    const Whole TotalEntries = ( BenchDirs.size() - 1 ) + BenchFiles.size();
+    TestLog << "Walking a tree of " << BenchDirs.size() << " directories and " << BenchFiles.size()
+            << " files, best of " << Iterations << " runs.\n";
+
+    {// Thread Scaling
+        double SingleThreadTime = 0;
+        for( size_t ThreadCount : { size_t(1), size_t(2), size_t(4), size_t(8), size_t(16) } )
+        {
+            Filesystem::DirectoryWalkOptions Options;
+            Options.ThreadCount = ThreadCount;
+            std::atomic<Whole> EntryCount{0};
+            auto Counter = [&](const StringView, const ArchiveEntry&, const Whole) {
+                EntryCount.fetch_add(1,std::memory_order_relaxed);
+                return Filesystem::WalkAction::Continue;
+            };
+            Filesystem::DirectoryWalkResult Result;
+            double WalkTime = BestOf([&](){ Result = Filesystem::WalkDirectoryTree(BenchDir,Counter,Options); });
+            if( ThreadCount == 1 ) {
+                SingleThreadTime = WalkTime;
+            }
+            TestLog << "WalkDirectoryTree - " << ThreadCount << " threads: " << WalkTime << "ms, "
+                    << ( SingleThreadTime / WalkTime ) << "x speedup.\n";
+            TEST_EQUAL("ThreadScaling-EntriesVisited-" + std::to_string(ThreadCount) + "Threads",
+                       TotalEntries,Result.EntriesVisited)
+            TEST_EQUAL("ThreadScaling-VisitorCalls-" + std::to_string(ThreadCount) + "Threads",
+                       TotalEntries * Iterations,EntryCount.load())
+        }
+    }// Thread Scaling
+
+    for( const String& File : BenchFiles )
+    {
+        if( Filesystem::RemoveFile(File) == false ) {
+            TEST_RESULT("BenchFile-CleanupFailed",Testing::TestResult::Warning)
+            break;
+        }
+    }
+    for( auto DirIt = BenchDirs.rbegin() ; DirIt != BenchDirs.rend() ; ++DirIt )
+    {
+        if( Filesystem::RemoveDirectory(*DirIt) == false ) {
+            TEST_RESULT("BenchDir-CleanupFailed",Testing::TestResult::Warning)
+            break;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,207 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_DirectoryWalkerTests_h
+#define Mezz_Filesystem_DirectoryWalkerTests_h
+
+/// @file
+/// @brief A few tests of the utility that walks entire directory trees.
+
+#include "MezzTest.h"
+
+#include "DirectoryWalker.h"
+#include "FilesystemManagement.h"
+
+#include <mutex>
+#include <stdexcept>
+
+AUTOMATIC_TEST_GROUP(DirectoryWalkerTests,DirectoryWalker)
+{
+    using namespace Mezzanine;
+
+    const String RootDir("Walk/");
+    const StringVector TreeDirs = { "Walk/Sub1/", "Walk/Sub1/Deep/", "Walk/Sub2/" };
+    const StringVector TreeFiles = { "Walk/A.txt", "Walk/Sub1/B.txt", "Walk/Sub1/Deep/C.txt", "Walk/Sub2/D.txt" };
+
+    if( Filesystem::CreateDirectory(RootDir) == false ) {
+        TEST_RESULT("CreateWalkDir",Testing::TestResult::Failed)
+        return;
+    }
+    for( const String& TreeDir : TreeDirs )
+    {
+        if( Filesystem::CreateDirectory(TreeDir) == false ) {
+            TEST_RESULT("CreateWalkSubDir",Testing::TestResult::Failed)
+            return;
+        }
+    }
+    for( const String& TreeFile : TreeFiles )
+    {
+        std::ofstream WalkFile(TreeFile);
+        WalkFile << "Walk this way.";
+    }
+
+    std::mutex FoundLock;
+    StringVector Found;
+    auto Recorder = [&](const StringView Parent, const ArchiveEntry& Entry, const Whole) {
+        std::lock_guard<std::mutex> Lock(FoundLock);
+        Found.push_back( String(Parent) + Entry.Name );
+        return Filesystem::WalkAction::Continue;
+    };
+    auto WasFound = [&](const String& Path) {
+        return std::find(Found.begin(),Found.end(),Path) != Found.end();
+    };
+
+    {// Full Walks
+        for( size_t ThreadCount : { size_t(1), size_t(4) } )
+        {
+            const String Suffix = "-" + std::to_string(ThreadCount) + "Threads";
+            Filesystem::DirectoryWalkOptions Options;
+            Options.ThreadCount = ThreadCount;
+            Found.clear();
+            Filesystem::DirectoryWalkResult Result = Filesystem::WalkDirectoryTree(RootDir,Recorder,Options);
+            TEST_EQUAL("WalkDirectoryTree-EntriesVisited" + Suffix,Whole(7),Result.EntriesVisited)
+            TEST_EQUAL("WalkDirectoryTree-DirectoriesWalked" + Suffix,Whole(4),Result.DirectoriesWalked)
+            TEST_EQUAL("WalkDirectoryTree-DirectoriesFailed" + Suffix,Whole(0),Result.DirectoriesFailed)
+            TEST_EQUAL("WalkDirectoryTree-Stopped" + Suffix,false,Result.Stopped)
+            TEST_EQUAL("WalkDirectoryTree-FoundCount" + Suffix,size_t(7),Found.size())
+            TEST_EQUAL("WalkDirectoryTree-FoundDeepFile" + Suffix,true,WasFound("Walk/Sub1/Deep/C.txt"))
+            TEST_EQUAL("WalkDirectoryTree-FoundSubDir" + Suffix,true,WasFound("Walk/Sub2"))
+        }
+
+        Found.clear();
+        Filesystem::DirectoryWalkResult NoSlashResult = Filesystem::WalkDirectoryTree("Walk",Recorder);
+        TEST_EQUAL("WalkDirectoryTree-NoTrailingSeparator",Whole(7),NoSlashResult.EntriesVisited)
+
+        Filesystem::DirectoryWalkResult MissingResult = Filesystem::WalkDirectoryTree("NotAWalkDir/",Recorder);
+        TEST_EQUAL("WalkDirectoryTree-Missing-EntriesVisited",Whole(0),MissingResult.EntriesVisited)
+        TEST_EQUAL("WalkDirectoryTree-Missing-DirectoriesFailed",Whole(1),MissingResult.DirectoriesFailed)
+    }// Full Walks
+
+    {// Depth Limits and Actions
+        Filesystem::DirectoryWalkOptions Options;
+        Options.MaxDepth = 0;
+        Found.clear();
+        Filesystem::DirectoryWalkResult RootOnly = Filesystem::WalkDirectoryTree(RootDir,Recorder,Options);
+        TEST_EQUAL("WalkDirectoryTree-MaxDepth0-EntriesVisited",Whole(3),RootOnly.EntriesVisited)
+        TEST_EQUAL("WalkDirectoryTree-MaxDepth0-DirectoriesWalked",Whole(1),RootOnly.DirectoriesWalked)
+
+        Options.MaxDepth = 1;
+        Whole DeepestSeen = 0;
+        Filesystem::DirectoryWalkResult OneDeep = Filesystem::WalkDirectoryTree(RootDir,
+            [&](const StringView, const ArchiveEntry&, const Whole Depth) {
+                std::lock_guard<std::mutex> Lock(FoundLock);
+                DeepestSeen = std::max(DeepestSeen,Depth);
+                return Filesystem::WalkAction::Continue;
+            },Options);
+        TEST_EQUAL("WalkDirectoryTree-MaxDepth1-EntriesVisited",Whole(6),OneDeep.EntriesVisited)
+        TEST_EQUAL("WalkDirectoryTree-MaxDepth1-DeepestSeen",Whole(1),DeepestSeen)
+
+        Filesystem::DirectoryWalkResult Skipped = Filesystem::WalkDirectoryTree(RootDir,
+            [](const StringView, const ArchiveEntry& Entry, const Whole) {
+                if( Entry.Name == "Sub1" ) {
+                    return Filesystem::WalkAction::SkipSubtree;
+                }
+                return Filesystem::WalkAction::Continue;
+            });
+        TEST_EQUAL("WalkDirectoryTree-SkipSubtree-EntriesVisited",Whole(4),Skipped.EntriesVisited)
+
+        Filesystem::DirectoryWalkOptions SingleThread;
+        SingleThread.ThreadCount = 1;
+        Filesystem::DirectoryWalkResult Stopped = Filesystem::WalkDirectoryTree(RootDir,
+            [](const StringView, const ArchiveEntry&, const Whole) {
+                return Filesystem::WalkAction::Stop;
+            },SingleThread);
+        TEST_EQUAL("WalkDirectoryTree-Stop-EntriesVisited",Whole(1),Stopped.EntriesVisited)
+        TEST_EQUAL("WalkDirectoryTree-Stop-Stopped",true,Stopped.Stopped)
+
+        TEST_THROW("WalkDirectoryTree-VisitorThrows",std::runtime_error,[&](){
+            static_cast<void>( Filesystem::WalkDirectoryTree(RootDir,
+                [](const StringView, const ArchiveEntry&, const Whole) -> Filesystem::WalkAction {
+                    throw std::runtime_error("Visitor Failure");
+                }) );
+        })
+    }// Depth Limits and Actions
+
+    {// Symlink Loops
+        const String LoopLink("Walk/Sub1/Deep/Loop");
+        Filesystem::ModifyResult LinkResult = Filesystem::CreateDirectorySymlink(LoopLink,"../..");
+        if( LinkResult == Filesystem::ModifyResult::Success ) {
+            Filesystem::DirectoryWalkOptions Options;
+            Found.clear();
+            Filesystem::DirectoryWalkResult NoFollow = Filesystem::WalkDirectoryTree(RootDir,Recorder,Options);
+            TEST_EQUAL("WalkDirectoryTree-DontFollow-EntriesVisited",Whole(8),NoFollow.EntriesVisited)
+            TEST_EQUAL("WalkDirectoryTree-DontFollow-DirectoriesWalked",Whole(4),NoFollow.DirectoriesWalked)
+
+            Options.Symlinks = Filesystem::SymlinkPolicy::Follow;
+            Filesystem::DirectoryWalkResult Follow = Filesystem::WalkDirectoryTree(RootDir,Recorder,Options);
+            TEST_EQUAL("WalkDirectoryTree-Follow-EntriesVisited",Whole(8),Follow.EntriesVisited)
+            TEST_EQUAL("WalkDirectoryTree-Follow-DirectoriesWalked",Whole(4),Follow.DirectoriesWalked)
+            TEST_EQUAL("WalkDirectoryTree-Follow-LoopsSkipped",Whole(1),Follow.LoopsSkipped)
+
+            if( Filesystem::RemoveSymlink(LoopLink) == false ) {
+                TEST_RESULT("LoopLink-CleanupFailed",Testing::TestResult::Warning)
+            }
+        }else if( LinkResult == Filesystem::ModifyResult::PrivilegeNotHeld ||
+                  LinkResult == Filesystem::ModifyResult::NotSupported )
+        {
+            this->TestLog << "Unable to create Symlinks on the host system.\n";
+            TEST_RESULT("WalkDirectoryTree-SymlinkLoops",Testing::TestResult::Skipped)
+        }else{
+            TEST_RESULT("WalkDirectoryTree-SymlinkLoops",Testing::TestResult::Failed)
+        }
+    }// Symlink Loops
+
+    for( const String& TreeFile : TreeFiles )
+    {
+        if( Filesystem::RemoveFile(TreeFile) == false ) {
+            TEST_RESULT("WalkFile-CleanupFailed",Testing::TestResult::Warning)
+        }
+    }
+    for( auto DirIt = TreeDirs.rbegin() ; DirIt != TreeDirs.rend() ; ++DirIt )
+    {
+        if( Filesystem::RemoveDirectory(*DirIt) == false ) {
+            TEST_RESULT("WalkSubDir-CleanupFailed",Testing::TestResult::Warning)
+        }
+    }
+    if( Filesystem::RemoveDirectory(RootDir) == false ) {
+        TEST_RESULT("WalkDir-CleanupFailed",Testing::TestResult::Warning)
+    }
+}
+
+#endif
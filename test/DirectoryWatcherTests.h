@@ -0,0 +1,218 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_DirectoryWatcherTests_h
+#define Mezz_Filesystem_DirectoryWatcherTests_h
+
+/// @file
+/// @brief A few tests of being notified of changes to directories.
+
+#include "MezzTest.h"
+
+#include "DirectoryWatcher.h"
+#include "FilesystemManagement.h"
+
+#include <condition_variable>
+#include <mutex>
+
+AUTOMATIC_TEST_GROUP(DirectoryWatcherTests,DirectoryWatcher)
+{
+    using namespace Mezzanine;
+    using Filesystem::WatchEventType;
+
+    /// @brief Collects the changes delivered by a watcher so the test thread can wait on them.
+    struct EventCollector
+    {
+        std::mutex EventLock;
+        std::condition_variable EventsDelivered;
+        Filesystem::WatchEventBatch Events;
+        Whole BatchCount = 0;
+
+        Filesystem::WatchCallback GetCallback()
+        {
+            return [this](const Filesystem::WatchEventBatch& Batch) {
+                std::lock_guard<std::mutex> Lock(this->EventLock);
+                this->Events.insert(this->Events.end(),Batch.begin(),Batch.end());
+                ++(this->BatchCount);
+                this->EventsDelivered.notify_all();
+            };
+        }
+        Boole WaitFor(const String& Path, const WatchEventType Type)
+        {
+            std::unique_lock<std::mutex> Lock(this->EventLock);
+            return this->EventsDelivered.wait_for(Lock,std::chrono::seconds(5),[&](){
+                return this->Count(Path,Type) > 0;
+            });
+        }
+        size_t Count(const String& Path, const WatchEventType Type)
+        {
+            return static_cast<size_t>( std::count_if(this->Events.begin(),this->Events.end(),
+                                                      [&](const Filesystem::WatchEvent& Event){
+                return ( Event.Path == Path && Event.Type == Type );
+            }) );
+        }
+        size_t Count(const String& Path)
+        {
+            return static_cast<size_t>( std::count_if(this->Events.begin(),this->Events.end(),
+                                                      [&](const Filesystem::WatchEvent& Event){
+                return ( Event.Path == Path );
+            }) );
+        }
+        void Reset()
+        {
+            std::lock_guard<std::mutex> Lock(this->EventLock);
+            this->Events.clear();
+            this->BatchCount = 0;
+        }
+    };//EventCollector
+
+    const String WatchDir("WatchTest");
+    if( Filesystem::CreateDirectory(WatchDir + "/") == false ) {
+        TEST_RESULT("CreateWatchDir",Testing::TestResult::Failed)
+        return;
+    }
+
+    {// Missing Directories
+        Filesystem::DirectoryWatcher Missing(WatchDir + "/NotADir/",[](const Filesystem::WatchEventBatch&){  });
+        TEST_EQUAL("DirectoryWatcher::IsActive()-Missing",false,Missing.IsActive())
+        TEST_EQUAL("DirectoryWatcher::GetDirectoryPath()",String("WatchTest/NotADir"),Missing.GetDirectoryPath())
+    }// Missing Directories
+
+#if defined(MEZZ_Linux) && !defined(MEZZ_CompilerIsEmscripten)
+    {// Coalescing
+        EventCollector Collector;
+        Filesystem::DirectoryWatcherOptions Options;
+        Options.CoalesceInterval = 200;
+        Filesystem::DirectoryWatcher Watcher(WatchDir + "/",Collector.GetCallback(),Options);
+        TEST_EQUAL("DirectoryWatcher::IsActive()",true,Watcher.IsActive())
+        TEST_EQUAL("DirectoryWatcher::GetWatchedDirectoryCount()",size_t(1),Watcher.GetWatchedDirectoryCount())
+
+        {
+            std::ofstream WrittenFile(WatchDir + "/Written.txt");
+            WrittenFile << "Several writes in one burst.";
+            WrittenFile.flush();
+            WrittenFile << "More data.";
+        }
+        {
+            std::ofstream FleetingFile(WatchDir + "/Fleeting.txt");
+        }
+        static_cast<void>( Filesystem::RemoveFile(WatchDir + "/Fleeting.txt") );
+
+        TEST_EQUAL("DirectoryWatcher-Coalesce-Created",
+                   true,Collector.WaitFor(WatchDir + "/Written.txt",WatchEventType::Created))
+        {
+            std::lock_guard<std::mutex> Lock(Collector.EventLock);
+            TEST_EQUAL("DirectoryWatcher-Coalesce-OneBatch",Whole(1),Collector.BatchCount)
+            TEST_EQUAL("DirectoryWatcher-Coalesce-Cancelled",size_t(0),Collector.Count(WatchDir + "/Fleeting.txt"))
+            TEST_EQUAL("DirectoryWatcher-Coalesce-OneEvent",size_t(1),Collector.Events.size())
+        }
+
+        Collector.Reset();
+        {
+            std::ofstream WrittenFile(WatchDir + "/Written.txt",std::ios::app);
+            WrittenFile << "Appended.";
+        }
+        TEST_EQUAL("DirectoryWatcher-Modified",
+                   true,Collector.WaitFor(WatchDir + "/Written.txt",WatchEventType::Modified))
+
+        Collector.Reset();
+        static_cast<void>( Filesystem::MoveFile(WatchDir + "/Written.txt",WatchDir + "/Moved.txt",
+                                                Filesystem::FileOverwrite::Deny) );
+        TEST_EQUAL("DirectoryWatcher-Moved-Created",
+                   true,Collector.WaitFor(WatchDir + "/Moved.txt",WatchEventType::Created))
+        TEST_EQUAL("DirectoryWatcher-Moved-Removed",
+                   true,Collector.WaitFor(WatchDir + "/Written.txt",WatchEventType::Removed))
+
+        Collector.Reset();
+        static_cast<void>( Filesystem::CreateDirectoryPath(WatchDir + "/Unwatched/Deeper/") );
+        TEST_EQUAL("DirectoryWatcher-NotRecursive-Created",
+                   true,Collector.WaitFor(WatchDir + "/Unwatched",WatchEventType::Created))
+        TEST_EQUAL("DirectoryWatcher-NotRecursive-Count",size_t(1),Watcher.GetWatchedDirectoryCount())
+        static_cast<void>( Filesystem::RemoveDirectoryTree(WatchDir + "/Unwatched/") );
+        static_cast<void>( Filesystem::RemoveFile(WatchDir + "/Moved.txt") );
+        TEST_EQUAL("DirectoryWatcher-Removed",
+                   true,Collector.WaitFor(WatchDir + "/Moved.txt",WatchEventType::Removed))
+        TEST_EQUAL("DirectoryWatcher::GetOverflowCount()",UInt64(0),Watcher.GetOverflowCount())
+    }// Coalescing
+
+    {// Recursive
+        static_cast<void>( Filesystem::CreateDirectory(WatchDir + "/Existing/") );
+        EventCollector Collector;
+        Filesystem::DirectoryWatcherOptions Options;
+        Options.Recursive = true;
+        Options.CoalesceInterval = 0;
+        Filesystem::DirectoryWatcher Watcher(WatchDir,Collector.GetCallback(),Options);
+        TEST_EQUAL("DirectoryWatcher-Recursive-ExistingWatched",size_t(2),Watcher.GetWatchedDirectoryCount())
+
+        {
+            std::ofstream NestedFile(WatchDir + "/Existing/Nested.txt");
+        }
+        TEST_EQUAL("DirectoryWatcher-Recursive-Existing",
+                   true,Collector.WaitFor(WatchDir + "/Existing/Nested.txt",WatchEventType::Created))
+
+        static_cast<void>( Filesystem::CreateDirectoryPath(WatchDir + "/New/Deeper/") );
+        TEST_EQUAL("DirectoryWatcher-Recursive-NewDirectory",
+                   true,Collector.WaitFor(WatchDir + "/New",WatchEventType::Created))
+        TEST_EQUAL("DirectoryWatcher-Recursive-NewSubdirectory",
+                   true,Collector.WaitFor(WatchDir + "/New/Deeper",WatchEventType::Created))
+        {
+            std::ofstream DeepFile(WatchDir + "/New/Deeper/Deep.txt");
+        }
+        TEST_EQUAL("DirectoryWatcher-Recursive-NewNested",
+                   true,Collector.WaitFor(WatchDir + "/New/Deeper/Deep.txt",WatchEventType::Created))
+
+        static_cast<void>( Filesystem::RemoveDirectoryTree(WatchDir + "/New/") );
+        TEST_EQUAL("DirectoryWatcher-Recursive-Removed",
+                   true,Collector.WaitFor(WatchDir + "/New",WatchEventType::Removed))
+        {
+            std::unique_lock<std::mutex> Lock(Collector.EventLock);
+            Collector.EventsDelivered.wait_for(Lock,std::chrono::seconds(5),[&](){
+                return Watcher.GetWatchedDirectoryCount() == 2;
+            });
+        }
+        TEST_EQUAL("DirectoryWatcher-Recursive-WatchesRemoved",size_t(2),Watcher.GetWatchedDirectoryCount())
+    }// Recursive
+#endif
+
+    if( Filesystem::RemoveDirectoryTree(WatchDir + "/") == false ) {
+        TEST_RESULT("WatchDir-CleanupFailed",Testing::TestResult::Warning)
+    }
+}
+
+#endif
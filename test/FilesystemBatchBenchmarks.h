@@ -0,0 +1,192 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_FilesystemBatchBenchmarks_h
+#define Mezz_Filesystem_FilesystemBatchBenchmarks_h
+
+/// @file
+/// @brief Timings of batched filesystem operations against one call per operation.
+
+#include "MezzTest.h"
+
+#include "FilesystemBatch.h"
+#include "FilesystemManagement.h"
+
+#include <chrono>
+
+BENCHMARK_TEST_GROUP(FilesystemBatchBenchmarks,FilesystemBatchBenchmarks)
+{
+    using namespace Mezzanine;
+    using BenchClock = std::chrono::steady_clock;
+    using Milliseconds = std::chrono::duration<double,std::milli>;
+
+    const String BenchDir("./BatchBench/");
+    const Whole EntryCount = 20000;
+
+    StringVector BenchPaths;
+    BenchPaths.reserve(EntryCount);
+    for( Whole EntryNum = 0 ; EntryNum < EntryCount ; ++EntryNum )
+        { BenchPaths.push_back( BenchDir + "BatchedEntryWithAReasonablyLongName" + std::to_string(EntryNum) ); }
+
+    /// @brief Times a callable once, in milliseconds.
+    auto TimeOnce = [](auto&& ToTime) {
+        BenchClock::time_point Start = BenchClock::now();
+        ToTime();
+        return Milliseconds( BenchClock::now() - Start ).count();
+    };
+    /// @brief Creates every benchmark file, so that they can be removed.
+    auto CreateFiles = [&]() {
+        for( const String& BenchPath : BenchPaths )
+            { std::ofstream BenchFile(BenchPath); }
+    };
+    /// @brief Counts the results that weren't successful.
+    auto CountFailures = [](const Filesystem::FilesystemBatch::ResultContainer& Results) {
+        return std::count_if(Results.begin(),Results.end(),[](const Filesystem::ModifyResult Result) {
+            return Result != Filesystem::ModifyResult::Success;
+        });
+    };
+
+    if( Filesystem::CreateDirectory(BenchDir) == false ) {
+        TEST_RESULT("CreateBenchDir",Testing::TestResult::Failed)
+        return;
+    }
+    TestLog << "Batches " << ( Filesystem::FilesystemBatch::IsAsyncSupported() ? "are" : "aren't" )
+            << " using io_uring. Timing " << EntryCount << " operations of each kind.\n";
+
+    {// Creating directories
+        Whole PerCallFailures = 0;
+        double PerCallTime = TimeOnce([&](){
+            for( const String& BenchPath : BenchPaths )
+                { PerCallFailures += ( Filesystem::CreateDirectory(BenchPath) != Filesystem::ModifyResult::Success ); }
+        });
+        for( const String& BenchPath : BenchPaths )
+            { static_cast<void>( Filesystem::RemoveDirectory(BenchPath) ); }
+
+        Filesystem::FilesystemBatch::ResultContainer BatchResults;
+        double BatchTime = TimeOnce([&](){
+            Filesystem::FilesystemBatch Batch;
+            for( const String& BenchPath : BenchPaths )
+                { Batch.CreateDirectory(BenchPath); }
+            BatchResults = Batch.Submit();
+        });
+
+        TestLog << "CreateDirectory - per call: " << PerCallTime << "ms, batched: " << BatchTime << "ms.\n";
+        TEST_EQUAL("CreateDirectory-PerCallFailures",Whole(0),PerCallFailures)
+        TEST_EQUAL("CreateDirectory-BatchFailures",0,CountFailures(BatchResults))
+    }// Creating directories
+
+    {// Stat and removing directories
+        ArchiveEntryVector Entries;
+        Entries.resize(EntryCount);
+        Whole PerCallFound = 0;
+        double PerCallStatTime = TimeOnce([&](){
+            for( const String& BenchPath : BenchPaths )
+                { PerCallFound += Filesystem::DirectoryExists(BenchPath); }
+        });
+        Filesystem::FilesystemBatch::ResultContainer StatResults;
+        double BatchStatTime = TimeOnce([&](){
+            Filesystem::FilesystemBatch Batch;
+            for( Whole EntryNum = 0 ; EntryNum < EntryCount ; ++EntryNum )
+                { Batch.Stat(BenchPaths[EntryNum],Entries[EntryNum]); }
+            StatResults = Batch.Submit();
+        });
+        Filesystem::FilesystemBatch::ResultContainer RemoveResults;
+        double BatchRemoveTime = TimeOnce([&](){
+            Filesystem::FilesystemBatch Batch;
+            for( const String& BenchPath : BenchPaths )
+                { Batch.RemoveDirectory(BenchPath); }
+            RemoveResults = Batch.Submit();
+        });
+
+        Whole PerCallFailures = 0;
+        for( const String& BenchPath : BenchPaths )
+            { static_cast<void>( Filesystem::CreateDirectory(BenchPath) ); }
+        double PerCallRemoveTime = TimeOnce([&](){
+            for( const String& BenchPath : BenchPaths )
+                { PerCallFailures += ( Filesystem::RemoveDirectory(BenchPath) != Filesystem::ModifyResult::Success ); }
+        });
+
+        TestLog << "Stat - per call: " << PerCallStatTime << "ms, batched: " << BatchStatTime << "ms.\n";
+        TestLog << "RemoveDirectory - per call: " << PerCallRemoveTime << "ms, "
+                << "batched: " << BatchRemoveTime << "ms.\n";
+        TEST_EQUAL("Stat-PerCallFound",EntryCount,PerCallFound)
+        TEST_EQUAL("RemoveDirectory-PerCallFailures",Whole(0),PerCallFailures)
+        TEST_EQUAL("Stat-BatchFailures",0,CountFailures(StatResults))
+        TEST_EQUAL("RemoveDirectory-BatchFailures",0,CountFailures(RemoveResults))
+    }// Stat and removing directories
+
+    {// Removing files
+        CreateFiles();
+        Whole PerCallFailures = 0;
+        double PerCallTime = TimeOnce([&](){
+            for( const String& BenchPath : BenchPaths )
+                { PerCallFailures += ( Filesystem::RemoveFile(BenchPath) != Filesystem::ModifyResult::Success ); }
+        });
+
+        CreateFiles();
+        Filesystem::FilesystemBatch::ResultContainer AsyncResults;
+        double AsyncTime = TimeOnce([&](){
+            Filesystem::FilesystemBatch Batch;
+            for( const String& BenchPath : BenchPaths )
+                { Batch.RemoveFile(BenchPath); }
+            AsyncResults = Batch.Submit();
+        });
+
+        CreateFiles();
+        Filesystem::FilesystemBatch::ResultContainer SyncResults;
+        double SyncTime = TimeOnce([&](){
+            Filesystem::FilesystemBatch Batch(Filesystem::BatchBackend::Synchronous);
+            for( const String& BenchPath : BenchPaths )
+                { Batch.RemoveFile(BenchPath); }
+            SyncResults = Batch.Submit();
+        });
+
+        TestLog << "RemoveFile - per call: " << PerCallTime << "ms, batched: " << AsyncTime << "ms, "
+                << "batched synchronously: " << SyncTime << "ms.\n";
+        TEST_EQUAL("RemoveFile-PerCallFailures",Whole(0),PerCallFailures)
+        TEST_EQUAL("RemoveFile-BatchFailures",0,CountFailures(AsyncResults))
+        TEST_EQUAL("RemoveFile-SyncBatchFailures",0,CountFailures(SyncResults))
+    }// Removing files
+
+    if( Filesystem::RemoveDirectoryTree(BenchDir) == false ) {
+        TEST_RESULT("BenchDir-CleanupFailed",Testing::TestResult::Warning)
+    }
+}
+
+#endif
@@ -0,0 +1,142 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_FilesystemBatchTests_h
+#define Mezz_Filesystem_FilesystemBatchTests_h
+
+/// @file
+/// @brief A few tests of queueing filesystem operations and submitting them together.
+
+#include "MezzTest.h"
+
+#include "FilesystemBatch.h"
+#include "FilesystemManagement.h"
+
+AUTOMATIC_TEST_GROUP(FilesystemBatchTests,FilesystemBatch)
+{
+    using namespace Mezzanine;
+    using ResultContainer = Filesystem::FilesystemBatch::ResultContainer;
+
+    TestLog << "Batches " << ( Filesystem::FilesystemBatch::IsAsyncSupported() ? "can" : "can't" )
+            << " be submitted through io_uring on this system.\n";
+
+    for( const Filesystem::BatchBackend Backend : { Filesystem::BatchBackend::Auto,
+                                                    Filesystem::BatchBackend::Synchronous } )
+    {
+        const String BackendName = ( Backend == Filesystem::BatchBackend::Auto ? "Auto" : "Synchronous" );
+        const String BatchDir("./BatchTest/");
+        const String FileData("Batched.");
+        const Whole SubDirCount = 20;
+
+        Filesystem::FilesystemBatch Batch(Backend);
+        TEST_EQUAL("FilesystemBatch::GetBackend()-" + BackendName,
+                   static_cast<int>(Backend),static_cast<int>( Batch.GetBackend() ))
+        TEST_EQUAL("FilesystemBatch::Submit()-" + BackendName + "-Empty",size_t(0),Batch.Submit().size())
+
+        Batch.CreateDirectory(BatchDir);
+        Batch.Barrier();
+        for( Whole SubDir = 0 ; SubDir < SubDirCount ; ++SubDir )
+            { Batch.CreateDirectory( BatchDir + "Sub" + std::to_string(SubDir) ); }
+        TEST_EQUAL("FilesystemBatch::GetOperationCount()-" + BackendName,size_t(SubDirCount + 1),
+                   Batch.GetOperationCount())
+        ResultContainer CreateResults = Batch.Submit();
+        TEST_EQUAL("FilesystemBatch::CreateDirectory(const_StringView)-" + BackendName + "-Count",
+                   size_t(SubDirCount + 1),CreateResults.size())
+        TEST_EQUAL("FilesystemBatch::CreateDirectory(const_StringView)-" + BackendName + "-AllSucceeded",
+                   true,std::all_of(CreateResults.begin(),CreateResults.end(),[](const Filesystem::ModifyResult R) {
+                       return R == Filesystem::ModifyResult::Success;
+                   }))
+        TEST_EQUAL("FilesystemBatch::CreateDirectory(const_StringView)-" + BackendName + "-Exists",
+                   true,Filesystem::DirectoryExists(BatchDir + "Sub" + std::to_string(SubDirCount - 1)))
+        TEST_EQUAL("FilesystemBatch::Submit()-" + BackendName + "-Cleared",size_t(0),Batch.GetOperationCount())
+
+        {
+            std::ofstream BatchFile(BatchDir + "File.txt");
+            BatchFile << FileData;
+        }
+        ArchiveEntry FileEntry;
+        ArchiveEntry DirEntry;
+        Batch.Stat(BatchDir + "File.txt",FileEntry);
+        Batch.Stat(BatchDir + "Sub0",DirEntry);
+        // Operations in a phase may run in any order, so the file has to be stat'd before it can be moved.
+        Batch.Barrier();
+        Batch.CreateDirectory(BatchDir + "Sub0");
+        Batch.RemoveFile(BatchDir + "NotAFile.txt");
+        Batch.MoveFile(BatchDir + "File.txt",BatchDir + "Moved.txt");
+        Batch.Barrier();
+        Batch.CreateSymlink(BatchDir + "Link.txt","Moved.txt");
+        ResultContainer MixedResults = Batch.Submit();
+        TEST_EQUAL("FilesystemBatch::Stat(const_StringView,ArchiveEntry&)-" + BackendName + "-File",
+                   static_cast<int>(Filesystem::ModifyResult::Success),static_cast<int>(MixedResults[0]))
+        TEST_EQUAL("FilesystemBatch::Stat(const_StringView,ArchiveEntry&)-" + BackendName + "-FileType",
+                   static_cast<int>(EntryType::File),static_cast<int>(FileEntry.Entry))
+        TEST_EQUAL("FilesystemBatch::Stat(const_StringView,ArchiveEntry&)-" + BackendName + "-FileSize",
+                   UInt64(FileData.size()),FileEntry.Size)
+        TEST_EQUAL("FilesystemBatch::Stat(const_StringView,ArchiveEntry&)-" + BackendName + "-DirType",
+                   static_cast<int>(EntryType::Directory),static_cast<int>(DirEntry.Entry))
+        TEST_EQUAL("FilesystemBatch::CreateDirectory(const_StringView)-" + BackendName + "-AlreadyExists",
+                   static_cast<int>(Filesystem::ModifyResult::AlreadyExists),static_cast<int>(MixedResults[2]))
+        TEST_EQUAL("FilesystemBatch::RemoveFile(const_StringView)-" + BackendName + "-DoesNotExist",
+                   static_cast<int>(Filesystem::ModifyResult::DoesNotExist),static_cast<int>(MixedResults[3]))
+        TEST_EQUAL("FilesystemBatch::MoveFile(const_StringView,const_StringView)-" + BackendName,
+                   static_cast<int>(Filesystem::ModifyResult::Success),static_cast<int>(MixedResults[4]))
+        TEST_EQUAL("FilesystemBatch::MoveFile(const_StringView,const_StringView)-" + BackendName + "-Moved",
+                   true,Filesystem::FileExists(BatchDir + "Moved.txt"))
+        if( MixedResults[5] == Filesystem::ModifyResult::Success ) {
+            TEST_EQUAL("FilesystemBatch::CreateSymlink(const_StringView,const_StringView)-" + BackendName,
+                       true,Filesystem::SymlinkExists(BatchDir + "Link.txt"))
+            Batch.RemoveFile(BatchDir + "Link.txt");
+        }
+
+        Batch.RemoveFile(BatchDir + "Moved.txt");
+        for( Whole SubDir = 0 ; SubDir < SubDirCount ; ++SubDir )
+            { Batch.RemoveDirectory( BatchDir + "Sub" + std::to_string(SubDir) ); }
+        Batch.Barrier();
+        Batch.RemoveDirectory(BatchDir);
+        ResultContainer RemoveResults = Batch.Submit();
+        TEST_EQUAL("FilesystemBatch::RemoveDirectory(const_StringView)-" + BackendName + "-AllSucceeded",
+                   true,std::all_of(RemoveResults.begin(),RemoveResults.end(),[](const Filesystem::ModifyResult R) {
+                       return R == Filesystem::ModifyResult::Success;
+                   }))
+        TEST_EQUAL("FilesystemBatch::RemoveDirectory(const_StringView)-" + BackendName + "-Removed",
+                   false,Filesystem::DirectoryExists(BatchDir))
+    }
+}
+
+#endif
@@ -0,0 +1,124 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_FilesystemCacheBenchmarks_h
+#define Mezz_Filesystem_FilesystemCacheBenchmarks_h
+
+/// @file
+/// @brief Timings of repeated metadata queries with and without a FilesystemCache.
+
+#include "MezzTest.h"
+
+#include "DirectoryContents.h"
+#include "FilesystemCache.h"
+#include "FilesystemManagement.h"
+
+#include <chrono>
+
+BENCHMARK_TEST_GROUP(FilesystemCacheBenchmarks,FilesystemCacheBenchmarks)
+{
+    using namespace Mezzanine;
+    using BenchClock = std::chrono::steady_clock;
+    using Milliseconds = std::chrono::duration<double,std::milli>;
+
+    const String BenchDir("./CacheBench/");
+    const Whole FileCount = 1000;
+    const Whole PassCount = 100;
+
+    if( Filesystem::CreateDirectory(BenchDir) == false ) {
+        TEST_RESULT("CreateBenchDir",Testing::TestResult::Failed)
+        return;
+    }
+    StringVector BenchFiles;
+    BenchFiles.reserve(FileCount);
+    for( Whole FileNum = 0 ; FileNum < FileCount ; ++FileNum )
+    {
+        BenchFiles.push_back( BenchDir + "HotReloadedAsset" + std::to_string(FileNum) + ".texture" );
+        std::ofstream BenchFile(BenchFiles.back());
+    }
+
+    /// @brief Times a callable over every pass, in milliseconds.
+    auto TimePasses = [&](auto&& ToTime) {
+        BenchClock::time_point Start = BenchClock::now();
+        for( Whole Pass = 0 ; Pass < PassCount ; ++Pass )
+            { ToTime(); }
+        return Milliseconds( BenchClock::now() - Start ).count();
+    };
+
+    Filesystem::FilesystemCache Cache;
+    TestLog << "Querying " << FileCount << " files " << PassCount << " times, with the cache "
+            << ( Cache.IsWatching() ? "watching" : "polling" ) << " directories.\n";
+
+    {// FileExists
+        Whole UncachedFound = 0;
+        double UncachedTime = TimePasses([&](){
+            for( const String& BenchFile : BenchFiles )
+                { UncachedFound += Filesystem::FileExists(BenchFile); }
+        });
+        Whole CachedFound = 0;
+        double CachedTime = TimePasses([&](){
+            for( const String& BenchFile : BenchFiles )
+                { CachedFound += Cache.FileExists(BenchFile); }
+        });
+        TestLog << "FileExists - uncached: " << UncachedTime << "ms, cached: " << CachedTime << "ms.\n";
+        TEST_EQUAL("FileExists-Matches",UncachedFound,CachedFound)
+    }// FileExists
+
+    {// GetDirectoryContents
+        size_t UncachedEntries = 0;
+        double UncachedTime = TimePasses([&](){
+            UncachedEntries += Filesystem::GetDirectoryContents(BenchDir).size();
+        });
+        size_t CachedEntries = 0;
+        double CachedTime = TimePasses([&](){
+            CachedEntries += Cache.GetDirectoryContents(BenchDir)->size();
+        });
+        TestLog << "GetDirectoryContents - uncached: " << UncachedTime << "ms, cached: " << CachedTime << "ms.\n";
+        TEST_EQUAL("GetDirectoryContents-Matches",UncachedEntries,CachedEntries)
+    }// GetDirectoryContents
+
+    const Filesystem::FilesystemCacheStatistics& Stats = Cache.GetStatistics();
+    TestLog << "Cache hits: " << Stats.Hits << ", misses: " << Stats.Misses << ".\n";
+
+    if( Filesystem::RemoveDirectoryTree(BenchDir) == false ) {
+        TEST_RESULT("BenchDir-CleanupFailed",Testing::TestResult::Warning)
+    }
+}
+
+#endif
@@ -0,0 +1,221 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_FilesystemCacheTests_h
+#define Mezz_Filesystem_FilesystemCacheTests_h
+
+/// @file
+/// @brief A few tests of caching directory listings and path metadata.
+
+#include "MezzTest.h"
+
+#include "FilesystemCache.h"
+#include "FilesystemManagement.h"
+
+AUTOMATIC_TEST_GROUP(FilesystemCacheTests,FilesystemCache)
+{
+    using namespace Mezzanine;
+
+    const String CacheDir("CacheTest/");
+    if( Filesystem::CreateDirectoryPath(CacheDir + "First/") == false ||
+        Filesystem::CreateDirectoryPath(CacheDir + "Second/") == false ||
+        Filesystem::CreateDirectoryPath(CacheDir + "Third/") == false )
+    {
+        TEST_RESULT("CreateCacheDirs",Testing::TestResult::Failed)
+        return;
+    }
+    {
+        std::ofstream CacheFile(CacheDir + "Cached.txt");
+        CacheFile << "Cached data.";
+    }
+
+    {// Hits and Misses
+        Filesystem::FilesystemCache Cache;
+        TEST_EQUAL("FilesystemCache::FileExists(const_StringView)-Miss",true,Cache.FileExists(CacheDir + "Cached.txt"))
+        TEST_EQUAL("FilesystemCache::FileExists(const_StringView)-Hit",true,Cache.FileExists(CacheDir + "Cached.txt"))
+        TEST_EQUAL("FilesystemCache::FileExists(const_StringView)-Directory",false,Cache.FileExists(CacheDir + "First"))
+        TEST_EQUAL("FilesystemCache::DirectoryExists(const_StringView)",
+                   true,Cache.DirectoryExists(CacheDir + "First/"))
+        TEST_EQUAL("FilesystemCache::DirectoryExists(const_StringView)-File",
+                   false,Cache.DirectoryExists(CacheDir + "Cached.txt"))
+        TEST_EQUAL("FilesystemCache::FileExists(const_StringView)-Missing",
+                   false,Cache.FileExists(CacheDir + "Later.txt"))
+
+        Optional<ArchiveEntry> Stat = Cache.StatPath(CacheDir + "Cached.txt");
+        TEST_EQUAL("FilesystemCache::StatPath(const_StringView)",
+                   true,Stat.has_value() && Stat->Name == "Cached.txt" && Stat->Size == 12)
+        TEST_EQUAL("FilesystemCache::StatPath(const_StringView)-Root",true,Cache.StatPath("/").has_value())
+
+        Filesystem::FilesystemCache::ListingPointer Listing = Cache.GetDirectoryContents(CacheDir);
+        TEST_EQUAL("FilesystemCache::GetDirectoryContents(const_StringView)-Miss",size_t(4),Listing->size())
+        TEST_EQUAL("FilesystemCache::GetDirectoryContents(const_StringView)-Hit",
+                   Listing.get(),Cache.GetDirectoryContents("CacheTest").get())
+        TEST_EQUAL("FilesystemCache::GetDirectoryContents(const_StringView)-Missing",
+                   true,Cache.GetDirectoryContents(CacheDir + "NotADir/")->empty())
+
+        const Filesystem::FilesystemCacheStatistics& Stats = Cache.GetStatistics();
+        TEST_EQUAL("FilesystemCache::GetStatistics()-Hits",UInt64(5),Stats.Hits)
+        TEST_EQUAL("FilesystemCache::GetStatistics()-Misses",UInt64(6),Stats.Misses)
+        TEST_EQUAL("FilesystemCache::GetCachedDirectoryCount()",size_t(2),Cache.GetCachedDirectoryCount())
+
+        if( Cache.IsWatching() ) {
+            // The directory that doesn't exist can't be watched.
+            TEST_EQUAL("FilesystemCache::GetWatchedDirectoryCount()",size_t(1),Cache.GetWatchedDirectoryCount())
+            {
+                std::ofstream LaterFile(CacheDir + "Later.txt");
+                LaterFile << "Written after being cached.";
+            }
+            Cache.Refresh();
+            TEST_EQUAL("FilesystemCache-Watched-Created",true,Cache.FileExists(CacheDir + "Later.txt"))
+            TEST_EQUAL("FilesystemCache-Watched-Listing",size_t(5),Cache.GetDirectoryContents(CacheDir)->size())
+            TEST_EQUAL("FilesystemCache-Watched-OldListingKept",size_t(4),Listing->size())
+
+            static_cast<void>( Filesystem::RemoveFile(CacheDir + "Later.txt") );
+            Cache.Refresh();
+            TEST_EQUAL("FilesystemCache-Watched-Removed",false,Cache.FileExists(CacheDir + "Later.txt"))
+            TEST_EQUAL("FilesystemCache-Watched-Invalidations",true,Stats.Invalidations >= 4)
+        }else{
+            TEST_RESULT("FilesystemCache-Watched",Testing::TestResult::Skipped)
+        }
+
+        Cache.ResetStatistics();
+        TEST_EQUAL("FilesystemCache::ResetStatistics()",UInt64(0),Stats.Hits + Stats.Misses)
+        Cache.Clear();
+        TEST_EQUAL("FilesystemCache::Clear()",size_t(0),Cache.GetCachedDirectoryCount())
+        TEST_EQUAL("FilesystemCache::Clear()-Watches",size_t(0),Cache.GetWatchedDirectoryCount())
+    }// Hits and Misses
+
+    {// Polling
+        Filesystem::FilesystemCacheOptions PollOptions;
+        PollOptions.UseWatches = false;
+        PollOptions.PollInterval = 60 * 60 * 1000;
+        Filesystem::FilesystemCache Cache(PollOptions);
+        TEST_EQUAL("FilesystemCache::IsWatching()-Disabled",false,Cache.IsWatching())
+
+        TEST_EQUAL("FilesystemCache-Polled-Missing",false,Cache.FileExists(CacheDir + "Polled.txt"))
+        {
+            std::ofstream PolledFile(CacheDir + "Polled.txt");
+        }
+        Cache.Refresh();
+        TEST_EQUAL("FilesystemCache-Polled-NotExpired",false,Cache.FileExists(CacheDir + "Polled.txt"))
+        Cache.Invalidate(CacheDir + "Polled.txt");
+        TEST_EQUAL("FilesystemCache::Invalidate(const_StringView)",true,Cache.FileExists(CacheDir + "Polled.txt"))
+        static_cast<void>( Filesystem::RemoveFile(CacheDir + "Polled.txt") );
+
+        PollOptions.PollInterval = 0;
+        Filesystem::FilesystemCache ExpiringCache(PollOptions);
+        TEST_EQUAL("FilesystemCache-Polled-Expired-Before",false,ExpiringCache.FileExists(CacheDir + "Polled.txt"))
+        {
+            std::ofstream PolledFile(CacheDir + "Polled.txt");
+        }
+        TEST_EQUAL("FilesystemCache-Polled-Expired-After",true,ExpiringCache.FileExists(CacheDir + "Polled.txt"))
+        static_cast<void>( Filesystem::RemoveFile(CacheDir + "Polled.txt") );
+    }// Polling
+
+    {// Shared Watches
+        Filesystem::FilesystemCacheOptions SharedOptions;
+        SharedOptions.MaxDirectories = 2;
+        SharedOptions.EventCheckInterval = 0;
+        Filesystem::FilesystemCache Cache(SharedOptions);
+        const String Spelling = CacheDir + "First/";
+        const String OtherSpelling = CacheDir + "./First/";
+        TEST_EQUAL("FilesystemCache-SharedWatch-Missing",false,Cache.FileExists(Spelling + "Shared.txt"))
+        TEST_EQUAL("FilesystemCache-SharedWatch-OtherMissing",false,Cache.FileExists(OtherSpelling + "Shared.txt"))
+        TEST_EQUAL("FilesystemCache-SharedWatch-Records",size_t(2),Cache.GetCachedDirectoryCount())
+
+        if( Cache.IsWatching() ) {
+            TEST_EQUAL("FilesystemCache-SharedWatch-Watches",size_t(1),Cache.GetWatchedDirectoryCount())
+            {
+                std::ofstream SharedFile(Spelling + "Shared.txt");
+            }
+            TEST_EQUAL("FilesystemCache-SharedWatch-Created",true,Cache.FileExists(Spelling + "Shared.txt"))
+            TEST_EQUAL("FilesystemCache-SharedWatch-OtherCreated",
+                       true,Cache.FileExists(OtherSpelling + "Shared.txt"))
+
+            // Evicting the first spelling must leave the watch the second spelling relies on.
+            static_cast<void>( Cache.FileExists(OtherSpelling + "Shared.txt") );
+            static_cast<void>( Cache.FileExists(CacheDir + "Second/Shared.txt") );
+            TEST_EQUAL("FilesystemCache-SharedWatch-Evicted",UInt64(1),Cache.GetStatistics().Evictions)
+            static_cast<void>( Filesystem::RemoveFile(Spelling + "Shared.txt") );
+            TEST_EQUAL("FilesystemCache-SharedWatch-RemovedAfterEviction",
+                       false,Cache.FileExists(OtherSpelling + "Shared.txt"))
+        }else{
+            TEST_RESULT("FilesystemCache-SharedWatch",Testing::TestResult::Skipped)
+            static_cast<void>( Filesystem::RemoveFile(Spelling + "Shared.txt") );
+        }
+    }// Shared Watches
+
+    {// Trailing Separators
+        Filesystem::FilesystemCache Cache;
+        TEST_EQUAL("FilesystemCache::StatPath(const_StringView)-FileWithSeparator",
+                   false,Cache.StatPath(CacheDir + "Cached.txt/").has_value())
+        TEST_EQUAL("FilesystemCache::FileExists(const_StringView)-AfterSeparator",
+                   true,Cache.FileExists(CacheDir + "Cached.txt"))
+        TEST_EQUAL("FilesystemCache::FileExists(const_StringView)-WithSeparator",
+                   false,Cache.FileExists(CacheDir + "Cached.txt/"))
+        TEST_EQUAL("FilesystemCache::DirectoryExists(const_StringView)-WithSeparator",
+                   true,Cache.DirectoryExists(CacheDir + "Second/"))
+        TEST_EQUAL("FilesystemCache::DirectoryExists(const_StringView)-AfterSeparator",
+                   true,Cache.DirectoryExists(CacheDir + "Second"))
+    }// Trailing Separators
+
+    {// Least Recently Used
+        Filesystem::FilesystemCacheOptions LimitedOptions;
+        LimitedOptions.MaxDirectories = 2;
+        Filesystem::FilesystemCache Cache(LimitedOptions);
+        static_cast<void>( Cache.GetDirectoryContents(CacheDir + "First/") );
+        static_cast<void>( Cache.GetDirectoryContents(CacheDir + "Second/") );
+        static_cast<void>( Cache.GetDirectoryContents(CacheDir + "First/") );
+        static_cast<void>( Cache.GetDirectoryContents(CacheDir + "Third/") );
+        TEST_EQUAL("FilesystemCache-LRU-Count",size_t(2),Cache.GetCachedDirectoryCount())
+        TEST_EQUAL("FilesystemCache-LRU-Evictions",UInt64(1),Cache.GetStatistics().Evictions)
+
+        Cache.ResetStatistics();
+        static_cast<void>( Cache.GetDirectoryContents(CacheDir + "First/") );
+        static_cast<void>( Cache.GetDirectoryContents(CacheDir + "Second/") );
+        TEST_EQUAL("FilesystemCache-LRU-RecentKept",UInt64(1),Cache.GetStatistics().Hits)
+        TEST_EQUAL("FilesystemCache-LRU-OldestEvicted",UInt64(1),Cache.GetStatistics().Misses)
+    }// Least Recently Used
+
+    if( Filesystem::RemoveDirectoryTree(CacheDir) == false ) {
+        TEST_RESULT("CacheDir-CleanupFailed",Testing::TestResult::Warning)
+    }
+}
+
+#endif
@@ -45,8 +45,17 @@
 
 #include "MezzTest.h"
 
+#include "DirectoryContents.h"
 #include "FilesystemManagement.h"
 
+#include <chrono>
+
+#ifndef MEZZ_Windows
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
 namespace Mezzanine {
 namespace Filesystem {
 /// @brief Convenience streaming operator to enable the tests to compile.
@@ -67,6 +76,11 @@ AUTOMATIC_TEST_GROUP(FilesystemManagementTests,FilesystemManagement)
 {
     using namespace Mezzanine;
 
+    auto ReadWholeFile = [](const String& FileName) {
+        std::ifstream ToRead(FileName,std::ios_base::binary);
+        return String( std::istreambuf_iterator<char>(ToRead), std::istreambuf_iterator<char>() );
+    };
+
     {// Basic File Management
     #ifdef MEZZ_CompilerIsEmscripten
         const String UtilityTestFile("UtilityTestOriginal.txt");
@@ -135,6 +149,379 @@ AUTOMATIC_TEST_GROUP(FilesystemManagementTests,FilesystemManagement)
                    Filesystem::RemoveDirectory(MoveTargetDir))
     }// Basic File Management
 
+#ifndef MEZZ_Windows
+    {// Moving Across Filesystems
+        // Ram disks are usually mounted here, which is enough to test moves that can't be a simple rename.
+        const String LocalDir("./MoveAcross/");
+        const String RemoteDir("/dev/shm/MezzMoveAcross" + std::to_string( ::getpid() ) + "/");
+        const String FileData("Data that has to travel between filesystems.");
+
+        struct stat LocalStat;
+        struct stat RemoteStat;
+        Boole CanTest = ( Filesystem::CreateDirectory(LocalDir) == Filesystem::ModifyResult::Success &&
+                          Filesystem::CreateDirectory(RemoteDir) == Filesystem::ModifyResult::Success &&
+                          ::stat(LocalDir.c_str(),&LocalStat) == 0 &&
+                          ::stat(RemoteDir.c_str(),&RemoteStat) == 0 &&
+                          LocalStat.st_dev != RemoteStat.st_dev );
+        if( CanTest ) {
+            const String LocalFile = LocalDir + "File.txt";
+            const String RemoteFile = RemoteDir + "File.txt";
+            {
+                std::ofstream ToMove(LocalFile);
+                ToMove << FileData;
+            }
+            const struct timespec OldTimes[2] = { { 1000000000, 0 }, { 1000000000, 0 } };
+            Boole MetadataSet = ( ::chmod(LocalFile.c_str(),0640) == 0 &&
+                                  ::utimensat(AT_FDCWD,LocalFile.c_str(),OldTimes,0) == 0 );
+
+            TEST_EQUAL("MoveFile(const_StringView,const_StringView)-AcrossDevices-File",
+                       Filesystem::ModifyResult::Success,
+                       Filesystem::MoveFile(LocalFile,RemoteFile,Filesystem::FileOverwrite::Deny))
+            TEST_EQUAL("MoveFile(const_StringView,const_StringView)-AcrossDevices-FileSourceRemoved",
+                       false,Filesystem::FileExists(LocalFile))
+            TEST_EQUAL("MoveFile(const_StringView,const_StringView)-AcrossDevices-FileContents",
+                       FileData,ReadWholeFile(RemoteFile))
+            struct stat MovedStat;
+            if( MetadataSet && ::stat(RemoteFile.c_str(),&MovedStat) == 0 ) {
+                TEST_EQUAL("MoveFile(const_StringView,const_StringView)-AcrossDevices-FilePermissions",
+                           mode_t(0640),MovedStat.st_mode & 07777)
+                TEST_EQUAL("MoveFile(const_StringView,const_StringView)-AcrossDevices-FileModifyTime",
+                           time_t(1000000000),MovedStat.st_mtime)
+            }
+
+            {
+                std::ofstream Replacement(LocalFile);
+                Replacement << "Replacement.";
+            }
+            TEST_EQUAL("MoveFile(const_StringView,const_StringView)-AcrossDevices-Deny",
+                       Filesystem::ModifyResult::AlreadyExists,
+                       Filesystem::MoveFile(LocalFile,RemoteFile,Filesystem::FileOverwrite::Deny))
+            TEST_EQUAL("MoveFile(const_StringView,const_StringView)-AcrossDevices-Allow",
+                       Filesystem::ModifyResult::Success,
+                       Filesystem::MoveFile(LocalFile,RemoteFile,Filesystem::FileOverwrite::Allow))
+            TEST_EQUAL("MoveFile(const_StringView,const_StringView)-AcrossDevices-AllowContents",
+                       String("Replacement."),ReadWholeFile(RemoteFile))
+
+            const String LocalLink = LocalDir + "Link.txt";
+            const String RemoteLink = RemoteDir + "Link.txt";
+            if( Filesystem::CreateSymlink(LocalLink,"File.txt") == Filesystem::ModifyResult::Success ) {
+                TEST_EQUAL("MoveFile(const_StringView,const_StringView)-AcrossDevices-Symlink",
+                           Filesystem::ModifyResult::Success,
+                           Filesystem::MoveFile(LocalLink,RemoteLink,Filesystem::FileOverwrite::Deny))
+                TEST_EQUAL("MoveFile(const_StringView,const_StringView)-AcrossDevices-SymlinkTarget",
+                           String("File.txt"),Filesystem::GetSymlinkTargetPath(RemoteLink).value_or(String()))
+                TEST_EQUAL("MoveFile(const_StringView,const_StringView)-AcrossDevices-SymlinkSourceRemoved",
+                           false,Filesystem::SymlinkExists(LocalLink))
+            }
+
+            const String LocalTree = LocalDir + "Tree";
+            const String RemoteTree = RemoteDir + "Tree";
+            static_cast<void>( Filesystem::CreateDirectoryPath(LocalTree + "/Sub/") );
+            {
+                std::ofstream TreeFile(LocalTree + "/Sub/Leaf.txt");
+                TreeFile << FileData;
+            }
+            TEST_EQUAL("MoveFile(const_StringView,const_StringView)-AcrossDevices-Directory",
+                       Filesystem::ModifyResult::Success,
+                       Filesystem::MoveFile(LocalTree,RemoteTree,Filesystem::FileOverwrite::Deny))
+            TEST_EQUAL("MoveFile(const_StringView,const_StringView)-AcrossDevices-DirectoryContents",
+                       FileData,ReadWholeFile(RemoteTree + "/Sub/Leaf.txt"))
+            TEST_EQUAL("MoveFile(const_StringView,const_StringView)-AcrossDevices-DirectorySourceRemoved",
+                       false,Filesystem::DirectoryExists(LocalTree))
+
+            // Like rename, an empty directory is replaced, but one with anything in it is left alone.
+            const String LocalOther = LocalDir + "Other";
+            static_cast<void>( Filesystem::CreateDirectoryPath(LocalOther + "/Sub/") );
+            {
+                std::ofstream OtherFile(LocalOther + "/Sub/Leaf.txt");
+                OtherFile << "Other data.";
+            }
+            TEST_EQUAL("MoveFile(const_StringView,const_StringView)-AcrossDevices-DirectoryNotEmpty",
+                       Filesystem::ModifyResult::NotEmpty,
+                       Filesystem::MoveFile(LocalOther,RemoteTree,Filesystem::FileOverwrite::Allow))
+            TEST_EQUAL("MoveFile(const_StringView,const_StringView)-AcrossDevices-DirectoryNotEmptyKept",
+                       FileData,ReadWholeFile(RemoteTree + "/Sub/Leaf.txt"))
+            TEST_EQUAL("MoveFile(const_StringView,const_StringView)-AcrossDevices-DirectoryNotEmptySourceKept",
+                       true,Filesystem::FileExists(LocalOther + "/Sub/Leaf.txt"))
+
+            const String RemoteEmpty = RemoteDir + "Empty";
+            static_cast<void>( Filesystem::CreateDirectory(RemoteEmpty) );
+            TEST_EQUAL("MoveFile(const_StringView,const_StringView)-AcrossDevices-DirectoryReplaceEmpty",
+                       Filesystem::ModifyResult::Success,
+                       Filesystem::MoveFile(LocalOther,RemoteEmpty,Filesystem::FileOverwrite::Allow))
+            TEST_EQUAL("MoveFile(const_StringView,const_StringView)-AcrossDevices-DirectoryReplaceEmptyContents",
+                       String("Other data."),ReadWholeFile(RemoteEmpty + "/Sub/Leaf.txt"))
+            TEST_EQUAL("MoveFile(const_StringView,const_StringView)-AcrossDevices-DirectoryReplaceEmptyLeftovers",
+                       size_t(4),Filesystem::GetDirectoryContentNames(RemoteDir).size())
+        }else{
+            TestLog << "No second filesystem was found to test moving across.\n";
+            TEST_RESULT("MoveFile(const_StringView,const_StringView)-AcrossDevices",Testing::TestResult::Skipped)
+        }
+        static_cast<void>( Filesystem::RemoveDirectoryTree(RemoteDir) );
+        TEST_EQUAL("MoveFile(const_StringView,const_StringView)-AcrossDevices-Cleanup",
+                   Filesystem::ModifyResult::Success,
+                   Filesystem::RemoveDirectoryTree(LocalDir))
+    }// Moving Across Filesystems
+#endif
+
+    {// Copying File Data
+        const String CopySourceFile("./CopySource.dat");
+        const String CopyDestFile("./CopyDest.dat");
+        const String EmptySourceFile("./EmptySource.dat");
+        const String EmptyDestFile("./EmptyDest.dat");
+
+        // Large and oddly sized enough to need several passes through any buffer used.
+        String CopyData;
+        CopyData.reserve(3 * 1024 * 1024 + 7);
+        for( size_t ByteNum = 0 ; ByteNum < CopyData.capacity() ; ++ByteNum )
+            { CopyData.push_back( static_cast<char>( ( ByteNum * 31 ) % 251 ) ); }
+        {
+            std::ofstream CopySource(CopySourceFile,std::ios_base::binary | std::ios_base::trunc);
+            CopySource << CopyData;
+            std::ofstream EmptySource(EmptySourceFile,std::ios_base::binary | std::ios_base::trunc);
+        }
+
+        TEST_EQUAL("CopyFile(const_StringView,const_StringView)-Large",
+                   Filesystem::ModifyResult::Success,
+                   Filesystem::CopyFile(CopySourceFile,CopyDestFile,Filesystem::FileOverwrite::Deny))
+        TEST_EQUAL("CopyFile(const_StringView,const_StringView)-Large-Contents",
+                   true,ReadWholeFile(CopyDestFile) == CopyData)
+        TEST_EQUAL("CopyFile(const_StringView,const_StringView)-Overwrite",
+                   Filesystem::ModifyResult::Success,
+                   Filesystem::CopyFile(EmptySourceFile,CopyDestFile,Filesystem::FileOverwrite::Allow))
+        TEST_EQUAL("CopyFile(const_StringView,const_StringView)-Overwrite-Contents",
+                   true,ReadWholeFile(CopyDestFile).empty())
+        TEST_EQUAL("CopyFile(const_StringView,const_StringView)-Empty",
+                   Filesystem::ModifyResult::Success,
+                   Filesystem::CopyFile(EmptySourceFile,EmptyDestFile,Filesystem::FileOverwrite::Deny))
+        TEST_EQUAL("CopyFile(const_StringView,const_StringView)-Empty-Exists",
+                   true,Filesystem::FileExists(EmptyDestFile))
+
+        TEST_EQUAL("CopyFile(const_StringView,const_StringView)-MissingSource",
+                   Filesystem::ModifyResult::DoesNotExist,
+                   Filesystem::CopyFile("./NotACopySource.dat",CopyDestFile,Filesystem::FileOverwrite::Allow))
+        TEST_EQUAL("CopyFile(const_StringView,const_StringView)-MissingDestDir",
+                   Filesystem::ModifyResult::DoesNotExist,
+                   Filesystem::CopyFile(CopySourceFile,"./NotACopyDir/Dest.dat",Filesystem::FileOverwrite::Allow))
+    #ifndef MEZZ_Windows
+        TEST_EQUAL("CopyFile(const_StringView,const_StringView)-OntoItself",
+                   Filesystem::ModifyResult::AlreadyExists,
+                   Filesystem::CopyFile(CopySourceFile,CopySourceFile,Filesystem::FileOverwrite::Allow))
+    #endif
+        TEST_EQUAL("CopyFile(const_StringView,const_StringView)-OntoItself-Contents",
+                   true,ReadWholeFile(CopySourceFile) == CopyData)
+
+        {// Copy Strategies
+            const String StrategyDestFile("./CopyStrategyDest.dat");
+            Filesystem::CopyMethod MethodUsed = Filesystem::CopyMethod::None;
+
+            TEST_EQUAL("CopyFile(const_StringView,const_StringView,CopyStrategy,CopyMethod&)-FullCopy",
+                       Filesystem::ModifyResult::Success,
+                       Filesystem::CopyFile(CopySourceFile,StrategyDestFile,Filesystem::FileOverwrite::Deny,
+                                            Filesystem::CopyStrategy::FullCopy,MethodUsed))
+            TEST_EQUAL("CopyFile(const_StringView,const_StringView,CopyStrategy,CopyMethod&)-FullCopy-NotShared",
+                       true,MethodUsed == Filesystem::CopyMethod::SystemCopy ||
+                            MethodUsed == Filesystem::CopyMethod::BufferedCopy)
+            TEST_EQUAL("CopyFile(const_StringView,const_StringView,CopyStrategy,CopyMethod&)-FullCopy-Contents",
+                       true,ReadWholeFile(StrategyDestFile) == CopyData)
+
+            TEST_EQUAL("CopyFile(const_StringView,const_StringView,CopyStrategy,CopyMethod&)-ReflinkOrCopy",
+                       Filesystem::ModifyResult::Success,
+                       Filesystem::CopyFile(CopySourceFile,StrategyDestFile,Filesystem::FileOverwrite::Allow,
+                                            Filesystem::CopyStrategy::ReflinkOrCopy,MethodUsed))
+            TEST_EQUAL("CopyFile(const_StringView,const_StringView,CopyStrategy,CopyMethod&)-ReflinkOrCopy-Contents",
+                       true,ReadWholeFile(StrategyDestFile) == CopyData)
+            TestLog << "ReflinkOrCopy copied using method " << static_cast<int>(MethodUsed) << ".\n";
+
+            if( Filesystem::RemoveFile(StrategyDestFile) == false ) {
+                TEST_RESULT("CopyStrategyDest-CleanupFailed",Testing::TestResult::Warning)
+            }
+            Filesystem::ModifyResult ReflinkResult =
+                Filesystem::CopyFile(CopySourceFile,StrategyDestFile,Filesystem::FileOverwrite::Deny,
+                                     Filesystem::CopyStrategy::ReflinkOnly,MethodUsed);
+            if( ReflinkResult == Filesystem::ModifyResult::Success ) {
+                TEST_EQUAL("CopyFile(const_StringView,const_StringView,CopyStrategy,CopyMethod&)-ReflinkOnly-Method",
+                           true,MethodUsed == Filesystem::CopyMethod::Reflink)
+                TEST_EQUAL("CopyFile(const_StringView,const_StringView,CopyStrategy,CopyMethod&)-ReflinkOnly-Contents",
+                           true,ReadWholeFile(StrategyDestFile) == CopyData)
+                if( Filesystem::RemoveFile(StrategyDestFile) == false ) {
+                    TEST_RESULT("CopyStrategyDest-CleanupFailed",Testing::TestResult::Warning)
+                }
+            }else{
+                TestLog << "Reflinks are not supported by the filesystem being tested on.\n";
+                TEST_EQUAL("CopyFile(const_StringView,const_StringView,CopyStrategy,CopyMethod&)-ReflinkOnly-Fail",
+                           Filesystem::ModifyResult::NotSupported,ReflinkResult)
+                TEST_EQUAL("CopyFile(const_StringView,const_StringView,CopyStrategy,CopyMethod&)-ReflinkOnly-NoDest",
+                           false,Filesystem::FileExists(StrategyDestFile))
+            }
+
+            // An existing destination, longer than the source, must survive a clone that can't be made.
+            const String ExistingData = CopyData + "Existing data that must outlive a failed clone.";
+            {
+                std::ofstream ExistingDest(StrategyDestFile,std::ios_base::binary | std::ios_base::trunc);
+                ExistingDest << ExistingData;
+            }
+            ReflinkResult = Filesystem::CopyFile(CopySourceFile,StrategyDestFile,Filesystem::FileOverwrite::Allow,
+                                                 Filesystem::CopyStrategy::ReflinkOnly,MethodUsed);
+            if( ReflinkResult == Filesystem::ModifyResult::Success ) {
+                TEST_EQUAL("CopyFile(const_StringView,const_StringView,CopyStrategy,CopyMethod&)-ReflinkOnly-Replace",
+                           true,ReadWholeFile(StrategyDestFile) == CopyData)
+            }else{
+                TEST_EQUAL("CopyFile(const_StringView,const_StringView,CopyStrategy,CopyMethod&)-ReflinkOnly-Keep",
+                           true,ReadWholeFile(StrategyDestFile) == ExistingData)
+            }
+            if( Filesystem::RemoveFile(StrategyDestFile) == false ) {
+                TEST_RESULT("CopyStrategyDest-CleanupFailed",Testing::TestResult::Warning)
+            }
+        }// Copy Strategies
+
+    #ifndef MEZZ_Windows
+        {// Sparse Files
+            const String SparseSourceFile("./SparseSource.dat");
+            const String SparseDestFile("./SparseDest.dat");
+            const off_t SparseSize = off_t(10) * 1024 * 1024 * 1024;
+            const String ExtentData(64 * 1024,'S');
+            const off_t ExtentOffsets[] = { 0, SparseSize / 2, SparseSize - off_t( ExtentData.size() ) };
+
+            // A 10 GiB file with only three small extents of actual data.
+            int SparseHandle = ::open(SparseSourceFile.c_str(),O_WRONLY | O_CREAT | O_TRUNC,0644);
+            Boole SparseCreated = ( SparseHandle != -1 && ::ftruncate(SparseHandle,SparseSize) == 0 );
+            for( const off_t ExtentOffset : ExtentOffsets )
+            {
+                ssize_t Written = ::pwrite(SparseHandle,ExtentData.data(),ExtentData.size(),ExtentOffset);
+                SparseCreated = SparseCreated && Written == ssize_t(ExtentData.size());
+            }
+            if( SparseHandle != -1 ) {
+                ::close(SparseHandle);
+            }
+
+            struct stat SourceStat;
+            SparseCreated = SparseCreated && ::stat(SparseSourceFile.c_str(),&SourceStat) == 0;
+            if( SparseCreated && static_cast<off_t>(SourceStat.st_blocks) * 512 < SparseSize / 2 ) {
+                std::chrono::steady_clock::time_point CopyStart = std::chrono::steady_clock::now();
+                TEST_EQUAL("CopyFile(const_StringView,const_StringView)-Sparse",
+                           Filesystem::ModifyResult::Success,
+                           Filesystem::CopyFile(SparseSourceFile,SparseDestFile,Filesystem::FileOverwrite::Deny,
+                                                Filesystem::CopyStrategy::FullCopy))
+                std::chrono::duration<double,std::milli> CopyTime = std::chrono::steady_clock::now() - CopyStart;
+                TestLog << "Copied a 10 GiB sparse file in " << CopyTime.count() << "ms.\n";
+
+                struct stat DestStat;
+                if( ::stat(SparseDestFile.c_str(),&DestStat) == 0 ) {
+                    TEST_EQUAL("CopyFile(const_StringView,const_StringView)-Sparse-Size",
+                               SourceStat.st_size,DestStat.st_size)
+                    // Allow for the filesystem allocating slightly differently, but nothing close to the full size.
+                    TEST_EQUAL("CopyFile(const_StringView,const_StringView)-Sparse-BlocksPreserved",
+                               true,DestStat.st_blocks <= SourceStat.st_blocks + 2048)
+                    TestLog << "Sparse source blocks: " << SourceStat.st_blocks << ", "
+                            << "destination blocks: " << DestStat.st_blocks << ".\n";
+                }else{
+                    TEST_RESULT("CopyFile(const_StringView,const_StringView)-Sparse-Stat",Testing::TestResult::Failed)
+                }
+
+                Boole ExtentsMatch = true;
+                String ReadBack(ExtentData.size(),'\0');
+                int DestHandle = ::open(SparseDestFile.c_str(),O_RDONLY);
+                for( const off_t ExtentOffset : ExtentOffsets )
+                {
+                    ExtentsMatch = ExtentsMatch && DestHandle != -1 &&
+                        ::pread(DestHandle,&ReadBack[0],ReadBack.size(),ExtentOffset) == ssize_t(ReadBack.size()) &&
+                        ReadBack == ExtentData;
+                }
+                char HoleByte = 'X';
+                ExtentsMatch = ExtentsMatch && ::pread(DestHandle,&HoleByte,1,SparseSize / 4) == 1 && HoleByte == 0;
+                if( DestHandle != -1 ) {
+                    ::close(DestHandle);
+                }
+                TEST_EQUAL("CopyFile(const_StringView,const_StringView)-Sparse-Contents",true,ExtentsMatch)
+            }else{
+                TestLog << "The filesystem being tested on doesn't support sparse files.\n";
+                TEST_RESULT("CopyFile(const_StringView,const_StringView)-Sparse",Testing::TestResult::Skipped)
+            }
+            static_cast<void>( Filesystem::RemoveFile(SparseDestFile) );
+            static_cast<void>( Filesystem::RemoveFile(SparseSourceFile) );
+        }// Sparse Files
+    #endif
+
+        for( const String& CopyFile : { CopySourceFile, CopyDestFile, EmptySourceFile, EmptyDestFile } )
+        {
+            if( Filesystem::RemoveFile(CopyFile) == false ) {
+                TEST_RESULT("CopyFileData-CleanupFailed",Testing::TestResult::Warning)
+            }
+        }
+    }// Copying File Data
+
+    {// Atomic File Writing
+        const String AtomicDir("./AtomicWrite/");
+        const String AtomicFile = AtomicDir + "Config.txt";
+        const String FirstData("First version of the file.");
+        const String SecondData("Second, somewhat longer version of the file.");
+
+        TEST_EQUAL("AtomicWriteFile-Setup",
+                   Filesystem::ModifyResult::Success,
+                   Filesystem::CreateDirectory(AtomicDir))
+        TEST_EQUAL("AtomicWriteFile(const_StringView,const_StringView,const_DurabilityPolicy)-Create",
+                   Filesystem::ModifyResult::Success,
+                   Filesystem::AtomicWriteFile(AtomicFile,FirstData,Filesystem::DurabilityPolicy::None))
+        TEST_EQUAL("AtomicWriteFile(const_StringView,const_StringView,const_DurabilityPolicy)-CreateContents",
+                   FirstData,ReadWholeFile(AtomicFile))
+    #ifndef MEZZ_Windows
+        Boole ModeSet = ( ::chmod(AtomicFile.c_str(),0600) == 0 );
+    #endif
+        TEST_EQUAL("AtomicWriteFile(const_StringView,const_StringView,const_DurabilityPolicy)-Replace",
+                   Filesystem::ModifyResult::Success,
+                   Filesystem::AtomicWriteFile(AtomicFile,SecondData,
+                                               Filesystem::DurabilityPolicy::FlushFileAndDirectory))
+        TEST_EQUAL("AtomicWriteFile(const_StringView,const_StringView,const_DurabilityPolicy)-ReplaceContents",
+                   SecondData,ReadWholeFile(AtomicFile))
+    #ifndef MEZZ_Windows
+        struct stat AtomicStat;
+        if( ModeSet && ::stat(AtomicFile.c_str(),&AtomicStat) == 0 ) {
+            TEST_EQUAL("AtomicWriteFile(const_StringView,const_StringView,const_DurabilityPolicy)-Permissions",
+                       mode_t(0600),AtomicStat.st_mode & 07777)
+        }
+    #endif
+
+        auto ChunkWriter = [](const Filesystem::FileDataSink& Sink) {
+            for( Whole Line = 0 ; Line < 1000 ; ++Line )
+            {
+                if( !Sink( "Line " + std::to_string(Line) + "\n" ) ) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        TEST_EQUAL("AtomicWriteFile(const_StringView,const_FileDataWriter&,const_DurabilityPolicy)-Chunks",
+                   Filesystem::ModifyResult::Success,
+                   Filesystem::AtomicWriteFile(AtomicFile,ChunkWriter,Filesystem::DurabilityPolicy::FlushFile))
+        String ChunkedContents = ReadWholeFile(AtomicFile);
+        TEST_EQUAL("AtomicWriteFile(const_StringView,const_FileDataWriter&,const_DurabilityPolicy)-ChunksContents",
+                   true,ChunkedContents.size() > 7000 && ChunkedContents.compare(0,7,"Line 0\n") == 0)
+
+        auto CancelWriter = [](const Filesystem::FileDataSink& Sink) {
+            return Sink("Partial data that should never be seen.") && false;
+        };
+        TEST_EQUAL("AtomicWriteFile(const_StringView,const_FileDataWriter&,const_DurabilityPolicy)-Cancel",
+                   Filesystem::ModifyResult::OperationCanceled,
+                   Filesystem::AtomicWriteFile(AtomicFile,CancelWriter,Filesystem::DurabilityPolicy::None))
+        TEST_EQUAL("AtomicWriteFile(const_StringView,const_FileDataWriter&,const_DurabilityPolicy)-CancelUntouched",
+                   ChunkedContents,ReadWholeFile(AtomicFile))
+        TEST_EQUAL("AtomicWriteFile(const_StringView,const_FileDataWriter&,const_DurabilityPolicy)-NoTemporaries",
+                   size_t(1),Filesystem::GetDirectoryContentNames(AtomicDir).size())
+
+        TEST_EQUAL("AtomicWriteFile(const_StringView,const_StringView,const_DurabilityPolicy)-MissingDirectory",
+                   Filesystem::ModifyResult::DoesNotExist,
+                   Filesystem::AtomicWriteFile("./NotAnAtomicDir/File.txt",FirstData,
+                                               Filesystem::DurabilityPolicy::None))
+        TEST_EQUAL("AtomicWriteFile(const_StringView,const_StringView,const_DurabilityPolicy)-Directory",
+                   Filesystem::ModifyResult::IsADirectory,
+                   Filesystem::AtomicWriteFile(AtomicDir,FirstData,Filesystem::DurabilityPolicy::None))
+
+        TEST_EQUAL("AtomicWriteFile-Cleanup",
+                   Filesystem::ModifyResult::Success,
+                   Filesystem::RemoveDirectoryTree(AtomicDir))
+    }// Atomic File Writing
+
     #ifdef MEZZ_CompilerIsEmscripten
     {// Symlinks
         // Symlinks don't make sense on emscripten. Attempts were made to make it work and
@@ -317,6 +704,146 @@ AUTOMATIC_TEST_GROUP(FilesystemManagementTests,FilesystemManagement)
                    Filesystem::RemoveDirectory(BasePathTestDir))
     }// Basic Directory Management
 
+    {// Directory Tree Copies
+        const String TreeSource("./TreeSource/");
+        const String TreeDest("./TreeDest/");
+        const String TopFileData("Top of the tree.");
+        const String DeepFileData("Deep down in the tree.");
+
+        TEST_EQUAL("CopyDirectoryTree(const_StringView,const_StringView)-Setup",
+                   Filesystem::ModifyResult::Success,
+                   Filesystem::CreateDirectoryPath(TreeSource + "Sub/Deeper/"))
+        {
+            std::ofstream TopFile(TreeSource + "Top.txt");
+            TopFile << TopFileData;
+            std::ofstream InnerFile(TreeSource + "Sub/Inner.txt");
+            InnerFile << "Somewhere in the middle.";
+            std::ofstream DeepFile(TreeSource + "Sub/Deeper/Deep.txt");
+            DeepFile << DeepFileData;
+        }
+        Filesystem::ModifyResult LinkResult = Filesystem::CreateSymlink(TreeSource + "Link.txt","Top.txt");
+        Boole HasLink = ( LinkResult == Filesystem::ModifyResult::Success );
+    #ifndef MEZZ_Windows
+        const String TopFile = TreeSource + "Top.txt";
+        const struct timespec OldTimes[2] = { { 1000000000, 0 }, { 1000000000, 0 } };
+        Boole MetadataSet = ( ::chmod(TopFile.c_str(),0640) == 0 &&
+                              ::utimensat(AT_FDCWD,TopFile.c_str(),OldTimes,0) == 0 );
+    #endif
+
+        TEST_EQUAL("CopyDirectoryTree(const_StringView,const_StringView)-Copy",
+                   Filesystem::ModifyResult::Success,
+                   Filesystem::CopyDirectoryTree(TreeSource,TreeDest))
+        TEST_EQUAL("CopyDirectoryTree(const_StringView,const_StringView)-TopContents",
+                   TopFileData,ReadWholeFile(TreeDest + "Top.txt"))
+        TEST_EQUAL("CopyDirectoryTree(const_StringView,const_StringView)-DeepContents",
+                   DeepFileData,ReadWholeFile(TreeDest + "Sub/Deeper/Deep.txt"))
+        TEST_EQUAL("CopyDirectoryTree(const_StringView,const_StringView)-InnerExists",
+                   true,Filesystem::FileExists(TreeDest + "Sub/Inner.txt"))
+        if( HasLink ) {
+            TEST_EQUAL("CopyDirectoryTree(const_StringView,const_StringView)-SymlinkPreserved",
+                       true,Filesystem::SymlinkExists(TreeDest + "Link.txt"))
+        }
+    #ifndef MEZZ_Windows
+        struct stat CopiedStat;
+        if( MetadataSet && ::stat((TreeDest + "Top.txt").c_str(),&CopiedStat) == 0 ) {
+            TEST_EQUAL("CopyDirectoryTree(const_StringView,const_StringView)-Permissions",
+                       mode_t(0640),CopiedStat.st_mode & 07777)
+            TEST_EQUAL("CopyDirectoryTree(const_StringView,const_StringView)-ModifyTime",
+                       time_t(1000000000),CopiedStat.st_mtime)
+        }else{
+            TEST_RESULT("CopyDirectoryTree(const_StringView,const_StringView)-Metadata",Testing::TestResult::Skipped)
+        }
+    #endif
+
+        Filesystem::DirectoryCopyOptions Options;
+        TEST_EQUAL("CopyDirectoryTree(const_StringView,const_StringView,const_DirectoryCopyOptions&)-Deny",
+                   Filesystem::ModifyResult::AlreadyExists,
+                   Filesystem::CopyDirectoryTree(TreeSource,TreeDest,Options))
+        Options.IfExists = Filesystem::FileOverwrite::Allow;
+        Options.ThreadCount = 1;
+        TEST_EQUAL("CopyDirectoryTree(const_StringView,const_StringView,const_DirectoryCopyOptions&)-Allow",
+                   Filesystem::ModifyResult::Success,
+                   Filesystem::CopyDirectoryTree(TreeSource,TreeDest,Options))
+        TEST_EQUAL("CopyDirectoryTree(const_StringView,const_StringView)-MissingSource",
+                   Filesystem::ModifyResult::DoesNotExist,
+                   Filesystem::CopyDirectoryTree("./NotATreeSource/",TreeDest))
+        TEST_EQUAL("CopyDirectoryTree(const_StringView,const_StringView)-IntoItself",
+                   Filesystem::ModifyResult::Success,
+                   Filesystem::CopyDirectoryTree(TreeSource,TreeSource + "Nested/"))
+        TEST_EQUAL("CopyDirectoryTree(const_StringView,const_StringView)-IntoItself-NoRecursion",
+                   false,Filesystem::DirectoryExists(TreeSource + "Nested/Nested/"))
+
+        TEST_EQUAL("CopyDirectoryTree(const_StringView,const_StringView)-Cleanup",
+                   true,Filesystem::RemoveDirectoryTree(TreeSource) == Filesystem::ModifyResult::Success &&
+                        Filesystem::RemoveDirectoryTree(TreeDest) == Filesystem::ModifyResult::Success)
+    }// Directory Tree Copies
+
+    {// Directory Tree Removal
+        const String TreeRoot("./RemoveTree/");
+        const String Outside("./RemoveTreeOutside/");
+
+        auto BuildTree = [&]() {
+            Boole Built = ( Filesystem::CreateDirectoryPath(TreeRoot + "A/B/C/") == Filesystem::ModifyResult::Success &&
+                            Filesystem::CreateDirectoryPath(TreeRoot + "D/E/") == Filesystem::ModifyResult::Success );
+            for( const char* FileName : { "Top.txt", "A/One.txt", "A/B/Two.txt", "A/B/C/Three.txt", "D/E/Four.txt" } )
+            {
+                std::ofstream TreeFile(TreeRoot + FileName);
+                TreeFile << FileName;
+            }
+            return Built;
+        };
+        static_cast<void>( Filesystem::CreateDirectory(Outside) );
+        {
+            std::ofstream OutsideFile(Outside + "Keep.txt");
+            OutsideFile << "Not part of the tree.";
+        }
+
+        TEST_EQUAL("RemoveDirectoryTree(const_StringView)-Setup",true,BuildTree())
+        Filesystem::ModifyResult LinkResult =
+            Filesystem::CreateDirectorySymlink(TreeRoot + "A/B/OutsideLink","../../../RemoveTreeOutside");
+        Boole HasLink = ( LinkResult == Filesystem::ModifyResult::Success );
+        TEST_EQUAL("RemoveDirectoryTree(const_StringView)-Remove",
+                   Filesystem::ModifyResult::Success,
+                   Filesystem::RemoveDirectoryTree(TreeRoot))
+        TEST_EQUAL("RemoveDirectoryTree(const_StringView)-Removed",
+                   false,Filesystem::DirectoryExists(TreeRoot))
+        if( HasLink ) {
+            TEST_EQUAL("RemoveDirectoryTree(const_StringView)-SymlinkNotFollowed",
+                       true,Filesystem::FileExists(Outside + "Keep.txt"))
+        }
+
+        TEST_EQUAL("RemoveDirectoryTree(const_StringView,size_t)-Setup",true,BuildTree())
+        TEST_EQUAL("RemoveDirectoryTree(const_StringView,size_t)-OneThread",
+                   Filesystem::ModifyResult::Success,
+                   Filesystem::RemoveDirectoryTree(TreeRoot,1))
+        TEST_EQUAL("RemoveDirectoryTree(const_StringView,size_t)-ManyThreads-Setup",true,BuildTree())
+        TEST_EQUAL("RemoveDirectoryTree(const_StringView,size_t)-ManyThreads",
+                   Filesystem::ModifyResult::Success,
+                   Filesystem::RemoveDirectoryTree(TreeRoot,8))
+        TEST_EQUAL("RemoveDirectoryTree(const_StringView,size_t)-ManyThreads-Removed",
+                   false,Filesystem::DirectoryExists(TreeRoot))
+
+        TEST_EQUAL("RemoveDirectoryTree(const_StringView)-Missing",
+                   Filesystem::ModifyResult::DoesNotExist,
+                   Filesystem::RemoveDirectoryTree("./NotATreeToRemove/"))
+        TEST_EQUAL("RemoveDirectoryTree(const_StringView)-File",
+                   Filesystem::ModifyResult::NotADirectory,
+                   Filesystem::RemoveDirectoryTree(Outside + "Keep.txt"))
+        LinkResult = Filesystem::CreateDirectorySymlink("./RemoveTreeLink","RemoveTreeOutside");
+        if( LinkResult == Filesystem::ModifyResult::Success ) {
+            TEST_EQUAL("RemoveDirectoryTree(const_StringView)-SymlinkRoot",
+                       Filesystem::ModifyResult::NotADirectory,
+                       Filesystem::RemoveDirectoryTree("./RemoveTreeLink/"))
+            TEST_EQUAL("RemoveDirectoryTree(const_StringView)-SymlinkRoot-TargetKept",
+                       true,Filesystem::FileExists(Outside + "Keep.txt"))
+            static_cast<void>( Filesystem::RemoveSymlink("./RemoveTreeLink") );
+        }
+
+        TEST_EQUAL("RemoveDirectoryTree(const_StringView)-Cleanup",
+                   Filesystem::ModifyResult::Success,
+                   Filesystem::RemoveDirectoryTree(Outside))
+    }// Directory Tree Removal
+
     {// ModifyResult Operators
         Filesystem::ModifyResult Good = Filesystem::ModifyResult::Success;
         Filesystem::ModifyResult BadOne = Filesystem::ModifyResult::DoesNotExist;
@@ -0,0 +1,174 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_PathUtilitiesBenchmarks_h
+#define Mezz_Filesystem_PathUtilitiesBenchmarks_h
+
+/// @file
+/// @brief Timings of removing dot segments from paths of a few different shapes.
+
+#include "MezzTest.h"
+
+#include "PathUtilities.h"
+#include "AllocationCounter.h"
+
+#include <chrono>
+#include <utility>
+#include <vector>
+
+BENCHMARK_TEST_GROUP(PathUtilitiesBenchmarks,PathUtilitiesBenchmarks)
+{
+    using namespace Mezzanine;
+    using BenchClock = std::chrono::steady_clock;
+    using Milliseconds = std::chrono::duration<double,std::milli>;
+
+    const Whole PassCount = 1000000;
+
+    // Long enough to not fit in the small string buffer of most standard libraries.
+    const String ShortPath = "Data/Common/./Textures/Grass.png";
+    String DeepPath = "/opt/mezzanine";
+    for( Whole Depth = 0 ; Depth < 24 ; ++Depth )
+        { DeepPath.append("/level" + std::to_string(Depth)); }
+    DeepPath.append("/./asset.mesh");
+    String ParentHeavyPath = "../../Shared";
+    for( Whole Depth = 0 ; Depth < 12 ; ++Depth )
+        { ParentHeavyPath.append("/Sub" + std::to_string(Depth) + "/../Other" + std::to_string(Depth)); }
+    ParentHeavyPath.append("/../../../Config.ini");
+
+    /// @brief Times a normalization over every pass, returning milliseconds and the allocations made.
+    auto TimePasses = [&](auto&& ToTime) {
+        BenchClock::time_point Start = BenchClock::now();
+        const size_t Allocations = Filesystem::CountAllocations([&]() {
+            for( Whole Pass = 0 ; Pass < PassCount ; ++Pass )
+                { ToTime(); }
+        });
+        return std::make_pair(Milliseconds( BenchClock::now() - Start ).count(),Allocations);
+    };
+
+    /// @brief Times each version of RemoveDotSegments_Posix on a path.
+    /// @return Returns whether every version gave the same result, and whether the in-place and buffer versions
+    /// avoided allocating.
+    auto TimeVersions = [&](const char* CaseName, const String& Path) {
+        const String Expected = Filesystem::RemoveDotSegments_Posix(Path);
+
+        size_t StringTotal = 0;
+        auto StringResult = TimePasses([&](){
+            StringTotal += Filesystem::RemoveDotSegments_Posix(Path).size();
+        });
+
+        // The in-place version needs a fresh copy of the path on every pass, which is copied into a reused
+        // String so only the normalization is measured.
+        String InPlace;
+        InPlace.reserve( Path.size() );
+        size_t InPlaceTotal = 0;
+        auto InPlaceResult = TimePasses([&](){
+            InPlace.assign(Path);
+            Filesystem::RemoveDotSegmentsInPlace_Posix(InPlace);
+            InPlaceTotal += InPlace.size();
+        });
+
+        std::vector<Char8> Buffer( Path.size() );
+        size_t BufferTotal = 0;
+        auto BufferResult = TimePasses([&](){
+            BufferTotal += Filesystem::RemoveDotSegments_Posix(Path,Buffer.data(),Buffer.size());
+        });
+
+        TestLog << CaseName << " path (" << Path.size() << " characters) over " << PassCount << " passes - "
+                << "String: " << StringResult.first << "ms/" << StringResult.second << " allocations, "
+                << "in place: " << InPlaceResult.first << "ms/" << InPlaceResult.second << " allocations, "
+                << "buffer: " << BufferResult.first << "ms/" << BufferResult.second << " allocations.\n";
+        const Boole Matches = ( StringTotal == InPlaceTotal && StringTotal == BufferTotal && Expected == InPlace );
+        const Boole NoAllocations = ( InPlaceResult.second == 0 && BufferResult.second == 0 );
+        return std::make_pair(Matches,NoAllocations);
+    };
+
+    const std::pair<Boole,Boole> ShortResult = TimeVersions("Short",ShortPath);
+    TEST_EQUAL("RemoveDotSegments-Short-Matches",true,ShortResult.first)
+    TEST_EQUAL("RemoveDotSegments-Short-NoAllocations",true,ShortResult.second)
+    const std::pair<Boole,Boole> DeepResult = TimeVersions("Deep",DeepPath);
+    TEST_EQUAL("RemoveDotSegments-Deep-Matches",true,DeepResult.first)
+    TEST_EQUAL("RemoveDotSegments-Deep-NoAllocations",true,DeepResult.second)
+    const std::pair<Boole,Boole> ParentHeavyResult = TimeVersions("Parent heavy",ParentHeavyPath);
+    TEST_EQUAL("RemoveDotSegments-ParentHeavy-Matches",true,ParentHeavyResult.first)
+    TEST_EQUAL("RemoveDotSegments-ParentHeavy-NoAllocations",true,ParentHeavyResult.second)
+
+    {// Separator Scanning
+        size_t NameTotal = 0;
+        auto DirNameResult = TimePasses([&](){
+            NameTotal += Filesystem::GetDirName(DeepPath).size();
+        });
+        auto BaseNameResult = TimePasses([&](){
+            NameTotal += Filesystem::GetBaseName(DeepPath.c_str()).size();
+        });
+        Integer DepthTotal = 0;
+        auto DepthResult = TimePasses([&](){
+            DepthTotal += Filesystem::GetDirectoryDepth_Posix(DeepPath,false);
+        });
+
+        TestLog << "Deep path separator scanning over " << PassCount << " passes - "
+                << "GetDirName: " << DirNameResult.first << "ms, "
+                << "GetBaseName: " << BaseNameResult.first << "ms, "
+                << "GetDirectoryDepth_Posix: " << DepthResult.first << "ms.\n";
+        const size_t ExpectedNames = DeepPath.size() * PassCount;
+        TEST_EQUAL("SeparatorScan-Deep-NamesMatch",ExpectedNames,NameTotal)
+        TEST_EQUAL("SeparatorScan-Deep-DepthMatches",Integer(26) * Integer(PassCount),DepthTotal)
+    }// Separator Scanning
+
+    {// Sub Path Checks
+        const String MountRoot = "/opt/mezzanine/level0/level1/level2/";
+        Whole SubPathCount = 0;
+        auto SubPathResult = TimePasses([&](){
+            SubPathCount += ( Filesystem::IsSubPath_Posix(MountRoot,DeepPath) ? 1u : 0u );
+        });
+        Integer DepthTotal = 0;
+        auto DepthResult = TimePasses([&](){
+            DepthTotal += Filesystem::GetDirectoryDepth_Posix(ParentHeavyPath,true);
+        });
+
+        TestLog << "Deep path sub path checks over " << PassCount << " passes - "
+                << "IsSubPath_Posix: " << SubPathResult.first << "ms/" << SubPathResult.second << " allocations, "
+                << "GetDirectoryDepth_Posix: " << DepthResult.first << "ms/" << DepthResult.second
+                << " allocations.\n";
+        TEST_EQUAL("IsSubPath-Deep-Matches",PassCount,SubPathCount)
+        TEST_EQUAL("IsSubPath-Deep-NoAllocations",size_t(0),SubPathResult.second)
+        TEST_EQUAL("GetDirectoryDepth-ParentHeavy-NoAllocations",size_t(0),DepthResult.second)
+    }// Sub Path Checks
+}
+
+#endif
@@ -94,6 +94,24 @@ AUTOMATIC_TEST_GROUP(PathUtilitiesTests,PathUtilities)
                    "c",Filesystem::GetBaseName(String("/a/b/c")))
         TEST_EQUAL("GetBaseName(const_StringView)-UnixDir",
                    "",Filesystem::GetBaseName(String("/a/b/c/")))
+
+        // Long enough that separators land in full scan blocks as well as the leftover tail.
+        const String LongPosixPath("/a/deeply/nested/directory/with/enough/characters/for/several/blocks/File.txt");
+        const String LongWindowsPath("C:\\Program Files\\Some Vendor\\Some Product\\Version 1.2.3\\Bin\\App.exe");
+        TEST_EQUAL("GetDirName(const_char*)-LongUnixCStr",
+                   "/a/deeply/nested/directory/with/enough/characters/for/several/blocks/",
+                   Filesystem::GetDirName(LongPosixPath.c_str()))
+        TEST_EQUAL("GetDirName(const_StringView)-LongWindows",
+                   "C:\\Program Files\\Some Vendor\\Some Product\\Version 1.2.3\\Bin\\",
+                   Filesystem::GetDirName(LongWindowsPath))
+        TEST_EQUAL("GetDirName(const_StringView)-LongNoSeparator",
+                   "",Filesystem::GetDirName(String(100,'x')))
+        TEST_EQUAL("GetBaseName(const_char*)-LongUnixCStr",
+                   "File.txt",Filesystem::GetBaseName(LongPosixPath.c_str()))
+        TEST_EQUAL("GetBaseName(const_StringView)-LongWindows",
+                   "App.exe",Filesystem::GetBaseName(LongWindowsPath))
+        TEST_EQUAL("GetBaseName(const_StringView)-LongLeadingSeparatorOnly",
+                   String(63,'x'),Filesystem::GetBaseName("/" + String(63,'x')))
     }// Dir and Base Name
 
     {// Dot Segment Checks
@@ -219,6 +237,15 @@ AUTOMATIC_TEST_GROUP(PathUtilitiesTests,PathUtilities)
         TEST_EQUAL("GetDirectoryDepth_Posix(const_StringView,const_Boole)-Fourth",
                    2,Filesystem::GetDirectoryDepth_Posix(DepthDirFour,false))
 
+        const String DepthDirLong("one/two/three/./four/five/six/../seven/eight/nine/ten/eleven/twelve/thirteen/");
+        const String DepthDirLongNegative("./here/../../../and/back/up/through/some/longer/directory/names/");
+        TEST_EQUAL("GetDirectoryDepth_Posix(const_StringView,const_Boole)-Long",
+                   12,Filesystem::GetDirectoryDepth_Posix(DepthDirLong,false))
+        TEST_EQUAL("GetDirectoryDepth_Posix(const_StringView,const_Boole)-LongExitIfNegative",
+                   -1,Filesystem::GetDirectoryDepth_Posix(DepthDirLongNegative,true))
+        TEST_EQUAL("GetDirectoryDepth_Posix(const_StringView,const_Boole)-LongNoExit",
+                   6,Filesystem::GetDirectoryDepth_Posix(DepthDirLongNegative,false))
+
     #ifdef MEZZ_Windows
         const String DepthDirFive("MyDir\\..\\..\\MyOtherDir\\");
 
@@ -258,6 +285,18 @@ AUTOMATIC_TEST_GROUP(PathUtilitiesTests,PathUtilities)
         TEST_EQUAL("IsSubPath_Windows(const_StringView,const_StringView)-Second-Fail",
                    false,Filesystem::IsSubPath_Windows(BaseDirFour,"MyDocs\\Code\\..\\"))
 
+        // Longer than the stack buffers IsSubPath normalizes into, so the heap fallback is used.
+        String LongBaseDir("/srv");
+        for( Whole Depth = 0 ; Depth < 64 ; ++Depth )
+            { LongBaseDir.append("/mount").append(std::to_string(Depth)); }
+        LongBaseDir.append("/");
+        TEST_EQUAL("IsSubPath_Posix(const_StringView,const_StringView)-Long-Pass",
+                   true,Filesystem::IsSubPath_Posix(LongBaseDir,LongBaseDir + "./inner/../file/"))
+        TEST_EQUAL("IsSubPath_Posix(const_StringView,const_StringView)-Long-Fail",
+                   false,Filesystem::IsSubPath_Posix(LongBaseDir,LongBaseDir + "inner/../../file/"))
+        TEST_EQUAL("IsSubPath_Posix(const_StringView,const_StringView)-LongCheckOnly-Pass",
+                   true,Filesystem::IsSubPath_Posix(BaseDirOne,"/user/home" + LongBaseDir))
+
     #ifdef MEZZ_Windows
         const String BaseDirFive("C:\\");
 
@@ -366,6 +405,39 @@ AUTOMATIC_TEST_GROUP(PathUtilitiesTests,PathUtilities)
                    DotSegPathSixResult,Filesystem::RemoveDotSegments_Host(DotSegPathSix))
     #endif
 
+        TEST_EQUAL("RemoveDotSegments_Posix(const_StringView)-FileName",
+                   String("/a/c/file.txt"),Filesystem::RemoveDotSegments_Posix("/a/./b/../c/file.txt"))
+        TEST_EQUAL("RemoveDotSegments_Posix(const_StringView)-NoSeparator",
+                   String("file.txt"),Filesystem::RemoveDotSegments_Posix("file.txt"))
+        TEST_EQUAL("RemoveDotSegments_Posix(const_StringView)-LeadingParents",
+                   String("../../a/"),Filesystem::RemoveDotSegments_Posix("../../a/b/../"))
+        TEST_EQUAL("RemoveDotSegments_Posix(const_StringView)-AbsoluteParents",
+                   String("/a"),Filesystem::RemoveDotSegments_Posix("/../../a"))
+        TEST_EQUAL("RemoveDotSegments_Windows(const_StringView)-FileName",
+                   String("C:\\Users\\file.txt"),Filesystem::RemoveDotSegments_Windows("C:\\Users/Me\\..\\file.txt"))
+
+        const String DotSegBuffered("data/./textures/../models//ship.mesh");
+        const String DotSegBufferedResult("data/models/ship.mesh");
+        char DotSegBuffer[64] = {};
+        const size_t DotSegLength = Filesystem::RemoveDotSegments_Posix(DotSegBuffered,DotSegBuffer,64);
+        TEST_EQUAL("RemoveDotSegments_Posix(const_StringView,Char8*,const_size_t)",
+                   DotSegBufferedResult,String(DotSegBuffer,DotSegLength))
+        TEST_EQUAL("RemoveDotSegments_Posix(const_StringView,Char8*,const_size_t)-TooSmall",
+                   StringView::npos,Filesystem::RemoveDotSegments_Posix(DotSegBuffered,DotSegBuffer,8))
+        const size_t DotSegWinLength = Filesystem::RemoveDotSegments_Windows(DotSegPathFour,DotSegBuffer,64);
+        TEST_EQUAL("RemoveDotSegments_Windows(const_StringView,Char8*,const_size_t)",
+                   DotSegPathFourResult,String(DotSegBuffer,DotSegWinLength))
+
+        String DotSegInPlace = DotSegBuffered;
+        Filesystem::RemoveDotSegmentsInPlace_Posix(DotSegInPlace);
+        TEST_EQUAL("RemoveDotSegmentsInPlace_Posix(String&)",DotSegBufferedResult,DotSegInPlace)
+        String DotSegInPlaceWin = DotSegPathThree;
+        Filesystem::RemoveDotSegmentsInPlace_Windows(DotSegInPlaceWin);
+        TEST_EQUAL("RemoveDotSegmentsInPlace_Windows(String&)",DotSegPathThreeResult,DotSegInPlaceWin)
+        String DotSegInPlaceHost = DotSegPathSix;
+        Filesystem::RemoveDotSegmentsInPlace_Host(DotSegInPlaceHost);
+        TEST_EQUAL("RemoveDotSegmentsInPlace_Host(String&)",DotSegPathSixResult,DotSegInPlaceHost)
+
         const String CombinePathOne("C:\\Users\\Person\\Desktop\\");
         const String CombinePathTwo("home/");
         const String CombinePathThree("/etc/dir");
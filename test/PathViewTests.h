@@ -0,0 +1,159 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_PathViewTests_h
+#define Mezz_Filesystem_PathViewTests_h
+
+/// @file
+/// @brief This file tests the non-owning view of a path and its segment iteration.
+
+#include "MezzTest.h"
+
+#include "PathView.h"
+#include "AllocationCounter.h"
+
+AUTOMATIC_TEST_GROUP(PathViewTests,PathView)
+{
+    using namespace Mezzanine;
+    using Filesystem::PosixPathView;
+    using Filesystem::WindowsPathView;
+
+    // Joins the segments of a path so they can be compared in a single test.
+    auto JoinSegments = [](const auto& ToJoin) {
+        String Ret;
+        for( const StringView Segment : ToJoin )
+        {
+            Ret.append(Segment);
+            Ret.append(1,'|');
+        }
+        return Ret;
+    };
+
+    {// Posix Parts
+        const PosixPathView Absolute("/usr/local/lib/libMezz.so.2");
+        TEST_EQUAL("PathView<Posix>::Root()",StringView("/"),Absolute.Root())
+        TEST_EQUAL("PathView<Posix>::DirName()",StringView("/usr/local/lib/"),Absolute.DirName())
+        TEST_EQUAL("PathView<Posix>::BaseName()",StringView("libMezz.so.2"),Absolute.BaseName())
+        TEST_EQUAL("PathView<Posix>::Extension()",StringView(".2"),Absolute.Extension())
+        TEST_EQUAL("PathView<Posix>::Stem()",StringView("libMezz.so"),Absolute.Stem())
+        TEST_EQUAL("PathView<Posix>::IsAbsolute()",true,Absolute.IsAbsolute())
+        TEST_EQUAL("PathView<Posix>::GetView()",
+                   true,Absolute.GetView().data() == Absolute.BaseName().data() - 15)
+
+        const PosixPathView Relative("data/.profile");
+        TEST_EQUAL("PathView<Posix>::Root()-Relative",true,Relative.Root().empty())
+        TEST_EQUAL("PathView<Posix>::IsAbsolute()-Relative",false,Relative.IsAbsolute())
+        TEST_EQUAL("PathView<Posix>::Extension()-Hidden",true,Relative.Extension().empty())
+        TEST_EQUAL("PathView<Posix>::Stem()-Hidden",StringView(".profile"),Relative.Stem())
+
+        const PosixPathView Directory("a/b/");
+        TEST_EQUAL("PathView<Posix>::DirName()-Trailing",StringView("a/b/"),Directory.DirName())
+        TEST_EQUAL("PathView<Posix>::BaseName()-Trailing",true,Directory.BaseName().empty())
+        TEST_EQUAL("PathView<Posix>::BaseName()-NoSeparator",
+                   StringView("File.txt"),PosixPathView("File.txt").BaseName())
+        TEST_EQUAL("PathView<Posix>::DirName()-NoSeparator",true,PosixPathView("File.txt").DirName().empty())
+        TEST_EQUAL("PathView<Posix>::Extension()-DotSegment",true,PosixPathView("a/..").Extension().empty())
+        TEST_EQUAL("PathView<Posix>::BaseName()-BackslashIsName",
+                   StringView("c:\\file.txt"),PosixPathView("c:\\file.txt").BaseName())
+        TEST_EQUAL("PathView<Posix>::empty()",true,PosixPathView("").empty())
+    }// Posix Parts
+
+    {// Windows Parts
+        const WindowsPathView Absolute("C:\\Program Files/Mezz\\Engine.dll");
+        TEST_EQUAL("PathView<Windows>::Root()",StringView("C:\\"),Absolute.Root())
+        TEST_EQUAL("PathView<Windows>::IsAbsolute()",true,Absolute.IsAbsolute())
+        TEST_EQUAL("PathView<Windows>::DirName()",StringView("C:\\Program Files/Mezz\\"),Absolute.DirName())
+        TEST_EQUAL("PathView<Windows>::BaseName()",StringView("Engine.dll"),Absolute.BaseName())
+        TEST_EQUAL("PathView<Windows>::Extension()",StringView(".dll"),Absolute.Extension())
+
+        const WindowsPathView DriveRelative("d:Saves\\Slot1.sav");
+        TEST_EQUAL("PathView<Windows>::Root()-DriveRelative",StringView("d:"),DriveRelative.Root())
+        TEST_EQUAL("PathView<Windows>::IsAbsolute()-DriveRelative",false,DriveRelative.IsAbsolute())
+        TEST_EQUAL("PathView<Windows>::Root()-Rooted",StringView("\\"),WindowsPathView("\\Temp\\").Root())
+        TEST_EQUAL("PathView<Windows>::Root()-Relative",true,WindowsPathView("Temp\\a.txt").Root().empty())
+    }// Windows Parts
+
+    {// Segment Iteration
+        TEST_EQUAL("PathView<Posix>::begin()",
+                   String("usr|local|lib|"),JoinSegments(PosixPathView("/usr/local/lib")))
+        TEST_EQUAL("PathView<Posix>::begin()-RepeatedSeparators",
+                   String("a|.|b|..|c|"),JoinSegments(PosixPathView("a//./b/../c///")))
+        TEST_EQUAL("PathView<Posix>::begin()-RootOnly",
+                   true,PosixPathView("/").begin() == PosixPathView("/").end())
+        TEST_EQUAL("PathView<Posix>::begin()-Empty",
+                   true,PosixPathView("").begin() == PosixPathView("").end())
+        TEST_EQUAL("PathView<Windows>::begin()",String("Program Files|Mezz|Engine.dll|"),
+                   JoinSegments(WindowsPathView("C:\\Program Files/Mezz\\Engine.dll")))
+        TEST_EQUAL("PathView<Windows>::begin()-DriveRelative",
+                   String("Saves|Slot1.sav|"),JoinSegments(WindowsPathView("d:Saves\\Slot1.sav")))
+
+        const PosixPathView Counted("a/b/c");
+        TEST_EQUAL("PathView<Posix>::const_iterator-Distance",
+                   std::ptrdiff_t(3),std::distance(Counted.begin(),Counted.end()))
+        PosixPathView::const_iterator SegIt = Counted.begin();
+        SegIt++;
+        TEST_EQUAL("PathView<Posix>::const_iterator::operator++(int)",StringView("b"),*SegIt)
+        TEST_EQUAL("PathView<Posix>::const_iterator::operator->()",size_t(1),SegIt->size())
+    }// Segment Iteration
+
+    {// Compile Time Evaluation
+        constexpr PosixPathView Constant("/a/b.txt");
+        static_assert( Constant.BaseName() == "b.txt", "PathView should be usable in constant expressions." );
+        static_assert( Constant.Extension() == ".txt", "PathView should be usable in constant expressions." );
+        static_assert( *( ++Constant.begin() ) == "b.txt", "PathView should be usable in constant expressions." );
+        TEST_EQUAL("PathView<Posix>-Constexpr",StringView("/a/"),Constant.DirName())
+    }// Compile Time Evaluation
+
+    {// Allocations
+        const String Owned = "/some/resource/directory/texture.png";
+        size_t SegmentCount = 0;
+        size_t PartLengths = 0;
+        const size_t Allocations = Filesystem::CountAllocations([&]() {
+            const Filesystem::HostPathView ToSplit(Owned);
+            for( const StringView Segment : ToSplit )
+                { PartLengths += Segment.size(); ++SegmentCount; }
+            PartLengths += ToSplit.DirName().size() + ToSplit.BaseName().size() + ToSplit.Extension().size() +
+                           ToSplit.Stem().size() + ToSplit.Root().size();
+        });
+        TEST_EQUAL("PathView-NoAllocations",size_t(0),Allocations)
+        TEST_EQUAL("PathView-NoAllocationsSegments",size_t(4),SegmentCount)
+    }// Allocations
+}
+
+#endif
@@ -0,0 +1,173 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_SmallPathTests_h
+#define Mezz_Filesystem_SmallPathTests_h
+
+/// @file
+/// @brief This file tests the owning path with inline storage and its composition functions.
+
+#include "MezzTest.h"
+
+#include "SmallPath.h"
+#include "FilesystemManagement.h"
+#include "AllocationCounter.h"
+
+#include <cstring>
+
+AUTOMATIC_TEST_GROUP(SmallPathTests,SmallPath)
+{
+    using namespace Mezzanine;
+    using Filesystem::SmallPath;
+    using TinyPath = Filesystem::BasicSmallPath<16>;
+
+    const String HostSep(1,Filesystem::GetDirectorySeparator_Host());
+
+    {// Construction
+        const SmallPath Blank;
+        TEST_EQUAL("SmallPath::SmallPath()-Empty",true,Blank.empty())
+        TEST_EQUAL("SmallPath::SmallPath()-Inline",true,Blank.IsInline())
+        TEST_EQUAL("SmallPath::SmallPath()-CStr",size_t(0),std::strlen( Blank.c_str() ))
+        TEST_EQUAL("SmallPath::capacity()",size_t(256),Blank.capacity())
+
+        const SmallPath FromCStr("Data/Common");
+        TEST_EQUAL("SmallPath::SmallPath(const_char*)",StringView("Data/Common"),FromCStr.GetView())
+        const SmallPath FromString( String("Data/Common") );
+        TEST_EQUAL("SmallPath::SmallPath(const_String&)",true,FromString == FromCStr)
+        TEST_EQUAL("SmallPath::size()",size_t(11),FromString.size())
+    }// Construction
+
+    {// Composition
+        SmallPath Combined("Data");
+        Combined.Combine("Textures").Combine("Grass.png");
+        const String Expected =
+            Filesystem::CombinePathAndFileName_Host(Filesystem::CombinePathAndFileName_Host("Data","Textures"),
+                                                    "Grass.png");
+        TEST_EQUAL("SmallPath::Combine(const_StringView)",StringView(Expected),Combined.GetView())
+        TEST_EQUAL("SmallPath::Combine(const_StringView)-Inline",true,Combined.IsInline())
+
+        SmallPath TrailingSeparator("Data" + HostSep);
+        TrailingSeparator.Combine("File.txt");
+        TEST_EQUAL("SmallPath::Combine(const_StringView)-TrailingSeparator",
+                   true,TrailingSeparator == "Data" + HostSep + "File.txt")
+
+        const String OtherSep( 1,( HostSep == "/" ? '\\' : '/' ) );
+        SmallPath OtherSeparator("Data" + OtherSep);
+        OtherSeparator.Combine("File.txt");
+        TEST_EQUAL("SmallPath::Combine(const_StringView)-OtherSeparator",
+                   true,OtherSeparator == Filesystem::CombinePathAndFileName_Host("Data" + OtherSep,"File.txt"))
+
+        SmallPath FromEmpty;
+        FromEmpty.Combine("File.txt");
+        TEST_EQUAL("SmallPath::Combine(const_StringView)-Empty",StringView("File.txt"),FromEmpty.GetView())
+
+        SmallPath Appended("Grass");
+        Appended.Append(".png").Append('~');
+        TEST_EQUAL("SmallPath::Append(const_StringView)",StringView("Grass.png~"),Appended.GetView())
+
+        SmallPath Doubled("abc");
+        Doubled.Append(Doubled);
+        TEST_EQUAL("SmallPath::Append(const_StringView)-Self",StringView("abcabc"),Doubled.GetView())
+
+        const String ToNormalize = "Data" + HostSep + "." + HostSep + "Old" + HostSep + ".." + HostSep + "File.txt";
+        SmallPath Normalized(ToNormalize);
+        Normalized.Normalize();
+        const String ExpectedNormal = Filesystem::RemoveDotSegments_Host(ToNormalize);
+        TEST_EQUAL("SmallPath::Normalize()",StringView(ExpectedNormal),Normalized.GetView())
+        TEST_EQUAL("SmallPath::Normalize()-CStr",Normalized.size(),std::strlen( Normalized.c_str() ))
+    }// Composition
+
+    {// Spilling
+        TinyPath Growing("/opt");
+        Growing.Append("/mezzanine/data/./textures");
+        TEST_EQUAL("BasicSmallPath::Append(const_StringView)-Spilled",false,Growing.IsInline())
+        TEST_EQUAL("BasicSmallPath::Append(const_StringView)-SpilledContents",
+                   StringView("/opt/mezzanine/data/./textures"),Growing.GetView())
+        TEST_EQUAL("BasicSmallPath::Append(const_StringView)-SpilledCStr",
+                   Growing.size(),std::strlen( Growing.c_str() ))
+
+        TinyPath SelfSpill("0123456789");
+        SelfSpill.Append(SelfSpill);
+        TEST_EQUAL("BasicSmallPath::Append(const_StringView)-SelfSpill",
+                   StringView("01234567890123456789"),SelfSpill.GetView())
+
+        TinyPath Copied(Growing);
+        TEST_EQUAL("BasicSmallPath::BasicSmallPath(const_BasicSmallPath&)-Spilled",true,Copied == Growing.GetView())
+        TinyPath Moved( std::move(Copied) );
+        TEST_EQUAL("BasicSmallPath::BasicSmallPath(BasicSmallPath&&)-Spilled",true,Moved == Growing.GetView())
+        TEST_EQUAL("BasicSmallPath::BasicSmallPath(BasicSmallPath&&)-SourceEmptied",true,Copied.empty())
+
+        Growing.Assign("/opt");
+        TEST_EQUAL("BasicSmallPath::Assign(const_StringView)-BackInline",true,Growing.IsInline())
+        TEST_EQUAL("BasicSmallPath::Assign(const_StringView)-BackInlineContents",
+                   StringView("/opt"),Growing.GetView())
+
+        const size_t ReuseAllocations = Filesystem::CountAllocations([&]() {
+            Growing.Append("/mezzanine/data/textures");
+        });
+        TEST_EQUAL("BasicSmallPath::Append(const_StringView)-ReusesHeap",size_t(0),ReuseAllocations)
+    }// Spilling
+
+    {// Allocations
+        const String Root = "Data" + HostSep + "Common";
+        size_t TotalLength = 0;
+        const size_t Allocations = Filesystem::CountAllocations([&]() {
+            for( Whole Count = 0 ; Count < 100 ; ++Count )
+            {
+                SmallPath Composed(Root);
+                Composed.Combine("Textures").Combine("Terrain").Combine(".").Combine("..").Combine("Grass.png");
+                Composed.Normalize();
+                TotalLength += Composed.size();
+            }
+        });
+        TEST_EQUAL("SmallPath-ComposeWithoutAllocating",size_t(0),Allocations)
+        TEST_EQUAL("SmallPath-ComposeWithoutAllocating-Length",
+                   size_t(100) * ( Root.size() + HostSep.size() * 2 + 17 ),TotalLength)
+    }// Allocations
+
+    {// Filesystem Calls
+        const SmallPath Here(".");
+        TEST_EQUAL("SmallPath-DirectoryExists",true,Filesystem::DirectoryExists(Here))
+        SmallPath Missing(Here);
+        Missing.Combine("SmallPathTestsMissingFile.txt");
+        TEST_EQUAL("SmallPath-FileExists",false,Filesystem::FileExists(Missing))
+    }// Filesystem Calls
+}
+
+#endif
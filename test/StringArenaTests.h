@@ -0,0 +1,104 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_StringArenaTests_h
+#define Mezz_Filesystem_StringArenaTests_h
+
+/// @file
+/// @brief A few tests of storing many strings in a few large blocks.
+
+#include "MezzTest.h"
+
+#include "StringArena.h"
+
+AUTOMATIC_TEST_GROUP(StringArenaTests,StringArena)
+{
+    using namespace Mezzanine;
+
+    {// Storing
+        Filesystem::StringArena Arena(16);
+        TEST_EQUAL("StringArena::GetBlockSize()",size_t(16),Arena.GetBlockSize())
+        TEST_EQUAL("StringArena::GetBlockCount()-Empty",size_t(0),Arena.GetBlockCount())
+
+        StringView First = Arena.Store("First");
+        StringView Second = Arena.Store("Second");
+        TEST_EQUAL("StringArena::Store(const_StringView)-First",String("First"),String(First))
+        TEST_EQUAL("StringArena::Store(const_StringView)-Second",String("Second"),String(Second))
+        TEST_EQUAL("StringArena::Store(const_StringView)-Terminated",'\0',First.data()[First.size()])
+        TEST_EQUAL("StringArena::Store(const_StringView)-Contiguous",First.data() + 6,Second.data())
+        TEST_EQUAL("StringArena::GetBytesUsed()",size_t(13),Arena.GetBytesUsed())
+        TEST_EQUAL("StringArena::GetBlockCount()-OneBlock",size_t(1),Arena.GetBlockCount())
+
+        StringView Overflow = Arena.Store("Overflow");
+        StringView Large = Arena.Store("A string longer than a whole block.");
+        TEST_EQUAL("StringArena::Store(const_StringView)-NewBlock",String("Overflow"),String(Overflow))
+        TEST_EQUAL("StringArena::Store(const_StringView)-LargerThanBlock",
+                   String("A string longer than a whole block."),String(Large))
+        TEST_EQUAL("StringArena::Store(const_StringView)-EarlierViewsValid",String("First"),String(First))
+        TEST_EQUAL("StringArena::GetBlockCount()-Grown",size_t(3),Arena.GetBlockCount())
+        TEST_EQUAL("StringArena::GetCapacity()",size_t(16 + 16 + 36),Arena.GetCapacity())
+        TEST_EQUAL("StringArena::Store(const_StringView)-Empty",true,Arena.Store("").empty())
+    }// Storing
+
+    {// Clearing and Releasing
+        Filesystem::StringArena Arena(32);
+        StringView First = Arena.Store("Reused");
+        static_cast<void>( Arena.Store("A string that takes a block of its own.") );
+        const size_t Capacity = Arena.GetCapacity();
+
+        Arena.Clear();
+        TEST_EQUAL("StringArena::Clear()-BytesUsed",size_t(0),Arena.GetBytesUsed())
+        TEST_EQUAL("StringArena::Clear()-CapacityKept",Capacity,Arena.GetCapacity())
+        StringView Again = Arena.Store("Again");
+        TEST_EQUAL("StringArena::Clear()-MemoryReused",First.data(),Again.data())
+        static_cast<void>( Arena.Store("A string that takes a block of its own.") );
+        TEST_EQUAL("StringArena::Clear()-NoNewBlocks",Capacity,Arena.GetCapacity())
+
+        Filesystem::StringArena Moved(std::move(Arena));
+        TEST_EQUAL("StringArena::StringArena(StringArena&&)-ViewsValid",String("Again"),String(Again))
+        TEST_EQUAL("StringArena::StringArena(StringArena&&)-Capacity",Capacity,Moved.GetCapacity())
+
+        Moved.Release();
+        TEST_EQUAL("StringArena::Release()-Capacity",size_t(0),Moved.GetCapacity())
+        TEST_EQUAL("StringArena::Release()-BlockCount",size_t(0),Moved.GetBlockCount())
+        TEST_EQUAL("StringArena::Release()-StoreAfter",String("After"),String( Moved.Store("After") ))
+    }// Clearing and Releasing
+}
+
+#endif
@@ -71,6 +71,16 @@ AUTOMATIC_TEST_GROUP(SystemPathUtilitiesTests,SystemPathUtilities)
         TEST_EQUAL("GetSystemPATH(const_StringView)-Element1",String("/a/b/c"),SplitPosixPath[0])
         TEST_EQUAL("GetSystemPATH(const_StringView)-Element2",String("/bin"),SplitPosixPath[1])
         TEST_EQUAL("GetSystemPATH(const_StringView)-Element3",String(""),SplitPosixPath[2])
+
+        String LongPath;
+        for( Whole Entry = 0 ; Entry < 12 ; ++Entry )
+            { LongPath.append("/opt/package").append(std::to_string(Entry)).append("/bin").append(1,HostSep); }
+        LongPath.append("/ignored/trailing/entry");
+
+        StringVector SplitLongPath = Filesystem::GetSystemPATH( LongPath );
+        TEST_EQUAL("GetSystemPATH(const_StringView)-LongCount",size_t(12),SplitLongPath.size())
+        TEST_EQUAL("GetSystemPATH(const_StringView)-LongFirst",String("/opt/package0/bin"),SplitLongPath.front())
+        TEST_EQUAL("GetSystemPATH(const_StringView)-LongLast",String("/opt/package11/bin"),SplitLongPath.back())
     }//GetSystemPATH
 
 #ifndef MEZZ_CompilerIsEmscripten
@@ -0,0 +1,200 @@
+// � Copyright 2010 - 2019 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Filesystem_TreeSnapshotTests_h
+#define Mezz_Filesystem_TreeSnapshotTests_h
+
+/// @file
+/// @brief A few tests of capturing, saving and comparing directory tree snapshots.
+
+#include "MezzTest.h"
+
+#include "TreeSnapshot.h"
+#include "FilesystemManagement.h"
+
+#include <fstream>
+
+AUTOMATIC_TEST_GROUP(TreeSnapshotTests,TreeSnapshot)
+{
+    using namespace Mezzanine;
+
+    // Flattens a set of changes so it can be compared in a single test.
+    auto Describe = [](const Filesystem::TreeChangeVector& Changes) {
+        StringVector Ret;
+        for( const Filesystem::TreeChange& Change : Changes )
+        {
+            const char* ChangeName = "Modified";
+            if( Change.Change == Filesystem::TreeChangeType::Added ) {
+                ChangeName = "Added";
+            }else if( Change.Change == Filesystem::TreeChangeType::Removed ) {
+                ChangeName = "Removed";
+            }
+            const char* TypeName = ( Change.Type == EntryType::Directory ? "Dir" : "File" );
+            Ret.push_back( Change.Path + " " + ChangeName + " " + TypeName );
+        }
+        return Ret;
+    };
+    auto WriteFile = [](const char* FilePath, const String& Contents) {
+        std::ofstream ToWrite(FilePath);
+        ToWrite << Contents;
+    };
+
+    if( Filesystem::CreateDirectoryPath("Tree/Sub/Deep/") == false ||
+        Filesystem::CreateDirectory("Tree/Sub/Empty/") == false )
+    {
+        TEST_RESULT("CreateTreeDirs",Testing::TestResult::Failed)
+        return;
+    }
+    WriteFile("Tree/A.txt","Alpha");
+    WriteFile("Tree/Sub/B.txt","Bravo");
+    WriteFile("Tree/Sub/Deep/C.txt","Charlie");
+
+    Filesystem::TreeSnapshot Original = Filesystem::CaptureTreeSnapshot("Tree/");
+
+    {// Capture
+        TEST_EQUAL("CaptureTreeSnapshot(const_StringView)-Count",size_t(7),Original.size())
+        TEST_EQUAL("TreeSnapshot::GetRootPath()",String("Tree/"),Original.GetRootPath())
+        TEST_EQUAL("TreeSnapshot::GetName(const_size_t)-Root",true,Original.GetName(0).empty())
+        TEST_EQUAL("TreeSnapshot::GetName(const_size_t)-Sorted",String("A.txt"),String( Original.GetName(1) ))
+
+        const size_t DeepFile = Original.Find("Sub/Deep/C.txt");
+        TEST_EQUAL("TreeSnapshot::Find(const_StringView)",String("C.txt"),String( Original.GetName(DeepFile) ))
+        TEST_EQUAL("TreeSnapshot::Find(const_StringView)-Size",UInt64(7),Original.GetNode(DeepFile).Size)
+        const size_t SubDir = Original.Find("Sub/");
+        TEST_EQUAL("TreeSnapshot::Find(const_StringView)-Type",
+                   static_cast<int>(EntryType::Directory),static_cast<int>( Original.GetNode(SubDir).Type ))
+        TEST_EQUAL("TreeSnapshot::Find(const_StringView)-Root",size_t(0),Original.Find(""))
+        TEST_EQUAL("TreeSnapshot::Find(const_StringView)-Missing",Original.size(),Original.Find("Sub/Missing.txt"))
+        TEST_EQUAL("TreeSnapshot::FindChild(const_size_t,const_StringView)",
+                   Original.Find("Sub/B.txt"),Original.FindChild(Original.Find("Sub"),"B.txt"))
+        TEST_EQUAL("CaptureTreeSnapshot(const_StringView)-Missing",
+                   true,Filesystem::CaptureTreeSnapshot("Tree/NotADir/").empty())
+    }// Capture
+
+    {// Serialization
+        const String Serialized = Original.Serialize();
+        Filesystem::TreeSnapshot Loaded;
+        TEST_EQUAL("TreeSnapshot::Deserialize(const_StringView)",true,Loaded.Deserialize(Serialized))
+        TEST_EQUAL("TreeSnapshot::Deserialize(const_StringView)-RootPath",Original.GetRootPath(),Loaded.GetRootPath())
+        TEST_EQUAL("TreeSnapshot::Deserialize(const_StringView)-NoChanges",
+                   true,Filesystem::DiffTreeSnapshots(Original,Loaded).empty())
+        TEST_EQUAL("TreeSnapshot::Serialize()-RoundTrip",Serialized,Loaded.Serialize())
+
+        Filesystem::TreeSnapshot Truncated;
+        TEST_EQUAL("TreeSnapshot::Deserialize(const_StringView)-Truncated",
+                   false,Truncated.Deserialize( StringView(Serialized).substr(0,Serialized.size() - 1) ))
+        TEST_EQUAL("TreeSnapshot::Deserialize(const_StringView)-TruncatedEmpty",true,Truncated.empty())
+        String BadVersion = Serialized;
+        BadVersion[4] = 99;
+        TEST_EQUAL("TreeSnapshot::Deserialize(const_StringView)-Version",false,Truncated.Deserialize(BadVersion))
+
+        TEST_EQUAL("SaveTreeSnapshot(const_TreeSnapshot&,const_StringView)",
+                   true,Filesystem::SaveTreeSnapshot(Original,"Tree.snapshot") == Filesystem::ModifyResult::Success)
+        Optional<Filesystem::TreeSnapshot> FromFile = Filesystem::LoadTreeSnapshot("Tree.snapshot");
+        TEST_EQUAL("LoadTreeSnapshot(const_StringView)",true,FromFile.has_value())
+        TEST_EQUAL("LoadTreeSnapshot(const_StringView)-Contents",
+                   true,FromFile.has_value() && FromFile->Serialize() == Serialized)
+        TEST_EQUAL("LoadTreeSnapshot(const_StringView)-Missing",
+                   false,Filesystem::LoadTreeSnapshot("Missing.snapshot").has_value())
+        if( Filesystem::RemoveFile("Tree.snapshot") == false ) {
+            TEST_RESULT("TreeSnapshotFile-CleanupFailed",Testing::TestResult::Warning)
+        }
+    }// Serialization
+
+    {// Differences
+        TEST_EQUAL("DiffTreeSnapshot(const_TreeSnapshot&,const_StringView)-Unchanged",
+                   true,Filesystem::DiffTreeSnapshot(Original,"Tree/").empty())
+
+        WriteFile("Tree/A.txt","Alpha, but longer");
+        static_cast<void>( Filesystem::RemoveFile("Tree/Sub/B.txt") );
+        WriteFile("Tree/Sub/New.txt","New");
+        static_cast<void>( Filesystem::RemoveDirectory("Tree/Sub/Empty/") );
+        WriteFile("Tree/Sub/Empty","No longer a directory");
+        static_cast<void>( Filesystem::CreateDirectory("Tree/NewDir/") );
+        WriteFile("Tree/NewDir/D.txt","Delta");
+
+        const StringVector Expected = {
+            "A.txt Modified File",
+            "NewDir Added Dir",
+            "NewDir/D.txt Added File",
+            "Sub/B.txt Removed File",
+            "Sub/Empty Removed Dir",
+            "Sub/Empty Added File",
+            "Sub/New.txt Added File"
+        };
+        Filesystem::TreeSnapshot Changed = Filesystem::CaptureTreeSnapshot("Tree/");
+        TEST_EQUAL("DiffTreeSnapshots(const_TreeSnapshot&,const_TreeSnapshot&)",
+                   true,Describe( Filesystem::DiffTreeSnapshots(Original,Changed) ) == Expected)
+        TEST_EQUAL("DiffTreeSnapshot(const_TreeSnapshot&,const_StringView)",
+                   true,Describe( Filesystem::DiffTreeSnapshot(Original,"Tree/") ) == Expected)
+        TEST_EQUAL("DiffTreeSnapshot(const_TreeSnapshot&,const_StringView,const_Boole)",
+                   true,Describe( Filesystem::DiffTreeSnapshot(Original,"Tree/",true) ) == Expected)
+
+        const Filesystem::TreeSnapshot Empty;
+        TEST_EQUAL("DiffTreeSnapshots(const_TreeSnapshot&,const_TreeSnapshot&)-AllAdded",
+                   Changed.size() - 1,Filesystem::DiffTreeSnapshots(Empty,Changed).size())
+        const Filesystem::TreeChangeVector AllRemoved = Filesystem::DiffTreeSnapshots(Changed,Empty);
+        TEST_EQUAL("DiffTreeSnapshots(const_TreeSnapshot&,const_TreeSnapshot&)-AllRemoved",
+                   true,AllRemoved.size() == Changed.size() - 1 &&
+                        AllRemoved.front().Change == Filesystem::TreeChangeType::Removed)
+
+        // Adding to a subdirectory doesn't touch the modification time of its parent.
+        WriteFile("Tree/Sub/Deep/E.txt","Echo");
+        Filesystem::TreeSnapshot Reused = Filesystem::CaptureTreeSnapshot("Tree/",Changed);
+        TEST_EQUAL("CaptureTreeSnapshot(const_StringView,const_TreeSnapshot&)",
+                   true,Reused.Find("Sub/Deep/E.txt") < Reused.size())
+        TEST_EQUAL("DiffTreeSnapshot(const_TreeSnapshot&,const_StringView,const_Boole)-Nested",
+                   true,Describe( Filesystem::DiffTreeSnapshot(Changed,"Tree/",true) ) ==
+                        StringVector({ "Sub/Deep/E.txt Added File" }))
+        TEST_EQUAL("CaptureTreeSnapshot(const_StringView,const_TreeSnapshot&)-Unchanged",
+                   true,Filesystem::DiffTreeSnapshot(Reused,"Tree/",true).empty())
+
+        // Rewriting a file in place doesn't touch its directory, so only a full capture sees it.
+        WriteFile("Tree/Sub/Deep/C.txt","Charlie, rewritten");
+        TEST_EQUAL("DiffTreeSnapshot(const_TreeSnapshot&,const_StringView)-InPlace",
+                   true,Describe( Filesystem::DiffTreeSnapshot(Reused,"Tree/") ) ==
+                        StringVector({ "Sub/Deep/C.txt Modified File" }))
+    }// Differences
+
+    if( Filesystem::RemoveDirectoryTree("Tree/") == false ) {
+        TEST_RESULT("TreeDir-CleanupFailed",Testing::TestResult::Warning)
+    }
+}
+
+#endif